@@ -75,6 +75,18 @@ unless have_library("ippi"    + $ipp_lib_suffix, "ippiCopy_8u_C3R",        "ipp.
 	exit 1
 end
 
+# Optional features: huge-page backed image buffers and GC accounting of them
+have_header("sys/mman.h")
+have_func("rb_gc_adjust_memory_usage", "ruby.h")
+
+# Thread pool of asynchronous operations and parallel kernels
+have_header("ruby/thread.h")
+have_library("pthread", "pthread_create") unless RUBY_PLATFORM =~ /mswin|mingw/
+have_func("ippSetNumThreads", "ipp.h")
+
+# Native kernels must give the same results on every CPU tier, so floating point expressions are never contracted into FMA
+$CFLAGS << " -ffp-contract=off" if try_cflags("-ffp-contract=off")
+
 if options[:opencv]
 	$CFLAGS << " -DUSE_OPENCV"
 	unless find_header("cxcore.h", *$include_dirs) and
@@ -14,6 +14,22 @@
 #include "ipp4r_metatype.h"
 #include "ipp4r_struct.h"
 #include "ipp4r_matrix.h"
+#include "ipp4r_lut.h"
+#include "ipp4r_arith.h"
+#include "ipp4r_resize.h"
+#include "ipp4r_pyramid.h"
+#include "ipp4r_remap.h"
+#include "ipp4r_rotate.h"
+#include "ipp4r_colorspace.h"
+#include "ipp4r_planar.h"
+#include "ipp4r_convert.h"
+#include "ipp4r_filter.h"
+#include "ipp4r_half.h"
+#include "ipp4r_dispatch.h"
+#include "ipp4r_numa.h"
+#include "ipp4r_pool.h"
+#include "ipp4r_future.h"
+#include "ipp4r_batch.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -77,10 +93,19 @@ IPP4R_EXTERN VALUE rb_Ipp;
 
 IPP4R_EXTERN VALUE rb_Image;
 IPP4R_EXTERN VALUE rb_Data;
+IPP4R_EXTERN VALUE rb_PlanarImage;
 IPP4R_EXTERN VALUE rb_Color;
 IPP4R_EXTERN VALUE rb_ColorRef;
 IPP4R_EXTERN VALUE rb_Point;
 IPP4R_EXTERN VALUE rb_Size;
+IPP4R_EXTERN VALUE rb_Lut;
+IPP4R_EXTERN VALUE rb_Kernel;
+IPP4R_EXTERN VALUE rb_Mask;
+IPP4R_EXTERN VALUE rb_ResizePlan;
+IPP4R_EXTERN VALUE rb_RemapPlan;
+IPP4R_EXTERN VALUE rb_Future;
+IPP4R_EXTERN VALUE rb_AsyncImage;
+IPP4R_EXTERN VALUE rb_ImageBatch;
 
 IPP4R_EXTERN VALUE rb_Exception;
 
@@ -91,15 +116,20 @@ IPP4R_EXTERN VALUE rb_MetaType;
 IPP4R_EXTERN VALUE rb_CmpOp;
 IPP4R_EXTERN VALUE rb_Axis;
 IPP4R_EXTERN VALUE rb_MaskSize;
+IPP4R_EXTERN VALUE rb_BlendMode;
+IPP4R_EXTERN VALUE rb_ResizeMode;
+IPP4R_EXTERN VALUE rb_InterpMode;
+IPP4R_EXTERN VALUE rb_BorderMode;
+IPP4R_EXTERN VALUE rb_ColorSpace;
+IPP4R_EXTERN VALUE rb_Yuv420Format;
 
 
 // -------------------------------------------------------------------------- //
 // Frequently used IDs
 // -------------------------------------------------------------------------- //
 #define IPP4R_IDS                                                               \
-  (16, (                                                                        \
+  (14, (                                                                        \
     (spaceship,            "<=>"),                                              \
-    (aref,                 "[]"),                                               \
     (enumerators,          NULL),                                               \
     (enumerators_by_value, NULL),                                               \
     (r,                    NULL),                                               \
@@ -109,8 +139,7 @@ IPP4R_EXTERN VALUE rb_MaskSize;
     (new,                  NULL),                                               \
     (private_class_method, NULL),                                               \
     (clone,                NULL),                                               \
-    (row_size,             NULL),                                               \
-    (column_size,          NULL),                                               \
+    (to_a,                 NULL),                                               \
     (width,                NULL),                                               \
     (height,               NULL),                                               \
     (resize,               NULL)                                                \
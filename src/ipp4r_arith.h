@@ -0,0 +1,171 @@
+#ifndef __IPP4R_ARITH_H__
+#define __IPP4R_ARITH_H__
+
+#include <ippdefs.h>
+#include "ipp4r_fwd.h"
+#include "ipp4r_metatype.h"
+
+/**
+ * @file
+ *
+ * This file defines per-pixel arithmetic kernels. <p>
+ *
+ * All operations are defined in MetaNumber space, i.e. as if pixel values were normalized to [0, 1] range for integer data types.
+ * This way <tt>mul</tt> of two 8u images is <tt>a * b / 255</tt>, not <tt>a * b</tt>, and results are the same (up to rounding) for images of all data types.
+ * Results are saturated to the range of a destination data type for integer data types, signed ones (16s, 32s) covering [-1, 1]. <p>
+ *
+ * Each kernel is a single pass over the source and destination buffers, with the operation inlined into the inner loop.
+ * In AC4 images the alpha channel is not processed, it's copied from the first source, while C4 images have all four channels processed. <p>
+ *
+ * Blending kernels take the source in premultiplied form, which is how the drawing code caches converted sprites.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/**
+ * Arithmetic operation
+ */
+typedef enum {
+  ARITH_ADD,            /**< a + b */
+  ARITH_SUB,            /**< a - b */
+  ARITH_MUL,            /**< a * b */
+  ARITH_DIV,            /**< a / b */
+  ARITH_ABSDIFF,        /**< |a - b| */
+  ARITH_ADDWEIGHTED     /**< w[0] * a + w[1] * b + w[2] */
+} ArithOp;
+
+
+/**
+ * Blend mode. Source color <tt>s</tt> and alpha <tt>a</tt> are combined with an opaque background color <tt>b</tt> as follows.
+ */
+typedef enum {
+  BLEND_COPY,           /**< s, alpha is ignored */
+  BLEND_OVER,           /**< s * a + b * (1 - a) */
+  BLEND_MULTIPLY,       /**< b * (1 - a + s * a) */
+  BLEND_SCREEN,         /**< s * a + b * (1 - s * a) */
+  BLEND_ADDITIVE        /**< s * a + b */
+} BlendMode;
+
+
+// -------------------------------------------------------------------------- //
+// Function declarations
+// -------------------------------------------------------------------------- //
+/**
+ * Performs an arithmetic operation on two image buffers of the same metatype. In-place operation is supported, i.e. pDst may be equal to pSrc1 or pSrc2.
+ *
+ * @param op operation to perform
+ * @param metaType metatype of sources and destination
+ * @param pSrc1 first source buffer
+ * @param src1Step size of first source row in bytes
+ * @param pSrc2 second source buffer
+ * @param src2Step size of second source row in bytes
+ * @param pDst destination buffer
+ * @param dstStep size of destination row in bytes
+ * @param roi size of processed region in pixels
+ * @param weights weights for ARITH_ADDWEIGHTED, ignored for other operations
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int arith_apply(ArithOp op, IppMetaType metaType, const void* pSrc1, int src1Step, const void* pSrc2, int src2Step, void* pDst, int dstStep, IppiSize roi, const IppMetaNumber* weights);
+
+
+/**
+ * Performs an arithmetic operation on an image buffer and a constant color. In-place operation is supported.
+ *
+ * @param op operation to perform
+ * @param metaType metatype of source and destination
+ * @param pSrc source buffer
+ * @param srcStep size of source row in bytes
+ * @param color second operand
+ * @param pDst destination buffer
+ * @param dstStep size of destination row in bytes
+ * @param roi size of processed region in pixels
+ * @param weights weights for ARITH_ADDWEIGHTED, ignored for other operations
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int arith_apply_c(ArithOp op, IppMetaType metaType, const void* pSrc, int srcStep, Color* color, void* pDst, int dstStep, IppiSize roi, const IppMetaNumber* weights);
+
+
+/**
+ * Premultiplies color channels of a four-channel image buffer by its alpha channel. In-place operation is supported.
+ *
+ * @param metaType metatype of source and destination, must be AC4
+ * @param pSrc source buffer
+ * @param srcStep size of source row in bytes
+ * @param pDst destination buffer
+ * @param dstStep size of destination row in bytes
+ * @param roi size of processed region in pixels
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int arith_premultiply(IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi);
+
+
+/**
+ * Blends a premultiplied four-channel source over a background. In-place operation is supported, i.e. pDst may be equal to pBg. <br>
+ * Background of a single-channel metatype gets the grayscale value of the source color. Alpha of a four-channel background is composited too,
+ * which requires floating point math. Blending over opaque backgrounds of integer data types is done in integer arithmetic with a single multiplication per channel.
+ *
+ * @param mode blend mode, must not be BLEND_COPY
+ * @param metaType metatype of background and destination. Source is of AC4 metatype with the same data type
+ * @param pSrc premultiplied source buffer
+ * @param srcStep size of source row in bytes
+ * @param pBg background buffer
+ * @param bgStep size of background row in bytes
+ * @param pDst destination buffer
+ * @param dstStep size of destination row in bytes
+ * @param roi size of processed region in pixels
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int arith_blend(BlendMode mode, IppMetaType metaType, const void* pSrc, int srcStep, const void* pBg, int bgStep, void* pDst, int dstStep, IppiSize roi);
+
+
+/**
+ * Replaces pixel values that are less or greater than a threshold with the given value. This is a native version of ippiThreshold_Val
+ * for metatypes IPP doesn't cover (C4, 32s and 64f).
+ *
+ * @param metaType metatype of source and destination
+ * @param pSrc source buffer
+ * @param srcStep size of source row in bytes
+ * @param pDst destination buffer
+ * @param dstStep size of destination row in bytes
+ * @param roi size of processed region in pixels
+ * @param threshold threshold color
+ * @param cmp comparison operation, ippCmpLess or ippCmpGreater
+ * @param value color to replace the pixels with
+ * @returns ippStsNoErr if everything went OK, ippStsNotSupportedModeErr for unsupported comparison operation
+ */
+int arith_threshold(IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, Color* threshold, IppCmpOp cmp, Color* value);
+
+
+/**
+ * Adds uniformly distributed noise to an image buffer in place. This is a native version of ippiAddRandUniform_Direct for metatypes IPP doesn't cover (32s and 64f).
+ *
+ * @param metaType metatype of an image
+ * @param pSrcDst image buffer
+ * @param srcDstStep size of image row in bytes
+ * @param roi size of processed region in pixels
+ * @param lo lower bound of noise
+ * @param hi upper bound of noise
+ * @param seed seed of the random number generator, updated on return
+ * @returns ippStsNoErr if everything went OK, non-zero error code otherwise
+ */
+int arith_add_rand_uniform(IppMetaType metaType, void* pSrcDst, int srcDstStep, IppiSize roi, IppMetaNumber lo, IppMetaNumber hi, unsigned int* seed);
+
+
+/**
+ * Registers dispatch tables of arithmetic kernels, see dispatch_init.
+ */
+void arith_dispatch_init(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
@@ -0,0 +1,95 @@
+#ifndef __IPP4R_ATOMIC_H__
+#define __IPP4R_ATOMIC_H__
+
+#include <stddef.h>
+
+/**
+ * @file
+ *
+ * This file defines atomic counters, i.e. ints that may be changed by several threads at once. <p>
+ *
+ * C11 atomics are used where the compiler provides them, GCC builtins and MSVC interlocked intrinsics elsewhere.
+ * All operations are sequentially consistent, ATOMIC_INC and ATOMIC_DEC return the new value of a counter.
+ * A counter must be initialized with ATOMIC_INIT before use, or be a zero-initialized static. <p>
+ *
+ * ATOMIC_SIZE is a counter of size_t values, e.g. of bytes, with its own set of operations. ATOMIC_ADD_SIZE and ATOMIC_SUB_SIZE return the new value,
+ * ATOMIC_CAS_SIZE(P, E, D) sets the counter to D if it equals E and returns non-zero, or stores its current value into the lvalue E and returns zero. <p>
+ *
+ * ATOMIC_PTR is a pointer published by one thread and read by others, e.g. a lazily built table. ATOMIC_LOAD_PTR returns void*,
+ * ATOMIC_CAS_PTR(P, E, D) works like ATOMIC_CAS_SIZE, with E a void* lvalue.
+ */
+
+#if !defined(__cplusplus) && defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+#  include <stdatomic.h>
+#  define ATOMIC_INT atomic_int
+#  define ATOMIC_INIT(P, V) atomic_init((P), (V))
+#  define ATOMIC_LOAD(P) atomic_load(P)
+#  define ATOMIC_INC(P) (atomic_fetch_add((P), 1) + 1)
+#  define ATOMIC_DEC(P) (atomic_fetch_sub((P), 1) - 1)
+#  define ATOMIC_SIZE atomic_size_t
+#  define ATOMIC_LOAD_SIZE(P) atomic_load(P)
+#  define ATOMIC_ADD_SIZE(P, V) (atomic_fetch_add((P), (V)) + (V))
+#  define ATOMIC_SUB_SIZE(P, V) (atomic_fetch_sub((P), (V)) - (V))
+#  define ATOMIC_CAS_SIZE(P, E, D) atomic_compare_exchange_strong((P), &(E), (D))
+#  define ATOMIC_PTR _Atomic(void*)
+#  define ATOMIC_LOAD_PTR(P) atomic_load(P)
+#  define ATOMIC_CAS_PTR(P, E, D) atomic_compare_exchange_strong((P), &(E), (D))
+#elif defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+#  define ATOMIC_INT int
+#  define ATOMIC_INIT(P, V) (*(P) = (V))
+#  define ATOMIC_LOAD(P) __atomic_load_n((P), __ATOMIC_SEQ_CST)
+#  define ATOMIC_INC(P) __atomic_add_fetch((P), 1, __ATOMIC_SEQ_CST)
+#  define ATOMIC_DEC(P) __atomic_sub_fetch((P), 1, __ATOMIC_SEQ_CST)
+#  define ATOMIC_SIZE size_t
+#  define ATOMIC_LOAD_SIZE(P) __atomic_load_n((P), __ATOMIC_SEQ_CST)
+#  define ATOMIC_ADD_SIZE(P, V) __atomic_add_fetch((P), (V), __ATOMIC_SEQ_CST)
+#  define ATOMIC_SUB_SIZE(P, V) __atomic_sub_fetch((P), (V), __ATOMIC_SEQ_CST)
+#  define ATOMIC_CAS_SIZE(P, E, D) __atomic_compare_exchange_n((P), &(E), (D), 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+#  define ATOMIC_PTR void*
+#  define ATOMIC_LOAD_PTR(P) __atomic_load_n((P), __ATOMIC_SEQ_CST)
+#  define ATOMIC_CAS_PTR(P, E, D) __atomic_compare_exchange_n((P), &(E), (D), 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+#elif defined(_MSC_VER)
+#  include <intrin.h>
+#  define ATOMIC_INT long
+#  define ATOMIC_INIT(P, V) (*(P) = (V))
+#  define ATOMIC_LOAD(P) _InterlockedOr((P), 0)
+#  define ATOMIC_INC(P) _InterlockedIncrement(P)
+#  define ATOMIC_DEC(P) _InterlockedDecrement(P)
+#  ifdef _WIN64
+#    define ATOMIC_SIZE __int64
+#    define ATOMIC_LOAD_SIZE(P) ((size_t) _InterlockedOr64((P), 0))
+#    define ATOMIC_ADD_SIZE(P, V) ((size_t) _InterlockedExchangeAdd64((P), (__int64) (V)) + (V))
+#    define ATOMIC_SUB_SIZE(P, V) ((size_t) _InterlockedExchangeAdd64((P), -(__int64) (V)) - (V))
+#    define ATOMIC_CAS_SIZE_I(P, E, D) ((size_t) _InterlockedCompareExchange64((P), (__int64) (D), (__int64) (E)))
+#  else
+#    define ATOMIC_SIZE long
+#    define ATOMIC_LOAD_SIZE(P) ((size_t) _InterlockedOr((P), 0))
+#    define ATOMIC_ADD_SIZE(P, V) ((size_t) _InterlockedExchangeAdd((P), (long) (V)) + (V))
+#    define ATOMIC_SUB_SIZE(P, V) ((size_t) _InterlockedExchangeAdd((P), -(long) (V)) - (V))
+#    define ATOMIC_CAS_SIZE_I(P, E, D) ((size_t) _InterlockedCompareExchange((P), (long) (D), (long) (E)))
+#  endif
+#  define ATOMIC_CAS_SIZE(P, E, D) atomic_cas_size((P), &(E), (D))
+static __inline int atomic_cas_size(ATOMIC_SIZE volatile* p, size_t* expected, size_t desired) {
+  size_t old = ATOMIC_CAS_SIZE_I(p, *expected, desired);
+  if(old == *expected)
+    return 1;
+  *expected = old;
+  return 0;
+}
+#  define ATOMIC_PTR void* volatile
+#  define ATOMIC_LOAD_PTR(P) _InterlockedCompareExchangePointer((P), NULL, NULL)
+#  define ATOMIC_CAS_PTR(P, E, D) atomic_cas_ptr((P), &(E), (D))
+static __inline int atomic_cas_ptr(void* volatile* p, void** expected, void* desired) {
+  void* old = _InterlockedCompareExchangePointer(p, desired, *expected);
+  if(old == *expected)
+    return 1;
+  *expected = old;
+  return 0;
+}
+#else
+#  error "Atomic operations are not supported for this compiler"
+#endif
+
+#endif
+
+
@@ -0,0 +1,245 @@
+#include <assert.h>
+#include <string.h>
+#include "ipp4r.h"
+
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/** State of rb_Image_batch shared with its ensure function */
+typedef struct {
+  Batch* batch;         /**< batch to run */
+  VALUE rb_batch;       /**< ruby wrapper of batch, referenced from the stack so that gc doesn't collect it */
+  VALUE images;         /**< array of source images */
+  Future** futures;     /**< futures of images, NULL for the ones not created yet */
+  long count;           /**< number of images */
+} BatchRun;
+
+
+// -------------------------------------------------------------------------- //
+// Supplementary functions
+// -------------------------------------------------------------------------- //
+/**
+ * Queues a job for each image and collects the results. Body function for rb_ensure.
+ */
+static VALUE batch_run_body(VALUE arg) {
+  BatchRun* run = (BatchRun*) arg;
+  FutureArgs args;
+  Image* source;
+  VALUE result;
+  long i;
+
+  run->futures = ALLOC_N(Future*, run->count);
+  MEMZERO(run->futures, Future*, run->count);
+
+  memset(&args, 0, sizeof(args));
+  for(i = 0; i < run->count; i++) {
+    raise_on_error(image_clone(Data_Get_Struct_Ret(rb_ary_entry(run->images, i), Image), &source));
+
+    args.batch = batch_retain(run->batch);
+    run->futures[i] = future_new(source, batch_run, &args);
+    if(run->futures[i] == NULL) {
+      batch_release(args.batch);
+      image_destroy(source);
+      rb_raise(rb_eNoMemError, "could not allocate Future structure");
+    }
+
+    raise_on_error(future_submit(run->futures[i]));
+  }
+
+  result = rb_ary_new2(run->count);
+  for(i = 0; i < run->count; i++) {
+    future_wait(run->futures[i]);
+    raise_on_error(run->futures[i]->status);
+    rb_ary_push(result, image_wrap(run->futures[i]->result));
+    run->futures[i]->result = NULL;
+  }
+
+  return result;
+}
+
+
+/**
+ * Releases the futures of rb_Image_batch. Jobs that are still queued or running finish on their own. Ensure function for rb_ensure.
+ */
+static VALUE batch_run_ensure(VALUE arg) {
+  BatchRun* run = (BatchRun*) arg;
+  long i;
+
+  if(run->futures == NULL)
+    return Qnil;
+
+  for(i = 0; i < run->count; i++)
+    if(run->futures[i] != NULL)
+      future_release(run->futures[i]);
+  xfree(run->futures);
+
+  return Qnil;
+}
+
+
+// -------------------------------------------------------------------------- //
+// batch_new
+// -------------------------------------------------------------------------- //
+Batch* batch_new(void) {
+  Batch* batch;
+
+  batch = (Batch*) malloc(sizeof(Batch));
+  if(batch == NULL)
+    return NULL;
+
+  ATOMIC_INIT(&batch->refs, 1);
+  batch->ops = NULL;
+  batch->count = 0;
+  batch->capacity = 0;
+  batch->sealed = FALSE;
+
+  return batch;
+}
+
+
+// -------------------------------------------------------------------------- //
+// batch_add
+// -------------------------------------------------------------------------- //
+int batch_add(Batch* batch, FutureFunc func, const FutureArgs* args) {
+  BatchOp* ops;
+  int capacity;
+
+  assert(batch != NULL && func != NULL && args != NULL && !batch->sealed);
+
+  if(batch->count == batch->capacity) {
+    capacity = max(4, batch->capacity * 2);
+    ops = (BatchOp*) realloc(batch->ops, capacity * sizeof(BatchOp));
+    if(ops == NULL) {
+      if(args->matrix != NULL)
+        matrix_release(args->matrix);
+      return ippStsNoMemErr;
+    }
+    batch->ops = ops;
+    batch->capacity = capacity;
+  }
+
+  batch->ops[batch->count].func = func;
+  batch->ops[batch->count].args = *args;
+  batch->count++;
+
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// batch_retain
+// -------------------------------------------------------------------------- //
+Batch* batch_retain(Batch* batch) {
+  assert(batch != NULL);
+
+  ATOMIC_INC(&batch->refs);
+  return batch;
+}
+
+
+// -------------------------------------------------------------------------- //
+// batch_release
+// -------------------------------------------------------------------------- //
+void batch_release(Batch* batch) {
+  int i;
+
+  assert(batch != NULL);
+
+  if(ATOMIC_DEC(&batch->refs) != 0)
+    return;
+
+  for(i = 0; i < batch->count; i++)
+    if(batch->ops[i].args.matrix != NULL)
+      matrix_release(batch->ops[i].args.matrix);
+  free(batch->ops);
+  free(batch);
+}
+
+
+// -------------------------------------------------------------------------- //
+// batch_run
+// -------------------------------------------------------------------------- //
+int batch_run(Image* image, Image** dst, const FutureArgs* args) {
+  Batch* batch = args->batch;
+  Image* current;
+  Image* next;
+  int i, status;
+
+  assert(batch != NULL && batch->sealed && batch->count > 0);
+
+  current = image;
+  status = ippStsNoErr;
+  for(i = 0; i < batch->count; i++) {
+    status = batch->ops[i].func(current, &next, &batch->ops[i].args);
+    if(current != image)
+      image_destroy(current); /* intermediate result */
+    if(IS_ERROR(status))
+      return status;
+    current = next;
+  }
+
+  *dst = current;
+  return status;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Batch_record
+// -------------------------------------------------------------------------- //
+VALUE rb_Batch_record(VALUE self, FutureFunc func, const FutureArgs* args) {
+  Batch* batch;
+
+  batch = Data_Get_Struct_Ret(self, Batch);
+  if(batch->sealed) {
+    if(args->matrix != NULL)
+      matrix_release(args->matrix);
+    rb_raise(rb_eRuntimeError, "can't record operations after the batch block has returned");
+  }
+
+  raise_on_error(batch_add(batch, func, args));
+
+  return self;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_batch
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_batch(VALUE klass, VALUE images) {
+  Batch* batch;
+  BatchRun run;
+  VALUE image;
+  long i;
+
+  Check_Type(images, T_ARRAY);
+  if(!rb_block_given_p())
+    rb_raise(rb_eArgError, "no block given");
+
+  /* Images are checked before any job is queued, so that a wrong one doesn't leave half of the jobs running */
+  images = rb_ary_dup(images);
+  for(i = 0; i < RARRAY_LEN(images); i++) {
+    image = rb_ary_entry(images, i);
+    if(!RTEST(rb_obj_is_kind_of(image, rb_Image)))
+      rb_raise(rb_eTypeError, "wrong argument type %s in images (expected Ipp::Image)", rb_obj_classname(image));
+  }
+
+  batch = batch_new();
+  if(batch == NULL)
+    rb_raise(rb_eNoMemError, "could not allocate Batch structure");
+
+  run.batch = batch;
+  run.rb_batch = WRAP_BATCH(batch);
+  run.images = images;
+  run.count = RARRAY_LEN(images);
+  run.futures = NULL;
+
+  rb_yield(run.rb_batch);
+  batch->sealed = TRUE;
+  if(batch->count == 0)
+    rb_raise(rb_eArgError, "no operations recorded in the batch block");
+
+  return rb_ensure(batch_run_body, (VALUE) &run, batch_run_ensure, (VALUE) &run);
+}
+
+
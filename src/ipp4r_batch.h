@@ -0,0 +1,133 @@
+#ifndef __IPP4R_BATCH_H__
+#define __IPP4R_BATCH_H__
+
+#include <ruby.h>
+#include "ipp4r_fwd.h"
+#include "ipp4r_atomic.h"
+#include "ipp4r_future.h"
+
+/**
+ * @file
+ *
+ * This file defines C and Ruby interfaces for batches, i.e. chains of image operations applied to many images on the thread pool. <p>
+ *
+ * <tt>Ipp::Image.batch(images) { |b| b.resize(64, 64).filter_gauss(Ipp::Mask3x3) }</tt> yields an <tt>Ipp::Image::Batch</tt> recorder, whose methods
+ * are the ones of <tt>Ipp::Image::Async</tt>, but append an operation to the batch and return the recorder. Arguments are parsed once, when recorded.
+ * Then each image gets a pool job that runs the whole chain on a copy-on-write clone of it, and the results are returned in the order of images. <p>
+ *
+ * Operations are shared read-only by all jobs, so the recorder is sealed once the block returns.
+ * Batch is reference counted: the recorder and each job hold a reference.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/**
+ * Recorded operation.
+ */
+typedef struct {
+  FutureFunc func;      /**< operation */
+  FutureArgs args;      /**< arguments of operation, the batch holds the reference to the matrix in them */
+} BatchOp;
+
+
+/**
+ * Batch struct
+ */
+struct _Batch {
+  ATOMIC_INT refs;      /**< number of references, held by the ruby wrapper and by the jobs */
+  BatchOp* ops;         /**< recorded operations */
+  int count;            /**< number of recorded operations */
+  int capacity;         /**< number of allocated operations */
+  int sealed;           /**< are jobs using the operations? Sealed batch can't be changed */
+};
+
+
+// -------------------------------------------------------------------------- //
+// Batch C interface
+// -------------------------------------------------------------------------- //
+/**
+ * Creates an empty batch.
+ *
+ * @returns newly allocated Batch holding one reference, or NULL in case of an error
+ */
+Batch* batch_new(void);
+
+
+/**
+ * Appends an operation to a batch. Batch takes over the reference to the matrix in arguments, even if appending fails.
+ *
+ * @returns ippStsNoErr if everything went OK, ippStsNoMemErr otherwise
+ */
+int batch_add(Batch* batch, FutureFunc func, const FutureArgs* args);
+
+
+/**
+ * Adds a reference to a batch.
+ *
+ * @returns batch
+ */
+Batch* batch_retain(Batch* batch);
+
+
+/**
+ * Releases a reference to a batch, the batch is destroyed with the last one. Safe to call from any thread.
+ */
+void batch_release(Batch* batch);
+
+
+/**
+ * Asynchronous operation that runs all operations of args->batch in turn, each one on the result of the previous one.
+ *
+ * @see FutureFunc
+ */
+int batch_run(Image* image, Image** dst, const FutureArgs* args);
+
+
+// -------------------------------------------------------------------------- //
+// Batch Ruby interface
+// -------------------------------------------------------------------------- //
+/**
+ * Appends an operation to the batch of an Ipp::Image::Batch recorder.
+ *
+ * @param self Ipp::Image::Batch
+ * @param func operation
+ * @param args arguments of operation, the matrix in them is released even if an exception is raised
+ * @returns self
+ */
+VALUE rb_Batch_record(VALUE self, FutureFunc func, const FutureArgs* args);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image.batch(images) { |b| ... }</tt>
+ * </ul>
+ *
+ * Records the operations called on b, then applies them to all images on the thread pool, releasing the GVL while waiting.
+ * Raises the error of the first failed image, if any.
+ * @returns array of resulting images, in the order of images
+ */
+VALUE rb_Image_batch(VALUE klass, VALUE images);
+
+
+/**
+ * Wraps a Batch structure into ruby VALUE. Wrapper holds the reference the batch was created with.
+ *
+ * @param BATCH <tt>Batch*</tt>
+ */
+#define WRAP_BATCH(BATCH)                                                       \
+  Data_Wrap_Struct(rb_ImageBatch, NULL, batch_release, (BATCH))
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
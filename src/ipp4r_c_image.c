@@ -2,6 +2,8 @@
 #include <ruby.h>
 #include <time.h> /* for rand seed */
 #include <stdio.h> /* for debug purposes */
+#include <string.h> /* for memset */
+#include <math.h> /* for cos, sin */
 #include <assert.h>
 #include "ipp4r.h"
 #include "ipp4r_metatype.h"
@@ -19,6 +21,7 @@
 // Image accessors
 // -------------------------------------------------------------------------- //
 #define IS_SUBIMAGE(IMAGE) ((IMAGE)->is_subimage)
+#define IS_VIEW(IMAGE) ((IMAGE)->is_view)
 #define HEIGHT(IMAGE) ((IS_SUBIMAGE(IMAGE) ? (IMAGE)->height : (IMAGE)->data->height))
 #define WIDTH(IMAGE) ((IS_SUBIMAGE(IMAGE) ? (IMAGE)->width : (IMAGE)->data->width))
 #define PIXELSIZE(IMAGE) ((IMAGE)->data->pixelSize)
@@ -34,14 +37,136 @@
 #define CHANNELS(IMAGE) (metatype_channels(METATYPE(IMAGE)))
 #define DATATYPE(IMAGE) (metatype_datatype(METATYPE(IMAGE)))
 
-#define CHECK_DATATYPE_IN_DA(IMAGE, LEFT_PART, DA) IPPMETACALL(DATATYPE(IMAGE), LEFT_PART, DA, IPPMETAVAL, TRUE, ARX_EMPTY(), FALSE)
-#define CHECK_CHANNELS_IN_CA(IMAGE, LEFT_PART, CA) IPPMETACALL(CHANNELS(IMAGE), LEFT_PART, CA, IPPMETAVAL, TRUE, ARX_EMPTY(), FALSE)
+/* Gives an image a private copy of a buffer shared copy-on-write, returns from the calling function on error. */
+#define UNSHARE(IMAGE) { int unshareStatus; if(IS_ERROR(unshareStatus = data_unshare((IMAGE)->data))) TRACE_RETURN(unshareStatus); }
+#define TOUCH(IMAGE) { UNSHARE(IMAGE) (IMAGE)->data->stamp++; } /* must be called by every function that changes pixels of an image in place, before the change */
 
 // -------------------------------------------------------------------------- //
 // Helpers
 // -------------------------------------------------------------------------- //
 #define PWPWI(src, dst) PIXELS(src), WSTEP(src), PIXELS(dst), WSTEP(dst), IPPISIZE(src) /* IPPISIZE must be for src! see ippiman for Transpose function */
 #define PWI(src) PIXELS(src), WSTEP(src), IPPISIZE(src)
+#define MPWMPWI(src, dst) METATYPE(src), PIXELS(src), WSTEP(src), METATYPE(dst), PIXELS(dst), WSTEP(dst), IPPISIZE(src)
+
+
+// -------------------------------------------------------------------------- //
+// IPP coverage
+// -------------------------------------------------------------------------- //
+/* Metatypes that IPP provides primitives for, per function family. The rest of M_SUPPORTED is handled by native kernels. */
+#define M_IPP_ALL (20, (8u_C1, 8u_C3, 8u_AC4, 16u_C1, 16u_C3, 16u_AC4, 32f_C1, 32f_C3, 32f_AC4, 8u_C4, 16u_C4, 32f_C4, 16s_C1, 16s_C3, 16s_AC4, 16s_C4, 32s_C1, 32s_C3, 32s_AC4, 32s_C4))
+/* Data movement doesn't care about the meaning of bits, so 16f is moved by 16u primitives. */
+#define M_IPP_MOVE (24, (8u_C1, 8u_C3, 8u_AC4, 16u_C1, 16u_C3, 16u_AC4, 32f_C1, 32f_C3, 32f_AC4, 8u_C4, 16u_C4, 32f_C4, 16s_C1, 16s_C3, 16s_AC4, 16s_C4, 32s_C1, 32s_C3, 32s_AC4, 32s_C4, 16f_C1, 16f_C3, 16f_AC4, 16f_C4))
+#define M_MOVE(M) M_REPLACE_D_IF_D(M, 16f, 16u)
+#define M_IPP_BASIC (9, (8u_C1, 8u_C3, 8u_AC4, 16u_C1, 16u_C3, 16u_AC4, 32f_C1, 32f_C3, 32f_AC4))
+#define M_IPP_MORPH (11, (8u_C1, 8u_C3, 8u_AC4, 8u_C4, 16u_C1, 16u_C3, 16u_AC4, 32f_C1, 32f_C3, 32f_AC4, 32f_C4))
+#define M_IPP_ROTATE (12, (8u_C1, 8u_C3, 8u_AC4, 8u_C4, 16u_C1, 16u_C3, 16u_AC4, 16u_C4, 32f_C1, 32f_C3, 32f_AC4, 32f_C4))
+#define M_IPP_FILTER (15, (8u_C1, 8u_C3, 8u_AC4, 8u_C4, 16u_C1, 16u_C3, 16u_AC4, 16s_C1, 16s_C3, 16s_AC4, 16s_C4, 32f_C1, 32f_C3, 32f_AC4, 32f_C4))
+#define M_IPP_MEDIAN (9, (8u_C1, 8u_C3, 8u_AC4, 16u_C1, 16u_C3, 16u_AC4, 16s_C1, 16s_C3, 16s_AC4))
+#define M_IPP_THRESHOLD (12, (8u_C1, 8u_C3, 8u_AC4, 16u_C1, 16u_C3, 16u_AC4, 32f_C1, 32f_C3, 32f_AC4, 16s_C1, 16s_C3, 16s_AC4))
+#define M_IPP_RAND (16, (8u_C1, 8u_C3, 8u_AC4, 16u_C1, 16u_C3, 16u_AC4, 32f_C1, 32f_C3, 32f_AC4, 8u_C4, 16u_C4, 32f_C4, 16s_C1, 16s_C3, 16s_AC4, 16s_C4))
+
+
+// -------------------------------------------------------------------------- //
+// IPP tables
+// -------------------------------------------------------------------------- //
+/* Per-operation tables of IPP primitives, indexed by IppMetaType, see DEFINE_METATABLE. Metatypes with NULL entries are handled by native kernels. */
+#define IPP_PARAMS_R (const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi)
+#define IPP_PARAMS_IR (void* pSrcDst, int srcDstStep, IppiSize roi)
+
+/* Data movement, 32f is moved by 32s primitives where IPP has no 32f ones */
+#define IPP_COPY(M) return ARX_JOIN_3(ippiCopy_, M_MOVE(M), R) (pSrc, srcStep, pDst, dstStep, roi);
+DEFINE_METATABLE(IppStatus, ipp_copy, M_IPP_MOVE, IPP_PARAMS_R, IPP_COPY)
+
+#define IPP_COPY_REPLICATE_BORDER(M) return ARX_JOIN_3(ippiCopyReplicateBorder_, M_REPLACE_D_IF_D(M_MOVE(M), 32f, 32s), R) (pSrc, srcStep, srcRoi, pDst, dstStep, dstRoi, top, left);
+DEFINE_METATABLE(IppStatus, ipp_copy_replicate_border, M_IPP_MOVE, (const void* pSrc, int srcStep, IppiSize srcRoi, void* pDst, int dstStep, IppiSize dstRoi, int top, int left), IPP_COPY_REPLICATE_BORDER)
+
+#define IPP_COPY_REPLICATE_BORDER_I(M) return ARX_JOIN_3(ippiCopyReplicateBorder_, M_REPLACE_D_IF_D(M_MOVE(M), 32f, 32s), IR) (pSrcDst, srcDstStep, srcRoi, dstRoi, top, left);
+DEFINE_METATABLE(IppStatus, ipp_copy_replicate_border_i, M_IPP_MOVE, (const void* pSrcDst, int srcDstStep, IppiSize srcRoi, IppiSize dstRoi, int top, int left), IPP_COPY_REPLICATE_BORDER_I)
+
+#define IPP_TRANSPOSE(M) return ARX_JOIN_3(ippiTranspose_, M_REPLACE_C_IF_C(M_REPLACE_D_IF_D(M_MOVE(M), 32f, 32s), AC4, C4), R) (pSrc, srcStep, pDst, dstStep, roi); /* 32f -> 32s hack works, tested */
+DEFINE_METATABLE(IppStatus, ipp_transpose, M_IPP_MOVE, IPP_PARAMS_R, IPP_TRANSPOSE)
+
+#define IPP_MIRROR_TYPE(M) M_REPLACE_D_IF_D(M_REPLACE_D_IF_D(M_MOVE(M), 32f, 32s), 16s, 16u)
+#define IPP_MIRROR(M) return ARX_JOIN_3(ippiMirror_, IPP_MIRROR_TYPE(M), R) (pSrc, srcStep, pDst, dstStep, roi, axis);
+DEFINE_METATABLE(IppStatus, ipp_mirror, M_IPP_MOVE, (const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, IppiAxis axis), IPP_MIRROR)
+
+#define IPP_MIRROR_I(M) return ARX_JOIN_3(ippiMirror_, IPP_MIRROR_TYPE(M), IR) (pSrcDst, srcDstStep, roi, axis);
+DEFINE_METATABLE(IppStatus, ipp_mirror_i, M_IPP_MOVE, (void* pSrcDst, int srcDstStep, IppiSize roi, IppiAxis axis), IPP_MIRROR_I)
+
+#define IPP_ROTATE(M) return ARX_JOIN_3(ippiRotate_, M, R) (pSrc, srcSize, srcStep, srcRoi, pDst, dstStep, dstRoi, angle, xShift, yShift, interpolation);
+DEFINE_METATABLE(IppStatus, ipp_rotate, M_IPP_ROTATE, (const void* pSrc, IppiSize srcSize, int srcStep, IppiRect srcRoi, void* pDst, int dstStep, IppiRect dstRoi, double angle, double xShift, double yShift, int interpolation), IPP_ROTATE)
+
+/* Filling and test images */
+#define IPP_SET(M) USING_M2C_COLOR(1); return ARX_JOIN_3(ippiSet_, M_MOVE(M), R) (M2C_COLOR(M, color, 0), pDst, dstStep, roi);
+DEFINE_METATABLE(IppStatus, ipp_set, M_IPP_MOVE, (const IppMetaNumber* color, void* pDst, int dstStep, IppiSize roi), IPP_SET)
+
+#define IPP_JAEHNE(M) return ARX_JOIN_3(ippiImageJaehne_, M, R) (pDst, dstStep, roi);
+DEFINE_METATABLE(IppStatus, ipp_jaehne, M_IPP_ALL, (void* pDst, int dstStep, IppiSize roi), IPP_JAEHNE)
+
+#define IPP_RAMP(M) return ARX_JOIN_3(ippiImageRamp_, M, R) (pDst, dstStep, roi, offset, slope, axis);
+DEFINE_METATABLE(IppStatus, ipp_ramp, M_IPP_ALL, (void* pDst, int dstStep, IppiSize roi, float offset, float slope, IppiAxis axis), IPP_RAMP)
+
+#define IPP_ADD_RAND_UNIFORM(M) return ARX_JOIN_3(ippiAddRandUniform_Direct_, M, IR) (pSrcDst, srcDstStep, roi, M2C_NUMBER(M, lo), M2C_NUMBER(M, hi), seed);
+DEFINE_METATABLE(IppStatus, ipp_add_rand_uniform, M_IPP_RAND, (void* pSrcDst, int srcDstStep, IppiSize roi, IppMetaNumber lo, IppMetaNumber hi, unsigned int* seed), IPP_ADD_RAND_UNIFORM)
+
+#define IPP_THRESHOLD(M) USING_M2C_COLOR(2); return ARX_JOIN_3(ippiThreshold_Val_, M, R) (pSrc, srcStep, pDst, dstStep, roi, M2C_COLOR(M, threshold, 0), M2C_COLOR(M, value, 1), cmp);
+DEFINE_METATABLE(IppStatus, ipp_threshold, M_IPP_THRESHOLD, (const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, const IppMetaNumber* threshold, const IppMetaNumber* value, IppCmpOp cmp), IPP_THRESHOLD)
+
+/* Morphology */
+#define IPP_DILATE3X3(M) return ARX_JOIN_3(ippiDilate3x3_, M, R) (pSrc, srcStep, pDst, dstStep, roi);
+DEFINE_METATABLE(IppStatus, ipp_dilate3x3, M_IPP_MORPH, IPP_PARAMS_R, IPP_DILATE3X3)
+
+#define IPP_DILATE3X3_I(M) return ARX_JOIN_3(ippiDilate3x3_, M, IR) (pSrcDst, srcDstStep, roi);
+DEFINE_METATABLE(IppStatus, ipp_dilate3x3_i, M_IPP_MORPH, IPP_PARAMS_IR, IPP_DILATE3X3_I)
+
+#define IPP_ERODE3X3(M) return ARX_JOIN_3(ippiErode3x3_, M, R) (pSrc, srcStep, pDst, dstStep, roi);
+DEFINE_METATABLE(IppStatus, ipp_erode3x3, M_IPP_MORPH, IPP_PARAMS_R, IPP_ERODE3X3)
+
+#define IPP_ERODE3X3_I(M) return ARX_JOIN_3(ippiErode3x3_, M, IR) (pSrcDst, srcDstStep, roi);
+DEFINE_METATABLE(IppStatus, ipp_erode3x3_i, M_IPP_MORPH, IPP_PARAMS_IR, IPP_ERODE3X3_I)
+
+#define IPP_DILATE(M) return ARX_JOIN_3(ippiDilate_, M, R) (pSrc, srcStep, pDst, dstStep, roi, mask, maskSize, anchor);
+DEFINE_METATABLE(IppStatus, ipp_dilate, M_IPP_MORPH, (const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, const Ipp8u* mask, IppiSize maskSize, IppiPoint anchor), IPP_DILATE)
+
+#define IPP_DILATE_I(M) return ARX_JOIN_3(ippiDilate_, M, IR) (pSrcDst, srcDstStep, roi, mask, maskSize, anchor);
+DEFINE_METATABLE(IppStatus, ipp_dilate_i, M_IPP_MORPH, (void* pSrcDst, int srcDstStep, IppiSize roi, const Ipp8u* mask, IppiSize maskSize, IppiPoint anchor), IPP_DILATE_I)
+
+#define IPP_ERODE(M) return ARX_JOIN_3(ippiErode_, M, R) (pSrc, srcStep, pDst, dstStep, roi, mask, maskSize, anchor);
+DEFINE_METATABLE(IppStatus, ipp_erode, M_IPP_MORPH, (const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, const Ipp8u* mask, IppiSize maskSize, IppiPoint anchor), IPP_ERODE)
+
+#define IPP_ERODE_I(M) return ARX_JOIN_3(ippiErode_, M, IR) (pSrcDst, srcDstStep, roi, mask, maskSize, anchor);
+DEFINE_METATABLE(IppStatus, ipp_erode_i, M_IPP_MORPH, (void* pSrcDst, int srcDstStep, IppiSize roi, const Ipp8u* mask, IppiSize maskSize, IppiPoint anchor), IPP_ERODE_I)
+
+/* Filters */
+#define IPP_PARAMS_MASK_R (const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, IppiSize maskSize, IppiPoint anchor)
+
+#define IPP_FILTER_BOX(M) return ARX_JOIN_3(ippiFilterBox_, M, R) (pSrc, srcStep, pDst, dstStep, roi, maskSize, anchor);
+DEFINE_METATABLE(IppStatus, ipp_filter_box, M_IPP_FILTER, IPP_PARAMS_MASK_R, IPP_FILTER_BOX)
+
+#define IPP_FILTER_BOX_I(M) return ARX_JOIN_3(ippiFilterBox_, M, IR) (pSrcDst, srcDstStep, roi, maskSize, anchor);
+DEFINE_METATABLE(IppStatus, ipp_filter_box_i, M_IPP_FILTER, (void* pSrcDst, int srcDstStep, IppiSize roi, IppiSize maskSize, IppiPoint anchor), IPP_FILTER_BOX_I)
+
+#define IPP_FILTER_MIN(M) return ARX_JOIN_3(ippiFilterMin_, M, R) (pSrc, srcStep, pDst, dstStep, roi, maskSize, anchor);
+DEFINE_METATABLE(IppStatus, ipp_filter_min, M_IPP_FILTER, IPP_PARAMS_MASK_R, IPP_FILTER_MIN)
+
+#define IPP_FILTER_MAX(M) return ARX_JOIN_3(ippiFilterMax_, M, R) (pSrc, srcStep, pDst, dstStep, roi, maskSize, anchor);
+DEFINE_METATABLE(IppStatus, ipp_filter_max, M_IPP_FILTER, IPP_PARAMS_MASK_R, IPP_FILTER_MAX)
+
+#define IPP_FILTER_MEDIAN(M) return ARX_JOIN_3(ippiFilterMedian_, M, R) (pSrc, srcStep, pDst, dstStep, roi, maskSize, anchor);
+DEFINE_METATABLE(IppStatus, ipp_filter_median, M_IPP_MEDIAN, IPP_PARAMS_MASK_R, IPP_FILTER_MEDIAN)
+
+#define IPP_FILTER_GAUSS(M) return ARX_JOIN_3(ippiFilterGauss_, M, R) (pSrc, srcStep, pDst, dstStep, roi, mask);
+DEFINE_METATABLE(IppStatus, ipp_filter_gauss, M_IPP_FILTER, (const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, IppiMaskSize mask), IPP_FILTER_GAUSS)
+
+#define IPP_FILTER(M) return ARX_JOIN_5(IF_M_IS_D(M, 32f, ippiFilter_, ippiFilter32f_), M_DATATYPE(M), _, M_CHANNELS(M), R) (pSrc, srcStep, pDst, dstStep, roi, kernel, kernelSize, anchor);
+DEFINE_METATABLE(IppStatus, ipp_filter, M_IPP_FILTER, (const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, const Ipp32f* kernel, IppiSize kernelSize, IppiPoint anchor), IPP_FILTER)
+
+/* Pixel value converters */
+#define PIXEL_FROM_COLOR(M) M2C_COLOR_TO(M, color, pixel);
+DEFINE_METATABLE(void, pixel_from_color, M_INTERLEAVED, (const IppMetaNumber* color, void* pixel), PIXEL_FROM_COLOR)
+
+#define PIXEL_TO_COLOR(M) C2M_COLOR_TO(M, pixel, color);
+DEFINE_METATABLE(void, pixel_to_color, M_INTERLEAVED, (const void* pixel, IppMetaNumber* color), PIXEL_TO_COLOR)
 
 
 // -------------------------------------------------------------------------- //
@@ -91,6 +216,82 @@ static int masksize_border(IppiMaskSize maskSize) {
   }
 }
 
+/**
+ * Copies pixels between buffers of the same metatype.
+ */
+static int copy_pixels(IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi) {
+  return METATABLE_CALL(ipp_copy, metaType, (pSrc, srcStep, pDst, dstStep, roi), convert_copy(metaType, pSrc, srcStep, metaType, pDst, dstStep, roi));
+}
+
+/**
+ * Native counterpart of ippiCopyReplicateBorder. Source is copied to the destination at (left, top), and the rest of the destination
+ * is filled with replicated edge pixels. In-place operation is supported, in this case pSrc must point to the pixel (left, top) of pDst.
+ */
+static int copy_replicate_border(int pixelSize, const void* pSrc, int srcStep, IppiSize srcRoi, void* pDst, int dstStep, IppiSize dstRoi, int top, int left) {
+  int x, y, right;
+  char* d;
+
+  right = dstRoi.width - srcRoi.width - left;
+  for(y = 0; y < srcRoi.height; y++) {
+    d = (char*) pDst + (top + y) * dstStep;
+    if(pSrc != d + left * pixelSize || srcStep != dstStep)
+      memcpy(d + left * pixelSize, (const char*) pSrc + y * srcStep, srcRoi.width * pixelSize);
+    for(x = 0; x < left; x++)
+      memcpy(d + x * pixelSize, d + left * pixelSize, pixelSize);
+    for(x = 0; x < right; x++)
+      memcpy(d + (left + srcRoi.width + x) * pixelSize, d + (left + srcRoi.width - 1) * pixelSize, pixelSize);
+  }
+
+  for(y = 0; y < top; y++)
+    memcpy((char*) pDst + y * dstStep, (char*) pDst + top * dstStep, dstRoi.width * pixelSize);
+  for(y = top + srcRoi.height; y < dstRoi.height; y++)
+    memcpy((char*) pDst + y * dstStep, (char*) pDst + (top + srcRoi.height - 1) * dstStep, dstRoi.width * pixelSize);
+
+  return ippStsNoErr;
+}
+
+/**
+ * @returns orientation transform equal to mirroring about the given axis
+ */
+static Orientation axis_orientation(IppiAxis axis) {
+  switch(axis) {
+  case ippAxsHorizontal: return ORIENT_FLIP_V;
+  case ippAxsVertical: return ORIENT_FLIP_H;
+  default: return ORIENT_ROTATE_180;
+  }
+}
+
+/**
+ * Fills an image with a color, for metatypes IPP has no Set primitive for. As ippiSet does, leaves alpha of AC4 images intact.
+ */
+static int image_fill_native(Image* image, Color* color) {
+  Ipp64f value[C_MAX_COUNT];
+  int x, y, valueSize;
+  char* d;
+
+  if(METATABLE_FUNCTION(pixel_from_color, METATYPE(image)) == NULL) {
+    Unreachable();
+    return ippStsBadArgErr;
+  }
+  pixel_from_color[METATYPE(image)](color->as_array, value);
+
+  valueSize = CHANNELS(image) == ippAC4 ? PIXELSIZE(image) / 4 * 3 : PIXELSIZE(image);
+  for(y = 0; y < HEIGHT(image); y++) {
+    d = (char*) PIXEL_AT(image, 0, y);
+    for(x = 0; x < WIDTH(image); x++, d += PIXELSIZE(image))
+      memcpy(d, value, valueSize);
+  }
+
+  return ippStsNoErr;
+}
+
+/**
+ * Creates a 32f image with the size and channels of the given one. Test images of metatypes IPP can't render are rendered into it and then converted.
+ */
+static int image_new_32f_like(Image* image, Image** dst) {
+  return image_new(dst, WIDTH(image), HEIGHT(image), metatype_compose(ipp32f, CHANNELS(image)), 0);
+}
+
 
 // -------------------------------------------------------------------------- //
 // image_height
@@ -156,10 +357,9 @@ TRACE_FUNC(int, image_ensure_border, (Image* image, int border)) {
   srcRoi.height = image->data->height  + 2 * BORDER(image);
   dstRoi.width  = result->data->width  + 2 * BORDER(result);
   dstRoi.height = result->data->height + 2 * BORDER(result);
-  
-#define METAFUNC(M, ARG) ARX_JOIN_3(ippiCopyReplicateBorder_, M_REPLACE_D_IF_D(M, 32f, 32s), R) (image->data->buffer, WSTEP(image), srcRoi, result->data->buffer, WSTEP(result), dstRoi, borderGrowth, borderGrowth)
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, METAFUNC, ~, Unreachable(), ippStsBadArgErr);
-#undef METAFUNC  
+
+  status = METATABLE_CALL(ipp_copy_replicate_border, METATYPE(image), (image->data->buffer, WSTEP(image), srcRoi, result->data->buffer, WSTEP(result), dstRoi, borderGrowth, borderGrowth),
+                          copy_replicate_border(PIXELSIZE(image), image->data->buffer, WSTEP(image), srcRoi, result->data->buffer, WSTEP(result), dstRoi, borderGrowth, borderGrowth));
   if(IS_ERROR(status)) {
     image_destroy(result);
     TRACE_RETURN(status);
@@ -186,9 +386,9 @@ TRACE_FUNC(int, image_rebuild_border, (Image* image)) {
   dstRoi.width  = image->data->width  + 2 * BORDER(image);
   dstRoi.height = image->data->height + 2 * BORDER(image);
 
-#define METAFUNC(M, ARG) ARX_JOIN_3(ippiCopyReplicateBorder_, M_REPLACE_D_IF_D(M, 32f, 32s), IR) (image->data->pixels, WSTEP(image), srcRoi, dstRoi, BORDER(image), BORDER(image))
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, METAFUNC, ~, Unreachable(), ippStsBadArgErr);
-#undef METAFUNC  
+  /* No UNSHARE here: images sharing a buffer have the same pixels, so the border written is the same for all of them. */
+  status = METATABLE_CALL(ipp_copy_replicate_border_i, METATYPE(image), (image->data->pixels, WSTEP(image), srcRoi, dstRoi, BORDER(image), BORDER(image)),
+                          copy_replicate_border(PIXELSIZE(image), image->data->pixels, WSTEP(image), srcRoi, image->data->buffer, WSTEP(image), dstRoi, BORDER(image), BORDER(image)));
 
   TRACE_RETURN(status);
 } TRACE_END
@@ -246,6 +446,7 @@ TRACE_FUNC(int, image_new, (Image** dst, int width, int height, IppMetaType meta
 
   (*dst)->data = data;
   (*dst)->is_subimage = FALSE;
+  (*dst)->is_view = FALSE;
 
   TRACE_RETURN(ippStsNoErr);
 } TRACE_END
@@ -263,9 +464,10 @@ TRACE_FUNC(int, image_subimage, (Image* image, Image** dst, int x, int y, int wi
   if(*dst == NULL)
     TRACE_RETURN(ippStsNoMemErr);
 
-  (*dst)->data = image->data; // data is shared
+  (*dst)->data = data_retain(image->data); // data is shared
   (*dst)->rb_data = image->rb_data;
   (*dst)->is_subimage = TRUE;
+  (*dst)->is_view = TRUE;
   (*dst)->x = x;
   (*dst)->y = y;
   (*dst)->width = width;
@@ -281,8 +483,9 @@ TRACE_FUNC(int, image_subimage, (Image* image, Image** dst, int x, int y, int wi
 TRACE_FUNC(void, image_destroy, (Image* image)) {
   assert(image != NULL);
 
-  if(!SHARED(image))
-    data_destroy(image->data);
+  /* Shared data is referenced by its ruby wrapper, which releases it when swept. Views hold a reference of their own. */
+  if(!SHARED(image) || IS_VIEW(image))
+    data_release(image->data);
   free(image);
 } TRACE_END
 
@@ -311,8 +514,9 @@ TRACE_FUNC(void, image_share, (Image* image)) {
 
   TRACE(("%08X data=%08X", image, image->data));
 
+  /* Creator's reference passes to the wrapper. */
   image->data->shared = TRUE;
-  image->rb_data = Data_Wrap_Struct(rb_Data, NULL, data_destroy, image->data);
+  image->rb_data = Data_Wrap_Struct(rb_Data, NULL, data_release, image->data);
 } TRACE_END
 
 
@@ -320,11 +524,19 @@ TRACE_FUNC(void, image_share, (Image* image)) {
 // image_wrap
 // -------------------------------------------------------------------------- //
 TRACE_FUNC(VALUE, image_wrap, (Image* image)) {
+  TRACE_RETURN(image_wrap_class(image, rb_Image));
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_wrap_class
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(VALUE, image_wrap_class, (Image* image, VALUE klass)) {
   /* Check for NULL is needed, see rb_Image_alloc.
    * Check for SHARED is needed too, see rb_Image_subimage */
   if(image != NULL && !SHARED(image)) 
     image_share(image);
-  TRACE_RETURN(Data_Wrap_Struct(rb_Image, image_mark, image_destroy, image));
+  TRACE_RETURN(Data_Wrap_Struct(klass, image_mark, image_destroy, image));
 } TRACE_END
 
 
@@ -333,13 +545,28 @@ TRACE_FUNC(VALUE, image_wrap, (Image* image)) {
 // -------------------------------------------------------------------------- //
 TRACE_FUNC(int, image_clone, (Image* image, Image** dst)) {
   int status;
+  Data* data;
 
   assert(image != NULL && dst != NULL);
 
+  /* Whole images share their buffer copy-on-write, see TOUCH. */
+  if(!IS_SUBIMAGE(image) && (data = data_share(image->data)) != NULL) {
+    *dst = (Image*) malloc(sizeof(Image));
+    if(*dst == NULL) {
+      data_destroy(data);
+      TRACE_RETURN(ippStsNoMemErr);
+    }
+
+    (*dst)->data = data;
+    (*dst)->is_subimage = FALSE;
+    (*dst)->is_view = FALSE;
+    TRACE_RETURN(ippStsNoErr);
+  }
+
   if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0)))
     TRACE_RETURN(status);
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiCopy_, R, (PWPWI(image, *dst))), Unreachable(), ippStsBadArgErr);
+  status = copy_pixels(METATYPE(image), PWPWI(image, *dst));
   if(IS_ERROR(status))
     image_destroy(*dst);
 
@@ -585,35 +812,24 @@ TRACE_FUNC(int, image_addranduniform, (Image* image, IppMetaNumber lo, IppMetaNu
 
   assert(image != NULL);
 
+  TOUCH(image);
+
   seed = (unsigned int) time(NULL) + seedMod++;
 
-#define METAFUNC(M, ARG) ARX_JOIN_3(ippiAddRandUniform_Direct_, M, IR) (PWI(image), M2C_NUMBER(M, lo), M2C_NUMBER(M, hi), &seed)
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, METAFUNC, ~, Unreachable(), ippStsBadArgErr);
-#undef METAFUNC  
+  status = METATABLE_CALL(ipp_add_rand_uniform, METATYPE(image), (PWI(image), lo, hi, &seed), arith_add_rand_uniform(METATYPE(image), PWI(image), lo, hi, &seed));
   TRACE_RETURN(status);
 } TRACE_END
 
 
 // -------------------------------------------------------------------------- //
-// image_convert_datatype_copy
+// Conversion kernels
 // -------------------------------------------------------------------------- //
-TRACE_FUNC(int, image_convert_datatype_copy, (Image* image, Image** dst, IppDataType dataType)) {
-  int status;
-  Ipp32f scaleColor[4] = {D_SCALE(16u), D_SCALE(16u), D_SCALE(16u), D_SCALE(16u)};
-
-  assert(image != NULL && dst != NULL);
-
-  TRACE(("image_convert_datatype from %d to %d", DATATYPE(image), dataType));
-
-  if(DATATYPE(image) == dataType)
-    TRACE_RETURN(image_clone(image, dst));
+/** Converts an image to an allocated image of a metatype that differs either in data type or in channels */
+typedef int (*ImageConvertFunc)(Image* image, Image** dst);
 
-  if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), metatype_compose(dataType, CHANNELS(image)), 0)))
-    TRACE_RETURN(status);
-
-  TRACE(("image_convert_datatype from %d to %d", DATATYPE(image), dataType));
+static Ipp32f image_scale_16u[4] = {D_SCALE(16u), D_SCALE(16u), D_SCALE(16u), D_SCALE(16u)};
 
-#define CONVERT(D, C, NEW_D)                                                    \
+#define IMAGE_CONVERT_DATATYPE(D, C, NEW_D)                                     \
   IF_D_EQ_D(D, NEW_D,                                                           \
     Unreachable(),                                                              \
     ARX_IF(DD_IN_DDA((D, NEW_D), (2, ((16u, 8u), (8u, 16u)))),                  \
@@ -623,12 +839,12 @@ TRACE_FUNC(int, image_convert_datatype_copy, (Image* image, Image** dst, IppData
         IF_DD_EQ_DD((D, NEW_D), (16u, 32f),                                     \
           status = ARX_JOIN_6(ippiConvert_, D, NEW_D, _, C, R) (PWPWI(image, *dst)); \
           if(!IS_ERROR(status))                                                 \
-            status = ARX_JOIN_5(ippiDivC_, NEW_D, _, IF_C_EQ_C(C, AC4, C4, C), IR) (scaleColor IF_C_EQ_C(C, C1, [0], ARX_EMPTY()), PWI(*dst)), \
+            status = ARX_JOIN_5(ippiDivC_, NEW_D, _, IF_C_EQ_C(C, AC4, C4, C), IR) (image_scale_16u IF_C_EQ_C(C, C1, [0], ARX_EMPTY()), PWI(*dst)), \
           IF_DD_EQ_DD((D, NEW_D), (32f, 16u),                                   \
             {                                                                   \
               Image* newImage;                                                  \
               if(!IS_ERROR(status = image_new(&newImage, WIDTH(image), HEIGHT(image), METATYPE(image), 0))) { \
-                status = ARX_JOIN_5(ippiMulC_, D, _, IF_C_EQ_C(C, AC4, C4, C), R) (PIXELS(image), WSTEP(image), scaleColor IF_C_EQ_C(C, C1, [0], ARX_EMPTY()), PWI(newImage)); \
+                status = ARX_JOIN_5(ippiMulC_, D, _, IF_C_EQ_C(C, AC4, C4, C), R) (PIXELS(image), WSTEP(image), image_scale_16u IF_C_EQ_C(C, C1, [0], ARX_EMPTY()), PWI(newImage)); \
                 if(!IS_ERROR(status))                                           \
                   status = ARX_JOIN_6(ippiConvert_, D, NEW_D, _, C, R) (PWPWI(newImage, *dst), ippRndZero); \
                 image_destroy(newImage);                                        \
@@ -640,36 +856,7 @@ TRACE_FUNC(int, image_convert_datatype_copy, (Image* image, Image** dst, IppData
       )                                                                         \
     )                                                                           \
   )
-#define METAFUNC_2(NEW_D, M) CONVERT(M_DATATYPE(M), M_CHANNELS(M), NEW_D)
-#define METAFUNC(M, ARGS) IPPMETACALL(dataType, ARX_EMPTY(), D_SUPPORTED, METAFUNC_2, M, Unreachable(); status = ippStsBadArgErr, ARX_EMPTY())
-  IPPMETACALL(METATYPE(image), ARX_EMPTY(), M_SUPPORTED, METAFUNC, ~, Unreachable(); status = ippStsBadArgErr, ARX_EMPTY());
-#undef METAFUNC
-#undef METAFUNC_2
-#undef CONVERT
-
-  TRACE(("end_convert"));
-
-  if(IS_ERROR(status))
-    image_destroy(*dst);
-  TRACE_RETURN(status);
-} TRACE_END
-
-
-// -------------------------------------------------------------------------- //
-// image_convert_channels_copy
-// -------------------------------------------------------------------------- //
-TRACE_FUNC(int, image_convert_channels_copy, (Image* image, Image** dst, IppChannels channels)) {
-  int status;
-
-  assert(image != NULL && dst != NULL);
-
-  if(CHANNELS(image) == channels)
-    TRACE_RETURN(image_clone(image, dst));
-
-  if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), metatype_compose(DATATYPE(image), channels), 0)))
-    TRACE_RETURN(status);
-
-  #define CONVERT(D, C, NEW_C)                                                  \
+#define IMAGE_CONVERT_CHANNELS(D, C, NEW_C)                                     \
   IF_C_EQ_C(C, NEW_C,                                                           \
     Unreachable(),                                                              \
     ARX_IF(CC_IN_CCA((C, NEW_C), (2, ((AC4, C3), (C3, AC4)))),                  \
@@ -700,12 +887,108 @@ TRACE_FUNC(int, image_convert_channels_copy, (Image* image, Image** dst, IppChan
       )                                                                         \
     )                                                                           \
   )
-#define METAFUNC_2(NEW_C, M) CONVERT(M_DATATYPE(M), M_CHANNELS(M), NEW_C)
-#define METAFUNC(M, ARGS) IPPMETACALL(channels, ARX_EMPTY(), C_SUPPORTED, METAFUNC_2, M, Unreachable(); status = ippStsBadArgErr, ARX_EMPTY())
-  IPPMETACALL(METATYPE(image), ARX_EMPTY(), M_SUPPORTED, METAFUNC, ~, Unreachable(); status = ippStsBadArgErr, ARX_EMPTY());
-#undef METAFUNC
-#undef METAFUNC_2
-#undef CONVERT
+
+/**
+ * Defines a kernel <tt>image_convert_SRC_to_DST</tt> for metatypes of M_IPP_BASIC.
+ */
+#define DEFINE_IMAGE_CONVERT(DST, SRC)                                          \
+  IF_M_IS_C(DST, M_CHANNELS(SRC),                                               \
+    IF_M_IS_D(DST, M_DATATYPE(SRC), DEFINE_IMAGE_CONVERT_NONE, DEFINE_IMAGE_CONVERT_DATATYPE), \
+    IF_M_IS_D(DST, M_DATATYPE(SRC), DEFINE_IMAGE_CONVERT_CHANNELS, DEFINE_IMAGE_CONVERT_NONE) \
+  )(SRC, DST)
+#define DEFINE_IMAGE_CONVERT_DATATYPE(SRC, DST)                                 \
+static int ARX_JOIN_4(image_convert_, SRC, _to_, DST)(Image* image, Image** dst) { \
+  int status;                                                                   \
+  IMAGE_CONVERT_DATATYPE(M_DATATYPE(SRC), M_CHANNELS(SRC), M_DATATYPE(DST));    \
+  return status;                                                                \
+}
+#define DEFINE_IMAGE_CONVERT_CHANNELS(SRC, DST)                                 \
+static int ARX_JOIN_4(image_convert_, SRC, _to_, DST)(Image* image, Image** dst) { \
+  int status;                                                                   \
+  IMAGE_CONVERT_CHANNELS(M_DATATYPE(SRC), M_CHANNELS(SRC), M_CHANNELS(DST));    \
+  return status;                                                                \
+}
+#define DEFINE_IMAGE_CONVERT_NONE(SRC, DST)
+#define DEFINE_IMAGE_CONVERT_ROW(SRC, ARG) ARX_ARRAY_FOREACH(M_IPP_BASIC, DEFINE_IMAGE_CONVERT, SRC)
+
+ARX_ARRAY_FOREACH(M_IPP_BASIC, DEFINE_IMAGE_CONVERT_ROW, ~)
+
+
+/* Kernel table, indexed by M_INDEX of source and destination. M_IPP_BASIC is a prefix of M_SUPPORTED. */
+#define IMAGE_CONVERT_ENTRY(DST, SRC)                                           \
+  IF_M_IS_C(DST, M_CHANNELS(SRC),                                               \
+    IF_M_IS_D(DST, M_DATATYPE(SRC), NULL, ARX_JOIN_4(image_convert_, SRC, _to_, DST)), \
+    IF_M_IS_D(DST, M_DATATYPE(SRC), ARX_JOIN_4(image_convert_, SRC, _to_, DST), NULL) \
+  ),
+#define IMAGE_CONVERT_ROW(SRC, ARG) { ARX_ARRAY_FOREACH(M_IPP_BASIC, IMAGE_CONVERT_ENTRY, SRC) },
+
+static const ImageConvertFunc image_convert_table[ARX_ARRAY_SIZE(M_IPP_BASIC)][ARX_ARRAY_SIZE(M_IPP_BASIC)] = {
+  ARX_ARRAY_FOREACH(M_IPP_BASIC, IMAGE_CONVERT_ROW, ~)
+};
+
+
+/**
+ * @returns IPP-backed kernel that converts from one metatype to another, or NULL if there's none
+ */
+static ImageConvertFunc image_convert_kernel(IppMetaType from, IppMetaType to) {
+  if((unsigned int) from < ARX_ARRAY_SIZE(M_IPP_BASIC) && (unsigned int) to < ARX_ARRAY_SIZE(M_IPP_BASIC))
+    return image_convert_table[from][to];
+  else
+    return NULL;
+}
+
+
+// -------------------------------------------------------------------------- //
+// image_convert_datatype_copy
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_convert_datatype_copy, (Image* image, Image** dst, IppDataType dataType)) {
+  ImageConvertFunc kernel;
+  int status;
+
+  assert(image != NULL && dst != NULL);
+
+  TRACE(("image_convert_datatype from %d to %d", DATATYPE(image), dataType));
+
+  if(DATATYPE(image) == dataType)
+    TRACE_RETURN(image_clone(image, dst));
+
+  if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), metatype_compose(dataType, CHANNELS(image)), 0)))
+    TRACE_RETURN(status);
+
+  kernel = image_convert_kernel(METATYPE(image), METATYPE(*dst));
+  if(kernel != NULL)
+    status = kernel(image, dst);
+  else
+    status = convert_copy(MPWMPWI(image, *dst));
+
+  TRACE(("end_convert"));
+
+  if(IS_ERROR(status))
+    image_destroy(*dst);
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_convert_channels_copy
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_convert_channels_copy, (Image* image, Image** dst, IppChannels channels)) {
+  ImageConvertFunc kernel;
+  int status;
+
+  assert(image != NULL && dst != NULL);
+
+  if(CHANNELS(image) == channels)
+    TRACE_RETURN(image_clone(image, dst));
+
+  if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), metatype_compose(DATATYPE(image), channels), 0)))
+    TRACE_RETURN(status);
+
+  kernel = image_convert_kernel(METATYPE(image), METATYPE(*dst));
+  if(kernel != NULL)
+    status = kernel(image, dst);
+  else
+    status = convert_copy(MPWMPWI(image, *dst));
 
   if(IS_ERROR(status))
     image_destroy(*dst);
@@ -723,7 +1006,7 @@ TRACE_FUNC(int, image_convert_copy, (Image* image, Image** dst, IppMetaType meta
   IppDataType dataType;
 
   assert(image != NULL && dst != NULL);
-  assert(is_metatype_supported(metaType));
+  assert(metatype_planes(metaType) == 1);
 
   TRACE(("begin_convert from %d to %d", METATYPE(image), metaType));
 
@@ -747,74 +1030,61 @@ TRACE_FUNC(int, image_convert_copy, (Image* image, Image** dst, IppMetaType meta
 
 
 // -------------------------------------------------------------------------- //
-// image_get_pixel
+// image_colorspace_copy
 // -------------------------------------------------------------------------- //
-int image_get_pixel(Image* image, int x, int y, Color* color) {
-  void* p;
-
-  assert(image != NULL);
-  assert(x >= 0 && y >= 0 && x < WIDTH(image) && y <= HEIGHT(image));
-
-  p = PIXEL_AT(image, x, y);
-
-#define METAFUNC(M, ARGS) C2M_COLOR_TO(M, p, color->as_array)
-  IPPMETACALL(METATYPE(image), ARX_EMPTY(), M_SUPPORTED, METAFUNC, ~, Unreachable(); return ippStsBadArgErr, ARX_EMPTY())
-#undef METAFUNC
-
-  return ippStsNoErr;
-}
-
+TRACE_FUNC(int, image_colorspace_copy, (Image* image, Image** dst, ColorSpace from, ColorSpace to, IppDataType dataType)) {
+  int status;
 
-// -------------------------------------------------------------------------- //
-// image_set_pixel
-// -------------------------------------------------------------------------- //
-int image_set_pixel(Image* image, int x, int y, Color* color) {
-  void* p;
+  assert(image != NULL && dst != NULL);
 
-  assert(image != NULL);
-  assert(x >= 0 && y >= 0 && x < WIDTH(image) && y <= HEIGHT(image));
+  if(CHANNELS(image) == ippC1)
+    TRACE_RETURN(ippStsNumChannelsErr);
 
-  p = PIXEL_AT(image, x, y);
+  if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), metatype_compose(dataType, CHANNELS(image)), 0)))
+    TRACE_RETURN(status);
 
-#define METAFUNC(M, ARGS) M2C_COLOR_TO(M, color->as_array, p)
-  IPPMETACALL(METATYPE(image), ARX_EMPTY(), M_SUPPORTED, METAFUNC, ~, Unreachable(); return ippStsBadArgErr, ARX_EMPTY())
-#undef METAFUNC
+  status = colorspace_convert(from, to, METATYPE(image), PIXELS(image), WSTEP(image), METATYPE(*dst), PIXELS(*dst), WSTEP(*dst), IPPISIZE(image));
+  if(IS_ERROR(status))
+    image_destroy(*dst);
 
-  return ippStsNoErr;
-}
+  TRACE_RETURN(status);
+} TRACE_END
 
 
 // -------------------------------------------------------------------------- //
-// image_fill
+// image_to_yuv420
 // -------------------------------------------------------------------------- //
-TRACE_FUNC(int, image_fill, (Image* image, Color* color)) {
+TRACE_FUNC(int, image_to_yuv420, (Image* image, Yuv420Format format, Ipp8u* dst)) {
   int status;
-  USING_M2C_COLOR(1);
+  Image* converted;
 
-  assert(image != NULL && color != NULL);
+  assert(image != NULL && dst != NULL);
+
+  if(METATYPE(image) == ipp8u_C3 || METATYPE(image) == ipp8u_AC4 || METATYPE(image) == ipp8u_C4)
+    TRACE_RETURN(colorspace_to_yuv420(format, CHANNELS(image), PIXELS(image), WSTEP(image), IPPISIZE(image), dst));
+
+  if(IS_ERROR(status = image_convert_copy(image, &converted, ipp8u_C3)))
+    TRACE_RETURN(status);
 
-#define METAFUNC(M, ARGS) ARX_JOIN_3(ippiSet_, M, R) (M2C_COLOR(M, color->as_array, 0), PWI(image))
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, METAFUNC, ~, Unreachable(), ippStsBadArgErr);
-#undef METAFUNC
+  status = colorspace_to_yuv420(format, ippC3, PIXELS(converted), WSTEP(converted), IPPISIZE(converted), dst);
+  image_destroy(converted);
 
   TRACE_RETURN(status);
 } TRACE_END
 
 
 // -------------------------------------------------------------------------- //
-// image_transpose_copy
+// image_from_yuv420
 // -------------------------------------------------------------------------- //
-TRACE_FUNC(int, image_transpose_copy, (Image* image, Image** dst)) {
+TRACE_FUNC(int, image_from_yuv420, (Image** dst, const Ipp8u* src, IppiSize size, Yuv420Format format)) {
   int status;
 
-  assert(image != NULL && dst != NULL);
+  assert(dst != NULL && src != NULL);
 
-  if(IS_ERROR(status = image_new(dst, HEIGHT(image), WIDTH(image), METATYPE(image), 0)))
+  if(IS_ERROR(status = image_new(dst, size.width, size.height, ipp8u_C3, 0)))
     TRACE_RETURN(status);
 
-#define METAFUNC(M, ARGS) ARX_JOIN_3(ippiTranspose_, M_REPLACE_C_IF_C(M_REPLACE_D_IF_D(M, 32f, 32s), AC4, C4), R) (PWPWI(image, *dst)) /* 32f -> 32s hack works, tested */
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, METAFUNC, ~, Unreachable(), ippStsBadArgErr);
-#undef METAFUNC
+  status = colorspace_from_yuv420(format, src, size, ippC3, PIXELS(*dst), WSTEP(*dst));
   if(IS_ERROR(status))
     image_destroy(*dst);
 
@@ -823,39 +1093,46 @@ TRACE_FUNC(int, image_transpose_copy, (Image* image, Image** dst)) {
 
 
 // -------------------------------------------------------------------------- //
-// image_threshold
+// image_plane
 // -------------------------------------------------------------------------- //
-TRACE_FUNC(int, image_threshold, (Image* image, Color* threshold, IppCmpOp cmp, Color* value)) {
-  int status;
-  USING_M2C_COLOR(2);
+TRACE_FUNC(int, image_plane, (Image* image, Image** dst, int plane)) {
+  assert(image != NULL && dst != NULL);
+  assert(SHARED(image));
+  assert(plane >= 0 && plane < metatype_planes(METATYPE(image)));
 
-  assert(image != NULL && threshold != NULL && value != NULL);
-  assert(cmp == ippCmpLess || cmp == ippCmpGreater);
+  *dst = (Image*) malloc(sizeof(Image));
+  if(*dst == NULL)
+    TRACE_RETURN(ippStsNoMemErr);
 
-#define METAFUNC(M, ARGS) ARX_JOIN_3(ippiThreshold_Val_, M, IR) (PWI(image), M2C_COLOR(M, threshold->as_array, 0), M2C_COLOR(M, value->as_array, 1), cmp)
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, METAFUNC, ~, Unreachable(), ippStsBadArgErr);
-#undef METAFUNC
+  (*dst)->data = data_retain(image->data->planes[plane]); // plane data is owned by planar image data
+  (*dst)->rb_data = image->rb_data;
+  (*dst)->is_subimage = image->is_subimage;
+  (*dst)->is_view = TRUE;
+  (*dst)->x = image->x;
+  (*dst)->y = image->y;
+  (*dst)->width = image->width;
+  (*dst)->height = image->height;
 
-  TRACE_RETURN(status);
+  TRACE_RETURN(ippStsNoErr);
 } TRACE_END
 
 
 // -------------------------------------------------------------------------- //
-// image_threshold_copy
+// image_to_planar_copy
 // -------------------------------------------------------------------------- //
-TRACE_FUNC(int, image_threshold_copy, (Image* image, Image** dst, Color* threshold, IppCmpOp cmp, Color* value)) {
+TRACE_FUNC(int, image_to_planar_copy, (Image* image, Image** dst)) {
   int status;
-  USING_M2C_COLOR(2);
+  IppMetaType metaType;
 
-  assert(image != NULL && dst != NULL && threshold != NULL && value != NULL);
-  //assert(cmp == ippCmpLess || cmp == ippCmpGreater); TODO: do we need this?
+  assert(image != NULL && dst != NULL);
 
-  if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0)))
+  if((metaType = metatype_to_planar(METATYPE(image))) == (IppMetaType) -1)
+    TRACE_RETURN(ippStsNumChannelsErr);
+
+  if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), metaType, 0)))
     TRACE_RETURN(status);
 
-#define METAFUNC(M, ARGS) ARX_JOIN_3(ippiThreshold_Val_, M, R) (PWPWI(image, *dst), M2C_COLOR(M, threshold->as_array, 0), M2C_COLOR(M, value->as_array, 1), cmp)
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, METAFUNC, ~, Unreachable(), ippStsBadArgErr);
-#undef METAFUNC
+  status = planar_split(METATYPE(image), PIXELS(image), WSTEP(image), PIXELS(*dst), WSTEP(*dst), (*dst)->data->planeStep, IPPISIZE(image));
   if(IS_ERROR(status))
     image_destroy(*dst);
 
@@ -864,31 +1141,238 @@ TRACE_FUNC(int, image_threshold_copy, (Image* image, Image** dst, Color* thresho
 
 
 // -------------------------------------------------------------------------- //
-// image_jaehne 
+// image_from_planar_copy
 // -------------------------------------------------------------------------- //
-TRACE_FUNC(int, image_jaehne, (Image* image)) {
+TRACE_FUNC(int, image_from_planar_copy, (Image* image, Image** dst)) {
   int status;
+  IppMetaType metaType;
 
-  assert(image != NULL);
+  assert(image != NULL && dst != NULL);
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiImageJaehne_, R, (PWI(image))), Unreachable(), ippStsBadArgErr);
+  if((metaType = metatype_to_interleaved(METATYPE(image))) == (IppMetaType) -1)
+    TRACE_RETURN(ippStsNumChannelsErr);
+
+  if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), metaType, 0)))
+    TRACE_RETURN(status);
+
+  status = planar_merge(metaType, PIXELS(image), WSTEP(image), image->data->planeStep, PIXELS(*dst), WSTEP(*dst), IPPISIZE(image));
+  if(IS_ERROR(status))
+    image_destroy(*dst);
 
   TRACE_RETURN(status);
 } TRACE_END
 
 
 // -------------------------------------------------------------------------- //
-// image_ramp
+// image_get_pixel
 // -------------------------------------------------------------------------- //
-TRACE_FUNC(int, image_ramp, (Image* image, float offset, float slope, IppiAxis axis)) {
-  int status;
+int image_get_pixel(Image* image, int x, int y, Color* color) {
+  void* p;
 
   assert(image != NULL);
+  assert(x >= 0 && y >= 0 && x < WIDTH(image) && y <= HEIGHT(image));
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiImageRamp_, R, (PWI(image), offset, slope, axis)), Unreachable(), ippStsBadArgErr);
-
-  TRACE_RETURN(status);
-} TRACE_END
+  p = PIXEL_AT(image, x, y);
+
+  if(METATABLE_FUNCTION(pixel_to_color, METATYPE(image)) == NULL) {
+    Unreachable();
+    return ippStsBadArgErr;
+  }
+  pixel_to_color[METATYPE(image)](p, color->as_array);
+
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// image_set_pixel
+// -------------------------------------------------------------------------- //
+int image_set_pixel(Image* image, int x, int y, Color* color) {
+  int status;
+  void* p;
+
+  assert(image != NULL);
+  assert(x >= 0 && y >= 0 && x < WIDTH(image) && y <= HEIGHT(image));
+
+  /* Not a TRACE_FUNC, so TOUCH is expanded by hand */
+  if(IS_ERROR(status = data_unshare(image->data)))
+    return status;
+  image->data->stamp++;
+
+  p = PIXEL_AT(image, x, y);
+
+  if(METATABLE_FUNCTION(pixel_from_color, METATYPE(image)) == NULL) {
+    Unreachable();
+    return ippStsBadArgErr;
+  }
+  pixel_from_color[METATYPE(image)](color->as_array, p);
+
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// image_fill
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_fill, (Image* image, Color* color)) {
+  int status;
+
+  assert(image != NULL && color != NULL);
+
+  TOUCH(image);
+
+  status = METATABLE_CALL(ipp_set, METATYPE(image), (color->as_array, PWI(image)), image_fill_native(image, color));
+
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_transpose_copy
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_transpose_copy, (Image* image, Image** dst)) {
+  int status;
+
+  assert(image != NULL && dst != NULL);
+
+  if(IS_ERROR(status = image_new(dst, HEIGHT(image), WIDTH(image), METATYPE(image), 0)))
+    TRACE_RETURN(status);
+
+  status = METATABLE_CALL(ipp_transpose, METATYPE(image), (PWPWI(image, *dst)), rotate_copy(ORIENT_TRANSPOSE, METATYPE(image), PIXELS(image), WSTEP(image), IPPISIZE(image), PIXELS(*dst), WSTEP(*dst)));
+  if(IS_ERROR(status))
+    image_destroy(*dst);
+
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_transpose
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_transpose, (Image* image)) {
+  int status, width, height, border, dstStep;
+  IppiSize bufferSize;
+  Image* result;
+
+  assert(image != NULL);
+
+  width = WIDTH(image);
+  height = HEIGHT(image);
+
+  if(width == height) {
+    TOUCH(image);
+    TRACE_RETURN(rotate_inplace(ORIENT_TRANSPOSE, METATYPE(image), PIXELS(image), WSTEP(image), IPPISIZE(image)));
+  }
+
+  if(IS_SUBIMAGE(image))
+    TRACE_RETURN(ippStsSizeErr);
+
+  border = BORDER(image);
+  bufferSize.width = width + 2 * border;
+  bufferSize.height = height + 2 * border;
+  dstStep = data_row_step(bufferSize.height * PIXELSIZE(image));
+
+  if(ATOMIC_LOAD(&image->data->refs) == 1 && image->data->ownsBuffer && image->data->planeStep == 0 && dstStep * bufferSize.width <= WSTEP(image) * bufferSize.height && !data_shares_buffer(image->data)) {
+    /* The only reference is the wrapper's or the creator's, so no view or native user sees this Data, and the transposed image fits into its buffer,
+     * re-stride it in place. Border goes along, a transposed replicated border is a replicated border of the transposed image. */
+    if(IS_ERROR(status = rotate_transpose_restride(PIXELSIZE(image), image->data->buffer, WSTEP(image), bufferSize, dstStep)))
+      TRACE_RETURN(status);
+
+    image->data->width = height;
+    image->data->height = width;
+    image->data->wStep = dstStep;
+    image->data->pixels = (char*) image->data->buffer + border * (dstStep + PIXELSIZE(image));
+  } else {
+    /* Subimages, plane views and native users of the Data rely on its size, so the image switches to a transposed copy, which gets a wrapper of its own. */
+    if(IS_ERROR(status = image_transpose_copy(image, &result)))
+      TRACE_RETURN(status);
+
+    if(!SHARED(image) || IS_VIEW(image))
+      data_release(image->data);
+    if(SHARED(image)) {
+      image_share(result);
+      image->rb_data = result->rb_data;
+    }
+    image->data = result->data;
+    image->is_view = FALSE;
+    free(result);
+  }
+
+  TOUCH(image);
+
+  TRACE_RETURN(ippStsNoErr);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_threshold_copy
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_threshold_copy, (Image* image, Image** dst, Color* threshold, IppCmpOp cmp, Color* value)) {
+  int status;
+
+  assert(image != NULL && dst != NULL && threshold != NULL && value != NULL);
+  //assert(cmp == ippCmpLess || cmp == ippCmpGreater); TODO: do we need this?
+
+  if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0)))
+    TRACE_RETURN(status);
+
+  status = METATABLE_CALL(ipp_threshold, METATYPE(image), (PWPWI(image, *dst), threshold->as_array, value->as_array, cmp), arith_threshold(METATYPE(image), PWPWI(image, *dst), threshold, cmp, value));
+  if(IS_ERROR(status))
+    image_destroy(*dst);
+
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_jaehne 
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_jaehne, (Image* image)) {
+  int status;
+  Image* tmp;
+
+  assert(image != NULL);
+
+  TOUCH(image);
+
+  if(METATABLE_FUNCTION(ipp_jaehne, METATYPE(image)) == NULL) {
+    if(IS_ERROR(status = image_new_32f_like(image, &tmp)))
+      TRACE_RETURN(status);
+    if(!IS_ERROR(status = image_jaehne(tmp)))
+      status = convert_copy(MPWMPWI(tmp, image));
+    image_destroy(tmp);
+  } else {
+    status = ipp_jaehne[METATYPE(image)](PWI(image));
+  }
+
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_ramp
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_ramp, (Image* image, float offset, float slope, IppiAxis axis)) {
+  int status;
+  Image* tmp;
+
+  assert(image != NULL);
+
+  TOUCH(image);
+
+  if(METATABLE_FUNCTION(ipp_ramp, METATYPE(image)) == NULL) {
+    /* Native data types share the [0, 1] range of 32f, so offset and slope mean the same. */
+    if(IS_ERROR(status = image_new_32f_like(image, &tmp)))
+      TRACE_RETURN(status);
+    if(!IS_ERROR(status = image_ramp(tmp, offset, slope, axis)))
+      status = convert_copy(MPWMPWI(tmp, image));
+    image_destroy(tmp);
+  } else {
+    status = ipp_ramp[METATYPE(image)](PWI(image), offset, slope, axis);
+  }
+
+  TRACE_RETURN(status);
+} TRACE_END
 
 
 // -------------------------------------------------------------------------- //
@@ -899,10 +1383,12 @@ TRACE_FUNC(int, image_dilate3x3, (Image* image)) {
 
   assert(image != NULL);
 
+  TOUCH(image);
+
   if(IS_ERROR(status = image_ensure_border(image, 1)))
     TRACE_RETURN(status);
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiDilate3x3_, IR, (PWI(image))), Unreachable(), ippStsBadArgErr);
+  status = METATABLE_CALL(ipp_dilate3x3_i, METATYPE(image), (PWI(image)), filter_rank(FILTER_MAX, METATYPE(image), PWPWI(image, image), NULL, ippi_size(3, 3), ippi_point(1, 1)));
 
   TRACE_RETURN(status);
 } TRACE_END
@@ -922,7 +1408,7 @@ TRACE_FUNC(int, image_dilate3x3_copy, (Image* image, Image** dst)) {
   if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0)))
     TRACE_RETURN(status);
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiDilate3x3_, R, (PWPWI(image, *dst))), Unreachable(), ippStsBadArgErr);
+  status = METATABLE_CALL(ipp_dilate3x3, METATYPE(image), (PWPWI(image, *dst)), filter_rank(FILTER_MAX, METATYPE(image), PWPWI(image, *dst), NULL, ippi_size(3, 3), ippi_point(1, 1)));
   if(IS_ERROR(status))
     image_destroy(*dst);
 
@@ -938,10 +1424,12 @@ TRACE_FUNC(int, image_erode3x3, (Image* image)) {
 
   assert(image != NULL);
 
+  TOUCH(image);
+
   if(IS_ERROR(status = image_ensure_border(image, 1)))
     TRACE_RETURN(status);
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiErode3x3_, IR, (PWI(image))), Unreachable(), ippStsBadArgErr);
+  status = METATABLE_CALL(ipp_erode3x3_i, METATYPE(image), (PWI(image)), filter_rank(FILTER_MIN, METATYPE(image), PWPWI(image, image), NULL, ippi_size(3, 3), ippi_point(1, 1)));
 
   TRACE_RETURN(status);
 } TRACE_END
@@ -961,7 +1449,7 @@ TRACE_FUNC(int, image_erode3x3_copy, (Image* image, Image** dst)) {
   if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0)))
     TRACE_RETURN(status);
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiErode3x3_, R, (PWPWI(image, *dst))), Unreachable(), ippStsBadArgErr);
+  status = METATABLE_CALL(ipp_erode3x3, METATYPE(image), (PWPWI(image, *dst)), filter_rank(FILTER_MIN, METATYPE(image), PWPWI(image, *dst), NULL, ippi_size(3, 3), ippi_point(1, 1)));
   if(IS_ERROR(status))
     image_destroy(*dst);
 
@@ -977,12 +1465,14 @@ TRACE_FUNC(int, image_dilate, (Image* image, Matrix* mask, IppiPoint anchor)) {
   IppiSize maskSize;
 
   assert(image != NULL && mask != NULL);
+
+  TOUCH(image);
   assert(mask->isMask);
 
   if(IS_ERROR(status = image_ensure_border(image, required_border(mask->size, anchor))))
     TRACE_RETURN(status);
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiDilate_, IR, (PWI(image), (char*) mask->data, mask->size, anchor)), Unreachable(), ippStsBadArgErr);
+  status = METATABLE_CALL(ipp_dilate_i, METATYPE(image), (PWI(image), (Ipp8u*) mask->data, mask->size, anchor), filter_rank(FILTER_MAX, METATYPE(image), PWPWI(image, image), mask->separable ? NULL : (Ipp8u*) mask->data, mask->size, anchor));
 
   TRACE_RETURN(status);
 } TRACE_END
@@ -1003,7 +1493,7 @@ TRACE_FUNC(int, image_dilate_copy, (Image* image, Image** dst, Matrix* mask, Ipp
   if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0)))
     TRACE_RETURN(status);
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiDilate_, R, (PWPWI(image, *dst), (char*) mask->data, mask->size, anchor)), Unreachable(), ippStsBadArgErr);
+  status = METATABLE_CALL(ipp_dilate, METATYPE(image), (PWPWI(image, *dst), (Ipp8u*) mask->data, mask->size, anchor), filter_rank(FILTER_MAX, METATYPE(image), PWPWI(image, *dst), mask->separable ? NULL : (Ipp8u*) mask->data, mask->size, anchor));
   if(IS_ERROR(status))
     image_destroy(*dst);
 
@@ -1019,12 +1509,14 @@ TRACE_FUNC(int, image_erode, (Image* image, Matrix* mask, IppiPoint anchor)) {
   IppiSize maskSize;
 
   assert(image != NULL && mask != NULL);
+
+  TOUCH(image);
   assert(mask->isMask);
 
   if(IS_ERROR(status = image_ensure_border(image, required_border(mask->size, anchor))))
     TRACE_RETURN(status);
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiErode_, IR, (PWI(image), (char*) mask->data, mask->size, anchor)), Unreachable(), ippStsBadArgErr);
+  status = METATABLE_CALL(ipp_erode_i, METATYPE(image), (PWI(image), (Ipp8u*) mask->data, mask->size, anchor), filter_rank(FILTER_MIN, METATYPE(image), PWPWI(image, image), mask->separable ? NULL : (Ipp8u*) mask->data, mask->size, anchor));
 
   TRACE_RETURN(status);
 } TRACE_END
@@ -1045,7 +1537,7 @@ TRACE_FUNC(int, image_erode_copy, (Image* image, Image** dst, Matrix* mask, Ippi
   if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0)))
     TRACE_RETURN(status);
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiErode_, R, (PWPWI(image, *dst), (char*) mask->data, mask->size, anchor)), Unreachable(), ippStsBadArgErr);
+  status = METATABLE_CALL(ipp_erode, METATYPE(image), (PWPWI(image, *dst), (Ipp8u*) mask->data, mask->size, anchor), filter_rank(FILTER_MIN, METATYPE(image), PWPWI(image, *dst), mask->separable ? NULL : (Ipp8u*) mask->data, mask->size, anchor));
   if(IS_ERROR(status))
     image_destroy(*dst);
 
@@ -1061,10 +1553,12 @@ TRACE_FUNC(int, image_filter_box, (Image* image, IppiSize maskSize, IppiPoint an
 
   assert(image != NULL);
 
+  TOUCH(image);
+
   if(IS_ERROR(status = image_ensure_border(image, required_border(maskSize, anchor))))
     TRACE_RETURN(status);
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiFilterBox_, IR, (PWI(image), maskSize, anchor)), Unreachable(), ippStsBadArgErr);
+  status = METATABLE_CALL(ipp_filter_box_i, METATYPE(image), (PWI(image), maskSize, anchor), filter_box(METATYPE(image), PWPWI(image, image), maskSize, anchor));
 
   TRACE_RETURN(status);
 } TRACE_END
@@ -1084,7 +1578,7 @@ TRACE_FUNC(int, image_filter_box_copy, (Image* image, Image** dst, IppiSize mask
   if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0)))
     TRACE_RETURN(status);
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiFilterBox_, R, (PWPWI(image, *dst), maskSize, anchor)), Unreachable(), ippStsBadArgErr);
+  status = METATABLE_CALL(ipp_filter_box, METATYPE(image), (PWPWI(image, *dst), maskSize, anchor), filter_box(METATYPE(image), PWPWI(image, *dst), maskSize, anchor));
   if(IS_ERROR(status))
     image_destroy(*dst);
 
@@ -1106,7 +1600,7 @@ TRACE_FUNC(int, image_filter_min_copy, (Image* image, Image** dst, IppiSize mask
   if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0)))
     TRACE_RETURN(status);
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiFilterMin_, R, (PWPWI(image, *dst), maskSize, anchor)), Unreachable(), ippStsBadArgErr);
+  status = METATABLE_CALL(ipp_filter_min, METATYPE(image), (PWPWI(image, *dst), maskSize, anchor), filter_rank(FILTER_MIN, METATYPE(image), PWPWI(image, *dst), NULL, maskSize, anchor));
   if(IS_ERROR(status))
     image_destroy(*dst);
 
@@ -1128,7 +1622,7 @@ TRACE_FUNC(int, image_filter_max_copy, (Image* image, Image** dst, IppiSize mask
   if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0)))
     TRACE_RETURN(status);
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiFilterMax_, R, (PWPWI(image, *dst), maskSize, anchor)), Unreachable(), ippStsBadArgErr);
+  status = METATABLE_CALL(ipp_filter_max, METATYPE(image), (PWPWI(image, *dst), maskSize, anchor), filter_rank(FILTER_MAX, METATYPE(image), PWPWI(image, *dst), NULL, maskSize, anchor));
   if(IS_ERROR(status))
     image_destroy(*dst);
 
@@ -1141,35 +1635,19 @@ TRACE_FUNC(int, image_filter_max_copy, (Image* image, Image** dst, IppiSize mask
 // -------------------------------------------------------------------------- //
 TRACE_FUNC(int, image_filter_median_copy, (Image* image, Image** dst, IppiSize maskSize, IppiPoint anchor)) {
   int status;
-  int created = FALSE;
 
   assert(image != NULL && dst != NULL);
 
-  CHECK_DATATYPE_IN_DA(image, status =, (3, (8u, 16u, 16s)));
-  if(!status) {
-    image_convert_datatype_copy(image, &image, ipp16u);
-    created = TRUE;
-  }
-
-  if(IS_ERROR(status = image_ensure_border(image, required_border(maskSize, anchor)))) {
-    if(created)
-      image_destroy(image);
+  if(IS_ERROR(status = image_ensure_border(image, required_border(maskSize, anchor))))
     TRACE_RETURN(status);
-  }
 
-  if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0))) {
-    if(created)
-      image_destroy(image);
+  if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0)))
     TRACE_RETURN(status);
-  }
 
-                                          /* TODO: use macro like MA_INTERSECT_DA */
-  IPPMETACALL(METATYPE(image), status =, (6,  (8u_C1, 8u_C3, 8u_AC4, 16u_C1, 16u_C3, 16u_AC4)), IPPMETAFUNC, (ippiFilterMedian_, R, (PWPWI(image, *dst), maskSize, anchor)), Unreachable(), ippStsBadArgErr);
+  status = METATABLE_CALL(ipp_filter_median, METATYPE(image), (PWPWI(image, *dst), maskSize, anchor), filter_rank(FILTER_MEDIAN, METATYPE(image), PWPWI(image, *dst), NULL, maskSize, anchor));
   if(IS_ERROR(status))
     image_destroy(*dst);
 
-  if(created)
-    image_destroy(image);
   TRACE_RETURN(status);
 } TRACE_END
 
@@ -1188,7 +1666,7 @@ TRACE_FUNC(int, image_filter_gauss_copy, (Image* image, Image** dst, IppiMaskSiz
   if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0)))
     TRACE_RETURN(status);
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiFilterGauss_, R, (PWPWI(image, *dst), maskSize)), Unreachable(), ippStsBadArgErr);
+  status = METATABLE_CALL(ipp_filter_gauss, METATYPE(image), (PWPWI(image, *dst), maskSize), filter_gauss(METATYPE(image), PWPWI(image, *dst), maskSize));
   if(IS_ERROR(status))
     image_destroy(*dst);
 
@@ -1211,9 +1689,7 @@ TRACE_FUNC(int, image_filter_copy, (Image* image, Image** dst, Matrix* kernel, I
   if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0)))
     TRACE_RETURN(status);
 
-#define METAFUNC(M, ARGS) ARX_JOIN_5(IF_M_IS_D(M, 32f, ippiFilter_, ippiFilter32f_), M_DATATYPE(M), _, M_CHANNELS(M), R) (PWPWI(image, *dst), (Ipp32f*) kernel->data, kernel->size, anchor)
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, METAFUNC, ~, Unreachable(), ippStsBadArgErr);
-#undef METAFUNC
+  status = METATABLE_CALL(ipp_filter, METATYPE(image), (PWPWI(image, *dst), (Ipp32f*) kernel->data, kernel->size, anchor), filter_kernel(METATYPE(image), PWPWI(image, *dst), kernel, anchor));
   if(IS_ERROR(status))
     image_destroy(*dst);
 
@@ -1222,11 +1698,104 @@ TRACE_FUNC(int, image_filter_copy, (Image* image, Image** dst, Matrix* kernel, I
 
 
 // -------------------------------------------------------------------------- //
-// image_draw
+// image_coerce
 // -------------------------------------------------------------------------- //
-TRACE_FUNC(int, image_draw, (Image* image, Image* src, IppiPoint pos)) {
+/**
+ * Converts an image to the given metatype if needed. If the image is already of the given metatype, stores it into dst as is,
+ * so the caller must destroy *dst only if it's not equal to image.
+ */
+static int image_coerce(Image* image, Image** dst, IppMetaType metaType) {
+  if(METATYPE(image) == metaType) {
+    *dst = image;
+    return ippStsNoErr;
+  } else
+    return image_convert_copy(image, dst, metaType);
+}
+
+
+// -------------------------------------------------------------------------- //
+// image_cached_source
+// -------------------------------------------------------------------------- //
+/**
+ * Prepares an image for being drawn on an image of another metatype. <br>
+ * Converted (and, if requested, premultiplied) pixels are cached in the Data of an image and are reused by subsequent calls
+ * until the image is changed, so a sprite drawn over many frames is converted only once. Cache holds a single region of Data.
+ *
+ * @param image source image
+ * @param metaType required metatype
+ * @param premultiplied whether color channels must be premultiplied by alpha, makes sense for AC4 metatype only
+ * @param pixels pointer to store the pointer to the upper-left pixel of the prepared image into. Memory is owned by the cache or by the image
+ * @param wStep pointer to store the row step of the prepared image into
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+static int image_cached_source(Image* image, IppMetaType metaType, int premultiplied, void** pixels, int* wStep) {
   int status;
+  Data* data;
+  Data* cache;
   Image* source;
+  IppiRect rect;
+
+  assert(image != NULL && pixels != NULL && wStep != NULL);
+
+  if(METATYPE(image) == metaType && !premultiplied) {
+    *pixels = PIXELS(image);
+    *wStep = WSTEP(image);
+    return ippStsNoErr;
+  }
+
+  data = image->data;
+  rect.x = IS_SUBIMAGE(image) ? image->x : 0;
+  rect.y = IS_SUBIMAGE(image) ? image->y : 0;
+  rect.width = WIDTH(image);
+  rect.height = HEIGHT(image);
+
+  if(data->cache == NULL || data->cacheStamp != data->stamp || data->cache->metaType != metaType || data->cachePremultiplied != premultiplied || 
+    data->cacheRect.x != rect.x || data->cacheRect.y != rect.y || data->cacheRect.width != rect.width || data->cacheRect.height != rect.height) {
+    if(data->cache != NULL) {
+      data_destroy(data->cache);
+      data->cache = NULL;
+    }
+
+    if(IS_ERROR(status = image_coerce(image, &source, metaType)))
+      return status;
+
+    if(source != image) {
+      /* Steal the Data of a converted image. */
+      cache = source->data;
+      free(source);
+      if(premultiplied)
+        status = arith_premultiply(metaType, cache->pixels, cache->wStep, cache->pixels, cache->wStep, ippi_size(cache->width, cache->height));
+    } else {
+      cache = data_new(rect.width, rect.height, metaType, 0);
+      if(cache == NULL)
+        return ippStsNoMemErr;
+      status = arith_premultiply(metaType, PIXELS(image), WSTEP(image), cache->pixels, cache->wStep, IPPISIZE(image));
+    }
+
+    if(IS_ERROR(status)) {
+      data_destroy(cache);
+      return status;
+    }
+
+    data->cache = cache;
+    data->cacheRect = rect;
+    data->cachePremultiplied = premultiplied;
+    data->cacheStamp = data->stamp;
+  }
+
+  *pixels = data->cache->pixels;
+  *wStep = data->cache->wStep;
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// image_draw
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_draw, (Image* image, Image* src, IppiPoint pos, BlendMode mode)) {
+  int status;
+  void* pSrc;
+  int srcStep;
   IppiSize roi;
   IppiPoint shrink;
 
@@ -1239,15 +1808,23 @@ TRACE_FUNC(int, image_draw, (Image* image, Image* src, IppiPoint pos)) {
   pos = ippi_point(max(0, pos.x), max(0, pos.y));
   roi = ippi_size(min(WIDTH(src) - shrink.x, WIDTH(image) - pos.x), min(HEIGHT(src) - shrink.y, HEIGHT(image) - pos.y));
 
-  if(METATYPE(image) == METATYPE(src))
-    source = src;
-  else if(IS_ERROR(status = image_convert_copy(src, &source, METATYPE(image))))
-    TRACE_RETURN(status);
+  UNSHARE(image);
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiCopy_, R, (PIXEL_AT(source, shrink.x, shrink.y), WSTEP(source), PIXEL_AT(image, pos.x, pos.y), WSTEP(image), roi)), Unreachable(), ippStsBadArgErr);
+  if(mode == BLEND_COPY) {
+    if(IS_ERROR(status = image_cached_source(src, METATYPE(image), FALSE, &pSrc, &srcStep)))
+      TRACE_RETURN(status);
+    pSrc = (char*) pSrc + shrink.y * srcStep + shrink.x * PIXELSIZE(image);
 
-  if(source != src)
-    image_destroy(source);
+    status = copy_pixels(METATYPE(image), pSrc, srcStep, PIXEL_AT(image, pos.x, pos.y), WSTEP(image), roi);
+  } else {
+    if(IS_ERROR(status = image_cached_source(src, metatype_compose(DATATYPE(image), ippAC4), TRUE, &pSrc, &srcStep)))
+      TRACE_RETURN(status);
+    pSrc = (char*) pSrc + shrink.y * srcStep + shrink.x * metatype_pixel_size(metatype_compose(DATATYPE(image), ippAC4));
+
+    status = arith_blend(mode, METATYPE(image), pSrc, srcStep, PIXEL_AT(image, pos.x, pos.y), WSTEP(image), PIXEL_AT(image, pos.x, pos.y), WSTEP(image), roi);
+  }
+
+  TOUCH(image); /* after the cache of src was used, since src may share data with image */
   TRACE_RETURN(status);
 } TRACE_END
 
@@ -1255,6 +1832,30 @@ TRACE_FUNC(int, image_draw, (Image* image, Image* src, IppiPoint pos)) {
 // -------------------------------------------------------------------------- //
 // image_draw_rotated
 // -------------------------------------------------------------------------- //
+/**
+ * Draws a rotated image using a remap plan, for metatypes ippiRotate is not defined for.
+ * Transform is the same as of ippiRotate: x' = x cos(a) + y sin(a) + xShift, y' = -x sin(a) + y cos(a) + yShift, angle is in degrees.
+ */
+static int image_draw_rotated_remap(Image* image, Image* source, double angle, double xShift, double yShift) {
+  double coeffs[9], a;
+  RemapPlan* plan;
+  int status;
+
+  a = angle * IPP_PI / 180.0;
+  coeffs[0] =  cos(a); coeffs[1] = sin(a); coeffs[2] = xShift;
+  coeffs[3] = -sin(a); coeffs[4] = cos(a); coeffs[5] = yShift;
+  coeffs[6] = 0.0;     coeffs[7] = 0.0;    coeffs[8] = 1.0;
+
+  if(IS_ERROR(status = remap_plan_new_transform(&plan, IPPISIZE(source), IPPISIZE(image), METATYPE(image), coeffs, INTERP_CUBIC, BORDER_TRANSPARENT)))
+    return status;
+
+  status = remap_plan_apply(plan, PIXELS(source), WSTEP(source), PIXELS(image), WSTEP(image));
+
+  remap_plan_destroy(plan);
+  return status;
+}
+
+
 TRACE_FUNC(int, image_draw_rotated, (Image* image, Image* src, double angle, double xShift, double yShift)) {
   int status;
   Image* source;
@@ -1264,6 +1865,8 @@ TRACE_FUNC(int, image_draw_rotated, (Image* image, Image* src, double angle, dou
 
   assert(image != NULL && src != NULL);
 
+  TOUCH(image);
+
   TRACE(("1"));
 
   if(METATYPE(image) == METATYPE(src))
@@ -1281,7 +1884,8 @@ TRACE_FUNC(int, image_draw_rotated, (Image* image, Image* src, double angle, dou
   dstRoi.height = HEIGHT(image);
   dstRoi.width = WIDTH(image);
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiRotate_, R, (PIXELS(source), IPPISIZE(source), WSTEP(source), srcRoi, PIXELS(image), WSTEP(image), dstRoi, angle, xShift, yShift, IPPI_INTER_CUBIC | IPPI_SMOOTH_EDGE)), Unreachable(), ippStsBadArgErr);
+  status = METATABLE_CALL(ipp_rotate, METATYPE(image), (PIXELS(source), IPPISIZE(source), WSTEP(source), srcRoi, PIXELS(image), WSTEP(image), dstRoi, angle, xShift, yShift, IPPI_INTER_CUBIC | IPPI_SMOOTH_EDGE),
+                          image_draw_rotated_remap(image, source, angle, xShift, yShift));
 
   TRACE(("3"));
 
@@ -1295,23 +1899,388 @@ TRACE_FUNC(int, image_draw_rotated, (Image* image, Image* src, double angle, dou
 // -------------------------------------------------------------------------- //
 // image_resize_copy
 // -------------------------------------------------------------------------- //
-TRACE_FUNC(int, image_resize_copy, (Image* image, Image** dst, IppiSize newSize)) {
+TRACE_FUNC(int, image_resize_copy, (Image* image, Image** dst, IppiSize newSize, ResizeMode mode)) {
   int status;
-  IppiRect srcRoi;
+  ResizePlan* plan;
 
   assert(image != NULL && dst != NULL);
 
-  if(IS_ERROR(status = image_new(dst, newSize.width, newSize.height, METATYPE(image), 0)))
+  plan = resize_plan_acquire(IPPISIZE(image), newSize, METATYPE(image), mode);
+  if(plan == NULL)
+    TRACE_RETURN(ippStsNoMemErr);
+
+  status = image_resize_plan_copy(image, dst, plan);
+  resize_plan_release(plan);
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_resize_plan
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_resize_plan, (Image* image, Image* dst, ResizePlan* plan)) {
+  int status;
+
+  assert(image != NULL && dst != NULL && plan != NULL);
+
+  if(METATYPE(image) != plan->metaType || METATYPE(dst) != plan->metaType || image->data == dst->data)
+    TRACE_RETURN(ippStsBadArgErr);
+  if(WIDTH(image) != plan->srcSize.width || HEIGHT(image) != plan->srcSize.height || WIDTH(dst) != plan->dstSize.width || HEIGHT(dst) != plan->dstSize.height)
+    TRACE_RETURN(ippStsSizeErr);
+
+  UNSHARE(dst);
+
+  status = resize_plan_apply(plan, PIXELS(image), WSTEP(image), PIXELS(dst), WSTEP(dst));
+
+  TOUCH(dst);
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_resize_plan_copy
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_resize_plan_copy, (Image* image, Image** dst, ResizePlan* plan)) {
+  int status;
+
+  assert(image != NULL && dst != NULL && plan != NULL);
+
+  if(METATYPE(image) != plan->metaType)
+    TRACE_RETURN(ippStsBadArgErr);
+  if(WIDTH(image) != plan->srcSize.width || HEIGHT(image) != plan->srcSize.height)
+    TRACE_RETURN(ippStsSizeErr);
+
+  if(IS_ERROR(status = image_new(dst, plan->dstSize.width, plan->dstSize.height, METATYPE(image), 0)))
     TRACE_RETURN(status);
 
-  srcRoi.x = srcRoi.y = 0;
-  srcRoi.height = HEIGHT(image);
-  srcRoi.width = WIDTH(image);
+  status = resize_plan_apply(plan, PIXELS(image), WSTEP(image), PIXELS(*dst), WSTEP(*dst));
+  if(IS_ERROR(status))
+    image_destroy(*dst);
+
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_thumbnail_copy
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_thumbnail_copy, (Image* image, Image** dst, IppiSize maxSize)) {
+  int status;
+  double scale;
+  IppiSize size, newSize;
+  Data* tmp;
+  void* pSrc;
+  int srcStep;
+  ResizePlan* plan;
+
+  assert(image != NULL && dst != NULL);
+  assert(maxSize.width > 0 && maxSize.height > 0);
+
+  scale = min(1.0, min((double) maxSize.width / WIDTH(image), (double) maxSize.height / HEIGHT(image)));
+  newSize.width = max(1, min(maxSize.width, (int) (WIDTH(image) * scale + 0.5)));
+  newSize.height = max(1, min(maxSize.height, (int) (HEIGHT(image) * scale + 0.5)));
+
+  /* Box-halve down to within 2x of the target size. All steps after the first one are done in place. */
+  tmp = NULL;
+  size = IPPISIZE(image);
+  pSrc = PIXELS(image);
+  srcStep = WSTEP(image);
+  while(size.width / 2 >= newSize.width && size.height / 2 >= newSize.height) {
+    size = ippi_size(size.width / 2, size.height / 2);
+    if(tmp == NULL && (tmp = data_new(size.width, size.height, METATYPE(image), 0)) == NULL)
+      TRACE_RETURN(ippStsNoMemErr);
+
+    resize_halve(METATYPE(image), pSrc, srcStep, tmp->pixels, tmp->wStep, size);
+    pSrc = tmp->pixels;
+    srcStep = tmp->wStep;
+  }
+
+  /* Then do the final high-quality resample. */
+  plan = resize_plan_acquire(size, newSize, METATYPE(image), RESIZE_LANCZOS);
+  if(plan == NULL)
+    status = ippStsNoMemErr;
+  else {
+    if(!IS_ERROR(status = image_new(dst, newSize.width, newSize.height, METATYPE(image), 0))) {
+      status = resize_plan_apply(plan, pSrc, srcStep, PIXELS(*dst), WSTEP(*dst));
+      if(IS_ERROR(status))
+        image_destroy(*dst);
+    }
+    resize_plan_release(plan);
+  }
+
+  if(tmp != NULL)
+    data_destroy(tmp);
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_pyramid_height
+// -------------------------------------------------------------------------- //
+/**
+ * @returns total height of first levels of a pyramid with base of the given size
+ */
+static int image_pyramid_height(IppiSize size, int levels) {
+  int height;
+
+  for(height = 0; levels > 0; levels--, size = pyramid_next_size(size))
+    height += size.height;
+  return height;
+}
+
+
+// -------------------------------------------------------------------------- //
+// image_pyramid_fill
+// -------------------------------------------------------------------------- //
+/**
+ * Fills levels 1..levels-1 of a Gaussian pyramid stored in the given image, level 0 must already be in place.
+ */
+static int image_pyramid_fill(Image* pyramid, IppiSize size, int levels, Ipp32f* buffer) {
+  int status, y;
+
+  for(status = ippStsNoErr, y = 0; levels > 1 && !IS_ERROR(status); levels--) {
+    status = pyramid_down(METATYPE(pyramid), PIXEL_AT(pyramid, 0, y), WSTEP(pyramid), size, PIXEL_AT(pyramid, 0, y + size.height), WSTEP(pyramid), buffer);
+    y += size.height;
+    size = pyramid_next_size(size);
+  }
+  return status;
+}
+
+
+// -------------------------------------------------------------------------- //
+// image_gaussian_pyramid
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_gaussian_pyramid, (Image* image, Image** dst, int levels)) {
+  int status;
+  void* buffer;
+
+  assert(image != NULL && dst != NULL && levels > 0);
+
+  if(IS_ERROR(status = image_new(dst, WIDTH(image), image_pyramid_height(IPPISIZE(image), levels), METATYPE(image), 0)))
+    TRACE_RETURN(status);
+
+  buffer = malloc(PYRAMID_BUFFER_SIZE(WIDTH(image)));
+  if(buffer == NULL)
+    status = ippStsNoMemErr;
+  else {
+    status = copy_pixels(METATYPE(image), PWPWI(image, *dst));
+    if(!IS_ERROR(status))
+      status = image_pyramid_fill(*dst, IPPISIZE(image), levels, buffer);
+    free(buffer);
+  }
+
+  if(IS_ERROR(status))
+    image_destroy(*dst);
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_laplacian_pyramid
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_laplacian_pyramid, (Image* image, Image** dst, int levels)) {
+  int status, y;
+  IppiSize size, nextSize;
+  Ipp32f* buffer;
+
+  assert(image != NULL && dst != NULL && levels > 0);
+
+  if(IS_ERROR(status = image_new(dst, WIDTH(image), image_pyramid_height(IPPISIZE(image), levels), metatype_compose(ipp32f, CHANNELS(image)), 0)))
+    TRACE_RETURN(status);
+
+  buffer = (Ipp32f*) malloc(WIDTH(image) * 4 * sizeof(Ipp32f));
+  if(buffer == NULL)
+    status = ippStsNoMemErr;
+  else {
+    /* Build a Gaussian pyramid in 32f, then replace each level but the last with its difference from the expanded next level.
+     * Levels are processed from the bottom up, so that each one is expanded before it is itself replaced. */
+    if(!IS_ERROR(status = pyramid_normalize(METATYPE(image), PIXELS(image), WSTEP(image), (Ipp32f*) PIXELS(*dst), WSTEP(*dst), IPPISIZE(image))))
+      status = image_pyramid_fill(*dst, IPPISIZE(image), levels, buffer);
+
+    size = IPPISIZE(image);
+    for(y = 0; levels > 1 && !IS_ERROR(status); levels--) {
+      nextSize = pyramid_next_size(size);
+      status = pyramid_up_add(CHANNELS(image), (Ipp32f*) PIXEL_AT(*dst, 0, y + size.height), WSTEP(*dst), nextSize, (Ipp32f*) PIXEL_AT(*dst, 0, y), WSTEP(*dst), size, -1.0f, buffer);
+      y += size.height;
+      size = nextSize;
+    }
+    free(buffer);
+  }
 
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, IPPMETAFUNC, (ippiResize_, R, (PIXELS(image), IPPISIZE(image), WSTEP(image), srcRoi, PWI(*dst), (double) WIDTH(*dst) / WIDTH(image), (double) HEIGHT(*dst) / HEIGHT(image), IPPI_INTER_CUBIC)), Unreachable(), ippStsBadArgErr);
   if(IS_ERROR(status))
     image_destroy(*dst);
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_laplacian_reconstruct
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_laplacian_reconstruct, (Image** levels, int count, Image** dst)) {
+  int status, i, y;
+  IppiSize size;
+  IppMetaType metaType;
+  Data* tmp;
+  Ipp32f* buffer;
+  void* pSrc;
+  void* pDst;
+  int srcStep, dstStep;
+
+  assert(levels != NULL && dst != NULL && count > 0);
+
+  metaType = METATYPE(levels[0]);
+  if(metatype_datatype(metaType) != ipp32f)
+    TRACE_RETURN(ippStsBadArgErr);
+  for(i = 1; i < count; i++) {
+    if(METATYPE(levels[i]) != metaType)
+      TRACE_RETURN(ippStsBadArgErr);
+    size = pyramid_next_size(IPPISIZE(levels[i - 1]));
+    if(WIDTH(levels[i]) != size.width || HEIGHT(levels[i]) != size.height)
+      TRACE_RETURN(ippStsSizeErr);
+  }
+
+  if(IS_ERROR(status = image_new(dst, WIDTH(levels[0]), HEIGHT(levels[0]), metaType, 0)))
+    TRACE_RETURN(status);
 
+  /* Intermediate levels 1..count-2 are accumulated in a single temporary buffer, level 0 is accumulated right in the destination. */
+  tmp = NULL;
+  buffer = NULL;
+  if(count > 2 && (tmp = data_new(WIDTH(levels[1]), image_pyramid_height(IPPISIZE(levels[1]), count - 2), metaType, 0)) == NULL)
+    status = ippStsNoMemErr;
+  else if((buffer = (Ipp32f*) malloc(WIDTH(levels[0]) * 4 * sizeof(Ipp32f))) == NULL)
+    status = ippStsNoMemErr;
+
+  pSrc = PIXELS(levels[count - 1]);
+  srcStep = WSTEP(levels[count - 1]);
+  for(i = count - 1, y = 0; i >= 0 && !IS_ERROR(status); i--) {
+    if(i == 0) {
+      pDst = PIXELS(*dst);
+      dstStep = WSTEP(*dst);
+    } else if(i == count - 1) {
+      continue;
+    } else {
+      pDst = (char*) tmp->pixels + y * tmp->wStep;
+      dstStep = tmp->wStep;
+      y += HEIGHT(levels[i]);
+    }
+
+    status = copy_pixels(metaType, PIXELS(levels[i]), WSTEP(levels[i]), pDst, dstStep, IPPISIZE(levels[i]));
+    if(!IS_ERROR(status) && i < count - 1)
+      status = pyramid_up_add(metatype_channels(metaType), (Ipp32f*) pSrc, srcStep, IPPISIZE(levels[i + 1]), (Ipp32f*) pDst, dstStep, IPPISIZE(levels[i]), 1.0f, buffer);
+    pSrc = pDst;
+    srcStep = dstStep;
+  }
+
+  if(buffer != NULL)
+    free(buffer);
+  if(tmp != NULL)
+    data_destroy(tmp);
+  if(IS_ERROR(status))
+    image_destroy(*dst);
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_remap_plan
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_remap_plan, (Image* image, Image* dst, RemapPlan* plan)) {
+  int status;
+
+  assert(image != NULL && dst != NULL && plan != NULL);
+
+  if(METATYPE(image) != plan->metaType || METATYPE(dst) != plan->metaType || image->data == dst->data)
+    TRACE_RETURN(ippStsBadArgErr);
+  if(WIDTH(image) != plan->srcSize.width || HEIGHT(image) != plan->srcSize.height || WIDTH(dst) != plan->dstSize.width || HEIGHT(dst) != plan->dstSize.height)
+    TRACE_RETURN(ippStsSizeErr);
+
+  UNSHARE(dst);
+
+  status = remap_plan_apply(plan, PIXELS(image), WSTEP(image), PIXELS(dst), WSTEP(dst));
+
+  TOUCH(dst);
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_remap_plan_copy
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_remap_plan_copy, (Image* image, Image** dst, RemapPlan* plan)) {
+  int status, y;
+
+  assert(image != NULL && dst != NULL && plan != NULL);
+
+  if(METATYPE(image) != plan->metaType)
+    TRACE_RETURN(ippStsBadArgErr);
+  if(WIDTH(image) != plan->srcSize.width || HEIGHT(image) != plan->srcSize.height)
+    TRACE_RETURN(ippStsSizeErr);
+
+  if(IS_ERROR(status = image_new(dst, plan->dstSize.width, plan->dstSize.height, METATYPE(image), 0)))
+    TRACE_RETURN(status);
+
+  if(plan->border == BORDER_TRANSPARENT) /* there is nothing to see through in a newly created image */
+    for(y = 0; y < HEIGHT(*dst); y++)
+      memset(PIXEL_AT(*dst, 0, y), 0, WIDTH(*dst) * PIXELSIZE(*dst));
+
+  status = remap_plan_apply(plan, PIXELS(image), WSTEP(image), PIXELS(*dst), WSTEP(*dst));
+  if(IS_ERROR(status))
+    image_destroy(*dst);
+
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_warp_copy
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_warp_copy, (Image* image, Image** dst, IppiSize dstSize, const double* coeffs, InterpMode interp, BorderMode border)) {
+  int status;
+  RemapPlan* plan;
+
+  assert(image != NULL && dst != NULL && coeffs != NULL);
+
+  if(IS_ERROR(status = remap_plan_new_transform(&plan, IPPISIZE(image), dstSize, METATYPE(image), coeffs, interp, border)))
+    TRACE_RETURN(status);
+
+  status = image_remap_plan_copy(image, dst, plan);
+
+  remap_plan_destroy(plan);
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_remap_plan_new
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_remap_plan_new, (RemapPlan** dst, IppiSize srcSize, IppMetaType metaType, Image* mapX, Image* mapY, InterpMode interp, BorderMode border, RemapMapFormat format)) {
+  assert(dst != NULL && mapX != NULL && mapY != NULL);
+
+  if(METATYPE(mapX) != ipp32f_C1 || METATYPE(mapY) != ipp32f_C1)
+    TRACE_RETURN(ippStsBadArgErr);
+  if(WIDTH(mapX) != WIDTH(mapY) || HEIGHT(mapX) != HEIGHT(mapY))
+    TRACE_RETURN(ippStsSizeErr);
+
+  TRACE_RETURN(remap_plan_new_maps(dst, srcSize, IPPISIZE(mapX), metaType, (Ipp32f*) PIXELS(mapX), WSTEP(mapX), (Ipp32f*) PIXELS(mapY), WSTEP(mapY), interp, border, format));
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_remap_copy
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_remap_copy, (Image* image, Image** dst, Image* mapX, Image* mapY, InterpMode interp, BorderMode border)) {
+  int status;
+  RemapPlan* plan;
+
+  assert(image != NULL && dst != NULL && mapX != NULL && mapY != NULL);
+
+  /* A one-shot plan just references the maps, converting them would cost more than it saves. */
+  if(IS_ERROR(status = image_remap_plan_new(&plan, IPPISIZE(image), METATYPE(image), mapX, mapY, interp, border, REMAP_MAPS_BORROWED)))
+    TRACE_RETURN(status);
+
+  status = image_remap_plan_copy(image, dst, plan);
+
+  remap_plan_destroy(plan);
   TRACE_RETURN(status);
 } TRACE_END
 
@@ -1324,9 +2293,9 @@ TRACE_FUNC(int, image_mirror, (Image* image, IppiAxis axis)) {
 
   assert(image != NULL);
 
-#define METAFUNC(M, ARGS) ARX_JOIN_3(ippiMirror_, M_REPLACE_D_IF_D(M, 32f, 32s), IR) (PWI(image), axis)
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, METAFUNC, ~, Unreachable(), ippStsBadArgErr);
-#undef METAFUNC
+  TOUCH(image);
+
+  status = METATABLE_CALL(ipp_mirror_i, METATYPE(image), (PWI(image), axis), rotate_inplace(axis_orientation(axis), METATYPE(image), PWI(image)));
 
   TRACE_RETURN(status);
 } TRACE_END
@@ -1343,10 +2312,210 @@ TRACE_FUNC(int, image_mirror_copy, (Image* image, Image** dst, IppiAxis axis)) {
   if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0)))
     TRACE_RETURN(status);
 
-#define METAFUNC(M, ARGS) ARX_JOIN_3(ippiMirror_, M_REPLACE_D_IF_D(M, 32f, 32s), R) (PWPWI(image, *dst), axis)
-  IPPMETACALL(METATYPE(image), status =, M_SUPPORTED, METAFUNC, ~, Unreachable(), ippStsBadArgErr);
-#undef METAFUNC
+  status = METATABLE_CALL(ipp_mirror, METATYPE(image), (PWPWI(image, *dst), axis), rotate_copy(axis_orientation(axis), METATYPE(image), PIXELS(image), WSTEP(image), IPPISIZE(image), PIXELS(*dst), WSTEP(*dst)));
+
+  if(IS_ERROR(status))
+    image_destroy(*dst);
+
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_orient
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_orient, (Image* image, Orientation orientation)) {
+  assert(image != NULL);
+
+  if(rotate_swaps_axes(orientation) && WIDTH(image) != HEIGHT(image))
+    TRACE_RETURN(ippStsSizeErr);
+
+  TOUCH(image);
+
+  TRACE_RETURN(rotate_inplace(orientation, METATYPE(image), PIXELS(image), WSTEP(image), IPPISIZE(image)));
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_orient_copy
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_orient_copy, (Image* image, Image** dst, Orientation orientation)) {
+  int status;
+  IppiSize dstSize;
+
+  assert(image != NULL && dst != NULL);
+
+  dstSize = rotate_size(orientation, IPPISIZE(image));
+  if(IS_ERROR(status = image_new(dst, dstSize.width, dstSize.height, METATYPE(image), 0)))
+    TRACE_RETURN(status);
+
+  status = rotate_copy(orientation, METATYPE(image), PIXELS(image), WSTEP(image), IPPISIZE(image), PIXELS(*dst), WSTEP(*dst));
+  if(IS_ERROR(status))
+    image_destroy(*dst);
+
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_apply_lut
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_apply_lut, (Image* image, Lut* lut)) {
+  assert(image != NULL && lut != NULL);
+
+  TOUCH(image);
+
+  TRACE_RETURN(lut_apply(lut, METATYPE(image), PIXELS(image), WSTEP(image), PWI(image)));
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_apply_lut_copy
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_apply_lut_copy, (Image* image, Image** dst, Lut* lut)) {
+  int status;
+
+  assert(image != NULL && dst != NULL && lut != NULL);
+
+  if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0)))
+    TRACE_RETURN(status);
+
+  status = lut_apply(lut, METATYPE(image), PWPWI(image, *dst));
+  if(IS_ERROR(status))
+    image_destroy(*dst);
+
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_arith
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_arith, (Image* image, Image* other, ArithOp op, const IppMetaNumber* weights)) {
+  int status;
+  Image* source;
+
+  assert(image != NULL && other != NULL);
+
+  if(WIDTH(image) != WIDTH(other) || HEIGHT(image) != HEIGHT(other))
+    TRACE_RETURN(ippStsSizeErr);
+
+  TOUCH(image);
+
+  if(IS_ERROR(status = image_coerce(other, &source, METATYPE(image))))
+    TRACE_RETURN(status);
+
+  status = arith_apply(op, METATYPE(image), PIXELS(image), WSTEP(image), PIXELS(source), WSTEP(source), PWI(image), weights);
+
+  if(source != other)
+    image_destroy(source);
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_arith_copy
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_arith_copy, (Image* image, Image** dst, Image* other, ArithOp op, const IppMetaNumber* weights)) {
+  int status;
+  Image* source;
+
+  assert(image != NULL && dst != NULL && other != NULL);
+
+  if(WIDTH(image) != WIDTH(other) || HEIGHT(image) != HEIGHT(other))
+    TRACE_RETURN(ippStsSizeErr);
+
+  if(IS_ERROR(status = image_coerce(other, &source, METATYPE(image))))
+    TRACE_RETURN(status);
+
+  if(!IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0))) {
+    status = arith_apply(op, METATYPE(image), PIXELS(image), WSTEP(image), PIXELS(source), WSTEP(source), PWI(*dst), weights);
+    if(IS_ERROR(status))
+      image_destroy(*dst);
+  }
+
+  if(source != other)
+    image_destroy(source);
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_arith_c
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_arith_c, (Image* image, Color* color, ArithOp op, const IppMetaNumber* weights)) {
+  assert(image != NULL && color != NULL);
+
+  TOUCH(image);
+
+  TRACE_RETURN(arith_apply_c(op, METATYPE(image), PIXELS(image), WSTEP(image), color, PWI(image), weights));
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_arith_c_copy
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_arith_c_copy, (Image* image, Image** dst, Color* color, ArithOp op, const IppMetaNumber* weights)) {
+  int status;
+
+  assert(image != NULL && dst != NULL && color != NULL);
+
+  if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0)))
+    TRACE_RETURN(status);
+
+  status = arith_apply_c(op, METATYPE(image), PIXELS(image), WSTEP(image), color, PWI(*dst), weights);
+  if(IS_ERROR(status))
+    image_destroy(*dst);
+
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_alpha_composite
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_alpha_composite, (Image* image, Image* src)) {
+  int status;
+  void* pSrc;
+  int srcStep;
+
+  assert(image != NULL && src != NULL);
+
+  if(WIDTH(image) != WIDTH(src) || HEIGHT(image) != HEIGHT(src))
+    TRACE_RETURN(ippStsSizeErr);
+
+  UNSHARE(image);
+
+  if(IS_ERROR(status = image_cached_source(src, metatype_compose(DATATYPE(image), ippAC4), TRUE, &pSrc, &srcStep)))
+    TRACE_RETURN(status);
+
+  status = arith_blend(BLEND_OVER, METATYPE(image), pSrc, srcStep, PIXELS(image), WSTEP(image), PWI(image));
+
+  TOUCH(image); /* after the cache of src was used, since src may share data with image */
+  TRACE_RETURN(status);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// image_alpha_composite_copy
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, image_alpha_composite_copy, (Image* image, Image** dst, Image* src)) {
+  int status;
+  void* pSrc;
+  int srcStep;
+
+  assert(image != NULL && dst != NULL && src != NULL);
+
+  if(WIDTH(image) != WIDTH(src) || HEIGHT(image) != HEIGHT(src))
+    TRACE_RETURN(ippStsSizeErr);
+
+  if(IS_ERROR(status = image_cached_source(src, metatype_compose(DATATYPE(image), ippAC4), TRUE, &pSrc, &srcStep)))
+    TRACE_RETURN(status);
+
+  if(IS_ERROR(status = image_new(dst, WIDTH(image), HEIGHT(image), METATYPE(image), 0)))
+    TRACE_RETURN(status);
 
+  status = arith_blend(BLEND_OVER, METATYPE(image), pSrc, srcStep, PIXELS(image), WSTEP(image), PWI(*dst));
   if(IS_ERROR(status))
     image_destroy(*dst);
 
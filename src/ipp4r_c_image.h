@@ -6,6 +6,11 @@
 #include <ippi.h>
 #include "ipp4r_fwd.h"
 #include "ipp4r_metatype.h"
+#include "ipp4r_arith.h"
+#include "ipp4r_resize.h"
+#include "ipp4r_remap.h"
+#include "ipp4r_rotate.h"
+#include "ipp4r_colorspace.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -17,31 +22,26 @@ extern "C" {
 /**
  * Main Image structure. <p>
  *
- * Note that we are using ruby gc facilities for sharing one Data structure between several Images. <br>
- * Of course this isn't the only possible solution for our problem. Other approaches are as follows:
- * <ul>
- * <li> Use internal reference counting
- *   <ul>
- *   <li> Use thread-safe reference-counting
- *   <li> Give up thread-safe counting, use <tt>++</tt> and <tt>--</tt> and hope nobody'd notice
- *   </ul>
- * <li> Don't use shared data structure
- * </ul>
- * The last approach isn't flexible enough, unsafe counting is, huh, unsafe, so the only reasonable alternative is to use thread-safe counting.
- * But implementing thread-safe counting is a real pain in the ass - we'd have to implement it several times for different platforms, operating systems, and even compilers.
- * Only on Windows we have neat InterlockedIncrement and InterlockedDecrement intrinsics. For *nix we'll have no choice but to mess with inline assembler or pthreads. <br>
- * So that's it - the simplest way is to use ruby gc. <p>
+ * Note that one Data structure is shared between several Images, and its lifetime is managed by an atomic reference count (see data_retain and data_release). <br>
+ * Images that are visible from ruby don't hold references themselves. Instead, Data is wrapped into a ruby object, rb_data, which holds one reference,
+ * and every Image marks it. So Data lives as long as any Image that uses it is reachable, and ruby gc is all the bookkeeping ruby code needs. <br>
+ * Views, i.e. subimages and planes, hold one more reference each, so that the count tells whether anything but the image itself sees its Data, see image_transpose. <br>
+ * Native code that must keep Data alive on its own, e.g. a worker thread that runs with the GVL released or a queue of pending operations,
+ * takes its own reference with data_retain, and releases it with data_release when done - from any thread. The Data is destroyed with the last reference,
+ * whether it's released by ruby gc or by a worker. <p>
  *
  * Also note that even though we are storing a reference to Data structure, it is still considered a part of Image's internal state, 
  * i.e. <tt>clone</tt> and <tt>dup</tt> methods copy the Data.
  * The motivation here is simple: Image class is opaque and user knows nothing about it's internal structure. From outside our Image structure is perceived as a
- * "smart reference" to image data, and therefore the data itself is a part of Image's internal state. <p>
+ * "smart reference" to image data, and therefore the data itself is a part of Image's internal state. <br>
+ * The copy is lazy though: a clone gets its own Data that shares the pixel buffer copy-on-write, and the buffer is copied by the first in-place change of either image
+ * (see data_share and data_unshare). So a defensive <tt>dup</tt> that is only read from costs nothing. <p>
  *
  * Another thing you must know is that there exist no way to change the size of an existing Data structure. Motivation: change of size involves creating of a new image and
  * is not an in-place operation. Also change of size may invalidate pixel references or even Image structures. That's why all in-place operations does not change the size of
  * an image.<p>
  *
- * As I've noted above, we use ruby gc for sharing one Data structure between several images. It's a nice approach, but it gives rise to many subtle problems.
+ * As I've noted above, ruby code relies on ruby gc for sharing one Data structure between several images. It's a nice approach, but it gives rise to many subtle problems.
  * Consider the following example:
  * <code><pre>
  *   Image* img = image_new(...);
@@ -49,14 +49,15 @@ extern "C" {
  *   image_transpose(img); // use image
  * </pre></code>
  * It seems everything is OK, but it's not. A call to xalloc may trigger gc, which will sweep out the underlying shared Data structure and we'll end up with a segmentation fault.
- * To avoid it, we use lazy gc registration of Data structure - it gets registered in image_wrap. And if you call image_destroy before a call to image_wrap, the Data will be 
- * deallocated.
+ * To avoid it, we use lazy gc registration of Data structure - it gets registered in image_wrap. Until then the image holds the reference its Data was created with,
+ * and if you call image_destroy before a call to image_wrap, the reference is released and the Data will be deallocated, unless somebody else retained it.
  */
 struct _Image {
   VALUE rb_data;        /**< Ruby wrapper around Data associated with this Image */
   Data* data;           /**< Pointer to Data structure associated with this Image */
 
   int is_subimage;      /**< is this image a subimage? i.e. should we use ROI information? */
+  int is_view;          /**< is this image a subimage or a plane of another image? Views hold a reference to their Data */
   int x;                /**< ROI x coordinate */
   int y;                /**< ROI y coordinate */
   int width;            /**< width of ROI in pixels */
@@ -109,13 +110,19 @@ VALUE image_wrap(Image* image);
 
 
 /**
- * Turns Image* into shared object by registering the underlying Data structure in ruby gc.
+ * Same as image_wrap, but wraps an Image* into an object of the given class, i.e. PlanarImage.
+ */
+VALUE image_wrap_class(Image* image, VALUE klass);
+
+
+/**
+ * Turns Image* into shared object by registering the underlying Data structure in ruby gc. Reference to Data held by the image passes to the ruby wrapper.
  */
 void image_share(Image* image);
 
 
 /**
- * Clones the given image (including the Data it references)
+ * Clones the given image (including the Data it references). Pixel buffer of a whole image is shared copy-on-write, subimages and planar images are copied at once.
  *
  * @param image image to clone
  * @param dst destination image
@@ -211,7 +218,7 @@ int image_addranduniform(Image* image, IppMetaNumber lo, IppMetaNumber hi);
 
 
 /**
- * Converts the given image to given data type. If no conversion is needed, just returns a clone of the given image (underlying data is cloned too!).
+ * Converts the given image to given data type. If no conversion is needed, just returns a clone of the given image, see image_clone.
  * 
  * @param image source image
  * @param dst destination image
@@ -222,7 +229,7 @@ int image_convert_datatype_copy(Image* image, Image** dst, IppDataType dataType)
 
 
 /**
- * Converts the given image to given channels type. If no conversion is needed, just returns a clone of the given image (underlying data is cloned too!).
+ * Converts the given image to given channels type. If no conversion is needed, just returns a clone of the given image, see image_clone.
  * 
  * @param image source image
  * @param dst destination image
@@ -233,7 +240,7 @@ int image_convert_channels_copy(Image* image, Image** dst, IppChannels channels)
 
 
 /**
- * Converts the given image to given metatype. If no conversion is needed, just returns a clone of the given image (underlying data is cloned too!).
+ * Converts the given image to given metatype. If no conversion is needed, just returns a clone of the given image, see image_clone.
  * 
  * @param image source image
  * @param dst destination image
@@ -243,6 +250,73 @@ int image_convert_channels_copy(Image* image, Image** dst, IppChannels channels)
 int image_convert_copy(Image* image, Image** dst, IppMetaType metaType);
 
 
+/**
+ * Converts an image from one color space to another. Channels of the image are preserved, single-channel images are not supported.
+ *
+ * @param image source image
+ * @param dst destination image
+ * @param from color space of source
+ * @param to color space of destination
+ * @param dataType data type of destination, conversion is done in the same pass
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_colorspace_copy(Image* image, Image** dst, ColorSpace from, ColorSpace to, IppDataType dataType);
+
+
+/**
+ * Converts an image to YUV 4:2:0. Images of metatypes other than 8u_C3, 8u_AC4 and 8u_C4 are converted to 8u_C3 first.
+ *
+ * @param image source image
+ * @param format layout of destination
+ * @param dst destination buffer of colorspace_yuv420_size(size of image) bytes
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_to_yuv420(Image* image, Yuv420Format format, Ipp8u* dst);
+
+
+/**
+ * Creates an 8u_C3 image from a YUV 4:2:0 buffer.
+ *
+ * @param dst destination image
+ * @param src source buffer of colorspace_yuv420_size(size) bytes
+ * @param size size of an image
+ * @param format layout of source
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_from_yuv420(Image** dst, const Ipp8u* src, IppiSize size, Yuv420Format format);
+
+
+/**
+ * Creates a C1 image which shares memory with the given plane of a planar image.
+ *
+ * @param image planar image, must be shared
+ * @param dst destination image
+ * @param plane index of a plane
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_plane(Image* image, Image** dst, int plane);
+
+
+/**
+ * Converts a C3 or AC4 image to P3 or P4 planar image of the same data type.
+ *
+ * @param image source image
+ * @param dst destination image
+ * @returns ippStsNoErr if everything went OK, ippStsNumChannelsErr for single-channel images, non-zero error or warning code otherwise
+ */
+int image_to_planar_copy(Image* image, Image** dst);
+
+
+/**
+ * Converts a P3 or P4 planar image to C3 or AC4 image of the same data type.
+ *
+ * @param image source image
+ * @param dst destination image
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_from_planar_copy(Image* image, Image** dst);
+
+
 /**
  * Gets color of a pixel at (x, y)
  * 
@@ -287,6 +361,18 @@ int image_fill(Image* image, Color* color);
 int image_transpose_copy(Image* image, Image** dst);
 
 
+/**
+ * Transposes an image in place. <br>
+ * Square images are transposed tile by tile. Non-square images must not be subimages. A Data that nobody else sees, i.e. one with no views,
+ * no native users and no copy-on-write clones, is re-strided to the transposed size in its own buffer if it fits. Otherwise the image switches
+ * to a transposed copy of its Data, which subimages and plane views of the image go on using untransposed.
+ *
+ * @param image source image
+ * @returns ippStsNoErr if everything went OK, ippStsSizeErr if the image is a non-square subimage, non-zero error or warning code otherwise
+ */
+int image_transpose(Image* image);
+
+
 /**
  * Performs in-place thresholding of pixel values in an image.
  * Pixels that satisfy the cmp relation with threshold, are set to a specified value.
@@ -470,7 +556,7 @@ int image_filter_max_copy(Image* image, Image** dst, IppiSize maskSize, IppiPoin
 
 /**
  * Filters an image using a median filter.
- * Underlying routines doesn't support ipp32f type, therefore conversion to ipp16u is performed if the image of ipp32f datatype is passed.
+ * Metatypes ippiFilterMedian doesn't support (32f, 32s, 64f and C4 ones) are filtered natively, so the result is always of the source metatype.
  *
  * @param image source image
  * @param dst destination image
@@ -505,14 +591,17 @@ int image_filter_copy(Image* image, Image** dst, Matrix* kernel, IppiPoint ancho
 
 
 /**
- * Draws one image on another.
+ * Draws one image on another. <br>
+ * Source image is converted to the metatype of destination (to AC4 metatype of the same data type and premultiplied by alpha for blend modes other than BLEND_COPY),
+ * and the result of the conversion is cached in the source image data, so repeated drawing of the same unchanged source doesn't convert it again.
  *
  * @param image destination image
  * @param src source image
  * @param pos source image position in destination image
+ * @param mode blend mode
  * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
  */
-int image_draw(Image* image, Image* src, IppiPoint pos);
+int image_draw(Image* image, Image* src, IppiPoint pos, BlendMode mode);
 
 
 /**
@@ -529,14 +618,152 @@ int image_draw_rotated(Image* image, Image* src, double angle, double xShift, do
 
 
 /**
- * Resizes the given image.
+ * Resizes the given image. Uses a plan from the internal plan cache, so resizing many images of the same size doesn't recompute filter weights.
  *
  * @param image source image
  * @param dst destination image
  * @param newSize new size of an image
+ * @param mode interpolation mode
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_resize_copy(Image* image, Image** dst, IppiSize newSize, ResizeMode mode);
+
+
+/**
+ * Resizes the given image into an existing destination image using a resize plan. Doesn't allocate memory.
+ *
+ * @param image source image, must match plan source size and metatype
+ * @param dst destination image, must match plan destination size and metatype, must not share data with source
+ * @param plan resize plan
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_resize_plan(Image* image, Image* dst, ResizePlan* plan);
+
+
+/**
+ * Resizes the given image using a resize plan.
+ *
+ * @param image source image, must match plan source size and metatype
+ * @param dst destination image
+ * @param plan resize plan
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_resize_plan_copy(Image* image, Image** dst, ResizePlan* plan);
+
+
+/**
+ * Creates a thumbnail of the given image, i.e. downscales it to fit into the given size preserving aspect ratio. Never upscales. <br>
+ * Image is first halved with a 2x2 box filter while it stays at least twice as large as the target, and then resampled with a Lanczos filter.
+ *
+ * @param image source image
+ * @param dst destination image
+ * @param maxSize maximal size of a thumbnail
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_thumbnail_copy(Image* image, Image** dst, IppiSize maxSize);
+
+
+/**
+ * Builds a Gaussian pyramid of the given image. All levels are stored in a single image of the source metatype, one under another,
+ * i.e. level <tt>i</tt> is located at (0, sum of heights of levels 0..i-1) and has the size given by applying pyramid_next_size to the source size i times. <br>
+ * Level 0 is a copy of the source.
+ *
+ * @param image source image
+ * @param dst destination image holding the pyramid
+ * @param levels number of levels, must be positive
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_gaussian_pyramid(Image* image, Image** dst, int levels);
+
+
+/**
+ * Builds a Laplacian pyramid of the given image. Layout of levels is the same as for image_gaussian_pyramid,
+ * but the pyramid is of 32f metatype with the same channels as the source, since differences are signed. The last level is a Gaussian level.
+ *
+ * @param image source image
+ * @param dst destination image holding the pyramid
+ * @param levels number of levels, must be positive
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_laplacian_pyramid(Image* image, Image** dst, int levels);
+
+
+/**
+ * Reconstructs an image from its Laplacian pyramid.
+ *
+ * @param levels levels of a Laplacian pyramid, all of the same 32f metatype, each one of pyramid_next_size of the previous one
+ * @param count number of levels, must be positive
+ * @param dst destination image of 32f metatype
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_laplacian_reconstruct(Image** levels, int count, Image** dst);
+
+
+/**
+ * Remaps the given image using a remap plan.
+ *
+ * @param image source image, must match plan source size and metatype
+ * @param dst destination image, must match plan destination size and metatype, and must not share data with the source
+ * @param plan remap plan
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_remap_plan(Image* image, Image* dst, RemapPlan* plan);
+
+
+/**
+ * Remaps the given image using a remap plan.
+ *
+ * @param image source image, must match plan source size and metatype
+ * @param dst destination image
+ * @param plan remap plan
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_remap_plan_copy(Image* image, Image** dst, RemapPlan* plan);
+
+
+/**
+ * Applies a projective transform to the given image.
+ *
+ * @param image source image
+ * @param dst destination image
+ * @param dstSize size of destination image
+ * @param coeffs 3x3 row-major matrix of a transform from source to destination coordinates
+ * @param interp interpolation mode
+ * @param border border mode
+ * @returns ippStsNoErr if everything went OK, ippStsCoeffErr if the transform is singular, non-zero error code otherwise
+ */
+int image_warp_copy(Image* image, Image** dst, IppiSize dstSize, const double* coeffs, InterpMode interp, BorderMode border);
+
+
+/**
+ * Creates a remap plan from a pair of coordinate map images.
+ *
+ * @param dst pointer to the newly created plan
+ * @param srcSize size of a source image
+ * @param metaType metatype of source and destination images
+ * @param mapX source x coordinates, 32f_C1 image of destination size
+ * @param mapY source y coordinates, 32f_C1 image of destination size
+ * @param interp interpolation mode
+ * @param border border mode
+ * @param format format of maps to store in the plan
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_remap_plan_new(RemapPlan** dst, IppiSize srcSize, IppMetaType metaType, Image* mapX, Image* mapY, InterpMode interp, BorderMode border, RemapMapFormat format);
+
+
+/**
+ * Remaps the given image using a pair of coordinate map images. <br>
+ * Since the destination image is newly created, BORDER_TRANSPARENT leaves zeros, the same way as BORDER_CONSTANT.
+ *
+ * @param image source image
+ * @param dst destination image of the maps size
+ * @param mapX source x coordinates, 32f_C1 image
+ * @param mapY source y coordinates, 32f_C1 image of the same size
+ * @param interp interpolation mode
+ * @param border border mode
  * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
  */
-int image_resize_copy(Image* image, Image** dst, IppiSize newSize);
+int image_remap_copy(Image* image, Image** dst, Image* mapX, Image* mapY, InterpMode interp, BorderMode border);
 
 
 /**
@@ -560,6 +787,119 @@ int image_mirror(Image* image, IppiAxis axis);
 int image_mirror_copy(Image* image, Image** dst, IppiAxis axis);
 
 
+/**
+ * Applies a right-angle rotation or a flip to the given image in place. Transforms that swap axes are supported for square images only.
+ *
+ * @param image source image
+ * @param orientation transform to apply
+ * @returns ippStsNoErr if everything went OK, ippStsSizeErr if the transform swaps axes of a non-square image, non-zero error or warning code otherwise
+ */
+int image_orient(Image* image, Orientation orientation);
+
+
+/**
+ * Applies a right-angle rotation or a flip to the given image.
+ *
+ * @param image source image
+ * @param dst destination image
+ * @param orientation transform to apply
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_orient_copy(Image* image, Image** dst, Orientation orientation);
+
+
+/**
+ * Maps pixel values of an image through a lookup table. In the four-channel image the alpha channel is not processed.
+ *
+ * @param image source image
+ * @param lut lookup table
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_apply_lut(Image* image, Lut* lut);
+
+
+/**
+ * Maps pixel values of an image through a lookup table. In the four-channel image the alpha channel is not processed.
+ *
+ * @param image source image
+ * @param dst destination image
+ * @param lut lookup table
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_apply_lut_copy(Image* image, Image** dst, Lut* lut);
+
+
+/**
+ * Performs an arithmetic operation on two images of the same size. The second image is converted to the metatype of the first one if needed.
+ *
+ * @param image first operand and destination image
+ * @param other second operand
+ * @param op operation to perform
+ * @param weights weights for ARITH_ADDWEIGHTED, ignored for other operations
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_arith(Image* image, Image* other, ArithOp op, const IppMetaNumber* weights);
+
+
+/**
+ * Performs an arithmetic operation on two images of the same size. The second image is converted to the metatype of the first one if needed.
+ *
+ * @param image first operand
+ * @param dst destination image
+ * @param other second operand
+ * @param op operation to perform
+ * @param weights weights for ARITH_ADDWEIGHTED, ignored for other operations
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_arith_copy(Image* image, Image** dst, Image* other, ArithOp op, const IppMetaNumber* weights);
+
+
+/**
+ * Performs an arithmetic operation on an image and a constant color.
+ *
+ * @param image first operand and destination image
+ * @param color second operand
+ * @param op operation to perform
+ * @param weights weights for ARITH_ADDWEIGHTED, ignored for other operations
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_arith_c(Image* image, Color* color, ArithOp op, const IppMetaNumber* weights);
+
+
+/**
+ * Performs an arithmetic operation on an image and a constant color.
+ *
+ * @param image first operand
+ * @param dst destination image
+ * @param color second operand
+ * @param op operation to perform
+ * @param weights weights for ARITH_ADDWEIGHTED, ignored for other operations
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_arith_c_copy(Image* image, Image** dst, Color* color, ArithOp op, const IppMetaNumber* weights);
+
+
+/**
+ * Composites one image over another of the same size using the alpha channel of the source image. Source is converted to four-channel metatype if needed.
+ *
+ * @param image background and destination image
+ * @param src source image
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_alpha_composite(Image* image, Image* src);
+
+
+/**
+ * Composites one image over another of the same size using the alpha channel of the source image. Source is converted to four-channel metatype if needed.
+ *
+ * @param image background image
+ * @param dst destination image
+ * @param src source image
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int image_alpha_composite_copy(Image* image, Image** dst, Image* src);
+
+
 /**
  * Auxiliary function, returns textual description of an image_* error or warning. Don't try to deallocate the return value!
  * 
@@ -310,11 +310,11 @@ VALUE rb_ColorRef_a_eq(VALUE self, VALUE val);
   ARX_ARRAY_FOREACH(ARX_INDEX_ARRAY(SLOTS), USING_M2C_COLOR_D, ~)               \
   ARX_ARRAY_FOREACH(ARX_INDEX_ARRAY(SLOTS), USING_M2C_COLOR_U, ~)
 #define USING_M2C_COLOR_D(SLOT, ARGS)                                           \
-  ARX_ARRAY_FOREACH(D_SUPPORTED, USING_M2C_COLOR_DI, SLOT)
+  ARX_ARRAY_FOREACH(D_ALL, USING_M2C_COLOR_DI, SLOT)
 #define USING_M2C_COLOR_DI(DATATYPE, SLOT)                                      \
   IF_D_EQ_D(DATATYPE, D_METANUM, ARX_EMPTY(), D_CTYPE(DATATYPE) M2C_COLOR_STORAGE(DATATYPE, SLOT)[C_MAX_COUNT];)
 #define USING_M2C_COLOR_U(SLOT, ARGS)                                           \
-  ARX_ARRAY_FOREACH(D_SUPPORTED, USING_M2C_COLOR_UI, SLOT)
+  ARX_ARRAY_FOREACH(D_ALL, USING_M2C_COLOR_UI, SLOT)
 #define USING_M2C_COLOR_UI(DATATYPE, SLOT)                                      \
   IF_D_EQ_D(DATATYPE, D_METANUM, ARX_EMPTY(), (void) M2C_COLOR_STORAGE(DATATYPE, SLOT);) /* just to make the compiler happy */
 
@@ -0,0 +1,930 @@
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+#include "ipp4r.h"
+
+
+// -------------------------------------------------------------------------- //
+// Defines
+// -------------------------------------------------------------------------- //
+#define COLORSPACE_M_SUPPORTED (18, (8u_C3, 8u_AC4, 8u_C4, 16u_C3, 16u_AC4, 16u_C4, 32f_C3, 32f_AC4, 32f_C4, 16s_C3, 16s_AC4, 16s_C4, 32s_C3, 32s_AC4, 32s_C4, 64f_C3, 64f_AC4, 64f_C4))
+
+#define COLORSPACE_GAMMA_LEVELS 1024  /**< Number of intervals in sRGB decoding table */
+
+#define COLORSPACE_Q_BITS 14
+#define COLORSPACE_Q(X) ((int) ((X) * (1 << COLORSPACE_Q_BITS) + 0.5))
+#define COLORSPACE_Q_ROUND(V) (((V) + (1 << (COLORSPACE_Q_BITS - 1))) >> COLORSPACE_Q_BITS)
+#define COLORSPACE_CLAMP_8u(V) ((Ipp8u) ((V) < 0 ? 0 : (V) > 255 ? 255 : (V)))
+
+/* D65 white point */
+#define COLORSPACE_XN 0.950456f
+#define COLORSPACE_ZN 1.088754f
+
+/* Lab companding threshold, (6 / 29)^3 */
+#define COLORSPACE_LAB_EPSILON 0.008856452f
+
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/** Reads n pixels into a buffer of (r, g, b, a) float quads */
+typedef void (*ColorspaceLoadFunc)(const void* pSrc, Ipp32f* buf, int n);
+
+/** Writes n pixels from a buffer of (r, g, b, a) float quads */
+typedef void (*ColorspaceStoreFunc)(const Ipp32f* buf, void* pDst, int n);
+
+/** Converts n (r, g, b, a) float quads in place */
+typedef void (*ColorspaceFunc)(Ipp32f* buf, int n);
+
+
+// -------------------------------------------------------------------------- //
+// Chunk load / store kernels
+// -------------------------------------------------------------------------- //
+#define COLORSPACE_SAT_8u(V)  ((Ipp8u) ((V) >= 1.0f ? 255 : (V) > 0.0f ? (int) ((V) * 255.0f + 0.5f) : 0))
+#define COLORSPACE_SAT_16u(V) ((Ipp16u) ((V) >= 1.0f ? 65535 : (V) > 0.0f ? (int) ((V) * 65535.0f + 0.5f) : 0))
+#define COLORSPACE_SAT_32f(V) (V)
+#define COLORSPACE_SAT_16s(V) ((Ipp16s) ((V) >= 1.0f ? 32767 : (V) > -1.0f ? (int) floor((V) * 32767.0f + 0.5f) : -32768))
+#define COLORSPACE_SAT_32s(V) ((Ipp32s) ((V) >= 1.0f ? 2147483647 : (V) > -1.0f ? (Ipp32s) floor((V) * 2147483647.0 + 0.5) : -2147483647 - 1))
+#define COLORSPACE_SAT_64f(V) (V)
+#define COLORSPACE_SAT(D, V) ARX_JOIN(COLORSPACE_SAT_, D)(V)
+
+/* Pixel slots are in BGR order, buffer quads are in RGB order. */
+#define COLORSPACE_LOAD_ALPHA_C3(S, B, K)  (B)[3] = 1.0f;
+#define COLORSPACE_LOAD_ALPHA_AC4(S, B, K) (B)[3] = (S)[3] * (K);
+#define COLORSPACE_LOAD_ALPHA_C4(S, B, K)  COLORSPACE_LOAD_ALPHA_AC4(S, B, K)
+#define COLORSPACE_STORE_ALPHA_C3(B, S, D)
+#define COLORSPACE_STORE_ALPHA_AC4(B, S, D) (S)[3] = COLORSPACE_SAT(D, (B)[3]);
+#define COLORSPACE_STORE_ALPHA_C4(B, S, D)  COLORSPACE_STORE_ALPHA_AC4(B, S, D)
+
+/**
+ * Defines <tt>colorspace_load_DATATYPE_CHANNELSR</tt> and <tt>colorspace_store_DATATYPE_CHANNELSR</tt>.
+ */
+#define DEFINE_COLORSPACE_LOADSTORE(METATYPE, ARG)                              \
+  DEFINE_COLORSPACE_LOADSTORE_I(M_DATATYPE(METATYPE), M_CHANNELS(METATYPE), D_CTYPE(M_DATATYPE(METATYPE)), C_CNUMB(M_CHANNELS(METATYPE)))
+#define DEFINE_COLORSPACE_LOADSTORE_I(D, C, CTYPE, CNUMB)                       \
+static void ARX_JOIN_5(colorspace_load_, D, _, C, R)(const void* pSrc, Ipp32f* buf, int n) { \
+  const CTYPE* s = (const CTYPE*) pSrc;                                         \
+  const Ipp32f k = 1.0f / D_SCALE(D);                                           \
+  int i;                                                                        \
+                                                                                \
+  for(i = 0; i < n; i++, s += CNUMB, buf += 4) {                                \
+    buf[0] = s[2] * k;                                                          \
+    buf[1] = s[1] * k;                                                          \
+    buf[2] = s[0] * k;                                                          \
+    ARX_JOIN(COLORSPACE_LOAD_ALPHA_, C)(s, buf, k)                              \
+  }                                                                             \
+}                                                                               \
+                                                                                \
+static void ARX_JOIN_5(colorspace_store_, D, _, C, R)(const Ipp32f* buf, void* pDst, int n) { \
+  CTYPE* d = (CTYPE*) pDst;                                                     \
+  int i;                                                                        \
+                                                                                \
+  for(i = 0; i < n; i++, d += CNUMB, buf += 4) {                                \
+    d[2] = COLORSPACE_SAT(D, buf[0]);                                           \
+    d[1] = COLORSPACE_SAT(D, buf[1]);                                           \
+    d[0] = COLORSPACE_SAT(D, buf[2]);                                           \
+    ARX_JOIN(COLORSPACE_STORE_ALPHA_, C)(buf, d, D)                             \
+  }                                                                             \
+}
+
+/* Kernel arrays are defined over M_SUPPORTED, single-channel metatypes have no kernels. */
+#define COLORSPACE_LOAD_KERNEL(M, ARG) IF_M_IS_C(M, C1, NULL, ARX_JOIN_5(colorspace_load_, M_DATATYPE(M), _, M_CHANNELS(M), R))
+#define COLORSPACE_STORE_KERNEL(M, ARG) IF_M_IS_C(M, C1, NULL, ARX_JOIN_5(colorspace_store_, M_DATATYPE(M), _, M_CHANNELS(M), R))
+
+ARX_ARRAY_FOREACH(COLORSPACE_M_SUPPORTED, DEFINE_COLORSPACE_LOADSTORE, ~)
+DEFINE_DISPATCH_KERNELS(colorspace_load_kernels_generic, M_SUPPORTED, COLORSPACE_LOAD_KERNEL, ~)
+DEFINE_DISPATCH_KERNELS(colorspace_store_kernels_generic, M_SUPPORTED, COLORSPACE_STORE_KERNEL, ~)
+
+DEFINE_DISPATCH_TABLE(colorspace_load_table, "colorspace_load", colorspace_load_kernels)
+DEFINE_DISPATCH_TABLE(colorspace_store_table, "colorspace_store", colorspace_store_kernels)
+
+
+// -------------------------------------------------------------------------- //
+// sRGB companding
+// -------------------------------------------------------------------------- //
+static Ipp32f colorspace_linear_table[COLORSPACE_GAMMA_LEVELS + 2];
+static int colorspace_tables_ready = FALSE;
+
+
+/**
+ * Decodes an sRGB component.
+ */
+static Ipp32f colorspace_srgb_to_linear(Ipp32f v) {
+  return v <= 0.04045f ? v / 12.92f : (Ipp32f) pow((v + 0.055f) / 1.055f, 2.4);
+}
+
+
+/**
+ * Encodes a linear component to sRGB.
+ */
+static Ipp32f colorspace_linear_to_srgb(Ipp32f v) {
+  return v <= 0.0031308f ? v * 12.92f : 1.055f * (Ipp32f) pow(v, 1.0 / 2.4) - 0.055f;
+}
+
+
+/**
+ * Fills sRGB decoding table. Must be called before going parallel.
+ */
+static void colorspace_init_tables(void) {
+  int i;
+
+  if(colorspace_tables_ready)
+    return;
+
+  for(i = 0; i <= COLORSPACE_GAMMA_LEVELS; i++)
+    colorspace_linear_table[i] = colorspace_srgb_to_linear((Ipp32f) i / COLORSPACE_GAMMA_LEVELS);
+  colorspace_linear_table[COLORSPACE_GAMMA_LEVELS + 1] = colorspace_linear_table[COLORSPACE_GAMMA_LEVELS]; /* guard for interpolation at 1.0 */
+
+  colorspace_tables_ready = TRUE;
+}
+
+
+/**
+ * Decodes an sRGB component using the table, values outside of [0, 1] are decoded exactly.
+ */
+static Ipp32f colorspace_decode(Ipp32f v) {
+  Ipp32f x, f;
+  int i;
+
+  if(!(v >= 0.0f && v <= 1.0f))
+    return v < 0.0f ? v / 12.92f : colorspace_srgb_to_linear(v); /* also passes NaN through */
+
+  x = v * COLORSPACE_GAMMA_LEVELS;
+  i = (int) x;
+  f = x - i;
+  return colorspace_linear_table[i] + f * (colorspace_linear_table[i + 1] - colorspace_linear_table[i]);
+}
+
+
+// -------------------------------------------------------------------------- //
+// Float color space kernels
+// -------------------------------------------------------------------------- //
+/**
+ * Computes hue as a fraction of a full turn, given rgb, maximal component and the range of components.
+ */
+static Ipp32f colorspace_hue(Ipp32f r, Ipp32f g, Ipp32f b, Ipp32f max, Ipp32f delta) {
+  Ipp32f h;
+
+  if(delta <= 0.0f)
+    return 0.0f;
+
+  if(max == r)
+    h = (g - b) / delta;
+  else if(max == g)
+    h = (b - r) / delta + 2.0f;
+  else
+    h = (r - g) / delta + 4.0f;
+
+  h /= 6.0f;
+  return h < 0.0f ? h + 1.0f : h;
+}
+
+
+/**
+ * Converts hue, chroma and an offset back to rgb.
+ */
+static void colorspace_hue_to_rgb(Ipp32f* p, Ipp32f h, Ipp32f c, Ipp32f m) {
+  Ipp32f h6, x;
+  int sector;
+
+  h6 = (h - (Ipp32f) floor(h)) * 6.0f;
+  sector = min((int) h6, 5);
+  x = c * (1.0f - (Ipp32f) fabs(fmod(h6, 2.0f) - 1.0f));
+
+  switch(sector) {
+  case 0:  p[0] = c; p[1] = x; p[2] = 0; break;
+  case 1:  p[0] = x; p[1] = c; p[2] = 0; break;
+  case 2:  p[0] = 0; p[1] = c; p[2] = x; break;
+  case 3:  p[0] = 0; p[1] = x; p[2] = c; break;
+  case 4:  p[0] = x; p[1] = 0; p[2] = c; break;
+  default: p[0] = c; p[1] = 0; p[2] = x; break;
+  }
+
+  p[0] += m;
+  p[1] += m;
+  p[2] += m;
+}
+
+
+static void colorspace_rgb_to_hsv(Ipp32f* buf, int n) {
+  Ipp32f mx, mn;
+  int i;
+
+  for(i = 0; i < n; i++, buf += 4) {
+    mx = max(buf[0], max(buf[1], buf[2]));
+    mn = min(buf[0], min(buf[1], buf[2]));
+    buf[0] = colorspace_hue(buf[0], buf[1], buf[2], mx, mx - mn);
+    buf[1] = mx > 0.0f ? (mx - mn) / mx : 0.0f;
+    buf[2] = mx;
+  }
+}
+
+
+static void colorspace_hsv_to_rgb(Ipp32f* buf, int n) {
+  Ipp32f c;
+  int i;
+
+  for(i = 0; i < n; i++, buf += 4) {
+    c = buf[2] * buf[1];
+    colorspace_hue_to_rgb(buf, buf[0], c, buf[2] - c);
+  }
+}
+
+
+static void colorspace_rgb_to_hls(Ipp32f* buf, int n) {
+  Ipp32f mx, mn, l, d;
+  int i;
+
+  for(i = 0; i < n; i++, buf += 4) {
+    mx = max(buf[0], max(buf[1], buf[2]));
+    mn = min(buf[0], min(buf[1], buf[2]));
+    l = (mx + mn) * 0.5f;
+    d = 1.0f - (Ipp32f) fabs(2.0f * l - 1.0f);
+    buf[0] = colorspace_hue(buf[0], buf[1], buf[2], mx, mx - mn);
+    buf[2] = d > 0.0f ? (mx - mn) / d : 0.0f;
+    buf[1] = l;
+  }
+}
+
+
+static void colorspace_hls_to_rgb(Ipp32f* buf, int n) {
+  Ipp32f c;
+  int i;
+
+  for(i = 0; i < n; i++, buf += 4) {
+    c = (1.0f - (Ipp32f) fabs(2.0f * buf[1] - 1.0f)) * buf[2];
+    colorspace_hue_to_rgb(buf, buf[0], c, buf[1] - c * 0.5f);
+  }
+}
+
+
+static void colorspace_rgb_to_ycbcr(Ipp32f* buf, int n) {
+  Ipp32f y;
+  int i;
+
+  for(i = 0; i < n; i++, buf += 4) {
+    y = 0.299f * buf[0] + 0.587f * buf[1] + 0.114f * buf[2];
+    buf[1] = (buf[2] - y) * (1.0f / 1.772f) + 0.5f;
+    buf[2] = (buf[0] - y) * (1.0f / 1.402f) + 0.5f;
+    buf[0] = y;
+  }
+}
+
+
+static void colorspace_ycbcr_to_rgb(Ipp32f* buf, int n) {
+  Ipp32f y, cb, cr;
+  int i;
+
+  for(i = 0; i < n; i++, buf += 4) {
+    y = buf[0];
+    cb = buf[1] - 0.5f;
+    cr = buf[2] - 0.5f;
+    buf[0] = y + 1.402f * cr;
+    buf[1] = y - 0.344136f * cb - 0.714136f * cr;
+    buf[2] = y + 1.772f * cb;
+  }
+}
+
+
+static void colorspace_rgb_to_xyz(Ipp32f* buf, int n) {
+  Ipp32f r, g, b;
+  int i;
+
+  for(i = 0; i < n; i++, buf += 4) {
+    r = colorspace_decode(buf[0]);
+    g = colorspace_decode(buf[1]);
+    b = colorspace_decode(buf[2]);
+    buf[0] = (0.4124564f * r + 0.3575761f * g + 0.1804375f * b) * (1.0f / COLORSPACE_XN);
+    buf[1] =  0.2126729f * r + 0.7151522f * g + 0.0721750f * b;
+    buf[2] = (0.0193339f * r + 0.1191920f * g + 0.9503041f * b) * (1.0f / COLORSPACE_ZN);
+  }
+}
+
+
+static void colorspace_xyz_to_rgb(Ipp32f* buf, int n) {
+  Ipp32f x, y, z;
+  int i;
+
+  for(i = 0; i < n; i++, buf += 4) {
+    x = buf[0] * COLORSPACE_XN;
+    y = buf[1];
+    z = buf[2] * COLORSPACE_ZN;
+    buf[0] = colorspace_linear_to_srgb( 3.2404542f * x - 1.5371385f * y - 0.4985314f * z);
+    buf[1] = colorspace_linear_to_srgb(-0.9692660f * x + 1.8760108f * y + 0.0415560f * z);
+    buf[2] = colorspace_linear_to_srgb( 0.0556434f * x - 0.2040259f * y + 1.0572252f * z);
+  }
+}
+
+
+/**
+ * Lab companding function.
+ */
+static Ipp32f colorspace_lab_f(Ipp32f t) {
+  return t > COLORSPACE_LAB_EPSILON ? (Ipp32f) pow(t, 1.0 / 3.0) : t * (841.0f / 108.0f) + 4.0f / 29.0f;
+}
+
+
+/**
+ * Inverse of colorspace_lab_f.
+ */
+static Ipp32f colorspace_lab_f_inv(Ipp32f f) {
+  return f > 6.0f / 29.0f ? f * f * f : (f - 4.0f / 29.0f) * (108.0f / 841.0f);
+}
+
+
+static void colorspace_rgb_to_lab(Ipp32f* buf, int n) {
+  Ipp32f fx, fy, fz;
+  int i;
+
+  colorspace_rgb_to_xyz(buf, n);
+
+  for(i = 0; i < n; i++, buf += 4) {
+    fx = colorspace_lab_f(buf[0]);
+    fy = colorspace_lab_f(buf[1]);
+    fz = colorspace_lab_f(buf[2]);
+    buf[0] = (116.0f * fy - 16.0f) * (1.0f / 100.0f);
+    buf[1] = (500.0f * (fx - fy) + 128.0f) * (1.0f / 255.0f);
+    buf[2] = (200.0f * (fy - fz) + 128.0f) * (1.0f / 255.0f);
+  }
+}
+
+
+static void colorspace_lab_to_rgb(Ipp32f* buf, int n) {
+  Ipp32f* p;
+  Ipp32f fx, fy, fz;
+  int i;
+
+  for(i = 0, p = buf; i < n; i++, p += 4) {
+    fy = (p[0] * 100.0f + 16.0f) * (1.0f / 116.0f);
+    fx = fy + (p[1] * 255.0f - 128.0f) * (1.0f / 500.0f);
+    fz = fy - (p[2] * 255.0f - 128.0f) * (1.0f / 200.0f);
+    p[0] = colorspace_lab_f_inv(fx);
+    p[1] = colorspace_lab_f_inv(fy);
+    p[2] = colorspace_lab_f_inv(fz);
+  }
+
+  colorspace_xyz_to_rgb(buf, n);
+}
+
+
+/** Conversions from RGB, indexed by ColorSpace */
+static const ColorspaceFunc colorspace_from_rgb[] = {
+  NULL, colorspace_rgb_to_hsv, colorspace_rgb_to_hls, colorspace_rgb_to_ycbcr, colorspace_rgb_to_lab, colorspace_rgb_to_xyz
+};
+
+/** Conversions to RGB, indexed by ColorSpace */
+static const ColorspaceFunc colorspace_to_rgb[] = {
+  NULL, colorspace_hsv_to_rgb, colorspace_hls_to_rgb, colorspace_ycbcr_to_rgb, colorspace_lab_to_rgb, colorspace_xyz_to_rgb
+};
+
+
+// -------------------------------------------------------------------------- //
+// Fixed-point 8u kernels
+// -------------------------------------------------------------------------- //
+/** Converts rows [yStart, yEnd) of 8u RGB to full-range YCbCr or back, dstCn is the number of channels of destination pixels */
+typedef void (*ColorspaceYcbcrFunc)(const Ipp8u* pSrc, int srcStep, Ipp8u* pDst, int dstStep, int dstCn, int width, int yStart, int yEnd);
+
+/* Shift of byte I of a 4-channel 8u pixel loaded as a 32-bit word */
+#ifdef WORDS_BIGENDIAN
+#  define COLORSPACE_BYTE_SHIFT(I) (8 * (3 - (I)))
+#else
+#  define COLORSPACE_BYTE_SHIFT(I) (8 * (I))
+#endif
+
+/**
+ * Loads 8u pixel X of row S into B, G, R and alpha A, which is 255 for 3-channel pixels.
+ * 4-channel pixels are loaded as 32-bit words and split with shifts, which vectorizes where loads of interleaved bytes don't.
+ */
+#define COLORSPACE_LOAD_8u_C3(S, X, B, G, R, A)                                 \
+  {                                                                             \
+    B = (S)[3 * (X)];                                                           \
+    G = (S)[3 * (X) + 1];                                                       \
+    R = (S)[3 * (X) + 2];                                                       \
+    A = 255;                                                                    \
+  }
+#define COLORSPACE_LOAD_8u_AC4(S, X, B, G, R, A)                                \
+  {                                                                             \
+    Ipp32u p_;                                                                  \
+    memcpy(&p_, (S) + 4 * (X), 4);                                              \
+    B = (p_ >> COLORSPACE_BYTE_SHIFT(0)) & 0xFF;                                \
+    G = (p_ >> COLORSPACE_BYTE_SHIFT(1)) & 0xFF;                                \
+    R = (p_ >> COLORSPACE_BYTE_SHIFT(2)) & 0xFF;                                \
+    A = (p_ >> COLORSPACE_BYTE_SHIFT(3)) & 0xFF;                                \
+  }
+#define COLORSPACE_LOAD_8u_C4(S, X, B, G, R, A) COLORSPACE_LOAD_8u_AC4(S, X, B, G, R, A)
+
+/**
+ * Stores B, G, R and alpha A into 8u pixel X of row D, alpha is dropped for 3-channel pixels.
+ */
+#define COLORSPACE_STORE_8u_C3(D, X, B, G, R, A)                                \
+  {                                                                             \
+    (D)[3 * (X)] = (B);                                                         \
+    (D)[3 * (X) + 1] = (G);                                                     \
+    (D)[3 * (X) + 2] = (R);                                                     \
+  }
+#define COLORSPACE_STORE_8u_AC4(D, X, B, G, R, A)                               \
+  {                                                                             \
+    Ipp32u p_ = (Ipp32u) (B) << COLORSPACE_BYTE_SHIFT(0) | (Ipp32u) (G) << COLORSPACE_BYTE_SHIFT(1) | \
+                (Ipp32u) (R) << COLORSPACE_BYTE_SHIFT(2) | (Ipp32u) (A) << COLORSPACE_BYTE_SHIFT(3); \
+    memcpy((D) + 4 * (X), &p_, 4);                                              \
+  }
+#define COLORSPACE_STORE_8u_C4(D, X, B, G, R, A) COLORSPACE_STORE_8u_AC4(D, X, B, G, R, A)
+
+/* Names of fixed-point kernels */
+#define COLORSPACE_8u_KERNEL_NAME(OP, C, TIER) ARX_JOIN_3(ARX_JOIN_5(colorspace_, OP, _8u_, C, R), _, TIER)
+
+/* Tiers that pay off for fixed-point kernels of an operation and an RGB pixel layout, measured on 2048x256 images.
+ * YCbCr rows vectorize from SSE4.1 up, except for RGB to YCbCr from 3-channel pixels, which is no faster than scalar code.
+ * Only the luma loop of RGB to YUV 4:2:0 vectorizes, and gains nothing from AVX-512, the other way round nothing does. */
+#define COLORSPACE_8u_TIERS_to_ycbcr_C3     (1, (generic))
+#define COLORSPACE_8u_TIERS_to_ycbcr_AC4    (4, (generic, sse4, avx2, avx512))
+#define COLORSPACE_8u_TIERS_to_ycbcr_C4     (4, (generic, sse4, avx2, avx512))
+#define COLORSPACE_8u_TIERS_from_ycbcr_C3   (4, (generic, sse4, avx2, avx512))
+#define COLORSPACE_8u_TIERS_from_ycbcr_AC4  (4, (generic, sse4, avx2, avx512))
+#define COLORSPACE_8u_TIERS_from_ycbcr_C4   (4, (generic, sse4, avx2, avx512))
+#define COLORSPACE_8u_TIERS_to_yuv420_C3    (3, (generic, sse4, avx2))
+#define COLORSPACE_8u_TIERS_to_yuv420_AC4   (3, (generic, sse4, avx2))
+#define COLORSPACE_8u_TIERS_to_yuv420_C4    (3, (generic, sse4, avx2))
+#define COLORSPACE_8u_TIERS_from_yuv420_C3  (1, (generic))
+#define COLORSPACE_8u_TIERS_from_yuv420_AC4 (1, (generic))
+#define COLORSPACE_8u_TIERS_from_yuv420_C4  (1, (generic))
+#define COLORSPACE_8u_TIERS(OP, C) ARX_JOIN_4(COLORSPACE_8u_TIERS_, OP, _, C)
+
+/**
+ * Converts a row of 8u RGB pixels of layout SC at s to full-range YCbCr pixels of layout DC at d.
+ */
+#define COLORSPACE_TO_YCBCR_ROW(SC, DC)                                         \
+  for(x = 0; x < width; x++) {                                                  \
+    ARX_JOIN(COLORSPACE_LOAD_8u_, SC)(s, x, b, g, r, a)                         \
+    l = COLORSPACE_Q_ROUND(COLORSPACE_Q(0.299) * r + COLORSPACE_Q(0.587) * g + COLORSPACE_Q(0.114) * b); \
+    cb = 128 + COLORSPACE_Q_ROUND(COLORSPACE_Q(1.0 / 1.772) * (b - l));         \
+    cr = 128 + COLORSPACE_Q_ROUND(COLORSPACE_Q(1.0 / 1.402) * (r - l));         \
+    ARX_JOIN(COLORSPACE_STORE_8u_, DC)(d, x, COLORSPACE_CLAMP_8u(cr), COLORSPACE_CLAMP_8u(cb), COLORSPACE_CLAMP_8u(l), a) \
+  }
+
+/**
+ * Converts a row of 8u full-range YCbCr pixels of layout SC at s to RGB pixels of layout DC at d.
+ */
+#define COLORSPACE_FROM_YCBCR_ROW(SC, DC)                                       \
+  for(x = 0; x < width; x++) {                                                  \
+    ARX_JOIN(COLORSPACE_LOAD_8u_, SC)(s, x, cr, cb, l, a)                       \
+    cb -= 128;                                                                  \
+    cr -= 128;                                                                  \
+    r = l + COLORSPACE_Q_ROUND(COLORSPACE_Q(1.402) * cr);                       \
+    g = l - COLORSPACE_Q_ROUND(COLORSPACE_Q(0.344136) * cb + COLORSPACE_Q(0.714136) * cr); \
+    b = l + COLORSPACE_Q_ROUND(COLORSPACE_Q(1.772) * cb);                       \
+    ARX_JOIN(COLORSPACE_STORE_8u_, DC)(d, x, COLORSPACE_CLAMP_8u(b), COLORSPACE_CLAMP_8u(g), COLORSPACE_CLAMP_8u(r), a) \
+  }
+
+/**
+ * Defines fixed-point kernel <tt>colorspace_OP_8u_CHANNELSR_TIER</tt> for rgb pixels of CHANNELS layout, if TIER is listed for the operation and the layout.
+ */
+#define DEFINE_COLORSPACE_8u_KERNEL(OP, C, TIER)                                \
+  ARX_IF(DISPATCH_HAS_TIER(COLORSPACE_8u_TIERS(OP, C), TIER), ARX_JOIN(DEFINE_COLORSPACE_8u_KERNEL_, OP), ARX_TUPLE_EAT_2)(C, TIER)
+
+
+/**
+ * Kernels of ColorspaceYcbcrFunc type for source pixels of layout C. Loops over destination layouts are separate, so that both pixel sizes are constant in them.
+ */
+#define DEFINE_COLORSPACE_8u_KERNEL_to_ycbcr(C, TIER) DEFINE_COLORSPACE_YCBCR_KERNEL(to_ycbcr, COLORSPACE_TO_YCBCR_ROW, C, TIER)
+#define DEFINE_COLORSPACE_8u_KERNEL_from_ycbcr(C, TIER) DEFINE_COLORSPACE_YCBCR_KERNEL(from_ycbcr, COLORSPACE_FROM_YCBCR_ROW, C, TIER)
+#define DEFINE_COLORSPACE_YCBCR_KERNEL(OP, ROW, C, TIER)                        \
+DISPATCH_TARGET(TIER) static void COLORSPACE_8u_KERNEL_NAME(OP, C, TIER)(const Ipp8u* pSrc, int srcStep, Ipp8u* pDst, int dstStep, int dstCn, int width, int yStart, int yEnd) { \
+  const Ipp8u* s;                                                               \
+  Ipp8u* d;                                                                     \
+  int x, y, r, g, b, a, l, cb, cr;                                              \
+                                                                                \
+  for(y = yStart; y < yEnd; y++) {                                              \
+    s = pSrc + y * srcStep;                                                     \
+    d = pDst + y * dstStep;                                                     \
+    if(dstCn == 3) {                                                            \
+      ROW(C, C3)                                                                \
+    } else {                                                                    \
+      ROW(C, C4)                                                                \
+    }                                                                           \
+  }                                                                             \
+}
+
+
+/* Limited-range BT.601 */
+#define COLORSPACE_VY(R, G, B)  (16  + COLORSPACE_Q_ROUND( COLORSPACE_Q(0.256788) * (R) + COLORSPACE_Q(0.504129) * (G) + COLORSPACE_Q(0.097906) * (B)))
+#define COLORSPACE_VCB(R, G, B) (128 + COLORSPACE_Q_ROUND(-COLORSPACE_Q(0.148223) * (R) - COLORSPACE_Q(0.290993) * (G) + COLORSPACE_Q(0.439216) * (B)))
+#define COLORSPACE_VCR(R, G, B) (128 + COLORSPACE_Q_ROUND( COLORSPACE_Q(0.439216) * (R) - COLORSPACE_Q(0.367788) * (G) - COLORSPACE_Q(0.071427) * (B)))
+
+
+/**
+ * Layout of a YUV 4:2:0 buffer: pointers to the first U and V samples and the distance between horizontally adjacent chroma samples.
+ */
+typedef struct {
+  Ipp8u* y;
+  Ipp8u* u;
+  Ipp8u* v;
+  int chromaStride;
+  int chromaStep;
+} Yuv420Planes;
+
+/** Converts chroma rows [cyStart, cyEnd) of an rgb image and the corresponding luma rows to YUV 4:2:0 */
+typedef void (*ColorspaceToYuv420Func)(const Yuv420Planes* planes, const Ipp8u* pSrc, int srcStep, IppiSize size, int cyStart, int cyEnd);
+
+/** Converts chroma rows [cyStart, cyEnd) of a YUV 4:2:0 buffer and the corresponding luma rows to rgb */
+typedef void (*ColorspaceFromYuv420Func)(const Yuv420Planes* planes, IppiSize size, Ipp8u* pDst, int dstStep, int cyStart, int cyEnd);
+
+
+/**
+ * Computes plane pointers for a YUV 4:2:0 buffer of the given size.
+ */
+static void colorspace_yuv420_planes(Yuv420Planes* planes, Yuv420Format format, const Ipp8u* p, IppiSize size) {
+  int cw, ch;
+  Ipp8u* c;
+
+  cw = (size.width + 1) / 2;
+  ch = (size.height + 1) / 2;
+  planes->y = (Ipp8u*) p;
+  c = (Ipp8u*) p + size.width * size.height;
+
+  switch(format) {
+  case YUV420_YV12:
+    planes->v = c;
+    planes->u = c + cw * ch;
+    planes->chromaStride = 1;
+    planes->chromaStep = cw;
+    break;
+  case YUV420_NV12:
+    planes->u = c;
+    planes->v = c + 1;
+    planes->chromaStride = 2;
+    planes->chromaStep = 2 * cw;
+    break;
+  case YUV420_NV21:
+    planes->v = c;
+    planes->u = c + 1;
+    planes->chromaStride = 2;
+    planes->chromaStep = 2 * cw;
+    break;
+  default:
+    planes->u = c;
+    planes->v = c + cw * ch;
+    planes->chromaStride = 1;
+    planes->chromaStep = cw;
+    break;
+  }
+}
+
+
+/**
+ * Kernel of ColorspaceToYuv420Func type for rgb pixels of layout C.
+ * Luma is computed row by row in a loop of its own, chroma of the average of each 2x2 block in a second one.
+ */
+#define DEFINE_COLORSPACE_8u_KERNEL_to_yuv420(C, TIER)                          \
+DISPATCH_TARGET(TIER) static void COLORSPACE_8u_KERNEL_NAME(to_yuv420, C, TIER)(const Yuv420Planes* planes, const Ipp8u* pSrc, int srcStep, IppiSize size, int cyStart, int cyEnd) { \
+  const Ipp8u* s[2];                                                            \
+  Ipp8u* py;                                                                    \
+  int cx, cy, x, i, j, rows, cols, r, g, b, a, rs, gs, bs, c;                   \
+                                                                                \
+  for(cy = cyStart; cy < cyEnd; cy++) {                                         \
+    rows = min(2, size.height - 2 * cy);                                        \
+    for(i = 0; i < rows; i++) {                                                 \
+      s[i] = pSrc + (2 * cy + i) * srcStep;                                     \
+      py = planes->y + (2 * cy + i) * size.width;                               \
+      for(x = 0; x < size.width; x++) {                                         \
+        ARX_JOIN(COLORSPACE_LOAD_8u_, C)(s[i], x, b, g, r, a)                   \
+        py[x] = COLORSPACE_CLAMP_8u(COLORSPACE_VY(r, g, b));                    \
+      }                                                                         \
+    }                                                                           \
+                                                                                \
+    for(cx = 0; cx * 2 < size.width; cx++) {                                    \
+      cols = min(2, size.width - 2 * cx);                                       \
+      rs = gs = bs = 0;                                                         \
+      for(i = 0; i < rows; i++) {                                               \
+        for(j = 0; j < cols; j++) {                                             \
+          ARX_JOIN(COLORSPACE_LOAD_8u_, C)(s[i], 2 * cx + j, b, g, r, a)        \
+          rs += r;                                                              \
+          gs += g;                                                              \
+          bs += b;                                                              \
+        }                                                                       \
+      }                                                                         \
+                                                                                \
+      (void) a;                                                                 \
+      /* Chroma is linear in rgb, so chroma of the average is the average of chroma. */ \
+      c = rows * cols;                                                          \
+      rs = (rs + c / 2) / c;                                                    \
+      gs = (gs + c / 2) / c;                                                    \
+      bs = (bs + c / 2) / c;                                                    \
+      planes->u[cy * planes->chromaStep + cx * planes->chromaStride] = COLORSPACE_CLAMP_8u(COLORSPACE_VCB(rs, gs, bs)); \
+      planes->v[cy * planes->chromaStep + cx * planes->chromaStride] = COLORSPACE_CLAMP_8u(COLORSPACE_VCR(rs, gs, bs)); \
+    }                                                                           \
+  }                                                                             \
+}
+
+
+/**
+ * Kernel of ColorspaceFromYuv420Func type for rgb pixels of layout C.
+ */
+#define DEFINE_COLORSPACE_8u_KERNEL_from_yuv420(C, TIER)                        \
+DISPATCH_TARGET(TIER) static void COLORSPACE_8u_KERNEL_NAME(from_yuv420, C, TIER)(const Yuv420Planes* planes, IppiSize size, Ipp8u* pDst, int dstStep, int cyStart, int cyEnd) { \
+  Ipp8u* d;                                                                     \
+  const Ipp8u* py;                                                              \
+  int cx, y, x, l, cb, cr, dr, dg, db;                                          \
+                                                                                \
+  for(y = 2 * cyStart; y < min(2 * cyEnd, size.height); y++) {                  \
+    d = pDst + y * dstStep;                                                     \
+    py = planes->y + y * size.width;                                            \
+    for(x = 0; x < size.width; x++) {                                           \
+      cx = x >> 1;                                                              \
+      cb = planes->u[(y >> 1) * planes->chromaStep + cx * planes->chromaStride] - 128; \
+      cr = planes->v[(y >> 1) * planes->chromaStep + cx * planes->chromaStride] - 128; \
+      dr = COLORSPACE_Q(1.596027) * cr;                                         \
+      dg = COLORSPACE_Q(0.391762) * cb + COLORSPACE_Q(0.812968) * cr;           \
+      db = COLORSPACE_Q(2.017232) * cb;                                         \
+      l = COLORSPACE_Q(1.164383) * (py[x] - 16);                                \
+      ARX_JOIN(COLORSPACE_STORE_8u_, C)(d, x, COLORSPACE_CLAMP_8u(COLORSPACE_Q_ROUND(l + db)), COLORSPACE_CLAMP_8u(COLORSPACE_Q_ROUND(l - dg)), \
+                                        COLORSPACE_CLAMP_8u(COLORSPACE_Q_ROUND(l + dr)), 255) \
+    }                                                                           \
+  }                                                                             \
+}
+
+
+/* Fixed-point kernel of metatype M, or NULL for anything but 3- and 4-channel 8u */
+#define COLORSPACE_8u_KERNEL(M, ARGS)                                           \
+  IF_M_IS_D(M, 8u, IF_M_IS_C(M, C1, COLORSPACE_8u_KERNEL_NULL, COLORSPACE_8u_KERNEL_I), COLORSPACE_8u_KERNEL_NULL)(M, ARX_TUPLE_ELEM(2, 0, ARGS), ARX_TUPLE_ELEM(2, 1, ARGS))
+#define COLORSPACE_8u_KERNEL_I(M, OP, TIER) COLORSPACE_8u_KERNEL_NAME(OP, M_CHANNELS(M), DISPATCH_TIER_FLOOR(COLORSPACE_8u_TIERS(OP, M_CHANNELS(M)), TIER))
+#define COLORSPACE_8u_KERNEL_NULL(M, OP, TIER) NULL
+
+#define DEFINE_COLORSPACE_8u_KERNELS_OF(OP, TIER)                               \
+  DEFINE_COLORSPACE_8u_KERNEL(OP, C3, TIER)                                     \
+  DEFINE_COLORSPACE_8u_KERNEL(OP, AC4, TIER)                                    \
+  DEFINE_COLORSPACE_8u_KERNEL(OP, C4, TIER)
+
+#define DEFINE_COLORSPACE_8u_KERNELS(TIER, ARG)                                 \
+  DEFINE_COLORSPACE_8u_KERNELS_OF(to_ycbcr, TIER)                               \
+  DEFINE_COLORSPACE_8u_KERNELS_OF(from_ycbcr, TIER)                             \
+  DEFINE_COLORSPACE_8u_KERNELS_OF(to_yuv420, TIER)                              \
+  DEFINE_COLORSPACE_8u_KERNELS_OF(from_yuv420, TIER)                            \
+  DEFINE_DISPATCH_KERNELS(ARX_JOIN(colorspace_to_ycbcr_8u_kernels_, TIER), M_SUPPORTED, COLORSPACE_8u_KERNEL, (to_ycbcr, TIER)) \
+  DEFINE_DISPATCH_KERNELS(ARX_JOIN(colorspace_from_ycbcr_8u_kernels_, TIER), M_SUPPORTED, COLORSPACE_8u_KERNEL, (from_ycbcr, TIER)) \
+  DEFINE_DISPATCH_KERNELS(ARX_JOIN(colorspace_to_yuv420_kernels_, TIER), M_SUPPORTED, COLORSPACE_8u_KERNEL, (to_yuv420, TIER)) \
+  DEFINE_DISPATCH_KERNELS(ARX_JOIN(colorspace_from_yuv420_kernels_, TIER), M_SUPPORTED, COLORSPACE_8u_KERNEL, (from_yuv420, TIER))
+
+ARX_ARRAY_FOREACH(DISPATCH_TIERS, DEFINE_COLORSPACE_8u_KERNELS, ~)
+
+DEFINE_DISPATCH_TIERED_TABLE(colorspace_to_ycbcr_8u_table, "colorspace_to_ycbcr_8u", colorspace_to_ycbcr_8u_kernels)
+DEFINE_DISPATCH_TIERED_TABLE(colorspace_from_ycbcr_8u_table, "colorspace_from_ycbcr_8u", colorspace_from_ycbcr_8u_kernels)
+DEFINE_DISPATCH_TIERED_TABLE(colorspace_to_yuv420_table, "colorspace_to_yuv420", colorspace_to_yuv420_kernels)
+DEFINE_DISPATCH_TIERED_TABLE(colorspace_from_yuv420_table, "colorspace_from_yuv420", colorspace_from_yuv420_kernels)
+
+
+/**
+ * Arguments of the chroma row loops of YUV 4:2:0 conversions, shared by their tiles.
+ */
+typedef struct {
+  const Yuv420Planes* planes;
+  ColorspaceToYuv420Func to;
+  ColorspaceFromYuv420Func from;
+  Ipp8u* pixels;        /**< rgb source or destination */
+  int step;             /**< row step of pixels */
+  IppiSize size;
+} Yuv420Tile;
+
+
+/**
+ * Tile functions for pool_parallel_for, items are chroma rows.
+ */
+static void colorspace_to_yuv420_tile(void* arg, int cyStart, int cyEnd) {
+  Yuv420Tile* t = (Yuv420Tile*) arg;
+
+  t->to(t->planes, t->pixels, t->step, t->size, cyStart, cyEnd);
+}
+
+static void colorspace_from_yuv420_tile(void* arg, int cyStart, int cyEnd) {
+  Yuv420Tile* t = (Yuv420Tile*) arg;
+
+  t->from(t->planes, t->size, t->pixels, t->step, cyStart, cyEnd);
+}
+
+
+// -------------------------------------------------------------------------- //
+// colorspace_dispatch_init
+// -------------------------------------------------------------------------- //
+void colorspace_dispatch_init(void) {
+  dispatch_register(&colorspace_load_table);
+  dispatch_register(&colorspace_store_table);
+  dispatch_register(&colorspace_to_ycbcr_8u_table);
+  dispatch_register(&colorspace_from_ycbcr_8u_table);
+  dispatch_register(&colorspace_to_yuv420_table);
+  dispatch_register(&colorspace_from_yuv420_table);
+}
+
+
+// -------------------------------------------------------------------------- //
+// colorspace_convert
+// -------------------------------------------------------------------------- //
+/**
+ * Converts rows [yStart, yEnd) chunk by chunk.
+ */
+static void colorspace_convert_band(ColorspaceLoadFunc load, ColorspaceFunc toRgb, ColorspaceFunc fromRgb, ColorspaceStoreFunc store,
+                                    const char* pSrc, int srcStep, int srcPixelSize, char* pDst, int dstStep, int dstPixelSize, int width, int yStart, int yEnd) {
+  Ipp32f buf[COLORSPACE_CHUNK * 4];
+  int x, y, n;
+
+  for(y = yStart; y < yEnd; y++) {
+    for(x = 0; x < width; x += COLORSPACE_CHUNK) {
+      n = min(COLORSPACE_CHUNK, width - x);
+      load(pSrc + y * srcStep + x * srcPixelSize, buf, n);
+      if(toRgb != NULL)
+        toRgb(buf, n);
+      if(fromRgb != NULL)
+        fromRgb(buf, n);
+      store(buf, pDst + y * dstStep + x * dstPixelSize, n);
+    }
+  }
+}
+
+
+/**
+ * Arguments of the row loop of colorspace_convert, shared by its tiles.
+ */
+typedef struct {
+  ColorspaceLoadFunc load;
+  ColorspaceFunc toRgb;
+  ColorspaceFunc fromRgb;
+  ColorspaceStoreFunc store;
+  ColorspaceYcbcrFunc ycbcr;  /**< kernel of colorspace_ycbcr_8u_tile */
+  const char* pSrc;
+  int srcStep;
+  int srcPixelSize;
+  char* pDst;
+  int dstStep;
+  int dstPixelSize;
+  int width;
+} ColorspaceTile;
+
+
+/**
+ * Tile functions for pool_parallel_for, items are rows.
+ */
+static void colorspace_convert_tile(void* arg, int yStart, int yEnd) {
+  ColorspaceTile* t = (ColorspaceTile*) arg;
+
+  colorspace_convert_band(t->load, t->toRgb, t->fromRgb, t->store, t->pSrc, t->srcStep, t->srcPixelSize, t->pDst, t->dstStep, t->dstPixelSize, t->width, yStart, yEnd);
+}
+
+static void colorspace_ycbcr_8u_tile(void* arg, int yStart, int yEnd) {
+  ColorspaceTile* t = (ColorspaceTile*) arg;
+
+  t->ycbcr((const Ipp8u*) t->pSrc, t->srcStep, (Ipp8u*) t->pDst, t->dstStep, t->dstPixelSize, t->width, yStart, yEnd);
+}
+
+
+int colorspace_convert(ColorSpace from, ColorSpace to, IppMetaType srcMetaType, const void* pSrc, int srcStep, IppMetaType dstMetaType, void* pDst, int dstStep, IppiSize roi) {
+  ColorspaceLoadFunc load;
+  ColorspaceStoreFunc store;
+  ColorspaceTile tile;
+
+  assert(pSrc != NULL && pDst != NULL);
+  assert(from >= COLORSPACE_RGB && from <= COLORSPACE_XYZ && to >= COLORSPACE_RGB && to <= COLORSPACE_XYZ);
+
+  load = DISPATCH_KERNEL(ColorspaceLoadFunc, colorspace_load_table, srcMetaType);
+  store = DISPATCH_KERNEL(ColorspaceStoreFunc, colorspace_store_table, dstMetaType);
+
+  if(load == NULL || store == NULL)
+    return ippStsNumChannelsErr;
+
+  tile.load = load;
+  tile.store = store;
+  tile.pSrc = (const char*) pSrc;
+  tile.srcStep = srcStep;
+  tile.srcPixelSize = metatype_pixel_size(srcMetaType);
+  tile.pDst = (char*) pDst;
+  tile.dstStep = dstStep;
+  tile.dstPixelSize = metatype_pixel_size(dstMetaType);
+  tile.width = roi.width;
+
+  if(metatype_datatype(srcMetaType) == ipp8u && metatype_datatype(dstMetaType) == ipp8u && from != to &&
+     (from == COLORSPACE_RGB || from == COLORSPACE_YCBCR) && (to == COLORSPACE_RGB || to == COLORSPACE_YCBCR)) {
+    tile.ycbcr = to == COLORSPACE_YCBCR ? DISPATCH_KERNEL(ColorspaceYcbcrFunc, colorspace_to_ycbcr_8u_table, srcMetaType)
+                                        : DISPATCH_KERNEL(ColorspaceYcbcrFunc, colorspace_from_ycbcr_8u_table, srcMetaType);
+    pool_parallel_for(roi.height, COLORSPACE_BAND_HEIGHT, colorspace_ycbcr_8u_tile, &tile);
+    return ippStsNoErr;
+  }
+
+  /* Conversion between two non-RGB spaces goes through RGB. */
+  tile.toRgb = from != to ? colorspace_to_rgb[from] : NULL;
+  tile.fromRgb = from != to ? colorspace_from_rgb[to] : NULL;
+  colorspace_init_tables();
+
+  pool_parallel_for(roi.height, COLORSPACE_BAND_HEIGHT, colorspace_convert_tile, &tile);
+
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// colorspace_yuv420_size
+// -------------------------------------------------------------------------- //
+int colorspace_yuv420_size(IppiSize size) {
+  return size.width * size.height + 2 * ((size.width + 1) / 2) * ((size.height + 1) / 2);
+}
+
+
+// -------------------------------------------------------------------------- //
+// colorspace_to_yuv420
+// -------------------------------------------------------------------------- //
+int colorspace_to_yuv420(Yuv420Format format, IppChannels channels, const Ipp8u* pSrc, int srcStep, IppiSize size, Ipp8u* pDst) {
+  Yuv420Planes planes;
+  Yuv420Tile tile;
+
+  assert(pSrc != NULL && pDst != NULL);
+
+  tile.to = DISPATCH_KERNEL(ColorspaceToYuv420Func, colorspace_to_yuv420_table, metatype_compose(ipp8u, channels));
+  if(tile.to == NULL)
+    return ippStsNumChannelsErr;
+
+  colorspace_yuv420_planes(&planes, format, pDst, size);
+
+  tile.planes = &planes;
+  tile.pixels = (Ipp8u*) pSrc;
+  tile.step = srcStep;
+  tile.size = size;
+  pool_parallel_for((size.height + 1) / 2, COLORSPACE_BAND_HEIGHT, colorspace_to_yuv420_tile, &tile);
+
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// colorspace_from_yuv420
+// -------------------------------------------------------------------------- //
+int colorspace_from_yuv420(Yuv420Format format, const Ipp8u* pSrc, IppiSize size, IppChannels channels, Ipp8u* pDst, int dstStep) {
+  Yuv420Planes planes;
+  Yuv420Tile tile;
+
+  assert(pSrc != NULL && pDst != NULL);
+
+  tile.from = DISPATCH_KERNEL(ColorspaceFromYuv420Func, colorspace_from_yuv420_table, metatype_compose(ipp8u, channels));
+  if(tile.from == NULL)
+    return ippStsNumChannelsErr;
+
+  colorspace_yuv420_planes(&planes, format, pSrc, size);
+
+  tile.planes = &planes;
+  tile.pixels = pDst;
+  tile.step = dstStep;
+  tile.size = size;
+  pool_parallel_for((size.height + 1) / 2, COLORSPACE_BAND_HEIGHT, colorspace_from_yuv420_tile, &tile);
+
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// r2c_color_space
+// -------------------------------------------------------------------------- //
+ColorSpace r2c_color_space(VALUE value) {
+  ID id;
+
+  if(SYMBOL_P(value)) {
+    id = SYM2ID(value);
+    if(id == rb_intern("rgb"))
+      return COLORSPACE_RGB;
+    else if(id == rb_intern("hsv"))
+      return COLORSPACE_HSV;
+    else if(id == rb_intern("hls"))
+      return COLORSPACE_HLS;
+    else if(id == rb_intern("ycbcr"))
+      return COLORSPACE_YCBCR;
+    else if(id == rb_intern("lab"))
+      return COLORSPACE_LAB;
+    else if(id == rb_intern("xyz"))
+      return COLORSPACE_XYZ;
+    else
+      rb_raise(rb_eArgError, "unknown color space :%s", rb_id2name(id));
+  }
+
+  return (ColorSpace) R2C_ENUM(value, rb_ColorSpace);
+}
+
+
+// -------------------------------------------------------------------------- //
+// r2c_yuv420_format
+// -------------------------------------------------------------------------- //
+Yuv420Format r2c_yuv420_format(VALUE value) {
+  ID id;
+
+  if(SYMBOL_P(value)) {
+    id = SYM2ID(value);
+    if(id == rb_intern("i420"))
+      return YUV420_I420;
+    else if(id == rb_intern("yv12"))
+      return YUV420_YV12;
+    else if(id == rb_intern("nv12"))
+      return YUV420_NV12;
+    else if(id == rb_intern("nv21"))
+      return YUV420_NV21;
+    else
+      rb_raise(rb_eArgError, "unknown YUV 4:2:0 format :%s", rb_id2name(id));
+  }
+
+  return (Yuv420Format) R2C_ENUM(value, rb_Yuv420Format);
+}
+
+
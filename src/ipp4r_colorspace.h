@@ -0,0 +1,147 @@
+#ifndef __IPP4R_COLORSPACE_H__
+#define __IPP4R_COLORSPACE_H__
+
+#include <ruby.h>
+#include <ippdefs.h>
+#include "ipp4r_fwd.h"
+#include "ipp4r_metatype.h"
+
+/**
+ * @file
+ *
+ * This file defines color space conversion kernels. <p>
+ *
+ * Images in a non-RGB color space keep their metatype, and components of the color space are stored in red, green and blue slots, in this order,
+ * i.e. hue of an HSV image is returned by <tt>Color#r</tt>. All components are normalized to MetaNumber [0, 1] range:
+ * <ul>
+ * <li> HSV, HLS: hue is a fraction of a full turn.
+ * <li> YCbCr: full-range BT.601 (as in JPEG), chroma is offset by 0.5.
+ * <li> XYZ: linear sRGB with D65 white point, X and Z are divided by the white point so that white is (1, 1, 1).
+ * <li> Lab: L / 100, (a + 128) / 255, (b + 128) / 255, which is the usual 8-bit encoding.
+ * </ul>
+ *
+ * Each conversion is a single pass over an image. Pixels are converted in short chunks that fit in L1 cache: a chunk is read into a float buffer,
+ * converted there and written out in the destination data type, so conversion between data types is fused into the same pass.
+ * 8u RGB <-> YCbCr and YUV 4:2:0 conversions use fixed-point integer arithmetic instead. Row bands are processed in parallel as tiles on the pool, see pool_parallel_for. <p>
+ *
+ * YUV 4:2:0 buffers use limited-range BT.601 (video levels), chroma planes are subsampled by 2 in both directions, rounding the size up.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -------------------------------------------------------------------------- //
+// Defines
+// -------------------------------------------------------------------------- //
+#define COLORSPACE_CHUNK 256          /**< Number of pixels converted at once */
+#define COLORSPACE_BAND_HEIGHT 16     /**< Number of rows in a tile of a parallel loop */
+
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/**
+ * Color space
+ */
+typedef enum {
+  COLORSPACE_RGB,       /**< sRGB, native color space of images */
+  COLORSPACE_HSV,       /**< hue, saturation, value */
+  COLORSPACE_HLS,       /**< hue, lightness, saturation */
+  COLORSPACE_YCBCR,     /**< luma and chroma */
+  COLORSPACE_LAB,       /**< CIE L*a*b* */
+  COLORSPACE_XYZ        /**< CIE XYZ */
+} ColorSpace;
+
+
+/**
+ * Layout of a YUV 4:2:0 buffer. All layouts start with a full-resolution Y plane.
+ */
+typedef enum {
+  YUV420_I420,          /**< planar, U plane followed by V plane */
+  YUV420_YV12,          /**< planar, V plane followed by U plane */
+  YUV420_NV12,          /**< semi-planar, interleaved UV plane */
+  YUV420_NV21           /**< semi-planar, interleaved VU plane */
+} Yuv420Format;
+
+
+// -------------------------------------------------------------------------- //
+// Function declarations
+// -------------------------------------------------------------------------- //
+/**
+ * Converts an image buffer from one color space to another, and possibly to another data type. <br>
+ * Both metatypes must have C3, AC4 or C4 channels. Alpha channel is converted to the destination data type, or set to opaque for C3 source.
+ *
+ * @param from color space of source
+ * @param to color space of destination
+ * @param srcMetaType metatype of source
+ * @param pSrc source buffer
+ * @param srcStep size of source row in bytes
+ * @param dstMetaType metatype of destination
+ * @param pDst destination buffer
+ * @param dstStep size of destination row in bytes
+ * @param roi size of processed region in pixels
+ * @returns ippStsNoErr if everything went OK, ippStsNumChannelsErr for single-channel metatypes, non-zero error code otherwise
+ */
+int colorspace_convert(ColorSpace from, ColorSpace to, IppMetaType srcMetaType, const void* pSrc, int srcStep, IppMetaType dstMetaType, void* pDst, int dstStep, IppiSize roi);
+
+
+/**
+ * @returns size in bytes of a YUV 4:2:0 buffer for an image of the given size
+ */
+int colorspace_yuv420_size(IppiSize size);
+
+
+/**
+ * Converts an 8u RGB image buffer to YUV 4:2:0. Chroma is averaged over 2x2 blocks.
+ *
+ * @param format layout of destination
+ * @param channels channels of source, C3, AC4 or C4. Data type is 8u
+ * @param pSrc source buffer
+ * @param srcStep size of source row in bytes
+ * @param size size of source in pixels
+ * @param pDst destination buffer of colorspace_yuv420_size(size) bytes
+ * @returns ippStsNoErr if everything went OK, non-zero error code otherwise
+ */
+int colorspace_to_yuv420(Yuv420Format format, IppChannels channels, const Ipp8u* pSrc, int srcStep, IppiSize size, Ipp8u* pDst);
+
+
+/**
+ * Converts a YUV 4:2:0 buffer to an 8u RGB image buffer. Alpha of four-channel destination is set to opaque.
+ *
+ * @param format layout of source
+ * @param pSrc source buffer of colorspace_yuv420_size(size) bytes
+ * @param size size of an image in pixels
+ * @param channels channels of destination, C3, AC4 or C4. Data type is 8u
+ * @param pDst destination buffer
+ * @param dstStep size of destination row in bytes
+ * @returns ippStsNoErr if everything went OK, non-zero error code otherwise
+ */
+int colorspace_from_yuv420(Yuv420Format format, const Ipp8u* pSrc, IppiSize size, IppChannels channels, Ipp8u* pDst, int dstStep);
+
+
+/**
+ * Converts the given ruby value (ColorSpace enum or one of <tt>:rgb, :hsv, :hls, :ycbcr, :lab, :xyz</tt>) to ColorSpace.
+ */
+ColorSpace r2c_color_space(VALUE value);
+
+
+/**
+ * Converts the given ruby value (Yuv420Format enum or one of <tt>:i420, :yv12, :nv12, :nv21</tt>) to Yuv420Format.
+ */
+Yuv420Format r2c_yuv420_format(VALUE value);
+
+
+/**
+ * Registers dispatch tables of color space kernels, see dispatch_init.
+ */
+void colorspace_dispatch_init(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
@@ -0,0 +1,262 @@
+#include <assert.h>
+#include <string.h>
+#include "ipp4r.h"
+
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/** Reads n pixels into a buffer of (b, g, r, a) double quads */
+typedef void (*ConvertLoadFunc)(const void* pSrc, Ipp64f* buf, int n);
+
+/** Writes n pixels from a buffer of (b, g, r, a) double quads */
+typedef void (*ConvertStoreFunc)(const Ipp64f* buf, void* pDst, int n);
+
+/** Arguments of the row loops of convert_copy, shared by their tiles */
+typedef struct {
+  ConvertLoadFunc load;
+  ConvertStoreFunc store;
+  const char* pSrc;
+  int srcStep;
+  int srcPixelSize;
+  char* pDst;
+  int dstStep;
+  int dstPixelSize;
+  int width;            /**< number of pixels, or of values in a row for 16f conversions */
+  int grayscale;        /**< is destination a grayscale of a color source? */
+} ConvertTile;
+
+
+// -------------------------------------------------------------------------- //
+// Saturation
+// -------------------------------------------------------------------------- //
+DEFINE_D_SAT(convert_round_, 8u, Ipp64f)
+DEFINE_D_SAT(convert_round_, 16u, Ipp64f)
+DEFINE_D_SAT(convert_round_, 16s, Ipp64f)
+DEFINE_D_SAT(convert_round_, 32s, Ipp64f)
+
+/* convert_sat_DATATYPE converts a MetaNumber to the given data type with rounding and saturation */
+#define convert_sat_8u(V)  convert_round_8u((V) * D_SCALE(8u))
+#define convert_sat_16u(V) convert_round_16u((V) * D_SCALE(16u))
+#define convert_sat_16s(V) convert_round_16s((V) * D_SCALE(16s))
+#define convert_sat_32s(V) convert_round_32s((V) * D_SCALE(32s))
+
+static Ipp32f convert_sat_32f(Ipp64f v) {
+  return (Ipp32f) v;
+}
+
+static Ipp64f convert_sat_64f(Ipp64f v) {
+  return v;
+}
+
+static Ipp16f convert_sat_16f(Ipp64f v) {
+  return half_from_float((Ipp32f) v);
+}
+
+
+// -------------------------------------------------------------------------- //
+// Chunk load / store kernels
+// -------------------------------------------------------------------------- //
+/* Value of a stored number, halves are the only ones that need decoding. */
+#define CONVERT_IN(D, V) IF_D_EQ_D(D, 16f, half_to_float(V), (V))
+
+#define CONVERT_LOAD_C1(S, B, K, D)  (B)[0] = (B)[1] = (B)[2] = CONVERT_IN(D, (S)[0]) * (K); (B)[3] = 1.0;
+#define CONVERT_LOAD_C3(S, B, K, D)  (B)[0] = CONVERT_IN(D, (S)[0]) * (K); (B)[1] = CONVERT_IN(D, (S)[1]) * (K); (B)[2] = CONVERT_IN(D, (S)[2]) * (K); (B)[3] = 1.0;
+#define CONVERT_LOAD_AC4(S, B, K, D) (B)[0] = CONVERT_IN(D, (S)[0]) * (K); (B)[1] = CONVERT_IN(D, (S)[1]) * (K); (B)[2] = CONVERT_IN(D, (S)[2]) * (K); (B)[3] = CONVERT_IN(D, (S)[3]) * (K);
+#define CONVERT_LOAD_C4(S, B, K, D)  CONVERT_LOAD_AC4(S, B, K, D)
+
+/* Grayscale is computed by convert_copy before storing to C1, into the first slot. */
+#define CONVERT_STORE_C1(B, S, D)  (S)[0] = ARX_JOIN(convert_sat_, D)((B)[0]);
+#define CONVERT_STORE_C3(B, S, D)  (S)[0] = ARX_JOIN(convert_sat_, D)((B)[0]); (S)[1] = ARX_JOIN(convert_sat_, D)((B)[1]); (S)[2] = ARX_JOIN(convert_sat_, D)((B)[2]);
+#define CONVERT_STORE_AC4(B, S, D) CONVERT_STORE_C3(B, S, D) (S)[3] = ARX_JOIN(convert_sat_, D)((B)[3]);
+#define CONVERT_STORE_C4(B, S, D)  CONVERT_STORE_AC4(B, S, D)
+
+/* Names of load / store kernels */
+#define CONVERT_LOAD_NAME(D, C, TIER) ARX_JOIN_3(ARX_JOIN_5(convert_load_, D, _, C, R), _, TIER)
+#define CONVERT_STORE_NAME(D, C, TIER) ARX_JOIN_3(ARX_JOIN_5(convert_store_, D, _, C, R), _, TIER)
+
+/* Tiers that change the code of load / store kernels of a data type. Loads of 16u and 16s and stores of 32f are vectorized. */
+#define CONVERT_LOAD_TIERS_8u   (1, (generic))
+#define CONVERT_LOAD_TIERS_16u  (3, (generic, sse4, avx2))
+#define CONVERT_LOAD_TIERS_32f  (1, (generic))
+#define CONVERT_LOAD_TIERS_16s  (2, (generic, avx2))
+#define CONVERT_LOAD_TIERS_32s  (1, (generic))
+#define CONVERT_LOAD_TIERS_64f  (1, (generic))
+#define CONVERT_LOAD_TIERS_16f  (1, (generic))
+#define CONVERT_LOAD_TIERS(D) ARX_JOIN(CONVERT_LOAD_TIERS_, D)
+
+#define CONVERT_STORE_TIERS_8u  (1, (generic))
+#define CONVERT_STORE_TIERS_16u (1, (generic))
+#define CONVERT_STORE_TIERS_32f (2, (generic, avx2))
+#define CONVERT_STORE_TIERS_16s (1, (generic))
+#define CONVERT_STORE_TIERS_32s (1, (generic))
+#define CONVERT_STORE_TIERS_64f (1, (generic))
+#define CONVERT_STORE_TIERS_16f (1, (generic))
+#define CONVERT_STORE_TIERS(D) ARX_JOIN(CONVERT_STORE_TIERS_, D)
+
+/**
+ * Defines <tt>convert_load_DATATYPE_CHANNELSR_TIER</tt> and <tt>convert_store_DATATYPE_CHANNELSR_TIER</tt>, if TIER is listed for DATATYPE.
+ */
+#define DEFINE_CONVERT_LOADSTORE(METATYPE, TIER)                                \
+  DEFINE_CONVERT_LOADSTORE_I(M_DATATYPE(METATYPE), M_CHANNELS(METATYPE), TIER, D_CTYPE(M_DATATYPE(METATYPE)), C_CNUMB(M_CHANNELS(METATYPE)))
+#define DEFINE_CONVERT_LOADSTORE_I(D, C, TIER, CTYPE, CNUMB)                    \
+  ARX_IF(DISPATCH_HAS_TIER(CONVERT_LOAD_TIERS(D), TIER), DEFINE_CONVERT_LOAD, ARX_TUPLE_EAT_5)(D, C, TIER, CTYPE, CNUMB) \
+  ARX_IF(DISPATCH_HAS_TIER(CONVERT_STORE_TIERS(D), TIER), DEFINE_CONVERT_STORE, ARX_TUPLE_EAT_5)(D, C, TIER, CTYPE, CNUMB)
+#define DEFINE_CONVERT_LOAD(D, C, TIER, CTYPE, CNUMB)                           \
+DISPATCH_TARGET(TIER) static void CONVERT_LOAD_NAME(D, C, TIER)(const void* pSrc, Ipp64f* buf, int n) { \
+  const CTYPE* s = (const CTYPE*) pSrc;                                         \
+  const Ipp64f k = 1.0 / D_SCALE(D);                                            \
+  int i;                                                                        \
+                                                                                \
+  for(i = 0; i < n; i++, s += CNUMB, buf += 4) {                                \
+    ARX_JOIN(CONVERT_LOAD_, C)(s, buf, k, D)                                    \
+  }                                                                             \
+}
+#define DEFINE_CONVERT_STORE(D, C, TIER, CTYPE, CNUMB)                          \
+DISPATCH_TARGET(TIER) static void CONVERT_STORE_NAME(D, C, TIER)(const Ipp64f* buf, void* pDst, int n) { \
+  CTYPE* d = (CTYPE*) pDst;                                                     \
+  int i;                                                                        \
+                                                                                \
+  for(i = 0; i < n; i++, d += CNUMB, buf += 4) {                                \
+    ARX_JOIN(CONVERT_STORE_, C)(buf, d, D)                                      \
+  }                                                                             \
+}
+
+/**
+ * Defines load / store kernels and kernel arrays <tt>convert_load_kernels_TIER</tt>, <tt>convert_store_kernels_TIER</tt> for TIER.
+ * Entries of data types that TIER isn't listed for are the kernels of the tier below.
+ */
+#define DEFINE_CONVERT_KERNELS(TIER, ARG)                                       \
+  ARX_ARRAY_FOREACH(M_INTERLEAVED, DEFINE_CONVERT_LOADSTORE, TIER)              \
+  DEFINE_DISPATCH_KERNELS(ARX_JOIN(convert_load_kernels_, TIER), M_INTERLEAVED, CONVERT_LOAD_KERNEL, TIER) \
+  DEFINE_DISPATCH_KERNELS(ARX_JOIN(convert_store_kernels_, TIER), M_INTERLEAVED, CONVERT_STORE_KERNEL, TIER)
+#define CONVERT_LOAD_KERNEL(M, TIER) CONVERT_LOAD_NAME(M_DATATYPE(M), M_CHANNELS(M), DISPATCH_TIER_FLOOR(CONVERT_LOAD_TIERS(M_DATATYPE(M)), TIER))
+#define CONVERT_STORE_KERNEL(M, TIER) CONVERT_STORE_NAME(M_DATATYPE(M), M_CHANNELS(M), DISPATCH_TIER_FLOOR(CONVERT_STORE_TIERS(M_DATATYPE(M)), TIER))
+
+ARX_ARRAY_FOREACH(DISPATCH_TIERS, DEFINE_CONVERT_KERNELS, ~)
+
+DEFINE_DISPATCH_TIERED_TABLE(convert_load_table, "convert_load", convert_load_kernels)
+DEFINE_DISPATCH_TIERED_TABLE(convert_store_table, "convert_store", convert_store_kernels)
+
+
+// -------------------------------------------------------------------------- //
+// Supplementary functions
+// -------------------------------------------------------------------------- //
+/**
+ * Tile functions for pool_parallel_for, items are rows.
+ */
+static void convert_half_to_float_tile(void* arg, int yStart, int yEnd) {
+  ConvertTile* t = (ConvertTile*) arg;
+  int y;
+
+  for(y = yStart; y < yEnd; y++)
+    half_to_float_row((const Ipp16f*) (t->pSrc + y * t->srcStep), (Ipp32f*) (t->pDst + y * t->dstStep), t->width);
+}
+
+static void convert_half_from_float_tile(void* arg, int yStart, int yEnd) {
+  ConvertTile* t = (ConvertTile*) arg;
+  int y;
+
+  for(y = yStart; y < yEnd; y++)
+    half_from_float_row((const Ipp32f*) (t->pSrc + y * t->srcStep), (Ipp16f*) (t->pDst + y * t->dstStep), t->width);
+}
+
+static void convert_tile(void* arg, int yStart, int yEnd) {
+  ConvertTile* t = (ConvertTile*) arg;
+  Ipp64f buf[CONVERT_CHUNK * 4];
+  int x, y, i, n;
+
+  for(y = yStart; y < yEnd; y++) {
+    for(x = 0; x < t->width; x += CONVERT_CHUNK) {
+      n = min(CONVERT_CHUNK, t->width - x);
+      t->load(t->pSrc + y * t->srcStep + x * t->srcPixelSize, buf, n);
+      if(t->grayscale)
+        for(i = 0; i < n; i++)
+          buf[i * 4] = COLORARRAY_TO_GRAYSCALE(buf + i * 4);
+      t->store(buf, t->pDst + y * t->dstStep + x * t->dstPixelSize, n);
+    }
+  }
+}
+
+
+/**
+ * Converts an image buffer between metatypes that differ in nothing but 16f and 32f data type, or copies it if metatypes are equal.
+ *
+ * @returns TRUE if conversion was done, FALSE if it's not a conversion of this kind
+ */
+static int convert_copy_direct(IppMetaType srcMetaType, const void* pSrc, int srcStep, IppMetaType dstMetaType, void* pDst, int dstStep, IppiSize roi) {
+  IppDataType srcDataType, dstDataType;
+  ConvertTile tile;
+  int y;
+
+  srcDataType = metatype_datatype(srcMetaType);
+  dstDataType = metatype_datatype(dstMetaType);
+
+  tile.pSrc = (const char*) pSrc;
+  tile.srcStep = srcStep;
+  tile.pDst = (char*) pDst;
+  tile.dstStep = dstStep;
+
+  if(srcMetaType == dstMetaType) {
+    for(y = 0; y < roi.height; y++)
+      memcpy((char*) pDst + y * dstStep, (const char*) pSrc + y * srcStep, roi.width * metatype_pixel_size(srcMetaType));
+  } else if(metatype_channels(srcMetaType) != metatype_channels(dstMetaType))
+    return FALSE;
+  else if(srcDataType == ipp16f && dstDataType == ipp32f) {
+    tile.width = roi.width * metatype_pixel_size(srcMetaType) / sizeof(Ipp16f);
+    pool_parallel_for(roi.height, pool_tile_rows(tile.width * sizeof(Ipp32f)), convert_half_to_float_tile, &tile);
+  } else if(srcDataType == ipp32f && dstDataType == ipp16f) {
+    tile.width = roi.width * metatype_pixel_size(srcMetaType) / sizeof(Ipp32f);
+    pool_parallel_for(roi.height, pool_tile_rows(tile.width * sizeof(Ipp32f)), convert_half_from_float_tile, &tile);
+  } else
+    return FALSE;
+
+  return TRUE;
+}
+
+
+// -------------------------------------------------------------------------- //
+// convert_dispatch_init
+// -------------------------------------------------------------------------- //
+void convert_dispatch_init(void) {
+  dispatch_register(&convert_load_table);
+  dispatch_register(&convert_store_table);
+}
+
+
+// -------------------------------------------------------------------------- //
+// convert_copy
+// -------------------------------------------------------------------------- //
+int convert_copy(IppMetaType srcMetaType, const void* pSrc, int srcStep, IppMetaType dstMetaType, void* pDst, int dstStep, IppiSize roi) {
+  ConvertLoadFunc load;
+  ConvertStoreFunc store;
+  ConvertTile tile;
+
+  assert(pSrc != NULL && pDst != NULL);
+
+  load = DISPATCH_KERNEL(ConvertLoadFunc, convert_load_table, srcMetaType);
+  store = DISPATCH_KERNEL(ConvertStoreFunc, convert_store_table, dstMetaType);
+
+  if(load == NULL || store == NULL)
+    return ippStsDataTypeErr;
+
+  if(convert_copy_direct(srcMetaType, pSrc, srcStep, dstMetaType, pDst, dstStep, roi))
+    return ippStsNoErr;
+
+  tile.load = load;
+  tile.store = store;
+  tile.pSrc = (const char*) pSrc;
+  tile.srcStep = srcStep;
+  tile.srcPixelSize = metatype_pixel_size(srcMetaType);
+  tile.pDst = (char*) pDst;
+  tile.dstStep = dstStep;
+  tile.dstPixelSize = metatype_pixel_size(dstMetaType);
+  tile.width = roi.width;
+  tile.grayscale = metatype_channels(dstMetaType) == ippC1 && metatype_channels(srcMetaType) != ippC1;
+
+  pool_parallel_for(roi.height, pool_tile_rows(roi.width * 4 * sizeof(Ipp64f)), convert_tile, &tile);
+
+  return ippStsNoErr;
+}
+
+
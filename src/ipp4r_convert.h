@@ -0,0 +1,61 @@
+#ifndef __IPP4R_CONVERT_H__
+#define __IPP4R_CONVERT_H__
+
+#include <ippdefs.h>
+#include "ipp4r_fwd.h"
+#include "ipp4r_metatype.h"
+
+/**
+ * @file
+ *
+ * This file defines a generic metatype conversion kernel, used for conversions that have no IPP primitive,
+ * i.e. for any conversion that involves 16s, 32s, 64f, 16f or C4 images. <p>
+ *
+ * Pixels are converted in short chunks: a chunk is read into a double buffer of (b, g, r, a) quads normalized to MetaNumber range,
+ * and written out in the destination metatype. Single-channel source is replicated to all color channels, and conversion to a single channel
+ * computes grayscale, exactly as the IPP-backed paths do. Alpha of C3 and C1 source is opaque. Rows are processed in parallel as tiles on the pool. <p>
+ *
+ * Conversions between 16f and 32f with the same channels, and copies between equal metatypes, go row by row without the intermediate buffer.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -------------------------------------------------------------------------- //
+// Defines
+// -------------------------------------------------------------------------- //
+#define CONVERT_CHUNK 256  /**< Number of pixels converted at once */
+
+
+// -------------------------------------------------------------------------- //
+// Function declarations
+// -------------------------------------------------------------------------- //
+/**
+ * Converts an image buffer from one metatype to another. Both metatypes must be interleaved.
+ *
+ * @param srcMetaType metatype of source
+ * @param pSrc source buffer
+ * @param srcStep size of source row in bytes
+ * @param dstMetaType metatype of destination
+ * @param pDst destination buffer
+ * @param dstStep size of destination row in bytes
+ * @param roi size of processed region in pixels
+ * @returns ippStsNoErr if everything went OK, non-zero error code otherwise
+ */
+int convert_copy(IppMetaType srcMetaType, const void* pSrc, int srcStep, IppMetaType dstMetaType, void* pDst, int dstStep, IppiSize roi);
+
+
+/**
+ * Registers dispatch tables of conversion kernels, see dispatch_init.
+ */
+void convert_dispatch_init(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
@@ -1,14 +1,58 @@
 #include <assert.h>
+#include <string.h>
 #include <ipp.h>
 #include <ruby.h>
 #include "ipp4r.h"
 
+#ifdef HAVE_SYS_MMAN_H
+#  include <sys/mman.h>
+#  if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#    define MAP_ANONYMOUS MAP_ANON
+#  endif
+#endif
+
 // -------------------------------------------------------------------------- //
 // Debug facilities
 // -------------------------------------------------------------------------- //
 IF_TRACE(static int data_count = 0;)
 
 
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/** Header stored right before every block returned by ipp4rMalloc, at an address aligned to DATA_HEADER_ALIGNMENT */
+typedef struct {
+  void* ptr;            /**< pointer returned by the allocator */
+  size_t size;          /**< size of allocation */
+  DataBlockKind kind;   /**< allocator that provided the block */
+  int native;           /**< was the block allocated by a thread unknown to ruby? Such blocks come from malloc instead of xmalloc and are not reported to gc */
+  ATOMIC_INT refs;      /**< number of Data structures using the block, it's shared copy-on-write if there are several */
+} DataBlockHeader;
+
+#define DATA_HEADER_ALIGNMENT 16
+
+/** Allocation statistics as they're collected, blocks are allocated and freed by any thread. See DataStats for the meaning of fields */
+typedef struct {
+  ATOMIC_INT blocks[DATA_BLOCK_KIND_COUNT];
+  ATOMIC_SIZE bytes[DATA_BLOCK_KIND_COUNT];
+  ATOMIC_INT allocations[DATA_BLOCK_KIND_COUNT];
+  ATOMIC_INT fallbacks;
+  ATOMIC_SIZE liveBytes;
+  ATOMIC_SIZE peakBytes;
+} DataCounters;
+
+
+// -------------------------------------------------------------------------- //
+// Local variables
+// -------------------------------------------------------------------------- //
+static int data_alignment_value = 0; /* 0 stands for the default one */
+static int data_align_interior_value = FALSE;
+
+static MemoryPolicy data_memory_policy_value = MEMORY_POLICY_DEFAULT;
+static size_t data_huge_page_threshold_value = DATA_HUGE_PAGE_THRESHOLD;
+static DataCounters data_counters;
+
+
 // -------------------------------------------------------------------------- //
 // Supplementary functions
 // -------------------------------------------------------------------------- //
@@ -36,39 +80,220 @@ void* xmalloc_protected(long size) {
 
 
 /**
- * Allocates a memory block aligned to a 32-byte boundary. <br>
- * Much like the one from ipp, but uses xmalloc provided by ruby. <br>
+ * Tells ruby gc about memory it doesn't manage itself, so that large mapped blocks still trigger collection.
+ */
+static void data_adjust_gc(long diff) {
+#ifdef HAVE_RB_GC_ADJUST_MEMORY_USAGE
+  rb_gc_adjust_memory_usage(diff);
+#else
+  (void) diff;
+#endif
+}
+
+
+#ifdef HAVE_SYS_MMAN_H
+/**
+ * Maps anonymous memory aligned to DATA_HUGE_PAGE_SIZE, so that it can be backed by transparent huge pages.
+ *
+ * @returns mapped memory, or NULL in case of an error
+ */
+static void* data_map_aligned(size_t size) {
+  char* ptr;
+  char* result;
+  size_t head;
+
+  ptr = (char*) mmap(NULL, size + DATA_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if(ptr == (char*) MAP_FAILED)
+    return NULL;
+
+  result = (char*) (((size_t) ptr + DATA_HUGE_PAGE_SIZE - 1) & ~((size_t) DATA_HUGE_PAGE_SIZE - 1));
+  head = result - ptr;
+  if(head > 0)
+    munmap(ptr, head);
+  munmap(result + size, DATA_HUGE_PAGE_SIZE - head);
+
+  return result;
+}
+#endif
+
+
+/**
+ * Allocates a memory block of the given size with the allocator chosen by the memory policy, falls back to xmalloc if huge pages aren't available.
+ *
+ * @param size size of block in bytes
+ * @param header (out) header of the block
+ * @returns a pointer to a newly allocated block, or NULL in case of an error
+ */
+static void* data_block_alloc(size_t size, DataBlockHeader* header) {
+  DataCounters* stats = &data_counters;
+  MemoryPolicy policy;
+  void* ptr = NULL;
+  size_t live, peak;
+
+  policy = size >= data_huge_page_threshold_value ? data_memory_policy_value : MEMORY_POLICY_DEFAULT;
+  header->size = size;
+  /* xmalloc and gc accounting may raise or start gc, which threads unknown to ruby, e.g. pool workers, must not do */
+  header->native = !ruby_native_thread_p();
+
+#ifdef HAVE_SYS_MMAN_H
+  if(policy != MEMORY_POLICY_DEFAULT)
+    header->size = (size + DATA_HUGE_PAGE_SIZE - 1) & ~((size_t) DATA_HUGE_PAGE_SIZE - 1);
+
+#  ifdef MAP_HUGETLB
+  if(policy == MEMORY_POLICY_HUGETLB) {
+    /* Fails unless huge pages are reserved in /proc/sys/vm/nr_hugepages */
+    ptr = mmap(NULL, header->size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if(ptr == MAP_FAILED)
+      ptr = NULL;
+    else
+      header->kind = DATA_BLOCK_HUGETLB;
+  }
+#  endif
+
+  if(ptr == NULL && policy != MEMORY_POLICY_DEFAULT && (ptr = data_map_aligned(header->size)) != NULL) {
+#  ifdef MADV_HUGEPAGE
+    madvise(ptr, header->size, MADV_HUGEPAGE);
+#  endif
+    header->kind = DATA_BLOCK_THP;
+  }
+#endif
+
+  if(ptr == NULL) {
+    header->size = size;
+    ptr = header->native ? malloc(size) : xmalloc_protected((long) size);
+    if(ptr == NULL)
+      return NULL;
+    header->kind = DATA_BLOCK_HEAP;
+  } else if(!header->native)
+    data_adjust_gc((long) header->size);
+
+  if((policy == MEMORY_POLICY_HUGETLB && header->kind != DATA_BLOCK_HUGETLB) || (policy == MEMORY_POLICY_THP && header->kind != DATA_BLOCK_THP))
+    ATOMIC_INC(&stats->fallbacks);
+
+  header->ptr = ptr;
+  ATOMIC_INC(&stats->blocks[header->kind]);
+  ATOMIC_ADD_SIZE(&stats->bytes[header->kind], header->size);
+  ATOMIC_INC(&stats->allocations[header->kind]);
+  live = ATOMIC_ADD_SIZE(&stats->liveBytes, header->size);
+  peak = ATOMIC_LOAD_SIZE(&stats->peakBytes);
+  while(live > peak && !ATOMIC_CAS_SIZE(&stats->peakBytes, peak, live)); /* failed CAS reloads peak */
+
+  return ptr;
+}
+
+
+/**
+ * Frees a memory block allocated by data_block_alloc.
+ */
+static void data_block_free(const DataBlockHeader* header) {
+  DataCounters* stats = &data_counters;
+
+  ATOMIC_DEC(&stats->blocks[header->kind]);
+  ATOMIC_SUB_SIZE(&stats->bytes[header->kind], header->size);
+  ATOMIC_SUB_SIZE(&stats->liveBytes, header->size);
+
+#ifdef HAVE_SYS_MMAN_H
+  if(header->kind != DATA_BLOCK_HEAP) {
+    munmap(header->ptr, header->size);
+    if(!header->native)
+      data_adjust_gc(-(long) header->size);
+    return;
+  }
+#endif
+
+  if(header->native)
+    free(header->ptr);
+  else
+    xfree(header->ptr); /* doesn't need the GVL, so the last reference may be released by any thread */
+}
+
+
+/**
+ * @returns header of a block returned by ipp4rMalloc
+ */
+static DataBlockHeader* data_block_header(void* ptr) {
+  return (DataBlockHeader*) (((size_t) ptr - sizeof(DataBlockHeader)) & ~((size_t) DATA_HEADER_ALIGNMENT - 1));
+}
+
+
+/**
+ * Allocates a memory block for image rows, aligned to a data_alignment boundary. <br>
+ * Much like the one from ipp, but uses xmalloc provided by ruby, or huge pages for large blocks depending on the memory policy. <br>
+ * Block is placed so that the byte at the given offset is aligned, i.e. the block itself is aligned only if offset is a multiple of alignment.
  * 
+ * @param width row width in pixels
+ * @param height number of rows
+ * @param metaType metatype of pixels
+ * @param offset offset of the byte to align in the first row
+ * @param wStep (out) row step as returned by data_row_step
  * @returns a pointer to a newly allocated block, or NULL in case of an error
  */
-static void* ipp4rMalloc(int width, int height, IppMetaType metaType, int* wStep) {
+static void* ipp4rMalloc(int width, int height, IppMetaType metaType, int offset, int* wStep) {
+  DataBlockHeader header;
   char* ptr;
   char* result;
+  int alignment;
 
-  assert(width > 0 && height > 0);
+  assert(width > 0 && height > 0 && offset >= 0);
 
-  *wStep = (width * metatype_pixel_size(metaType) + 32 - 1) & -32;
+  alignment = data_alignment();
+  offset %= alignment;
+  *wStep = data_row_step(width * metatype_pixel_size(metaType));
 
-  ptr = xmalloc_protected(*wStep * height + 32 + sizeof(char*) - 1);
+  ptr = data_block_alloc((size_t) *wStep * height + 2 * alignment + sizeof(DataBlockHeader) + DATA_HEADER_ALIGNMENT - 1, &header);
   if(ptr == NULL)
     return NULL;
 
-  result = (char*)((long)(ptr + 32 - 1) & -32);
-  if(result - ptr < sizeof(char*))
-    result += 32;
-  *((char**)result - 1) = ptr;
+  result = (char*) (((size_t) ptr + sizeof(DataBlockHeader) + DATA_HEADER_ALIGNMENT - 1 + alignment - 1) & ~((size_t) alignment - 1));
+  result += (alignment - offset) % alignment;
+  *data_block_header(result) = header;
+  ATOMIC_INIT(&data_block_header(result)->refs, 1);
 
   return result;
 }
 
 
 /**
- * Frees a memory block allocated by ipp4rMalloc
+ * Releases a reference to a memory block allocated by ipp4rMalloc, the block is freed with the last one.
  */
 static void ipp4rFree(void* ptr) {
+  DataBlockHeader* header;
+
   assert(ptr != NULL);
 
-  xfree(*((char**)ptr - 1));
+  header = data_block_header(ptr);
+  assert(ATOMIC_LOAD(&header->refs) > 0);
+  if(ATOMIC_DEC(&header->refs) == 0)
+    data_block_free(header);
+}
+
+
+/**
+ * Creates a single-channel view of a plane of planar data. View doesn't own its buffer, and is referenced and destroyed together with the planar data.
+ *
+ * @returns newly allocated Data, or NULL in case of an error
+ */
+static Data* data_new_plane(Data* planar, int plane) {
+  Data* data;
+
+  data = (Data*) malloc(sizeof(Data));
+  if(data == NULL)
+    return NULL;
+
+  *data = *planar;
+  data->metaType = metatype_compose(metatype_datatype(planar->metaType), ippC1);
+  data->buffer = (char*) planar->buffer + plane * planar->planeStep;
+  data->pixels = (char*) planar->pixels + plane * planar->planeStep;
+  data->planeStep = 0;
+  memset(data->planes, 0, sizeof(data->planes));
+  data->ownsBuffer = FALSE;
+  data->shared = TRUE; /* Registered in ruby gc through the planar data */
+  ATOMIC_INIT(&data->refs, 0);
+  data->owner = planar;
+
+  IF_TRACE(data_count++;)
+
+  return data;
 }
 
 
@@ -76,7 +301,7 @@ static void ipp4rFree(void* ptr) {
 // data_new
 // -------------------------------------------------------------------------- //
 TRACE_FUNC(Data*, data_new, (int width, int height, IppMetaType metaType, int border)) {
-  int wStep;
+  int wStep, planes, i;
   Data* data;
   void* buffer;
 
@@ -89,7 +314,8 @@ TRACE_FUNC(Data*, data_new, (int width, int height, IppMetaType metaType, int bo
   if(data == NULL)
     TRACE_RETURN(NULL);
 
-  buffer = ipp4rMalloc(width + 2 * border, height + 2 * border, metaType, &wStep); 
+  planes = metatype_planes(metaType);
+  buffer = ipp4rMalloc(width + 2 * border, planes * (height + 2 * border), metaType, data_align_interior() ? border * metatype_pixel_size(metaType) : 0, &wStep); 
   if(buffer == NULL) {
     free(data);
     TRACE_RETURN(NULL);
@@ -102,11 +328,28 @@ TRACE_FUNC(Data*, data_new, (int width, int height, IppMetaType metaType, int bo
   data->wStep = wStep;
   data->pixelSize = metatype_pixel_size(metaType);
   data->border = border;
+  data->planeStep = planes > 1 ? wStep * (height + 2 * border) : 0;
+  memset(data->planes, 0, sizeof(data->planes));
+  data->ownsBuffer = TRUE;
 
   data->shared = FALSE; /* Initially data is not shared */
+  ATOMIC_INIT(&data->refs, 1); /* Creator's reference */
+  data->owner = NULL;
+
+  data->stamp = 0;
+  data->cache = NULL;
 
   data->pixels = (char*) data->buffer + data->border * (data->wStep + data->pixelSize); /* pixels points to the "beginning" of an image */
 
+  numa_first_touch(data->buffer, wStep, planes * (height + 2 * border));
+
+  for(i = 0; i < planes && planes > 1; i++) {
+    if((data->planes[i] = data_new_plane(data, i)) == NULL) {
+      data_destroy(data);
+      TRACE_RETURN(NULL);
+    }
+  }
+
   IF_TRACE(data_count++;)
   TRACE(("data_count=%d", data_count));
   TRACE(("%08X w=%d h=%d b=%d m=%d buf=%08X", data, width, height, border, metaType, buffer));
@@ -119,23 +362,215 @@ TRACE_FUNC(Data*, data_new, (int width, int height, IppMetaType metaType, int bo
 // data_destroy
 // -------------------------------------------------------------------------- //
 TRACE_FUNC(void, data_destroy, (Data* data)) {
+  int i;
+
   assert(data != NULL);
 
   IF_TRACE(data_count--;)
   TRACE(("data_count=%d", data_count));
   TRACE(("%08X w=%d h=%d m=%d buf=%08X", data, data->width, data->height, data->metaType, data->buffer));
 
-  ipp4rFree(data->buffer);
+  if(data->cache != NULL)
+    data_destroy(data->cache);
+  for(i = 0; i < C_MAX_COUNT; i++)
+    if(data->planes[i] != NULL)
+      data_destroy(data->planes[i]);
+  if(data->ownsBuffer)
+    ipp4rFree(data->buffer);
   free(data);
 } TRACE_END
 
 
+// -------------------------------------------------------------------------- //
+// data_retain
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(Data*, data_retain, (Data* data)) {
+  assert(data != NULL);
+
+  if(data->owner != NULL)
+    data_retain(data->owner);
+  else
+    ATOMIC_INC(&data->refs);
+
+  TRACE_RETURN(data);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// data_release
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(void, data_release, (Data* data)) {
+  assert(data != NULL);
+
+  if(data->owner != NULL) {
+    data_release(data->owner);
+    TRACE_RETURN_0();
+  }
+
+  assert(ATOMIC_LOAD(&data->refs) > 0);
+  if(ATOMIC_DEC(&data->refs) == 0)
+    data_destroy(data);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// data_share
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(Data*, data_share, (Data* data)) {
+  Data* result;
+
+  assert(data != NULL);
+
+  /* Plane views point into the buffer of planar data, and planar data owns them. */
+  if(!data->ownsBuffer || data->planeStep != 0)
+    TRACE_RETURN(NULL);
+
+  result = (Data*) malloc(sizeof(Data));
+  if(result == NULL)
+    TRACE_RETURN(NULL);
+
+  *result = *data;
+  result->shared = FALSE;
+  ATOMIC_INIT(&result->refs, 1);
+  result->stamp = 0;
+  result->cache = NULL;
+  ATOMIC_INC(&data_block_header(data->buffer)->refs);
+
+  IF_TRACE(data_count++;)
+  TRACE(("%08X shares buf=%08X of %08X", result, data->buffer, data));
+
+  TRACE_RETURN(result);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// data_unshare
+// -------------------------------------------------------------------------- //
+TRACE_FUNC(int, data_unshare, (Data* data)) {
+  int wStep, rows, rowSize, y;
+  char* buffer;
+
+  assert(data != NULL);
+
+  if(!data_shares_buffer(data))
+    TRACE_RETURN(ippStsNoErr);
+
+  rows = data->height + 2 * data->border;
+  rowSize = (data->width + 2 * data->border) * data->pixelSize;
+  buffer = ipp4rMalloc(data->width + 2 * data->border, rows, data->metaType, data_align_interior() ? data->border * data->pixelSize : 0, &wStep);
+  if(buffer == NULL)
+    TRACE_RETURN(ippStsNoMemErr);
+
+  for(y = 0; y < rows; y++)
+    memcpy(buffer + (size_t) y * wStep, (char*) data->buffer + (size_t) y * data->wStep, rowSize);
+
+  TRACE(("%08X buf=%08X -> %08X", data, data->buffer, buffer));
+
+  ipp4rFree(data->buffer);
+  data->buffer = buffer;
+  data->wStep = wStep;
+  data->pixels = buffer + data->border * (wStep + data->pixelSize);
+
+  TRACE_RETURN(ippStsNoErr);
+} TRACE_END
+
+
+// -------------------------------------------------------------------------- //
+// data_shares_buffer
+// -------------------------------------------------------------------------- //
+int data_shares_buffer(Data* data) {
+  assert(data != NULL);
+
+  return data->ownsBuffer && ATOMIC_LOAD(&data_block_header(data->buffer)->refs) > 1;
+}
+
+
+// -------------------------------------------------------------------------- //
+// Alignment
+// -------------------------------------------------------------------------- //
+int data_alignment(void) {
+  if(data_alignment_value != 0)
+    return data_alignment_value;
+  else
+    return dispatch_cpu_tier() >= CPU_TIER_AVX512 ? 64 : 32;
+}
+
+int data_set_alignment(int alignment) {
+  if(alignment != 0 && (alignment < DATA_ALIGNMENT_MIN || alignment > DATA_ALIGNMENT_MAX || (alignment & (alignment - 1)) != 0))
+    return ippStsBadArgErr;
+
+  data_alignment_value = alignment;
+  return ippStsNoErr;
+}
+
+int data_align_interior(void) {
+  return data_align_interior_value;
+}
+
+void data_set_align_interior(int alignInterior) {
+  data_align_interior_value = alignInterior ? TRUE : FALSE;
+}
+
+int data_row_step(int rowSize) {
+  int alignment, step;
+
+  assert(rowSize > 0);
+
+  alignment = data_alignment();
+  step = (rowSize + alignment - 1) & -alignment;
+
+  /* Rows that map to the same cache sets make column passes thrash L1, pad them by one alignment unit. */
+  if(step % DATA_ALIAS_PERIOD == 0 || (step >= DATA_ALIAS_MIN_STEP && (step & (step - 1)) == 0))
+    step += alignment;
+
+  return step;
+}
+
+
+// -------------------------------------------------------------------------- //
+// Memory policy
+// -------------------------------------------------------------------------- //
+MemoryPolicy data_memory_policy(void) {
+  return data_memory_policy_value;
+}
+
+void data_set_memory_policy(MemoryPolicy policy) {
+  assert(policy >= MEMORY_POLICY_DEFAULT && policy <= MEMORY_POLICY_HUGETLB);
+
+  data_memory_policy_value = policy;
+}
+
+size_t data_huge_page_threshold(void) {
+  return data_huge_page_threshold_value;
+}
+
+void data_set_huge_page_threshold(size_t threshold) {
+  data_huge_page_threshold_value = threshold;
+}
+
+void data_stats(DataStats* stats) {
+  int i;
+
+  assert(stats != NULL);
+
+  for(i = 0; i < DATA_BLOCK_KIND_COUNT; i++) {
+    stats->blocks[i] = ATOMIC_LOAD(&data_counters.blocks[i]);
+    stats->bytes[i] = ATOMIC_LOAD_SIZE(&data_counters.bytes[i]);
+    stats->allocations[i] = ATOMIC_LOAD(&data_counters.allocations[i]);
+  }
+  stats->fallbacks = ATOMIC_LOAD(&data_counters.fallbacks);
+  stats->liveBytes = ATOMIC_LOAD_SIZE(&data_counters.liveBytes);
+  stats->peakBytes = ATOMIC_LOAD_SIZE(&data_counters.peakBytes);
+}
+
+
 // -------------------------------------------------------------------------- //
 // data_swap
 // -------------------------------------------------------------------------- //
 TRACE_FUNC(void, data_swap, (Data* l, Data* r)) {
   Data tmp;
-  int intTmp;
+  Data* ptrTmp;
+  int intTmp, i;
 
   tmp = *l;
   *l = *r;
@@ -146,6 +581,23 @@ TRACE_FUNC(void, data_swap, (Data* l, Data* r)) {
   intTmp = l->shared;
   l->shared = r->shared;
   r->shared = intTmp;
+
+  /* Same goes for references - they are held to the structure, not to its contents. */
+  intTmp = ATOMIC_LOAD(&l->refs);
+  ATOMIC_INIT(&l->refs, ATOMIC_LOAD(&r->refs));
+  ATOMIC_INIT(&r->refs, intTmp);
+
+  ptrTmp = l->owner;
+  l->owner = r->owner;
+  r->owner = ptrTmp;
+
+  /* Plane views moved together with the buffer, so they have new owners. */
+  for(i = 0; i < C_MAX_COUNT; i++) {
+    if(l->planes[i] != NULL)
+      l->planes[i]->owner = l;
+    if(r->planes[i] != NULL)
+      r->planes[i]->owner = r;
+  }
 } TRACE_END
 
 
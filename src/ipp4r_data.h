@@ -4,15 +4,71 @@
 #include <ippdefs.h>
 #include "ipp4r_fwd.h"
 #include "ipp4r_metatype.h"
+#include "ipp4r_atomic.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// -------------------------------------------------------------------------- //
+// Defines
+// -------------------------------------------------------------------------- //
+#define DATA_ALIGNMENT_MIN 16     /**< Minimal configurable alignment of image rows */
+#define DATA_ALIGNMENT_MAX 4096   /**< Maximal configurable alignment of image rows */
+#define DATA_ALIAS_PERIOD 4096    /**< Addresses that differ by a multiple of this value map to the same L1 cache set */
+#define DATA_ALIAS_MIN_STEP 512   /**< Minimal power-of-two row step that is padded to avoid cache set conflicts */
+
+#define DATA_HUGE_PAGE_SIZE (2 << 20)         /**< Size of huge page, mapped blocks are rounded up to it */
+#define DATA_HUGE_PAGE_THRESHOLD (32 << 20)   /**< Default minimal size of block allocated according to the memory policy */
+
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/**
+ * Memory policy, i.e. the way image buffers not smaller than data_huge_page_threshold are allocated. Smaller ones always come from the ruby heap. <p>
+ *
+ * Huge pages cut TLB misses of column passes over large images. Policies other than the default one need mmap,
+ * and fall back to the next one if the system can't provide memory of the kind requested: hugetlb to thp, and thp to default.
+ */
+typedef enum {
+  MEMORY_POLICY_DEFAULT,  /**< ruby heap, i.e. xmalloc */
+  MEMORY_POLICY_THP,      /**< anonymous mapping advised to use transparent huge pages with madvise */
+  MEMORY_POLICY_HUGETLB   /**< mapping from the reserved huge page pool, MAP_HUGETLB */
+} MemoryPolicy;
+
+
+/**
+ * Kind of allocated image buffer
+ */
+typedef enum {
+  DATA_BLOCK_HEAP,
+  DATA_BLOCK_THP,
+  DATA_BLOCK_HUGETLB,
+  DATA_BLOCK_KIND_COUNT
+} DataBlockKind;
+
+
+/**
+ * Allocation statistics of image buffers. Counters are updated atomically, but a snapshot of them isn't, so fields may be off by allocations made while it's taken.
+ */
+typedef struct {
+  int blocks[DATA_BLOCK_KIND_COUNT];       /**< number of live blocks of each kind */
+  size_t bytes[DATA_BLOCK_KIND_COUNT];     /**< size of live blocks of each kind */
+  int allocations[DATA_BLOCK_KIND_COUNT];  /**< number of blocks of each kind allocated so far */
+  int fallbacks;                           /**< number of allocations that didn't get the memory kind requested by the policy */
+  size_t liveBytes;                        /**< size of all live blocks */
+  size_t peakBytes;                        /**< maximal value of liveBytes so far */
+} DataStats;
+
+
 
 /**
  * Data stores real image parameters, not the ROI ones, like Image does.
- * One instance of Data is shared between several instances of Image.
+ * One instance of Data is shared between several instances of Image. <p>
+ *
+ * Lifetime of Data is reference counted: its creator holds the first reference, and anyone who needs the data to stay alive,
+ * e.g. the ruby wrapper or a native thread that works without the GVL, holds one more. Plane views share the counter of their planar data.
  */
 struct _Data {
   IppMetaType metaType; /**< metatype of an image */
@@ -25,13 +81,29 @@ struct _Data {
   int pixelSize;        /**< size of one image pixel in bytes */
   int border;           /**< image border size */ 
 
+  int planeStep;        /**< distance between planes in bytes for planar metatypes, 0 for interleaved ones */
+  Data* planes[C_MAX_COUNT]; /**< single-channel views of the planes for planar metatypes, NULL for interleaved ones */
+  int ownsBuffer;       /**< Must buffer be freed with this data structure? FALSE for plane views, which point into the buffer of planar data. */
+
   int shared;           /**< Is this data structure already registered in ruby gc and is shared between several images? 
                          *   I.e. mustn't we deallocate it when freeing the corresponding image? */
+  ATOMIC_INT refs;      /**< number of references to this data structure, unused for plane views */
+  Data* owner;          /**< planar data that owns this plane view, NULL for other data */
+
+  int stamp;            /**< modification counter, incremented by every operation that changes pixels in place */
+
+  Data* cache;          /**< converted copy of a region of this data, reused when the same image is drawn repeatedly, or NULL */
+  IppiRect cacheRect;   /**< region of this data stored in cache */
+  int cachePremultiplied; /**< are color channels of cache premultiplied by alpha? */
+  int cacheStamp;       /**< value of stamp at the moment cache was filled */
 };
 
 
 /**
- * Allocates memory for Data of given size.
+ * Allocates memory for Data of given size. <br>
+ * Planes of a planar metatype are stored one after another in a single buffer, each with its own border,
+ * and a single-channel Data view is created for each of them. <br>
+ * May be called by threads unknown to ruby, e.g. pool workers, buffers are allocated with malloc there.
  * 
  * @returns newly allocated Data, or NULL in case of an error.
  */
@@ -39,17 +111,124 @@ Data* data_new(int width, int height, IppMetaType metaType, int border);
 
 
 /**
- * Frees memory occupied by Data structure.
+ * Frees memory occupied by Data structure, regardless of references. Must be used only for Data that nobody else references, use data_release otherwise.
  */
 void data_destroy(Data* data);
 
 
 /**
- * Swaps fields of two given Data structures.
+ * Takes a reference to Data, or to its planar data for a plane view. Safe to call from any thread, provided the caller already holds a reference.
+ *
+ * @returns the given Data
+ */
+Data* data_retain(Data* data);
+
+
+/**
+ * Releases a reference to Data, or to its planar data for a plane view. Data is destroyed with the last reference. Safe to call from any thread.
+ */
+void data_release(Data* data);
+
+
+/**
+ * Swaps contents of two given Data structures, i.e. everything but references, which belong to the structures themselves.
+ * Like any in-place change, must not run concurrently with other users of either Data.
  */
 void data_swap(Data* l, Data* r);
 
 
+/**
+ * Creates Data that shares the buffer of the given one copy-on-write: the buffer is reference counted,
+ * and the first in-place change of either Data must be preceded by data_unshare, which gives it a private copy. <br>
+ * Planar data and its plane views can't be shared this way.
+ *
+ * @returns newly allocated Data, or NULL in case of an error or if the given Data can't be shared
+ */
+Data* data_share(Data* data);
+
+
+/**
+ * Makes the buffer of the given Data private, i.e. copies it if it's shared copy-on-write with other Data. Must be called before any in-place change of pixels.
+ *
+ * @returns ippStsNoErr if everything went OK, ippStsNoMemErr if the copy couldn't be allocated
+ */
+int data_unshare(Data* data);
+
+
+/**
+ * @returns TRUE if the buffer of the given Data is shared copy-on-write with other Data
+ */
+int data_shares_buffer(Data* data);
+
+
+/**
+ * @returns alignment of image rows in bytes. Unless set with data_set_alignment, it's 64 on AVX-512 capable CPUs and 32 on others.
+ */
+int data_alignment(void);
+
+
+/**
+ * Sets alignment of image rows for newly allocated Data.
+ *
+ * @param alignment power of two between DATA_ALIGNMENT_MIN and DATA_ALIGNMENT_MAX, or 0 to restore the default one
+ * @returns ippStsNoErr if everything went OK, ippStsBadArgErr for a wrong alignment
+ */
+int data_set_alignment(int alignment);
+
+
+/**
+ * @returns TRUE if the first interior pixel of newly allocated Data is aligned, FALSE if the buffer start is. FALSE by default.
+ */
+int data_align_interior(void);
+
+
+/**
+ * Sets whether the first interior pixel, and therefore every interior row, of newly allocated Data must be aligned rather than the buffer start.
+ */
+void data_set_align_interior(int alignInterior);
+
+
+/**
+ * Computes the step of image rows of the given size. Step is rounded up to data_alignment,
+ * and padded by one more alignment unit if rows would otherwise map to the same cache sets, i.e. for multiples of DATA_ALIAS_PERIOD
+ * and powers of two starting from DATA_ALIAS_MIN_STEP.
+ *
+ * @param rowSize size of row in bytes
+ * @returns row step in bytes
+ */
+int data_row_step(int rowSize);
+
+
+/**
+ * @returns memory policy of image buffers
+ */
+MemoryPolicy data_memory_policy(void);
+
+
+/**
+ * Sets memory policy of newly allocated image buffers.
+ */
+void data_set_memory_policy(MemoryPolicy policy);
+
+
+/**
+ * @returns minimal size in bytes of image buffer allocated according to the memory policy, DATA_HUGE_PAGE_THRESHOLD by default
+ */
+size_t data_huge_page_threshold(void);
+
+
+/**
+ * Sets minimal size in bytes of image buffer allocated according to the memory policy.
+ */
+void data_set_huge_page_threshold(size_t threshold);
+
+
+/**
+ * Retrieves allocation statistics of image buffers.
+ */
+void data_stats(DataStats* stats);
+
+
 #ifdef __cplusplus
 }
 #endif
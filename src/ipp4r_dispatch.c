@@ -0,0 +1,250 @@
+#include <assert.h>
+#include "ipp4r.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#  include <intrin.h>
+#  define DISPATCH_X86_MSC
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  include <cpuid.h>
+#  define DISPATCH_X86_GNUC
+#endif
+
+
+// -------------------------------------------------------------------------- //
+// Local variables
+// -------------------------------------------------------------------------- //
+static DispatchTable* dispatch_tables[DISPATCH_MAX_TABLES];
+static int dispatch_count = 0;
+
+static int dispatch_features = 0;
+static CpuTier dispatch_max_tier = CPU_TIER_GENERIC;
+static CpuTier dispatch_current_tier = CPU_TIER_GENERIC;
+
+
+// -------------------------------------------------------------------------- //
+// Supplementary functions
+// -------------------------------------------------------------------------- //
+/**
+ * Executes cpuid, zeroes regs on non-x86 targets.
+ */
+static void dispatch_cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4]) {
+#if defined(DISPATCH_X86_MSC)
+  int info[4];
+
+  __cpuidex(info, (int) leaf, (int) subleaf);
+  regs[0] = info[0];
+  regs[1] = info[1];
+  regs[2] = info[2];
+  regs[3] = info[3];
+#elif defined(DISPATCH_X86_GNUC)
+  __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#else
+  regs[0] = regs[1] = regs[2] = regs[3] = 0;
+#endif
+}
+
+
+/**
+ * @returns XCR0, i.e. the register states saved by the OS. Must be called only if cpuid reports OSXSAVE.
+ */
+static Ipp64u dispatch_xgetbv(void) {
+#if defined(DISPATCH_X86_MSC) && _MSC_FULL_VER >= 160040219
+  return _xgetbv(0);
+#elif defined(DISPATCH_X86_GNUC)
+  unsigned int eax, edx;
+
+  __asm__ __volatile__("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+  return ((Ipp64u) edx << 32) | eax;
+#else
+  return 0;
+#endif
+}
+
+
+/**
+ * @returns CpuFeature flags of the CPU
+ */
+static int dispatch_detect_features(void) {
+  unsigned int regs[4], maxLeaf;
+  Ipp64u xcr0;
+  int features;
+
+  features = 0;
+  dispatch_cpuid(0, 0, regs);
+  maxLeaf = regs[0];
+  if(maxLeaf < 1)
+    return features;
+
+  dispatch_cpuid(1, 0, regs);
+  if(regs[3] & (1u << 26)) features |= CPU_FEATURE_SSE2;
+  if(regs[2] & (1u << 0))  features |= CPU_FEATURE_SSE3;
+  if(regs[2] & (1u << 9))  features |= CPU_FEATURE_SSSE3;
+  if(regs[2] & (1u << 19)) features |= CPU_FEATURE_SSE41;
+  if(regs[2] & (1u << 20)) features |= CPU_FEATURE_SSE42;
+  if(regs[2] & (1u << 23)) features |= CPU_FEATURE_POPCNT;
+
+  /* AVX state must be enabled by the OS, see Intel SDM 14.3 */
+  xcr0 = (regs[2] & (1u << 27)) ? dispatch_xgetbv() : 0;
+  if((xcr0 & 0x06) != 0x06)
+    return features;
+
+  if(regs[2] & (1u << 28)) features |= CPU_FEATURE_AVX;
+  if(regs[2] & (1u << 29)) features |= CPU_FEATURE_F16C;
+  if(regs[2] & (1u << 12)) features |= CPU_FEATURE_FMA;
+  if(maxLeaf < 7)
+    return features;
+
+  dispatch_cpuid(7, 0, regs);
+  if(regs[1] & (1u << 5))  features |= CPU_FEATURE_AVX2;
+
+  /* And so must be opmask and ZMM state */
+  if((xcr0 & 0xE0) != 0xE0)
+    return features;
+
+  if(regs[1] & (1u << 16)) features |= CPU_FEATURE_AVX512F;
+  if(regs[1] & (1u << 17)) features |= CPU_FEATURE_AVX512DQ;
+  if(regs[1] & (1u << 30)) features |= CPU_FEATURE_AVX512BW;
+  if(regs[1] & (1u << 31)) features |= CPU_FEATURE_AVX512VL;
+
+  return features;
+}
+
+
+/**
+ * @returns highest tier that the CPU with the given features supports
+ */
+static CpuTier dispatch_features_tier(int features) {
+  const int sse4 = CPU_FEATURE_SSE41 | CPU_FEATURE_SSE42 | CPU_FEATURE_POPCNT;
+  const int avx2 = sse4 | CPU_FEATURE_AVX | CPU_FEATURE_AVX2 | CPU_FEATURE_FMA | CPU_FEATURE_F16C;
+  const int avx512 = avx2 | CPU_FEATURE_AVX512F | CPU_FEATURE_AVX512DQ | CPU_FEATURE_AVX512BW | CPU_FEATURE_AVX512VL;
+
+  if((features & avx512) == avx512)
+    return CPU_TIER_AVX512;
+  else if((features & avx2) == avx2)
+    return CPU_TIER_AVX2;
+  else if((features & sse4) == sse4)
+    return CPU_TIER_SSE4;
+  else
+    return CPU_TIER_GENERIC;
+}
+
+
+/**
+ * Makes a table use the kernels of the highest tier it has, up to the given one.
+ */
+static void dispatch_select(DispatchTable* table, CpuTier tier) {
+  int t;
+
+  for(t = tier; t > CPU_TIER_GENERIC; t--)
+    if(table->variants[t] != NULL)
+      break;
+
+  table->active = table->variants[t];
+  table->tier = (CpuTier) t;
+}
+
+
+// -------------------------------------------------------------------------- //
+// dispatch_init
+// -------------------------------------------------------------------------- //
+void dispatch_init(void) {
+  dispatch_features = dispatch_detect_features();
+  dispatch_max_tier = dispatch_features_tier(dispatch_features);
+  dispatch_current_tier = dispatch_max_tier;
+
+  arith_dispatch_init();
+  convert_dispatch_init();
+  resize_dispatch_init();
+  remap_dispatch_init();
+  rotate_dispatch_init();
+  pyramid_dispatch_init();
+  colorspace_dispatch_init();
+  lut_dispatch_init();
+}
+
+
+// -------------------------------------------------------------------------- //
+// dispatch_register
+// -------------------------------------------------------------------------- //
+void dispatch_register(DispatchTable* table) {
+  assert(table != NULL && table->variants[CPU_TIER_GENERIC] != NULL);
+  assert(dispatch_count < DISPATCH_MAX_TABLES);
+
+  dispatch_select(table, dispatch_current_tier);
+  dispatch_tables[dispatch_count++] = table;
+}
+
+
+// -------------------------------------------------------------------------- //
+// dispatch_set_tier
+// -------------------------------------------------------------------------- //
+int dispatch_set_tier(CpuTier tier) {
+  int i;
+
+  if(tier < CPU_TIER_GENERIC || tier > dispatch_max_tier)
+    return ippStsBadArgErr;
+
+  dispatch_current_tier = tier;
+  for(i = 0; i < dispatch_count; i++)
+    dispatch_select(dispatch_tables[i], tier);
+
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// Accessors
+// -------------------------------------------------------------------------- //
+int dispatch_cpu_features(void) {
+  return dispatch_features;
+}
+
+CpuTier dispatch_cpu_tier(void) {
+  return dispatch_max_tier;
+}
+
+CpuTier dispatch_tier(void) {
+  return dispatch_current_tier;
+}
+
+int dispatch_table_count(void) {
+  return dispatch_count;
+}
+
+const DispatchTable* dispatch_table(int index) {
+  assert(index >= 0 && index < dispatch_count);
+
+  return dispatch_tables[index];
+}
+
+const char* dispatch_tier_name(CpuTier tier) {
+  switch(tier) {
+  case CPU_TIER_GENERIC: return "generic";
+  case CPU_TIER_SSE4:    return "sse4";
+  case CPU_TIER_AVX2:    return "avx2";
+  case CPU_TIER_AVX512:  return "avx512";
+  default:               return NULL;
+  }
+}
+
+const char* dispatch_feature_name(CpuFeature feature) {
+  switch(feature) {
+  case CPU_FEATURE_SSE2:     return "sse2";
+  case CPU_FEATURE_SSE3:     return "sse3";
+  case CPU_FEATURE_SSSE3:    return "ssse3";
+  case CPU_FEATURE_SSE41:    return "sse4_1";
+  case CPU_FEATURE_SSE42:    return "sse4_2";
+  case CPU_FEATURE_POPCNT:   return "popcnt";
+  case CPU_FEATURE_AVX:      return "avx";
+  case CPU_FEATURE_F16C:     return "f16c";
+  case CPU_FEATURE_FMA:      return "fma";
+  case CPU_FEATURE_AVX2:     return "avx2";
+  case CPU_FEATURE_AVX512F:  return "avx512f";
+  case CPU_FEATURE_AVX512DQ: return "avx512dq";
+  case CPU_FEATURE_AVX512BW: return "avx512bw";
+  case CPU_FEATURE_AVX512VL: return "avx512vl";
+  default:                   return NULL;
+  }
+}
+
+
@@ -0,0 +1,239 @@
+#ifndef __IPP4R_DISPATCH_H__
+#define __IPP4R_DISPATCH_H__
+
+#include <ippdefs.h>
+#include "arx/Preprocessor.h"
+#include "ipp4r_fwd.h"
+#include "ipp4r_metatype.h"
+
+/**
+ * @file
+ *
+ * This file defines table-driven dispatch of native kernels. <p>
+ *
+ * Each dispatched operation has a DispatchTable: an array of kernels indexed by M_INDEX for each CPU tier the operation is built for.
+ * Kernel arrays are defined over M_SUPPORTED or M_INTERLEAVED, which are prefixes of M_STORABLE, so that an IppMetaType value is an index into them.
+ * Metatypes past the end of an array, and NULL entries, have no kernel. <p>
+ *
+ * dispatch_init detects CPU features at load time and makes every table use the kernels of the highest tier that both the CPU and the build support.
+ * Tier variants are the same generic code compiled for a wider instruction set, they are built with GCC and clang on x86 only.
+ * A tiered operation lists the tiers that change the code of its kernels, per data type; on other tiers it uses the kernel of the tier below, see DISPATCH_TIER_FLOOR.
+ * extconf.rb turns off contraction of floating point expressions into FMA, so that results don't depend on the tier.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -------------------------------------------------------------------------- //
+// Config
+// -------------------------------------------------------------------------- //
+#if (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))) && (defined(__x86_64__) || defined(__i386__))
+#  define DISPATCH_USE_TIERS
+#endif
+
+#define DISPATCH_MAX_TABLES 64  /**< Maximal number of registered tables */
+
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/**
+ * CPU tier, i.e. a set of instruction set extensions that kernels are compiled for. Tiers are ordered, each one includes the previous ones.
+ */
+typedef enum {
+  CPU_TIER_GENERIC,     /**< baseline of the build */
+  CPU_TIER_SSE4,        /**< SSE4.1, SSE4.2, POPCNT */
+  CPU_TIER_AVX2,        /**< AVX, AVX2, FMA, F16C */
+  CPU_TIER_AVX512,      /**< AVX-512 F, DQ, BW, VL */
+  CPU_TIER_COUNT
+} CpuTier;
+
+
+/**
+ * CPU feature flags, as returned by dispatch_cpu_features. AVX and AVX-512 flags are set only if the OS saves the corresponding registers.
+ */
+typedef enum {
+  CPU_FEATURE_SSE2     = 0x0001,
+  CPU_FEATURE_SSE3     = 0x0002,
+  CPU_FEATURE_SSSE3    = 0x0004,
+  CPU_FEATURE_SSE41    = 0x0008,
+  CPU_FEATURE_SSE42    = 0x0010,
+  CPU_FEATURE_POPCNT   = 0x0020,
+  CPU_FEATURE_AVX      = 0x0040,
+  CPU_FEATURE_F16C     = 0x0080,
+  CPU_FEATURE_FMA      = 0x0100,
+  CPU_FEATURE_AVX2     = 0x0200,
+  CPU_FEATURE_AVX512F  = 0x0400,
+  CPU_FEATURE_AVX512DQ = 0x0800,
+  CPU_FEATURE_AVX512BW = 0x1000,
+  CPU_FEATURE_AVX512VL = 0x2000
+} CpuFeature;
+
+
+/**
+ * Generic kernel pointer. Kernels are stored in this form and cast back to their own type by DISPATCH_KERNEL.
+ */
+typedef void (*DispatchFunc)(void);
+
+
+/**
+ * Dispatched operation
+ */
+typedef struct {
+  const char* name;                             /**< name of an operation */
+  int size;                                     /**< number of entries in each kernel array */
+  const DispatchFunc* variants[CPU_TIER_COUNT]; /**< kernel array for each tier, NULL for tiers the operation isn't built for */
+  const DispatchFunc* active;                   /**< kernel array in use */
+  CpuTier tier;                                 /**< tier of the kernel array in use */
+} DispatchTable;
+
+
+// -------------------------------------------------------------------------- //
+// Defines
+// -------------------------------------------------------------------------- //
+/* Tiers that kernels are built for, with names used in kernel names and target attributes of kernels */
+#ifdef DISPATCH_USE_TIERS
+#  define DISPATCH_TIERS (4, (generic, sse4, avx2, avx512))
+#  define DISPATCH_TARGET_generic __attribute__((unused))
+#  define DISPATCH_TARGET_sse4    __attribute__((target("sse4.1,sse4.2,popcnt")))
+#  define DISPATCH_TARGET_avx2    __attribute__((target("avx2,f16c")))
+#  define DISPATCH_TARGET_avx512  __attribute__((target("avx512f,avx512dq,avx512bw,avx512vl,avx2,f16c")))
+#else
+#  define DISPATCH_TIERS (1, (generic))
+#  define DISPATCH_TARGET_generic
+#endif
+
+#define DISPATCH_TIER_INDEX_generic 0
+#define DISPATCH_TIER_INDEX_sse4    1
+#define DISPATCH_TIER_INDEX_avx2    2
+#define DISPATCH_TIER_INDEX_avx512  3
+
+/**
+ * Function specifiers of a kernel compiled for TIER.
+ */
+#define DISPATCH_TARGET(TIER) ARX_JOIN(DISPATCH_TARGET_, TIER)
+
+
+/**
+ * @returns 1 if TIERS, an ARX array of tier names, contains TIER, 0 otherwise
+ */
+#define DISPATCH_HAS_TIER(TIERS, TIER) ARX_ARRAY_EXISTS(TIERS, DISPATCH_TIER_EQ, TIER)
+#define DISPATCH_TIER_EQ(TIER_0, TIER_1) ARX_EQUAL(ARX_JOIN(DISPATCH_TIER_INDEX_, TIER_0), ARX_JOIN(DISPATCH_TIER_INDEX_, TIER_1))
+
+
+/**
+ * @returns the highest tier of TIERS that is not above TIER, i.e. the tier of the kernel used on TIER. TIERS must contain generic.
+ */
+#define DISPATCH_TIER_FLOOR(TIERS, TIER) ARX_JOIN(DISPATCH_TIER_FLOOR_, TIER)(TIERS)
+#define DISPATCH_TIER_FLOOR_generic(TIERS) generic
+#define DISPATCH_TIER_FLOOR_sse4(TIERS) ARX_IF(DISPATCH_HAS_TIER(TIERS, sse4), sse4, DISPATCH_TIER_FLOOR_generic(TIERS))
+#define DISPATCH_TIER_FLOOR_avx2(TIERS) ARX_IF(DISPATCH_HAS_TIER(TIERS, avx2), avx2, DISPATCH_TIER_FLOOR_sse4(TIERS))
+#define DISPATCH_TIER_FLOOR_avx512(TIERS) ARX_IF(DISPATCH_HAS_TIER(TIERS, avx512), avx512, DISPATCH_TIER_FLOOR_avx2(TIERS))
+
+
+/**
+ * Defines a kernel array NAME over metatype LIST, which must be M_SUPPORTED or M_INTERLEAVED. Entry for metatype M is <tt>KERNEL(M, ARG)</tt>.
+ */
+#define DEFINE_DISPATCH_KERNELS(NAME, LIST, KERNEL, ARG)                        \
+  static const DispatchFunc NAME[] = { ARX_ARRAY_FOREACH(LIST, DISPATCH_KERNELS_ENTRY, (KERNEL, ARG)) };
+#define DISPATCH_KERNELS_ENTRY(M, KERNEL_ARG)                                   \
+  (DispatchFunc) ARX_TUPLE_ELEM(2, 0, KERNEL_ARG)(M, ARX_TUPLE_ELEM(2, 1, KERNEL_ARG)),
+
+
+/**
+ * Defines a DispatchTable VAR for an operation that has the generic kernel array <tt>PREFIX_generic</tt> only.
+ */
+#define DEFINE_DISPATCH_TABLE(VAR, NAME, PREFIX)                                \
+  static DispatchTable VAR = {NAME, DISPATCH_LENGTH(ARX_JOIN(PREFIX, _generic)), {ARX_JOIN(PREFIX, _generic)}, ARX_JOIN(PREFIX, _generic), CPU_TIER_GENERIC};
+
+/**
+ * Defines a DispatchTable VAR for an operation that has a kernel array <tt>PREFIX_TIER</tt> for each of DISPATCH_TIERS.
+ */
+#define DEFINE_DISPATCH_TIERED_TABLE(VAR, NAME, PREFIX)                         \
+  static DispatchTable VAR = {NAME, DISPATCH_LENGTH(ARX_JOIN(PREFIX, _generic)), {ARX_ARRAY_FOREACH(DISPATCH_TIERS, DISPATCH_TABLE_VARIANT, PREFIX)}, ARX_JOIN(PREFIX, _generic), CPU_TIER_GENERIC};
+#define DISPATCH_TABLE_VARIANT(TIER, PREFIX) ARX_JOIN_3(PREFIX, _, TIER),
+
+#define DISPATCH_LENGTH(A) ((int) (sizeof(A) / sizeof((A)[0])))
+
+
+/**
+ * @returns kernel of TYPE for the given metatype from TABLE, or NULL if there's none
+ */
+#define DISPATCH_KERNEL(TYPE, TABLE, METATYPE)                                  \
+  ((unsigned int) (METATYPE) < (unsigned int) (TABLE).size ? (TYPE) (TABLE).active[(METATYPE)] : (TYPE) NULL)
+
+
+// -------------------------------------------------------------------------- //
+// Function declarations
+// -------------------------------------------------------------------------- //
+/**
+ * Detects CPU features and registers the tables of all native modules. Must be called once at load time, until then all tables use generic kernels.
+ */
+void dispatch_init(void);
+
+
+/**
+ * Registers a table and makes it use the kernels of the current tier. Called by the dispatch_init functions of native modules.
+ */
+void dispatch_register(DispatchTable* table);
+
+
+/**
+ * @returns CpuFeature flags of the CPU
+ */
+int dispatch_cpu_features(void);
+
+
+/**
+ * @returns highest tier supported by the CPU
+ */
+CpuTier dispatch_cpu_tier(void);
+
+
+/**
+ * @returns tier that the kernels are selected for
+ */
+CpuTier dispatch_tier(void);
+
+
+/**
+ * Selects kernels of the given tier, or of the highest lower tier built, for all registered tables. Used to benchmark lower tiers.
+ *
+ * @param tier tier to select, must not be higher than dispatch_cpu_tier
+ * @returns ippStsNoErr if everything went OK, ippStsBadArgErr if the CPU doesn't support the given tier
+ */
+int dispatch_set_tier(CpuTier tier);
+
+
+/**
+ * @returns number of registered tables
+ */
+int dispatch_table_count(void);
+
+
+/**
+ * @returns registered table with the given index
+ */
+const DispatchTable* dispatch_table(int index);
+
+
+/**
+ * @returns name of a tier, e.g. "avx2", or NULL for an invalid one
+ */
+const char* dispatch_tier_name(CpuTier tier);
+
+
+/**
+ * @returns name of a single CPU feature flag as used by /proc/cpuinfo, e.g. "sse4_1", or NULL for an invalid one
+ */
+const char* dispatch_feature_name(CpuFeature feature);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
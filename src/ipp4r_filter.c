@@ -0,0 +1,543 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ipp4r.h"
+
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/** Reads n samples into a double buffer */
+typedef void (*FilterLoadFunc)(const void* pSrc, Ipp64f* buf, int n);
+
+/** Writes n samples from a double buffer, with rounding and saturation */
+typedef void (*FilterStoreFunc)(const Ipp64f* buf, void* pDst, int n);
+
+/** Filter parameters, only the ones relevant for a given row function are set */
+typedef struct {
+  FilterRank rank;
+  const Ipp8u* mask;
+  const Ipp64f* kernel;   /**< non-zero coefficients of a linear filter */
+  const int* taps;        /**< row and column of each non-zero coefficient, interleaved */
+  int tapCount;           /**< number of non-zero coefficients */
+  const Ipp64f* column;   /**< column factor of a separable filter */
+  const Ipp64f* row;      /**< row factor of a separable filter */
+} FilterParams;
+
+/**
+ * Filters a single row. rows[i] is the i-th neighborhood row starting at the leftmost pixel of the neighborhood of the first output pixel,
+ * i.e. output pixel x is computed over pixels x..x + maskSize.width - 1 of these rows. Only the first nproc channels of each pixel are computed.
+ */
+typedef void (*FilterRowFunc)(const Ipp64f** rows, Ipp64f* out, int width, int cnumb, int nproc, IppiSize maskSize, const FilterParams* params, Ipp64f* tmp);
+
+/** Arguments of the row loop of filter_run, shared by its tiles */
+typedef struct {
+  FilterRowFunc func;
+  const FilterParams* params;
+  int tmpSize;
+  FilterLoadFunc load;
+  FilterStoreFunc store;
+  const char* pSrc;
+  int srcStep;
+  char* pDst;
+  int dstStep;
+  IppiSize roi;
+  IppiSize maskSize;
+  IppiPoint anchor;
+  int cnumb;
+  int nproc;
+  int pixelSize;
+  int winWidth;
+  int status;           /**< set to an error by failed tiles */
+} FilterTile;
+
+
+// -------------------------------------------------------------------------- //
+// Load / store kernels
+// -------------------------------------------------------------------------- //
+/**
+ * Defines <tt>filter_load_DATATYPE</tt> and <tt>filter_store_DATATYPE</tt>.
+ */
+#define DEFINE_FILTER_LOADSTORE(DATATYPE, ARG)                                  \
+static void ARX_JOIN(filter_load_, DATATYPE)(const void* pSrc, Ipp64f* buf, int n) { \
+  const D_CTYPE(DATATYPE)* s = (const D_CTYPE(DATATYPE)*) pSrc;                 \
+  int i;                                                                        \
+                                                                                \
+  for(i = 0; i < n; i++)                                                        \
+    buf[i] = s[i];                                                              \
+}                                                                               \
+                                                                                \
+static void ARX_JOIN(filter_store_, DATATYPE)(const Ipp64f* buf, void* pDst, int n) { \
+  D_CTYPE(DATATYPE)* d = (D_CTYPE(DATATYPE)*) pDst;                             \
+  int i;                                                                        \
+                                                                                \
+  for(i = 0; i < n; i++)                                                        \
+    d[i] = FILTER_SAT(DATATYPE, buf[i]);                                        \
+}
+
+#define FILTER_SAT(D, V) IF_D_EQ_D(D, 32f, (Ipp32f) (V), IF_D_EQ_D(D, 64f, (V), ARX_JOIN(filter_sat_, D)(V)))
+
+DEFINE_D_SAT(filter_sat_, 8u, Ipp64f)
+DEFINE_D_SAT(filter_sat_, 16u, Ipp64f)
+DEFINE_D_SAT(filter_sat_, 16s, Ipp64f)
+DEFINE_D_SAT(filter_sat_, 32s, Ipp64f)
+
+ARX_ARRAY_FOREACH(D_SUPPORTED, DEFINE_FILTER_LOADSTORE, ~)
+
+#define FILTER_LOAD(M) ARX_JOIN(filter_load_, M_DATATYPE(M))
+#define FILTER_STORE(M) ARX_JOIN(filter_store_, M_DATATYPE(M))
+
+DEFINE_METATABLE_VALUES(FilterLoadFunc, filter_load_table, M_SUPPORTED, FILTER_LOAD)
+DEFINE_METATABLE_VALUES(FilterStoreFunc, filter_store_table, M_SUPPORTED, FILTER_STORE)
+
+
+// -------------------------------------------------------------------------- //
+// Row functions
+// -------------------------------------------------------------------------- //
+/**
+ * Selects k-th smallest of n values, reordering them.
+ */
+static Ipp64f filter_select(Ipp64f* v, int n, int k) {
+  int lo, hi, i, j;
+  Ipp64f pivot, t;
+
+  lo = 0;
+  hi = n - 1;
+  while(lo < hi) {
+    pivot = v[(lo + hi) / 2];
+    i = lo;
+    j = hi;
+    while(i <= j) {
+      while(v[i] < pivot)
+        i++;
+      while(v[j] > pivot)
+        j--;
+      if(i <= j) {
+        t = v[i];
+        v[i] = v[j];
+        v[j] = t;
+        i++;
+        j--;
+      }
+    }
+    if(k <= j)
+      hi = j;
+    else if(k >= i)
+      lo = i;
+    else
+      break;
+  }
+  return v[k];
+}
+
+
+/**
+ * Rank filter row, tmp must hold maskSize.width * maskSize.height values.
+ */
+static void filter_rank_row(const Ipp64f** rows, Ipp64f* out, int width, int cnumb, int nproc, IppiSize maskSize, const FilterParams* params, Ipp64f* tmp) {
+  int x, c, i, j, n;
+  Ipp64f v, r;
+
+  for(x = 0; x < width; x++) {
+    for(c = 0; c < nproc; c++) {
+      n = 0;
+      r = 0.0;
+      for(i = 0; i < maskSize.height; i++) {
+        for(j = 0; j < maskSize.width; j++) {
+          if(params->mask != NULL && params->mask[i * maskSize.width + j] == 0)
+            continue;
+
+          v = rows[i][(x + j) * cnumb + c];
+          if(params->rank == FILTER_MEDIAN)
+            tmp[n] = v;
+          else if(n == 0 || (params->rank == FILTER_MIN ? v < r : v > r))
+            r = v;
+          n++;
+        }
+      }
+      out[x * cnumb + c] = params->rank == FILTER_MEDIAN && n > 0 ? filter_select(tmp, n, n / 2) : r;
+    }
+  }
+}
+
+
+/**
+ * Minimum or maximum over a rectangular neighborhood, tmp must hold (width + maskSize.width - 1) * cnumb values.
+ * Rectangle is separable, so columns are reduced first, then a window runs along the row.
+ */
+static void filter_extreme_row(const Ipp64f** rows, Ipp64f* out, int width, int cnumb, int nproc, IppiSize maskSize, const FilterParams* params, Ipp64f* tmp) {
+  int x, c, i, j, n;
+  Ipp64f v, r;
+
+  n = (width + maskSize.width - 1) * cnumb;
+  memcpy(tmp, rows[0], n * sizeof(Ipp64f));
+  for(i = 1; i < maskSize.height; i++) {
+    for(x = 0; x < n; x++) {
+      v = rows[i][x];
+      if(params->rank == FILTER_MIN ? v < tmp[x] : v > tmp[x])
+        tmp[x] = v;
+    }
+  }
+
+  for(x = 0; x < width; x++) {
+    for(c = 0; c < nproc; c++) {
+      r = tmp[x * cnumb + c];
+      for(j = 1; j < maskSize.width; j++) {
+        v = tmp[(x + j) * cnumb + c];
+        if(params->rank == FILTER_MIN ? v < r : v > r)
+          r = v;
+      }
+      out[x * cnumb + c] = r;
+    }
+  }
+}
+
+
+/**
+ * Box filter row, tmp must hold (width + maskSize.width - 1) * cnumb values. Columns are summed first, then a sliding sum runs along the row.
+ */
+static void filter_box_row(const Ipp64f** rows, Ipp64f* out, int width, int cnumb, int nproc, IppiSize maskSize, const FilterParams* params, Ipp64f* tmp) {
+  int x, c, i, n;
+  Ipp64f sum, k;
+
+  n = (width + maskSize.width - 1) * cnumb;
+  memcpy(tmp, rows[0], n * sizeof(Ipp64f));
+  for(i = 1; i < maskSize.height; i++)
+    for(x = 0; x < n; x++)
+      tmp[x] += rows[i][x];
+
+  k = 1.0 / (maskSize.width * maskSize.height);
+  for(c = 0; c < nproc; c++) {
+    sum = 0.0;
+    for(x = 0; x < maskSize.width - 1; x++)
+      sum += tmp[x * cnumb + c];
+    for(x = 0; x < width; x++) {
+      sum += tmp[(x + maskSize.width - 1) * cnumb + c];
+      out[x * cnumb + c] = sum * k;
+      sum -= tmp[x * cnumb + c];
+    }
+  }
+}
+
+
+/**
+ * Linear filter row, params->kernel is applied as is, i.e. it's already reversed. Only non-zero coefficients are visited.
+ */
+static void filter_linear_row(const Ipp64f** rows, Ipp64f* out, int width, int cnumb, int nproc, IppiSize maskSize, const FilterParams* params, Ipp64f* tmp) {
+  int x, c, t;
+  Ipp64f sum;
+
+  for(x = 0; x < width; x++) {
+    for(c = 0; c < nproc; c++) {
+      sum = 0.0;
+      for(t = 0; t < params->tapCount; t++)
+        sum += params->kernel[t] * rows[params->taps[2 * t]][(x + params->taps[2 * t + 1]) * cnumb + c];
+      out[x * cnumb + c] = sum;
+    }
+  }
+}
+
+
+/**
+ * Separable linear filter row, tmp must hold (width + maskSize.width - 1) * cnumb values. Neighborhood rows are combined with params->column first,
+ * then params->row runs along the result. Both factors are applied as is, i.e. they're already reversed.
+ */
+static void filter_separable_row(const Ipp64f** rows, Ipp64f* out, int width, int cnumb, int nproc, IppiSize maskSize, const FilterParams* params, Ipp64f* tmp) {
+  int x, c, i, j, n;
+  Ipp64f sum;
+
+  n = (width + maskSize.width - 1) * cnumb;
+  for(x = 0; x < n; x++) {
+    sum = 0.0;
+    for(i = 0; i < maskSize.height; i++)
+      sum += params->column[i] * rows[i][x];
+    tmp[x] = sum;
+  }
+
+  for(x = 0; x < width; x++) {
+    for(c = 0; c < nproc; c++) {
+      sum = 0.0;
+      for(j = 0; j < maskSize.width; j++)
+        sum += params->row[j] * tmp[(x + j) * cnumb + c];
+      out[x * cnumb + c] = sum;
+    }
+  }
+}
+
+
+// -------------------------------------------------------------------------- //
+// Filter driver
+// -------------------------------------------------------------------------- //
+/**
+ * Filters rows [yStart, yEnd). Tile function for pool_parallel_for.
+ */
+static void filter_run_tile(void* arg, int yStart, int yEnd) {
+  FilterTile* t = (FilterTile*) arg;
+  Ipp64f* buf;
+  const Ipp64f** rows;
+  Ipp64f* out;
+  Ipp64f* tmp;
+  const char* s;
+  int y, i;
+
+  /* Buffers are shared by all rows of a tile */
+  buf = (Ipp64f*) malloc((t->maskSize.height * t->winWidth * t->cnumb + t->roi.width * t->cnumb + t->tmpSize) * sizeof(Ipp64f) + t->maskSize.height * sizeof(Ipp64f*));
+  if(buf == NULL) {
+    t->status = ippStsNoMemErr;
+    return;
+  }
+  out = buf + t->maskSize.height * t->winWidth * t->cnumb;
+  tmp = out + t->roi.width * t->cnumb;
+  rows = (const Ipp64f**) (tmp + t->tmpSize);
+
+  for(y = yStart; y < yEnd; y++) {
+    s = t->pSrc + (y - t->anchor.y) * t->srcStep - t->anchor.x * t->pixelSize;
+    for(i = 0; i < t->maskSize.height; i++) {
+      t->load(s + i * t->srcStep, buf + i * t->winWidth * t->cnumb, t->winWidth * t->cnumb);
+      rows[i] = buf + i * t->winWidth * t->cnumb;
+    }
+
+    t->func(rows, out, t->roi.width, t->cnumb, t->nproc, t->maskSize, t->params, tmp);
+
+    /* Alpha is not filtered, it's taken from the source pixel itself. */
+    if(t->nproc < t->cnumb)
+      for(i = 0; i < t->roi.width; i++)
+        out[i * t->cnumb + 3] = rows[t->anchor.y][(i + t->anchor.x) * t->cnumb + 3];
+
+    t->store(out, t->pDst + y * t->dstStep, t->roi.width * t->cnumb);
+  }
+
+  free(buf);
+}
+
+
+/**
+ * Runs the given row function over an image buffer. Neighborhood of pixel (x, y) spans from (x - anchor.x, y - anchor.y)
+ * to (x - anchor.x + maskSize.width - 1, y - anchor.y + maskSize.height - 1).
+ *
+ * @param tmpSize number of doubles in a per-thread scratch buffer passed to the row function
+ */
+static int filter_run(FilterRowFunc func, const FilterParams* params, int tmpSize, IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep,
+                      IppiSize roi, IppiSize maskSize, IppiPoint anchor) {
+  FilterLoadFunc load;
+  FilterStoreFunc store;
+  FilterTile tile;
+  int cnumb, nproc, pixelSize, winWidth;
+  void* copy;
+
+  assert(pSrc != NULL && pDst != NULL);
+
+  if(maskSize.width <= 0 || maskSize.height <= 0)
+    return ippStsMaskSizeErr;
+  if(anchor.x < 0 || anchor.y < 0 || anchor.x >= maskSize.width || anchor.y >= maskSize.height)
+    return ippStsAnchorErr;
+
+  if(!is_metatype_supported(metaType))
+    return ippStsDataTypeErr;
+
+  load = filter_load_table[metaType];
+  store = filter_store_table[metaType];
+  cnumb = metatype_cnumb(metaType);
+  nproc = metatype_channels(metaType) == ippAC4 ? 3 : cnumb;
+  pixelSize = metatype_pixel_size(metaType);
+  winWidth = roi.width + maskSize.width - 1;
+
+  /* In place, the source region with its neighborhood is copied out, so that filtered rows don't feed into the next ones. */
+  copy = NULL;
+  if(pSrc == pDst) {
+    int copyStep, i;
+    const char* s;
+
+    copyStep = winWidth * pixelSize;
+    copy = malloc(copyStep * (roi.height + maskSize.height - 1));
+    if(copy == NULL)
+      return ippStsNoMemErr;
+
+    s = (const char*) pSrc - anchor.y * srcStep - anchor.x * pixelSize;
+    for(i = 0; i < roi.height + maskSize.height - 1; i++)
+      memcpy((char*) copy + i * copyStep, s + i * srcStep, copyStep);
+
+    pSrc = (char*) copy + anchor.y * copyStep + anchor.x * pixelSize;
+    srcStep = copyStep;
+  }
+
+  tile.func = func;
+  tile.params = params;
+  tile.tmpSize = tmpSize;
+  tile.load = load;
+  tile.store = store;
+  tile.pSrc = (const char*) pSrc;
+  tile.srcStep = srcStep;
+  tile.pDst = (char*) pDst;
+  tile.dstStep = dstStep;
+  tile.roi = roi;
+  tile.maskSize = maskSize;
+  tile.anchor = anchor;
+  tile.cnumb = cnumb;
+  tile.nproc = nproc;
+  tile.pixelSize = pixelSize;
+  tile.winWidth = winWidth;
+  tile.status = ippStsNoErr;
+
+  /* Cost of a row grows with the neighborhood, so tiles get fewer rows for larger masks */
+  pool_parallel_for(roi.height, pool_tile_rows(maskSize.height * winWidth * cnumb * sizeof(Ipp64f)), filter_run_tile, &tile);
+
+  if(copy != NULL)
+    free(copy);
+
+  return tile.status;
+}
+
+
+// -------------------------------------------------------------------------- //
+// filter_rank
+// -------------------------------------------------------------------------- //
+int filter_rank(FilterRank rank, IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, const Ipp8u* mask, IppiSize maskSize, IppiPoint anchor) {
+  FilterParams params;
+
+  memset(&params, 0, sizeof(params));
+  params.rank = rank;
+  params.mask = mask;
+
+  if(mask == NULL && rank != FILTER_MEDIAN)
+    return filter_run(filter_extreme_row, &params, (roi.width + maskSize.width - 1) * C_MAX_COUNT, metaType, pSrc, srcStep, pDst, dstStep, roi, maskSize, anchor);
+  else
+    return filter_run(filter_rank_row, &params, maskSize.width * maskSize.height, metaType, pSrc, srcStep, pDst, dstStep, roi, maskSize, anchor);
+}
+
+
+// -------------------------------------------------------------------------- //
+// filter_box
+// -------------------------------------------------------------------------- //
+int filter_box(IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, IppiSize maskSize, IppiPoint anchor) {
+  FilterParams params;
+
+  memset(&params, 0, sizeof(params));
+
+  return filter_run(filter_box_row, &params, (roi.width + maskSize.width - 1) * C_MAX_COUNT, metaType, pSrc, srcStep, pDst, dstStep, roi, maskSize, anchor);
+}
+
+
+// -------------------------------------------------------------------------- //
+// filter_linear
+// -------------------------------------------------------------------------- //
+int filter_linear(IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, const Ipp32f* kernel, IppiSize kernelSize, IppiPoint anchor) {
+  FilterParams params;
+  Ipp64f* reversed;
+  int* taps;
+  IppiPoint reversedAnchor;
+  int i, n, status;
+
+  assert(kernel != NULL);
+
+  n = kernelSize.width * kernelSize.height;
+  if(n <= 0)
+    return ippStsMaskSizeErr;
+
+  /* Kernel is used in reverse order, so reversing it turns convolution into correlation, which is what filter_run computes.
+   * Zero coefficients are dropped, so that sparse kernels, e.g. derivative ones, cost only as much as their non-zero part. */
+  reversed = (Ipp64f*) malloc(n * (sizeof(Ipp64f) + 2 * sizeof(int)));
+  if(reversed == NULL)
+    return ippStsNoMemErr;
+  taps = (int*) (reversed + n);
+
+  memset(&params, 0, sizeof(params));
+  for(i = 0; i < n; i++) {
+    if(kernel[n - 1 - i] == 0.0f)
+      continue;
+    reversed[params.tapCount] = kernel[n - 1 - i];
+    taps[2 * params.tapCount] = i / kernelSize.width;
+    taps[2 * params.tapCount + 1] = i % kernelSize.width;
+    params.tapCount++;
+  }
+  reversedAnchor.x = kernelSize.width - 1 - anchor.x;
+  reversedAnchor.y = kernelSize.height - 1 - anchor.y;
+
+  params.kernel = reversed;
+  params.taps = taps;
+
+  status = filter_run(filter_linear_row, &params, 0, metaType, pSrc, srcStep, pDst, dstStep, roi, kernelSize, reversedAnchor);
+  free(reversed);
+
+  return status;
+}
+
+
+// -------------------------------------------------------------------------- //
+// filter_separable
+// -------------------------------------------------------------------------- //
+int filter_separable(IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, const Ipp32f* column, const Ipp32f* row, IppiSize kernelSize, IppiPoint anchor) {
+  FilterParams params;
+  Ipp64f* reversed;
+  IppiPoint reversedAnchor;
+  int i, status;
+
+  assert(column != NULL && row != NULL);
+
+  if(kernelSize.width <= 0 || kernelSize.height <= 0)
+    return ippStsMaskSizeErr;
+
+  /* Reversing both factors reverses their product, see filter_linear */
+  reversed = (Ipp64f*) malloc((kernelSize.width + kernelSize.height) * sizeof(Ipp64f));
+  if(reversed == NULL)
+    return ippStsNoMemErr;
+  for(i = 0; i < kernelSize.height; i++)
+    reversed[i] = column[kernelSize.height - 1 - i];
+  for(i = 0; i < kernelSize.width; i++)
+    reversed[kernelSize.height + i] = row[kernelSize.width - 1 - i];
+  reversedAnchor.x = kernelSize.width - 1 - anchor.x;
+  reversedAnchor.y = kernelSize.height - 1 - anchor.y;
+
+  memset(&params, 0, sizeof(params));
+  params.column = reversed;
+  params.row = reversed + kernelSize.height;
+
+  status = filter_run(filter_separable_row, &params, (roi.width + kernelSize.width - 1) * C_MAX_COUNT, metaType, pSrc, srcStep, pDst, dstStep, roi, kernelSize, reversedAnchor);
+  free(reversed);
+
+  return status;
+}
+
+
+// -------------------------------------------------------------------------- //
+// filter_kernel
+// -------------------------------------------------------------------------- //
+int filter_kernel(IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, const Matrix* kernel, IppiPoint anchor) {
+  assert(kernel != NULL && !kernel->isMask);
+
+  /* Two passes cost width + height multiplications per sample, the direct one costs a multiplication per non-zero coefficient */
+  if(kernel->separable && kernel->size.width + kernel->size.height < kernel->nonZero)
+    return filter_separable(metaType, pSrc, srcStep, pDst, dstStep, roi, kernel->column, kernel->row, kernel->size, anchor);
+  else
+    return filter_linear(metaType, pSrc, srcStep, pDst, dstStep, roi, (const Ipp32f*) kernel->data, kernel->size, anchor);
+}
+
+
+// -------------------------------------------------------------------------- //
+// filter_gauss
+// -------------------------------------------------------------------------- //
+int filter_gauss(IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, IppiMaskSize maskSize) {
+  static const Ipp32f kernel3x3[9] = {
+    1 / 16.0f, 2 / 16.0f, 1 / 16.0f,
+    2 / 16.0f, 4 / 16.0f, 2 / 16.0f,
+    1 / 16.0f, 2 / 16.0f, 1 / 16.0f
+  };
+  static const Ipp32f kernel5x5[25] = {
+     2 / 571.0f,   7 / 571.0f,  12 / 571.0f,   7 / 571.0f,   2 / 571.0f,
+     7 / 571.0f,  31 / 571.0f,  52 / 571.0f,  31 / 571.0f,   7 / 571.0f,
+    12 / 571.0f,  52 / 571.0f, 127 / 571.0f,  52 / 571.0f,  12 / 571.0f,
+     7 / 571.0f,  31 / 571.0f,  52 / 571.0f,  31 / 571.0f,   7 / 571.0f,
+     2 / 571.0f,   7 / 571.0f,  12 / 571.0f,   7 / 571.0f,   2 / 571.0f
+  };
+
+  switch(maskSize) {
+  case ippMskSize3x3:
+    return filter_linear(metaType, pSrc, srcStep, pDst, dstStep, roi, kernel3x3, ippi_size(3, 3), ippi_point(1, 1));
+  case ippMskSize5x5:
+    return filter_linear(metaType, pSrc, srcStep, pDst, dstStep, roi, kernel5x5, ippi_size(5, 5), ippi_point(2, 2));
+  default:
+    return ippStsMaskSizeErr;
+  }
+}
+
+
@@ -0,0 +1,106 @@
+#ifndef __IPP4R_FILTER_H__
+#define __IPP4R_FILTER_H__
+
+#include <ippdefs.h>
+#include "ipp4r_fwd.h"
+#include "ipp4r_metatype.h"
+
+/**
+ * @file
+ *
+ * This file defines native neighborhood filters, used for metatypes that IPP provides no filtering primitives for. <p>
+ *
+ * Filters follow IPP conventions: source buffer must have enough border pixels around the processed region for the given mask and anchor,
+ * mask of rank filters is aligned so that its anchor cell is over the processed pixel, and linear filter kernel is used in reverse order (convolution). <p>
+ *
+ * For each destination row the neighborhood rows are read into a double buffer, filtered there and written out with rounding and saturation,
+ * so a single implementation serves all data types. In AC4 images the alpha channel is not filtered, it's copied from the source.
+ * In-place operation is supported, in this case the source region is copied out first. Rows are processed in parallel as tiles on the pool. <p>
+ *
+ * Minimum and maximum over a rectangle, and separable kernels, are computed in two passes, columns first. Zero coefficients of linear kernels are skipped.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/**
+ * Rank filter
+ */
+typedef enum {
+  FILTER_MIN,           /**< minimum over a neighborhood, i.e. erosion */
+  FILTER_MAX,           /**< maximum over a neighborhood, i.e. dilation */
+  FILTER_MEDIAN         /**< median over a neighborhood */
+} FilterRank;
+
+
+// -------------------------------------------------------------------------- //
+// Function declarations
+// -------------------------------------------------------------------------- //
+/**
+ * Applies a rank filter to an image buffer.
+ *
+ * @param rank rank filter to apply
+ * @param metaType metatype of source and destination
+ * @param pSrc source buffer
+ * @param srcStep size of source row in bytes
+ * @param pDst destination buffer, may be equal to pSrc
+ * @param dstStep size of destination row in bytes
+ * @param roi size of processed region in pixels
+ * @param mask mask of maskSize elements, non-zero ones define the neighborhood. NULL means a rectangular neighborhood
+ * @param maskSize size of a mask
+ * @param anchor anchor cell of a mask
+ * @returns ippStsNoErr if everything went OK, non-zero error code otherwise
+ */
+int filter_rank(FilterRank rank, IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, const Ipp8u* mask, IppiSize maskSize, IppiPoint anchor);
+
+
+/**
+ * Applies a box (mean) filter to an image buffer. Parameters are the same as for filter_rank.
+ */
+int filter_box(IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, IppiSize maskSize, IppiPoint anchor);
+
+
+/**
+ * Applies a linear filter to an image buffer. Parameters are the same as for filter_rank.
+ *
+ * @param kernel kernel of kernelSize elements, in row-major order
+ */
+int filter_linear(IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, const Ipp32f* kernel, IppiSize kernelSize, IppiPoint anchor);
+
+
+/**
+ * Applies a separable linear filter, whose kernel is the outer product of a column and a row, to an image buffer in two passes.
+ * Parameters are the same as for filter_linear.
+ *
+ * @param column column factor of kernelSize.height elements
+ * @param row row factor of kernelSize.width elements
+ */
+int filter_separable(IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, const Ipp32f* column, const Ipp32f* row, IppiSize kernelSize, IppiPoint anchor);
+
+
+/**
+ * Applies a compiled kernel to an image buffer, in two passes if the kernel is separable and that's cheaper, with filter_linear otherwise.
+ * Parameters are the same as for filter_linear.
+ */
+int filter_kernel(IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, const Matrix* kernel, IppiPoint anchor);
+
+
+/**
+ * Applies a gaussian filter with the same kernels as ippiFilterGauss to an image buffer. Parameters are the same as for filter_rank.
+ *
+ * @param maskSize ippMskSize3x3 or ippMskSize5x5
+ */
+int filter_gauss(IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi, IppiMaskSize maskSize);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
@@ -0,0 +1,335 @@
+#include <assert.h>
+#include <string.h>
+#include "ipp4r.h"
+
+#ifdef HAVE_RUBY_THREAD_H
+#  include <ruby/thread.h>
+#endif
+
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/** State of a thread waiting for a future without the GVL */
+typedef struct {
+  Future* future;       /**< future to wait for */
+  int interrupted;      /**< was the wait interrupted by ruby, e.g. by a signal or Thread#raise? Guarded by the pool lock */
+} FutureWaiter;
+
+
+// -------------------------------------------------------------------------- //
+// Supplementary functions
+// -------------------------------------------------------------------------- //
+/**
+ * Job function: runs the operation on a pool worker and drops the reference held by the job.
+ */
+static void future_run(PoolJob* job) {
+  Future* future = (Future*) job;
+
+  future->status = future->func(future->source, &future->result, &future->args);
+  if(IS_ERROR(future->status))
+    future->result = NULL;
+
+  image_destroy(future->source);
+  future->source = NULL;
+
+  pool_lock();
+  future->done = TRUE;
+  pool_notify();
+  pool_unlock();
+
+  future_release(future);
+}
+
+
+/**
+ * Waits for a future, called without the GVL.
+ */
+static void* future_wait_nogvl(void* arg) {
+  FutureWaiter* waiter = (FutureWaiter*) arg;
+
+  pool_lock();
+  while(!waiter->future->done && !waiter->interrupted)
+    pool_wait();
+  pool_unlock();
+
+  return NULL;
+}
+
+
+/**
+ * Unblocking function: wakes up a thread waiting in future_wait_nogvl, so that it can handle interrupts.
+ */
+static void future_wait_ubf(void* arg) {
+  FutureWaiter* waiter = (FutureWaiter*) arg;
+
+  pool_lock();
+  waiter->interrupted = TRUE;
+  pool_notify();
+  pool_unlock();
+}
+
+
+/**
+ * Computes the value of a future created by then. Body block for rb_rescue2.
+ */
+static VALUE future_call_block(VALUE arg) {
+  Future* future = (Future*) arg;
+  VALUE value;
+
+  value = rb_funcall(future->rb_block, rb_intern("call"), 1, rb_Future_value(future->rb_parent));
+  if(RTEST(rb_obj_is_kind_of(value, rb_Future)))
+    value = rb_Future_value(value);
+
+  return value;
+}
+
+
+/**
+ * Remembers the exception raised by the block of a future created by then. Rescue block for rb_rescue2.
+ */
+static VALUE future_rescue_block(VALUE arg, VALUE error) {
+  Future* future = (Future*) arg;
+
+  future->rb_error = error;
+  return Qnil;
+}
+
+
+// -------------------------------------------------------------------------- //
+// future_new
+// -------------------------------------------------------------------------- //
+Future* future_new(Image* source, FutureFunc func, const FutureArgs* args) {
+  Future* future;
+
+  future = (Future*) malloc(sizeof(Future));
+  if(future == NULL)
+    return NULL;
+
+  future->job.func = future_run;
+  future->job.next = NULL;
+  ATOMIC_INIT(&future->refs, 1);
+
+  future->func = func;
+  if(args != NULL)
+    future->args = *args;
+  else
+    memset(&future->args, 0, sizeof(future->args));
+  future->source = source;
+  future->result = NULL;
+  future->status = ippStsNoErr;
+  future->done = func == NULL;
+
+  future->rb_parent = Qnil;
+  future->rb_block = Qnil;
+  future->rb_value = Qundef;
+  future->rb_error = Qnil;
+
+  return future;
+}
+
+
+// -------------------------------------------------------------------------- //
+// future_submit
+// -------------------------------------------------------------------------- //
+int future_submit(Future* future) {
+  int status;
+
+  assert(future != NULL && future->func != NULL && future->source != NULL);
+
+  ATOMIC_INC(&future->refs);
+  if(IS_ERROR(status = pool_submit(&future->job)))
+    future_release(future);
+
+  return status;
+}
+
+
+// -------------------------------------------------------------------------- //
+// future_release
+// -------------------------------------------------------------------------- //
+void future_release(Future* future) {
+  assert(future != NULL);
+
+  if(ATOMIC_DEC(&future->refs) != 0)
+    return;
+
+  if(future->source != NULL)
+    image_destroy(future->source);
+  if(future->result != NULL)
+    image_destroy(future->result);
+  if(future->args.matrix != NULL)
+    matrix_release(future->args.matrix);
+  if(future->args.batch != NULL)
+    batch_release(future->args.batch);
+  free(future);
+}
+
+
+// -------------------------------------------------------------------------- //
+// future_done
+// -------------------------------------------------------------------------- //
+int future_done(Future* future) {
+  int done;
+
+  pool_lock();
+  done = future->done;
+  pool_unlock();
+
+  return done;
+}
+
+
+// -------------------------------------------------------------------------- //
+// future_wait
+// -------------------------------------------------------------------------- //
+void future_wait(Future* future) {
+  FutureWaiter waiter;
+
+  waiter.future = future;
+  while(!future_done(future)) {
+    waiter.interrupted = FALSE;
+#ifdef HAVE_RUBY_THREAD_H
+    rb_thread_call_without_gvl(future_wait_nogvl, &waiter, future_wait_ubf, &waiter);
+    rb_thread_check_ints();
+#else
+    future_wait_nogvl(&waiter);
+#endif
+  }
+}
+
+
+// -------------------------------------------------------------------------- //
+// future_mark
+// -------------------------------------------------------------------------- //
+void future_mark(Future* future) {
+  rb_gc_mark(future->rb_parent);
+  rb_gc_mark(future->rb_block);
+  if(future->rb_value != Qundef)
+    rb_gc_mark(future->rb_value);
+  rb_gc_mark(future->rb_error);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Future_submit
+// -------------------------------------------------------------------------- //
+VALUE rb_Future_submit(VALUE image, FutureFunc func, const FutureArgs* args) {
+  Image* source;
+  Future* future;
+  VALUE result;
+  int status;
+
+  if(IS_ERROR(status = image_clone(Data_Get_Struct_Ret(image, Image), &source))) {
+    if(args->matrix != NULL)
+      matrix_release(args->matrix);
+    raise_on_error(status);
+  }
+
+  future = future_new(source, func, args);
+  if(future == NULL) {
+    image_destroy(source);
+    if(args->matrix != NULL)
+      matrix_release(args->matrix);
+    rb_raise(rb_eNoMemError, "could not allocate Future structure");
+  }
+
+  result = WRAP_FUTURE(future);
+  raise_on_error(future_submit(future));
+
+  return result;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Future_value
+// -------------------------------------------------------------------------- //
+VALUE rb_Future_value(VALUE self) {
+  Future* future;
+  VALUE value;
+
+  future = Data_Get_Struct_Ret(self, Future);
+
+  if(future->rb_value != Qundef)
+    return future->rb_value;
+  if(!NIL_P(future->rb_error))
+    rb_exc_raise(future->rb_error);
+
+  if(future->func == NULL) {
+    /* Only exceptions are caught, break, throw and thread termination go on */
+    value = rb_rescue2(future_call_block, (VALUE) future, future_rescue_block, (VALUE) future, rb_eException, (VALUE) 0);
+    if(!NIL_P(future->rb_error))
+      rb_exc_raise(future->rb_error);
+    future->rb_value = value;
+  } else {
+    future_wait(future);
+    raise_on_error(future->status);
+    future->rb_value = image_wrap(future->result);
+    future->result = NULL;
+  }
+
+  return future->rb_value;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Future_wait
+// -------------------------------------------------------------------------- //
+VALUE rb_Future_wait(VALUE self) {
+  Future* future;
+  int state;
+
+  future = Data_Get_Struct_Ret(self, Future);
+
+  if(future->func == NULL) {
+    /* Exception of the block is remembered by the future, anything else must go on */
+    rb_protect(rb_Future_value, self, &state);
+    if(state != 0) {
+      if(NIL_P(future->rb_error))
+        rb_jump_tag(state);
+      rb_set_errinfo(Qnil);
+    }
+  } else
+    future_wait(future);
+
+  return self;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Future_ready_p
+// -------------------------------------------------------------------------- //
+VALUE rb_Future_ready_p(VALUE self) {
+  Future* future;
+
+  future = Data_Get_Struct_Ret(self, Future);
+
+  if(future->func == NULL)
+    return C2R_BOOL(future->rb_value != Qundef || !NIL_P(future->rb_error));
+  else
+    return C2R_BOOL(future_done(future));
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Future_then
+// -------------------------------------------------------------------------- //
+VALUE rb_Future_then(VALUE self) {
+  Future* future;
+  VALUE result;
+
+  if(!rb_block_given_p())
+    rb_raise(rb_eArgError, "no block given");
+
+  future = future_new(NULL, NULL, NULL);
+  if(future == NULL)
+    rb_raise(rb_eNoMemError, "could not allocate Future structure");
+
+  result = WRAP_FUTURE(future);
+  future->rb_parent = self;
+  future->rb_block = rb_block_proc();
+
+  return result;
+}
+
+
@@ -0,0 +1,210 @@
+#ifndef __IPP4R_FUTURE_H__
+#define __IPP4R_FUTURE_H__
+
+#include <ruby.h>
+#include <ippdefs.h>
+#include "ipp4r_fwd.h"
+#include "ipp4r_atomic.h"
+#include "ipp4r_pool.h"
+#include "ipp4r_color.h"
+#include "ipp4r_resize.h"
+#include "ipp4r_rotate.h"
+
+/**
+ * @file
+ *
+ * This file defines C and Ruby interfaces for futures, i.e. results of image operations that run on the thread pool. <p>
+ *
+ * <tt>Ipp::Image#async</tt> returns an <tt>Ipp::Image::Async</tt> proxy, whose methods mirror non-destructive methods of Image, but queue the operation
+ * and return an <tt>Ipp::Future</tt> at once. Arguments are parsed by the calling thread, then the job gets a private copy-on-write clone of the image,
+ * so changes made to the image after the call don't affect the result. The job runs on a pool worker, without the GVL, and the thread that asks
+ * for the value releases the GVL while it waits. <p>
+ *
+ * Future created by <tt>then</tt> has no job of its own: its block is called with the value of the parent future by the first thread that asks for the value
+ * of the chained one. If the block returns a future, the value of that future becomes the value of the chained one.
+ * Values and exceptions of blocks are remembered, so the block runs at most once. <p>
+ *
+ * Future is reference counted: its ruby wrapper and its pending job hold a reference each, so a future that is dropped by ruby code still finishes safely.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/**
+ * Arguments of an asynchronous operation. Each operation uses the fields it needs.
+ */
+typedef struct {
+  IppMetaType metaType;   /**< destination metatype */
+  IppiSize size;          /**< mask size or destination size */
+  IppiPoint anchor;       /**< mask anchor */
+  IppiMaskSize maskSize;  /**< fixed mask size */
+  IppiAxis axis;          /**< mirror axis */
+  IppCmpOp cmp;           /**< threshold comparison */
+  Color threshold;        /**< threshold color */
+  Color value;            /**< replacement color */
+  Orientation orientation; /**< rotation */
+  ResizeMode mode;        /**< resize interpolation mode */
+  Matrix* matrix;         /**< kernel or mask, the future holds a reference, or NULL */
+  Batch* batch;           /**< operations of batch_run, the future holds a reference, or NULL */
+} FutureArgs;
+
+
+/**
+ * Asynchronous operation. Called on a pool worker, so it must not use ruby API.
+ *
+ * @param image private clone of the source image
+ * @param dst destination image
+ * @param args arguments of operation
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+typedef int (*FutureFunc)(Image* image, Image** dst, const FutureArgs* args);
+
+
+/**
+ * Future struct
+ */
+struct _Future {
+  PoolJob job;          /**< pool job that computes the result, must be the first field */
+  ATOMIC_INT refs;      /**< number of references, held by the ruby wrapper and by the pending job */
+
+  FutureFunc func;      /**< operation, NULL for futures created by then */
+  FutureArgs args;      /**< arguments of operation */
+  Image* source;        /**< private clone of the source image, destroyed by the job */
+  Image* result;        /**< result of operation until it's wrapped, or NULL */
+  int status;           /**< status returned by operation */
+  int done;             /**< is operation finished? Guarded by the pool lock */
+
+  VALUE rb_parent;      /**< future this one is chained to by then, or Qnil */
+  VALUE rb_block;       /**< block passed to then, or Qnil */
+  VALUE rb_value;       /**< value of this future once it's known, or Qundef */
+  VALUE rb_error;       /**< exception raised by the block, or Qnil */
+};
+
+
+// -------------------------------------------------------------------------- //
+// Future C interface
+// -------------------------------------------------------------------------- //
+/**
+ * Creates a future for an operation. Future takes ownership of the source image, and of the matrix and the batch references in arguments.
+ * If creation fails, they stay with the caller.
+ *
+ * @param source private clone of the source image, or NULL for a future created by then
+ * @param func operation, or NULL for a future created by then
+ * @param args arguments of operation, or NULL
+ * @returns newly allocated Future holding one reference, or NULL in case of an error
+ */
+Future* future_new(Image* source, FutureFunc func, const FutureArgs* args);
+
+
+/**
+ * Queues the operation of a future on the pool. The job holds its own reference until it's done.
+ *
+ * @returns ippStsNoErr if everything went OK, non-zero error code otherwise
+ */
+int future_submit(Future* future);
+
+
+/**
+ * Releases a reference to a future, the future is destroyed with the last one. Safe to call from any thread.
+ */
+void future_release(Future* future);
+
+
+/**
+ * @returns TRUE if the operation of a future is finished
+ */
+int future_done(Future* future);
+
+
+/**
+ * Waits for the operation of a future, releasing the GVL while waiting if ruby allows it.
+ * Ruby interrupts are handled while waiting, so this function may raise, e.g. on Thread#kill.
+ */
+void future_wait(Future* future);
+
+
+// -------------------------------------------------------------------------- //
+// Future Ruby interface
+// -------------------------------------------------------------------------- //
+/**
+ * Queues an operation on a clone of the given image.
+ *
+ * @param image Ipp::Image or Ipp::Image::Async
+ * @param func operation
+ * @param args arguments of operation, the matrix in them is released even if an exception is raised
+ * @returns newly created Ipp::Future
+ */
+VALUE rb_Future_submit(VALUE image, FutureFunc func, const FutureArgs* args);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Future#value</tt>
+ * </ul>
+ *
+ * Waits for the future and returns its value, or raises the exception of the operation or of the block.
+ */
+VALUE rb_Future_value(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Future#wait</tt>
+ * </ul>
+ *
+ * Waits for the future. Unlike value, doesn't raise if the operation failed.
+ * @returns self
+ */
+VALUE rb_Future_wait(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Future#ready?</tt>
+ * </ul>
+ *
+ * @returns true if value won't block
+ */
+VALUE rb_Future_ready_p(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Future#then { |value| ... }</tt>
+ * </ul>
+ *
+ * @returns new future, whose value is the result of the block called with the value of self
+ */
+VALUE rb_Future_then(VALUE self);
+
+
+/**
+ * Wraps a Future structure into ruby VALUE. Wrapper holds the reference the future was created with.
+ *
+ * @param FUTURE <tt>Future*</tt>
+ */
+#define WRAP_FUTURE(FUTURE)                                                     \
+  Data_Wrap_Struct(rb_Future, future_mark, future_release, (FUTURE))
+
+
+/**
+ * Mark function for ruby mark'n'sweep garbage collector.
+ */
+void future_mark(Future* future);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
@@ -7,6 +7,11 @@ typedef struct _Color Color;
 typedef struct _ColorRef ColorRef;
 typedef struct _Enum Enum;
 typedef struct _Matrix Matrix;
+typedef struct _Lut Lut;
+typedef struct _ResizePlan ResizePlan;
+typedef struct _RemapPlan RemapPlan;
+typedef struct _Future Future;
+typedef struct _Batch Batch;
 
 #endif
 
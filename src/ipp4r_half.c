@@ -0,0 +1,117 @@
+#include <assert.h>
+#include "ipp4r.h"
+
+#ifdef __F16C__
+#  include <immintrin.h>
+#endif
+
+
+// -------------------------------------------------------------------------- //
+// Supplementary functions
+// -------------------------------------------------------------------------- //
+/** Access to the bits of a single precision value */
+typedef union {
+  Ipp32u u;
+  Ipp32f f;
+} HalfFloatBits;
+
+
+/**
+ * Shifts value right by shift bits, rounding to nearest even.
+ */
+static Ipp32u half_round_shift(Ipp32u value, int shift) {
+  Ipp32u result, rest, halfway;
+
+  result = value >> shift;
+  rest = value & ((1u << shift) - 1);
+  halfway = 1u << (shift - 1);
+  if(rest > halfway || (rest == halfway && (result & 1)))
+    result++;
+  return result;
+}
+
+
+// -------------------------------------------------------------------------- //
+// half_to_float
+// -------------------------------------------------------------------------- //
+Ipp32f half_to_float(Ipp16f value) {
+  HalfFloatBits bits;
+  Ipp32u sign, exponent, mantissa;
+
+  sign = (Ipp32u) (value & 0x8000) << 16;
+  exponent = (value >> 10) & 0x1F;
+  mantissa = value & 0x3FF;
+
+  if(exponent == 0x1F) /* infinity or NaN */
+    bits.u = sign | 0x7F800000 | (mantissa << 13);
+  else if(exponent != 0)
+    bits.u = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+  else { /* zero or subnormal, i.e. mantissa * 2^-24 */
+    bits.f = mantissa * (1.0f / 16777216.0f);
+    bits.u |= sign;
+  }
+
+  return bits.f;
+}
+
+
+// -------------------------------------------------------------------------- //
+// half_from_float
+// -------------------------------------------------------------------------- //
+Ipp16f half_from_float(Ipp32f value) {
+  HalfFloatBits bits;
+  Ipp32u sign, abs, exponent;
+
+  bits.f = value;
+  sign = (bits.u >> 16) & 0x8000;
+  abs = bits.u & 0x7FFFFFFF;
+
+  if(abs > 0x7F800000) /* NaN */
+    return (Ipp16f) (sign | 0x7E00);
+  else if(abs >= 0x477FF000) /* 65520 and above round to infinity */
+    return (Ipp16f) (sign | 0x7C00);
+  else if(abs >= 0x38800000) { /* normal, 2^-14 and above */
+    exponent = (abs >> 23) - (127 - 15);
+    return (Ipp16f) (sign | half_round_shift((exponent << 23) | (abs & 0x7FFFFF), 13)); /* carry from mantissa correctly increments exponent */
+  } else if(abs > 0x33000000) { /* subnormal, above 2^-25 */
+    exponent = abs >> 23;
+    return (Ipp16f) (sign | half_round_shift((abs & 0x7FFFFF) | 0x800000, 126 - exponent));
+  } else /* 2^-25 and below round to zero */
+    return (Ipp16f) sign;
+}
+
+
+// -------------------------------------------------------------------------- //
+// half_to_float_row
+// -------------------------------------------------------------------------- //
+void half_to_float_row(const Ipp16f* pSrc, Ipp32f* pDst, int n) {
+  int i = 0;
+
+  assert(pSrc != NULL && pDst != NULL);
+
+#ifdef __F16C__
+  for(; i + 8 <= n; i += 8)
+    _mm256_storeu_ps(pDst + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*) (pSrc + i))));
+#endif
+  for(; i < n; i++)
+    pDst[i] = half_to_float(pSrc[i]);
+}
+
+
+// -------------------------------------------------------------------------- //
+// half_from_float_row
+// -------------------------------------------------------------------------- //
+void half_from_float_row(const Ipp32f* pSrc, Ipp16f* pDst, int n) {
+  int i = 0;
+
+  assert(pSrc != NULL && pDst != NULL);
+
+#ifdef __F16C__
+  for(; i + 8 <= n; i += 8)
+    _mm_storeu_si128((__m128i*) (pDst + i), _mm256_cvtps_ph(_mm256_loadu_ps(pSrc + i), _MM_FROUND_TO_NEAREST_INT));
+#endif
+  for(; i < n; i++)
+    pDst[i] = half_from_float(pSrc[i]);
+}
+
+
@@ -0,0 +1,55 @@
+#ifndef __IPP4R_HALF_H__
+#define __IPP4R_HALF_H__
+
+#include <ippdefs.h>
+#include "ipp4r_fwd.h"
+#include "ipp4r_metatype.h"
+
+/**
+ * @file
+ *
+ * This file defines conversions between half precision (16f) and single precision floating point numbers. <p>
+ *
+ * 16f is a storage-only data type: half values are IEEE 754 binary16 bit patterns, which are converted to Ipp32f to be processed.
+ * Conversion to half precision rounds to nearest even, values out of range become infinities, NaNs stay NaNs.
+ * Row converters use F16C instructions when built with them (e.g. with <tt>-mf16c</tt>), and scalar code otherwise.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -------------------------------------------------------------------------- //
+// Function declarations
+// -------------------------------------------------------------------------- //
+/**
+ * @returns single precision value of the given half
+ */
+Ipp32f half_to_float(Ipp16f value);
+
+
+/**
+ * @returns half nearest to the given single precision value
+ */
+Ipp16f half_from_float(Ipp32f value);
+
+
+/**
+ * Converts n halves to single precision.
+ */
+void half_to_float_row(const Ipp16f* pSrc, Ipp32f* pDst, int n);
+
+
+/**
+ * Converts n single precision values to halves.
+ */
+void half_from_float_row(const Ipp32f* pSrc, Ipp16f* pDst, int n);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
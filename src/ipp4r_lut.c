@@ -0,0 +1,606 @@
+#include <assert.h>
+#include <math.h>
+#include <ruby.h>
+#include "ipp4r.h"
+
+#ifdef DISPATCH_USE_TIERS
+#  include <immintrin.h>
+#endif
+
+
+// -------------------------------------------------------------------------- //
+// Table sizes
+// -------------------------------------------------------------------------- //
+#define LUT_TABLE_SIZE_8u  256
+#define LUT_TABLE_SIZE_16u 65536
+#define LUT_TABLE_SIZE_32f (2 * LUT_32F_LEVELS)
+#define LUT_TABLE_SIZE_16s 32768
+
+/* Data type of a compiled table used for the given data type. 32s and 64f values are too many to tabulate, so they are looked up in the 32f table. */
+#define LUT_STORAGE_8u  8u
+#define LUT_STORAGE_16u 16u
+#define LUT_STORAGE_32f 32f
+#define LUT_STORAGE_16s 16s
+#define LUT_STORAGE_32s 32f
+#define LUT_STORAGE_64f 32f
+#define LUT_STORAGE(DATATYPE) ARX_JOIN(LUT_STORAGE_, DATATYPE)
+
+#define LUT_TABLE_SIZE(DATATYPE) ARX_JOIN(LUT_TABLE_SIZE_, LUT_STORAGE(DATATYPE))
+#define LUT_TABLE(LUT, DATATYPE) ((LUT)->ARX_JOIN(table_, LUT_STORAGE(DATATYPE)))
+#define LUT_CTYPE(DATATYPE) D_CTYPE(LUT_STORAGE(DATATYPE))
+
+
+// -------------------------------------------------------------------------- //
+// Supplementary functions
+// -------------------------------------------------------------------------- //
+/**
+ * Clamps the given value to [0, 1] range. NaNs are mapped to 0.
+ */
+static IppMetaNumber clamp_unit(IppMetaNumber x) {
+  if(x > 1.0f)
+    return 1.0f;
+  else if(x >= 0.0f)
+    return x;
+  else
+    return 0.0f; /* also catches NaN */
+}
+
+
+/**
+ * Publishes a compiled table, unless another thread has published one first, in which case the given table is freed.
+ */
+static void lut_publish(ATOMIC_PTR* slot, void* table) {
+  void* expected = NULL;
+
+  if(!ATOMIC_CAS_PTR(slot, expected, table))
+    free(table);
+}
+
+
+/**
+ * Compiles integer table for the given DATATYPE. Table entries are rounded and saturated.
+ */
+#define DEFINE_LUT_COMPILE_INT(DATATYPE)                                        \
+static int ARX_JOIN(lut_compile_, DATATYPE)(Lut* lut) {                         \
+  int c, i;                                                                     \
+  D_CTYPE(DATATYPE)* table;                                                     \
+                                                                                \
+  if(ATOMIC_LOAD_PTR(&LUT_TABLE(lut, DATATYPE)) != NULL)                        \
+    return ippStsNoErr;                                                         \
+                                                                                \
+  table = (D_CTYPE(DATATYPE)*) malloc(LUT_CURVES * LUT_TABLE_SIZE(DATATYPE) * sizeof(D_CTYPE(DATATYPE))); \
+  if(table == NULL)                                                             \
+    return ippStsNoMemErr;                                                      \
+                                                                                \
+  for(c = 0; c < LUT_CURVES; c++)                                               \
+    for(i = 0; i < LUT_TABLE_SIZE(DATATYPE); i++)                               \
+      table[c * LUT_TABLE_SIZE(DATATYPE) + i] = (D_CTYPE(DATATYPE)) (clamp_unit(lut_eval(lut, c, C2M_NUMBER_D(DATATYPE, i))) * D_SCALE(DATATYPE) + 0.5f); \
+                                                                                \
+  lut_publish(&LUT_TABLE(lut, DATATYPE), table);                                \
+  return ippStsNoErr;                                                           \
+}
+
+DEFINE_LUT_COMPILE_INT(8u)
+DEFINE_LUT_COMPILE_INT(16u)
+DEFINE_LUT_COMPILE_INT(16s)
+
+
+/**
+ * Compiles 32f table. Each level is stored as a (value, slope) pair, so that interpolation costs one multiply-add.
+ */
+static int lut_compile_32f(Lut* lut) {
+  int c, i;
+  Ipp32f* table;
+  IppMetaNumber v0, v1;
+
+  if(ATOMIC_LOAD_PTR(&lut->table_32f) != NULL)
+    return ippStsNoErr;
+
+  table = (Ipp32f*) malloc(LUT_CURVES * LUT_TABLE_SIZE(32f) * sizeof(Ipp32f));
+  if(table == NULL)
+    return ippStsNoMemErr;
+
+  for(c = 0; c < LUT_CURVES; c++) {
+    v1 = lut_eval(lut, c, 0.0f);
+    for(i = 0; i < LUT_32F_LEVELS; i++) {
+      v0 = v1;
+      v1 = (i + 1 < LUT_32F_LEVELS) ? lut_eval(lut, c, (IppMetaNumber) (i + 1) / (LUT_32F_LEVELS - 1)) : v0;
+      table[c * LUT_TABLE_SIZE(32f) + 2 * i]     = v0;
+      table[c * LUT_TABLE_SIZE(32f) + 2 * i + 1] = v1 - v0;
+    }
+  }
+
+  lut_publish(&lut->table_32f, table);
+  return ippStsNoErr;
+}
+
+
+/**
+ * Defines <tt>lut_tables_DATATYPE</tt> function, which compiles table of DATATYPE if needed and stores pointers to its curves in tables.
+ */
+#define DEFINE_LUT_TABLES(DATATYPE)                                             \
+static int ARX_JOIN(lut_tables_, DATATYPE)(Lut* lut, const void** tables) {     \
+  int c, status;                                                                \
+  const LUT_CTYPE(DATATYPE)* table;                                             \
+                                                                                \
+  if(IS_ERROR(status = ARX_JOIN(lut_compile_, DATATYPE)(lut)))                  \
+    return status;                                                              \
+                                                                                \
+  table = (const LUT_CTYPE(DATATYPE)*) ATOMIC_LOAD_PTR(&LUT_TABLE(lut, DATATYPE)); \
+  for(c = 0; c < LUT_CURVES; c++)                                               \
+    tables[c] = table + c * LUT_TABLE_SIZE(DATATYPE);                           \
+  return ippStsNoErr;                                                           \
+}
+
+DEFINE_LUT_TABLES(8u)
+DEFINE_LUT_TABLES(16u)
+DEFINE_LUT_TABLES(16s)
+DEFINE_LUT_TABLES(32f)
+
+
+/**
+ * Looks up a value in compiled 32f table.
+ */
+static Ipp32f lut_lookup_32f(const Ipp32f* table, Ipp32f x) {
+  int i;
+
+  x = clamp_unit(x) * (LUT_32F_LEVELS - 1);
+  i = (int) x;
+  return table[2 * i] + table[2 * i + 1] * (x - i);
+}
+
+
+/**
+ * Looks up a 32s value in compiled 32f table.
+ */
+static Ipp32s lut_lookup_32s(const Ipp32f* table, Ipp32s v) {
+  return (Ipp32s) (clamp_unit(lut_lookup_32f(table, (Ipp32f) (v / D_SCALE(32s)))) * D_SCALE(32s) + 0.5);
+}
+
+
+// -------------------------------------------------------------------------- //
+// Kernels
+// -------------------------------------------------------------------------- //
+#define LUT_LOOKUP_8u(TABLES, CURVE, V) (TABLES)[CURVE][V]
+#define LUT_LOOKUP_16u(TABLES, CURVE, V) (TABLES)[CURVE][V]
+#define LUT_LOOKUP_32f(TABLES, CURVE, V) lut_lookup_32f((TABLES)[CURVE], V)
+#define LUT_LOOKUP_16s(TABLES, CURVE, V) (TABLES)[CURVE][max(V, 0)]
+#define LUT_LOOKUP_32s(TABLES, CURVE, V) lut_lookup_32s((TABLES)[CURVE], V)
+#define LUT_LOOKUP_64f(TABLES, CURVE, V) lut_lookup_32f((TABLES)[CURVE], (Ipp32f) (V))
+
+#define LUT_PIXEL_C1(S, D, TABLES, LOOKUP)                                      \
+  (D)[0] = LOOKUP(TABLES, LUT_GRAY, (S)[0]);
+#define LUT_PIXEL_C3(S, D, TABLES, LOOKUP)                                      \
+  (D)[0] = LOOKUP(TABLES, 0, (S)[0]);                                           \
+  (D)[1] = LOOKUP(TABLES, 1, (S)[1]);                                           \
+  (D)[2] = LOOKUP(TABLES, 2, (S)[2]);
+#define LUT_PIXEL_AC4(S, D, TABLES, LOOKUP)                                     \
+  LUT_PIXEL_C3(S, D, TABLES, LOOKUP)                                            \
+  (D)[3] = (S)[3];
+#define LUT_PIXEL_C4(S, D, TABLES, LOOKUP)                                      \
+  LUT_PIXEL_AC4(S, D, TABLES, LOOKUP)
+
+/** Table compiler, see DEFINE_LUT_TABLES */
+typedef int (*LutTablesFunc)(Lut* lut, const void** tables);
+
+/** LUT kernel, maps pixels through compiled tables of LUT_CURVES curves */
+typedef void (*LutApplyFunc)(const void* const* tables, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi);
+
+/* Names of kernels */
+#define LUT_APPLY_NAME(D, C, TIER) ARX_JOIN_6(lut_apply_, D, _, C, _, TIER)
+
+/* Tiers that pay off for kernels of a metatype, measured on 1024x1024 images. Plain C can't vectorize a table lookup, so only 8u gray pixels
+ * get one, written with shuffles, see DEFINE_LUT_ROW_8u_C1: 1.5x faster on SSE4, 1.9x on AVX2 and 3.5x on AVX-512. Color pixels would need
+ * a lookup per curve and a blend per channel, which is no faster than scalar lookups on any tier. */
+#define LUT_APPLY_TIERS_8u_C1 (4, (generic, sse4, avx2, avx512))
+#define LUT_APPLY_TIERS(M) IF_M_EQ_M(M, 8u_C1, LUT_APPLY_TIERS_8u_C1, (1, (generic)))
+
+
+#ifdef DISPATCH_USE_TIERS
+/* Vector operations of DEFINE_LUT_ROW_8u_C1, per tier. Table blocks are broadcast to every 128-bit lane, as pshufb doesn't cross lanes. */
+#define LUT_VEC_sse4                    __m128i
+#define LUT_WIDTH_sse4                  16
+#define LUT_LOAD_BLOCK_sse4(P)          _mm_loadu_si128((const __m128i*) (P))
+#define LUT_LOAD_sse4(P)                _mm_loadu_si128((const __m128i*) (P))
+#define LUT_STORE_sse4(P, V)            _mm_storeu_si128((__m128i*) (P), V)
+#define LUT_LOW_NIBBLE_sse4(V)          _mm_and_si128(V, _mm_set1_epi8(0x0F))
+#define LUT_SHUFFLE_sse4(BLOCK, I)      _mm_shuffle_epi8(BLOCK, I)
+#define LUT_BLEND_sse4(A, B, M)         _mm_blendv_epi8(A, B, M)
+#define LUT_SHL1_sse4(V)                _mm_slli_epi16(V, 1)
+
+#define LUT_VEC_avx2                    __m256i
+#define LUT_WIDTH_avx2                  32
+#define LUT_LOAD_BLOCK_avx2(P)          _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) (P)))
+#define LUT_LOAD_avx2(P)                _mm256_loadu_si256((const __m256i*) (P))
+#define LUT_STORE_avx2(P, V)            _mm256_storeu_si256((__m256i*) (P), V)
+#define LUT_LOW_NIBBLE_avx2(V)          _mm256_and_si256(V, _mm256_set1_epi8(0x0F))
+#define LUT_SHUFFLE_avx2(BLOCK, I)      _mm256_shuffle_epi8(BLOCK, I)
+#define LUT_BLEND_avx2(A, B, M)         _mm256_blendv_epi8(A, B, M)
+#define LUT_SHL1_avx2(V)                _mm256_slli_epi16(V, 1)
+
+#define LUT_VEC_avx512                  __m512i
+#define LUT_WIDTH_avx512                64
+#define LUT_LOAD_BLOCK_avx512(P)        _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*) (P)))
+#define LUT_LOAD_avx512(P)              _mm512_loadu_si512(P)
+#define LUT_STORE_avx512(P, V)          _mm512_storeu_si512(P, V)
+#define LUT_LOW_NIBBLE_avx512(V)        _mm512_and_si512(V, _mm512_set1_epi8(0x0F))
+#define LUT_SHUFFLE_avx512(BLOCK, I)    _mm512_shuffle_epi8(BLOCK, I)
+#define LUT_BLEND_avx512(A, B, M)       _mm512_mask_blend_epi8(_mm512_movepi8_mask(M), A, B)
+#define LUT_SHL1_avx512(V)              _mm512_slli_epi16(V, 1)
+
+#define LUT_OP(OP, TIER) ARX_JOIN_3(LUT_, OP, ARX_JOIN(_, TIER))
+
+
+/**
+ * Defines <tt>lut_row_8u_C1_TIER</tt>, which maps a row of n 8u values through the given 256-entry table with pshufb instead of gathers. <br>
+ * Table is sixteen blocks of sixteen entries. The low nibble of a value is looked up in every block, then the bits of the high nibble drop halves
+ * of the candidates, from the top one down. A blend only reads the top bit of a mask byte, so the value shifted left is the mask of each step. <br>
+ * Selection is written out rather than looped, so that candidates stay in registers whether or not the compiler unrolls.
+ *
+ * @returns number of values mapped, a multiple of the vector width, the rest is left to the caller
+ */
+#define DEFINE_LUT_ROW_8u_C1(TIER)                                              \
+DISPATCH_TARGET(TIER) static int ARX_JOIN(lut_row_8u_C1_, TIER)(const Ipp8u* table, const Ipp8u* s, Ipp8u* d, int n) { \
+  LUT_OP(VEC, TIER) b[16], t0, t1, t2, t3, t4, t5, t6, t7, v, lo;              \
+  int i, k;                                                                     \
+                                                                                \
+  for(k = 0; k < 16; k++)                                                       \
+    b[k] = LUT_OP(LOAD_BLOCK, TIER)(table + 16 * k);                            \
+                                                                                \
+  for(i = 0; i + LUT_OP(WIDTH, TIER) <= n; i += LUT_OP(WIDTH, TIER)) {          \
+    v = LUT_OP(LOAD, TIER)(s + i);                                              \
+    lo = LUT_OP(LOW_NIBBLE, TIER)(v);                                           \
+    t0 = LUT_OP(BLEND, TIER)(LUT_OP(SHUFFLE, TIER)(b[0], lo), LUT_OP(SHUFFLE, TIER)(b[8], lo), v); \
+    t1 = LUT_OP(BLEND, TIER)(LUT_OP(SHUFFLE, TIER)(b[1], lo), LUT_OP(SHUFFLE, TIER)(b[9], lo), v); \
+    t2 = LUT_OP(BLEND, TIER)(LUT_OP(SHUFFLE, TIER)(b[2], lo), LUT_OP(SHUFFLE, TIER)(b[10], lo), v); \
+    t3 = LUT_OP(BLEND, TIER)(LUT_OP(SHUFFLE, TIER)(b[3], lo), LUT_OP(SHUFFLE, TIER)(b[11], lo), v); \
+    t4 = LUT_OP(BLEND, TIER)(LUT_OP(SHUFFLE, TIER)(b[4], lo), LUT_OP(SHUFFLE, TIER)(b[12], lo), v); \
+    t5 = LUT_OP(BLEND, TIER)(LUT_OP(SHUFFLE, TIER)(b[5], lo), LUT_OP(SHUFFLE, TIER)(b[13], lo), v); \
+    t6 = LUT_OP(BLEND, TIER)(LUT_OP(SHUFFLE, TIER)(b[6], lo), LUT_OP(SHUFFLE, TIER)(b[14], lo), v); \
+    t7 = LUT_OP(BLEND, TIER)(LUT_OP(SHUFFLE, TIER)(b[7], lo), LUT_OP(SHUFFLE, TIER)(b[15], lo), v); \
+    v = LUT_OP(SHL1, TIER)(v);                                                  \
+    t0 = LUT_OP(BLEND, TIER)(t0, t4, v);                                        \
+    t1 = LUT_OP(BLEND, TIER)(t1, t5, v);                                        \
+    t2 = LUT_OP(BLEND, TIER)(t2, t6, v);                                        \
+    t3 = LUT_OP(BLEND, TIER)(t3, t7, v);                                        \
+    v = LUT_OP(SHL1, TIER)(v);                                                  \
+    t0 = LUT_OP(BLEND, TIER)(t0, t2, v);                                        \
+    t1 = LUT_OP(BLEND, TIER)(t1, t3, v);                                        \
+    v = LUT_OP(SHL1, TIER)(v);                                                  \
+    LUT_OP(STORE, TIER)(d + i, LUT_OP(BLEND, TIER)(t0, t1, v));                 \
+  }                                                                             \
+  return i;                                                                     \
+}
+
+DEFINE_LUT_ROW_8u_C1(sse4)
+DEFINE_LUT_ROW_8u_C1(avx2)
+DEFINE_LUT_ROW_8u_C1(avx512)
+#endif
+
+
+/**
+ * Defines a kernel <tt>lut_apply_DATATYPE_CHANNELS_TIER</tt> that maps pixels of METATYPE through compiled tables, if TIER is listed for it.
+ * Kernels of tiers above generic map as many pixels of a row as they can with <tt>lut_row_DATATYPE_CHANNELS_TIER</tt> first.
+ */
+#define DEFINE_LUT_APPLY(METATYPE, TIER)                                        \
+  ARX_IF(DISPATCH_HAS_TIER(LUT_APPLY_TIERS(METATYPE), TIER), DEFINE_LUT_APPLY_I, ARX_TUPLE_EAT_3)(M_DATATYPE(METATYPE), M_CHANNELS(METATYPE), TIER)
+#define DEFINE_LUT_APPLY_I(DATATYPE, CHANNELS, TIER)                            \
+  DEFINE_LUT_APPLY_II(DATATYPE, CHANNELS, TIER, D_CTYPE(DATATYPE), D_CTYPE(LUT_STORAGE(DATATYPE)), C_CNUMB(CHANNELS))
+#define DEFINE_LUT_APPLY_II(DATATYPE, CHANNELS, TIER, CTYPE, TTYPE, CNUMB)      \
+DISPATCH_TARGET(TIER) static void LUT_APPLY_NAME(DATATYPE, CHANNELS, TIER)(const void* const* pTables, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi) { \
+  int x, y;                                                                     \
+  const TTYPE* const* tables = (const TTYPE* const*) pTables;                   \
+  const CTYPE* s;                                                               \
+  CTYPE* d;                                                                     \
+                                                                                \
+  for(y = 0; y < roi.height; y++) {                                             \
+    s = (const CTYPE*) ((const char*) pSrc + y * srcStep);                      \
+    d = (CTYPE*) ((char*) pDst + y * dstStep);                                  \
+    x = ARX_IF(DISPATCH_TIER_EQ(TIER, generic), 0, ARX_JOIN_6(lut_row_, DATATYPE, _, CHANNELS, _, TIER)(tables[LUT_GRAY], s, d, roi.width)); \
+    for(s += x * CNUMB, d += x * CNUMB; x < roi.width; x++, s += CNUMB, d += CNUMB) { \
+      ARX_JOIN(LUT_PIXEL_, CHANNELS)(s, d, tables, ARX_JOIN(LUT_LOOKUP_, DATATYPE)) \
+    }                                                                           \
+  }                                                                             \
+}
+
+#define DEFINE_LUT_APPLY_KERNELS(TIER, ARG)                                     \
+  ARX_ARRAY_FOREACH(M_SUPPORTED, DEFINE_LUT_APPLY, TIER)                        \
+  DEFINE_DISPATCH_KERNELS(ARX_JOIN(lut_apply_kernels_, TIER), M_SUPPORTED, LUT_APPLY_KERNEL, TIER)
+#define LUT_APPLY_KERNEL(M, TIER) LUT_APPLY_NAME(M_DATATYPE(M), M_CHANNELS(M), DISPATCH_TIER_FLOOR(LUT_APPLY_TIERS(M), TIER))
+
+#define LUT_TABLES(M) ARX_JOIN(lut_tables_, LUT_STORAGE(M_DATATYPE(M)))
+
+ARX_ARRAY_FOREACH(DISPATCH_TIERS, DEFINE_LUT_APPLY_KERNELS, ~)
+DEFINE_DISPATCH_TIERED_TABLE(lut_apply_table, "lut_apply", lut_apply_kernels)
+DEFINE_METATABLE_VALUES(LutTablesFunc, lut_tables_table, M_SUPPORTED, LUT_TABLES)
+
+
+// -------------------------------------------------------------------------- //
+// lut_dispatch_init
+// -------------------------------------------------------------------------- //
+void lut_dispatch_init(void) {
+  dispatch_register(&lut_apply_table);
+}
+
+
+// -------------------------------------------------------------------------- //
+// lut_new
+// -------------------------------------------------------------------------- //
+Lut* lut_new(int length) {
+  Lut* lut;
+  int c;
+
+  assert(length >= 2);
+
+  lut = (Lut*) malloc(sizeof(Lut));
+  if(lut == NULL)
+    return NULL;
+
+  lut->curve[0] = (IppMetaNumber*) malloc(LUT_CURVES * length * sizeof(IppMetaNumber));
+  if(lut->curve[0] == NULL) {
+    free(lut);
+    return NULL;
+  }
+
+  for(c = 1; c < LUT_CURVES; c++)
+    lut->curve[c] = lut->curve[0] + c * length;
+
+  lut->length = length;
+  ATOMIC_INIT(&lut->table_8u, NULL);
+  ATOMIC_INIT(&lut->table_16u, NULL);
+  ATOMIC_INIT(&lut->table_16s, NULL);
+  ATOMIC_INIT(&lut->table_32f, NULL);
+  return lut;
+}
+
+
+// -------------------------------------------------------------------------- //
+// lut_destroy
+// -------------------------------------------------------------------------- //
+void lut_destroy(Lut* lut) {
+  assert(lut != NULL);
+
+  free(lut->curve[0]);
+  if(lut->table_8u != NULL)
+    free(lut->table_8u);
+  if(lut->table_16u != NULL)
+    free(lut->table_16u);
+  if(lut->table_16s != NULL)
+    free(lut->table_16s);
+  if(lut->table_32f != NULL)
+    free(lut->table_32f);
+  free(lut);
+}
+
+
+// -------------------------------------------------------------------------- //
+// lut_update_gray
+// -------------------------------------------------------------------------- //
+void lut_update_gray(Lut* lut) {
+  int i;
+
+  assert(lut != NULL);
+
+  for(i = 0; i < lut->length; i++)
+    lut->curve[LUT_GRAY][i] = COLOR_TO_GRAYSCALE(lut->curve[2][i], lut->curve[1][i], lut->curve[0][i]);
+}
+
+
+// -------------------------------------------------------------------------- //
+// lut_eval
+// -------------------------------------------------------------------------- //
+IppMetaNumber lut_eval(Lut* lut, int curve, IppMetaNumber x) {
+  IppMetaNumber* samples;
+  int i;
+
+  assert(lut != NULL && curve >= 0 && curve < LUT_CURVES);
+
+  samples = lut->curve[curve];
+  x = clamp_unit(x) * (lut->length - 1);
+  i = (int) x;
+  if(i >= lut->length - 1)
+    return samples[lut->length - 1];
+  return samples[i] + (samples[i + 1] - samples[i]) * (x - i);
+}
+
+
+// -------------------------------------------------------------------------- //
+// lut_compose
+// -------------------------------------------------------------------------- //
+Lut* lut_compose(Lut* first, Lut* second) {
+  Lut* result;
+  int c, i;
+
+  assert(first != NULL && second != NULL);
+
+  result = lut_new(max(first->length, second->length));
+  if(result == NULL)
+    return NULL;
+
+  /* Gray curve is composed too, not recalculated - that's exactly what applying both Luts to a single-channel image does. */
+  for(c = 0; c < LUT_CURVES; c++)
+    for(i = 0; i < result->length; i++)
+      result->curve[c][i] = lut_eval(second, c, lut_eval(first, c, (IppMetaNumber) i / (result->length - 1)));
+
+  return result;
+}
+
+
+// -------------------------------------------------------------------------- //
+// lut_apply
+// -------------------------------------------------------------------------- //
+int lut_apply(Lut* lut, IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi) {
+  const void* tables[LUT_CURVES];
+  int status;
+
+  assert(lut != NULL && pSrc != NULL && pDst != NULL);
+
+  if(!is_metatype_supported(metaType))
+    return ippStsDataTypeErr;
+
+  if(IS_ERROR(status = lut_tables_table[metaType](lut, tables)))
+    return status;
+
+  DISPATCH_KERNEL(LutApplyFunc, lut_apply_table, metaType)(tables, pSrc, srcStep, pDst, dstStep, roi);
+
+  return status;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Lut_alloc
+// -------------------------------------------------------------------------- //
+VALUE rb_Lut_alloc(VALUE klass) {
+  return WRAP_LUT_A(NULL, klass); /* Underlying C struct will be allocated later, in "initialize" method */
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Lut_initialize
+// -------------------------------------------------------------------------- //
+VALUE rb_Lut_initialize(int argc, VALUE *argv, VALUE self) {
+  Lut* lut;
+  VALUE curves[3];
+  int length, c, i;
+
+  switch(argc) {
+  case 1:
+    curves[0] = curves[1] = curves[2] = argv[0];
+    break;
+  case 3:
+    curves[0] = argv[2]; /* BGR */
+    curves[1] = argv[1];
+    curves[2] = argv[0];
+    break;
+  default:
+    rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 1 or 3)", argc);
+    break;
+  }
+
+  for(c = 0; c < 3; c++)
+    Check_Type(curves[c], T_ARRAY);
+
+  length = RARRAY_LEN(curves[0]);
+  if(length < 2)
+    rb_raise(rb_eArgError, "LUT curve must contain at least 2 samples");
+  for(c = 1; c < 3; c++)
+    if(RARRAY_LEN(curves[c]) != length)
+      rb_raise(rb_eArgError, "all LUT curves must be of the same length");
+
+  lut = lut_new(length);
+  if(lut == NULL)
+    rb_raise(rb_eNoMemError, "could not allocate LUT structure");
+  if(DATA_PTR(self) != NULL)
+    lut_destroy((Lut*) DATA_PTR(self)); /* re-initialization */
+  DATA_PTR(self) = lut; /* gc will free it if conversion below throws */
+
+  for(c = 0; c < 3; c++)
+    for(i = 0; i < length; i++)
+      lut->curve[c][i] = R2M_NUM(rb_ary_entry(curves[c], i));
+  lut_update_gray(lut);
+
+  return self;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Lut_gamma
+// -------------------------------------------------------------------------- //
+VALUE rb_Lut_gamma(VALUE klass, VALUE r_gamma) {
+  Lut* lut;
+  double gamma;
+  int i;
+
+  gamma = R2C_DBL(r_gamma);
+  if(gamma <= 0.0)
+    rb_raise(rb_eArgError, "gamma must be positive");
+
+  lut = lut_new(LUT_DEFAULT_LENGTH);
+  if(lut == NULL)
+    rb_raise(rb_eNoMemError, "could not allocate LUT structure");
+
+  for(i = 0; i < lut->length; i++)
+    lut->curve[0][i] = lut->curve[1][i] = lut->curve[2][i] = (IppMetaNumber) pow((double) i / (lut->length - 1), gamma);
+  lut_update_gray(lut);
+
+  return WRAP_LUT_A(lut, klass);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Lut_levels
+// -------------------------------------------------------------------------- //
+VALUE rb_Lut_levels(int argc, VALUE *argv, VALUE klass) {
+  Lut* lut;
+  IppMetaNumber inLo, inHi, outLo, outHi, x;
+  int i;
+
+  outLo = 0.0f;
+  outHi = 1.0f;
+
+  switch(argc) {
+  case 4:
+    outLo = R2M_NUM(argv[2]);
+    outHi = R2M_NUM(argv[3]);
+    /* fall through */
+  case 2:
+    inLo = R2M_NUM(argv[0]);
+    inHi = R2M_NUM(argv[1]);
+    break;
+  default:
+    rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 2 or 4)", argc);
+    break;
+  }
+
+  if(inHi <= inLo)
+    rb_raise(rb_eArgError, "wrong input range: [%f, %f]", inLo, inHi);
+
+  lut = lut_new(LUT_DEFAULT_LENGTH);
+  if(lut == NULL)
+    rb_raise(rb_eNoMemError, "could not allocate LUT structure");
+
+  for(i = 0; i < lut->length; i++) {
+    x = clamp_unit(((IppMetaNumber) i / (lut->length - 1) - inLo) / (inHi - inLo));
+    lut->curve[0][i] = lut->curve[1][i] = lut->curve[2][i] = outLo + (outHi - outLo) * x;
+  }
+  lut_update_gray(lut);
+
+  return WRAP_LUT_A(lut, klass);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Lut_compose
+// -------------------------------------------------------------------------- //
+VALUE rb_Lut_compose(VALUE self, VALUE other) {
+  Lut* result;
+
+  other = rb_Lut_coerce(other);
+
+  result = lut_compose(Data_Get_Struct_Ret(self, Lut), Data_Get_Struct_Ret(other, Lut));
+  if(result == NULL)
+    rb_raise(rb_eNoMemError, "could not allocate LUT structure");
+
+  return WRAP_LUT_A(result, CLASS_OF(self));
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Lut_length
+// -------------------------------------------------------------------------- //
+VALUE rb_Lut_length(VALUE self) {
+  return C2R_INT(Data_Get_Struct_Ret(self, Lut)->length);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Lut_coerce
+// -------------------------------------------------------------------------- //
+VALUE rb_Lut_coerce(VALUE value) {
+  if(RTEST(rb_obj_is_kind_of(value, rb_Lut)))
+    return value;
+  else
+    return rb_class_new_instance(1, &value, rb_Lut);
+}
+
+
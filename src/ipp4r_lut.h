@@ -0,0 +1,218 @@
+#ifndef __IPP4R_LUT_H__
+#define __IPP4R_LUT_H__
+
+#include <ruby.h>
+#include <ippdefs.h>
+#include "ipp4r_fwd.h"
+#include "ipp4r_atomic.h"
+#include "ipp4r_metatype.h"
+
+/**
+ * @file
+ *
+ * This file defines C and Ruby interfaces for lookup tables. <p>
+ *
+ * Lut stores a tone curve for each color channel as a set of uniformly spaced samples in MetaNumber space,
+ * i.e. <tt>curve[c][i]</tt> is the output value of channel <tt>c</tt> for the input value <tt>i / (length - 1)</tt>. Values between samples are interpolated linearly. <p>
+ *
+ * Curves are the only "source" state of a Lut. Lookup tables for concrete data types are compiled from curves lazily, on first application to an image of the
+ * corresponding data type, and are then reused by all subsequent calls. Threads that apply a Lut at once may compile the same table, the first one to publish it
+ * wins and the others free their copies. Since composition of two Luts is also a Lut, any chain of curves costs a single pass over an image.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -------------------------------------------------------------------------- //
+// Defines
+// -------------------------------------------------------------------------- //
+#define LUT_CURVES 4            /**< Number of curves in a Lut: blue, green, red (in pixel channel order) and gray. Alpha channel is never processed. */
+#define LUT_GRAY 3              /**< Index of a gray curve, which is used for single-channel images */
+#define LUT_DEFAULT_LENGTH 1024 /**< Number of samples in curves generated by Lut constructors */
+#define LUT_32F_LEVELS 1025     /**< Number of levels in compiled 32f tables */
+
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/**
+ * Lookup table struct
+ */
+struct _Lut {
+  int length;                         /**< number of samples in each curve */
+  IppMetaNumber* curve[LUT_CURVES];   /**< curve samples */
+
+  ATOMIC_PTR table_8u;                /**< compiled Ipp8u table, LUT_CURVES x 256 entries, or NULL if not compiled yet */
+  ATOMIC_PTR table_16u;               /**< compiled Ipp16u table, LUT_CURVES x 65536 entries, or NULL if not compiled yet */
+  ATOMIC_PTR table_16s;               /**< compiled Ipp16s table, LUT_CURVES x 32768 entries for non-negative inputs, or NULL if not compiled yet */
+  ATOMIC_PTR table_32f;               /**< compiled Ipp32f table, LUT_CURVES x LUT_32F_LEVELS (value, slope) pairs, or NULL if not compiled yet. Also used for 32s and 64f images */
+};
+
+
+// -------------------------------------------------------------------------- //
+// Lut C interface
+// -------------------------------------------------------------------------- //
+/**
+ * Allocates memory for a Lut with curves of given length. Curve samples are left uninitialized.
+ *
+ * @param length number of samples in each curve, must be at least 2
+ * @returns newly allocated Lut, or NULL in case of an error.
+ */
+Lut* lut_new(int length);
+
+
+/**
+ * Frees memory occupied by Lut structure, including compiled tables.
+ */
+void lut_destroy(Lut* lut);
+
+
+/**
+ * Recalculates gray curve from blue, green and red ones. Must be called after rgb curves of a newly created Lut were filled in.
+ */
+void lut_update_gray(Lut* lut);
+
+
+/**
+ * Evaluates the given curve of a Lut.
+ *
+ * @param lut lookup table
+ * @param curve index of a curve to evaluate
+ * @param x input value
+ * @returns interpolated output value
+ */
+IppMetaNumber lut_eval(Lut* lut, int curve, IppMetaNumber x);
+
+
+/**
+ * Composes two lookup tables.
+ *
+ * @param first lookup table to apply first
+ * @param second lookup table to apply second
+ * @returns newly allocated Lut equivalent to applying first and then second, or NULL in case of an error.
+ */
+Lut* lut_compose(Lut* first, Lut* second);
+
+
+/**
+ * Maps pixels of an image buffer through a lookup table. Compiles the table for the given metatype if needed. In-place operation is supported, i.e. pSrc may be equal to pDst. <br>
+ * Note that the alpha channel is not processed.
+ *
+ * @param lut lookup table
+ * @param metaType metatype of both source and destination
+ * @param pSrc source buffer
+ * @param srcStep size of source row in bytes
+ * @param pDst destination buffer
+ * @param dstStep size of destination row in bytes
+ * @param roi size of processed region in pixels
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int lut_apply(Lut* lut, IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize roi);
+
+
+/**
+ * Registers dispatch tables of LUT kernels, see dispatch_init.
+ */
+void lut_dispatch_init(void);
+
+
+// -------------------------------------------------------------------------- //
+// Lut ruby interface
+// -------------------------------------------------------------------------- //
+/**
+ * Alloc function for LUT class. Note that the memory is actually allocated in "initialize" method.
+ */
+VALUE rb_Lut_alloc(VALUE klass);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::LUT#initialize(curve)</tt>
+ * <li> <tt>Ipp::LUT#initialize(red, green, blue)</tt>
+ * </ul>
+ *
+ * Initializes a new LUT object from arrays of uniformly spaced curve samples. All curves must be of the same length.
+ */
+VALUE rb_Lut_initialize(int argc, VALUE *argv, VALUE self);
+
+
+/**
+ * Singleton method:
+ * <ul>
+ * <li> <tt>Ipp::LUT#gamma(gamma)</tt>
+ * </ul>
+ *
+ * @returns a LUT that maps <tt>x</tt> to <tt>x ** gamma</tt>
+ */
+VALUE rb_Lut_gamma(VALUE klass, VALUE gamma);
+
+
+/**
+ * Singleton method:
+ * <ul>
+ * <li> <tt>Ipp::LUT#levels(inLo, inHi, outLo = 0.0, outHi = 1.0)</tt>
+ * </ul>
+ *
+ * @returns a LUT that linearly maps [inLo, inHi] range to [outLo, outHi], clamping values outside of the input range
+ */
+VALUE rb_Lut_levels(int argc, VALUE *argv, VALUE klass);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::LUT#compose(LUT other)</tt>
+ * </ul>
+ *
+ * @returns a newly created LUT equivalent to applying self and then other
+ */
+VALUE rb_Lut_compose(VALUE self, VALUE other);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::LUT#length</tt>
+ * </ul>
+ *
+ * @returns number of samples in LUT curves
+ */
+VALUE rb_Lut_length(VALUE self);
+
+
+/**
+ * Converts the given ruby value to LUT. Arrays are converted by calling LUT.new, LUTs are returned as is.
+ *
+ * @returns LUT object
+ */
+VALUE rb_Lut_coerce(VALUE value);
+
+
+/**
+ * Wraps a Lut structure into ruby VALUE using given CLASS.
+ *
+ * @param LUT <tt>Lut*</tt>
+ * @param CLASS <tt>VALUE</tt> of ruby class used for wrapping
+ */
+#define WRAP_LUT_A(LUT, CLASS)                                                  \
+  Data_Wrap_Struct((CLASS), NULL, lut_destroy, (LUT))
+
+
+/**
+ * Wraps a Lut structure into ruby VALUE.
+ *
+ * @param LUT <tt>Lut*</tt>
+ */
+#define WRAP_LUT(LUT)                                                           \
+  WRAP_LUT_A(LUT, rb_Lut)
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
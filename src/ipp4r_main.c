@@ -1,4 +1,5 @@
 #include <assert.h>
+#include <string.h>
 #include <ruby.h>
 #include <ipp.h>
 
@@ -41,6 +42,80 @@ DEFINE_ACCESSOR(Size, width, INT)
 DEFINE_ACCESSOR(Size, height, INT)
 
 
+// -------------------------------------------------------------------------- //
+// Supplementary functions
+// -------------------------------------------------------------------------- //
+/**
+ * @returns symbol for the given tier, e.g. :avx2
+ */
+static VALUE c2r_cpu_tier(CpuTier tier) {
+  return ID2SYM(rb_intern(dispatch_tier_name(tier)));
+}
+
+
+/**
+ * @returns tier for the given symbol, nil stands for the highest tier supported by the CPU
+ */
+static CpuTier r2c_cpu_tier(VALUE value) {
+  ID id;
+  int tier;
+
+  if(NIL_P(value))
+    return dispatch_cpu_tier();
+
+  Check_Type(value, T_SYMBOL);
+  id = SYM2ID(value);
+  for(tier = CPU_TIER_GENERIC; tier < CPU_TIER_COUNT; tier++)
+    if(id == rb_intern(dispatch_tier_name((CpuTier) tier)))
+      return (CpuTier) tier;
+
+  rb_raise(rb_eArgError, "unknown CPU tier :%s", rb_id2name(id));
+  return CPU_TIER_GENERIC; /* never reached */
+}
+
+
+/**
+ * Names of memory policies and block kinds, indexed by MemoryPolicy and DataBlockKind
+ */
+static const char* memory_names[] = {"default", "thp", "hugetlb"};
+
+
+/**
+ * @returns memory policy for the given symbol
+ */
+static MemoryPolicy r2c_memory_policy(VALUE value) {
+  ID id;
+  int policy;
+
+  Check_Type(value, T_SYMBOL);
+  id = SYM2ID(value);
+  for(policy = MEMORY_POLICY_DEFAULT; policy <= MEMORY_POLICY_HUGETLB; policy++)
+    if(id == rb_intern(memory_names[policy]))
+      return (MemoryPolicy) policy;
+
+  rb_raise(rb_eArgError, "unknown memory policy :%s", rb_id2name(id));
+  return MEMORY_POLICY_DEFAULT; /* never reached */
+}
+
+
+/**
+ * @returns NUMA placement policy for the given symbol
+ */
+static NumaPolicy r2c_numa_policy(VALUE value) {
+  ID id;
+
+  Check_Type(value, T_SYMBOL);
+  id = SYM2ID(value);
+  if(id == rb_intern("none"))
+    return NUMA_POLICY_NONE;
+  else if(id == rb_intern("first_touch"))
+    return NUMA_POLICY_FIRST_TOUCH;
+
+  rb_raise(rb_eArgError, "unknown NUMA policy :%s", rb_id2name(id));
+  return NUMA_POLICY_NONE; /* never reached */
+}
+
+
 // -------------------------------------------------------------------------- //
 // Ipp module methods
 // -------------------------------------------------------------------------- //
@@ -52,6 +127,303 @@ VALUE rb_Ipp_version() {
 }
 
 
+/**
+ * @returns array of CPU features detected at load time, e.g. [:sse2, :sse3, ..., :avx2]
+ */
+VALUE rb_Ipp_cpu_features() {
+  VALUE result;
+  int features, feature;
+
+  result = rb_ary_new();
+  features = dispatch_cpu_features();
+  for(feature = CPU_FEATURE_SSE2; feature <= CPU_FEATURE_AVX512VL; feature <<= 1)
+    if(features & feature)
+      rb_ary_push(result, ID2SYM(rb_intern(dispatch_feature_name((CpuFeature) feature))));
+
+  return result;
+}
+
+
+/**
+ * @returns hash that describes which code paths run: IPP library variant as reported by ippGetLibVersion under :ipp, highest tier supported
+ *   by the CPU under :cpu_tier, selected tier under :tier, and the tier of every native kernel under :kernels, e.g.
+ *   <tt>{:ipp => {:name => ..., :version => ..., :build_date => ..., :target_cpu => "l9"}, :cpu_tier => :avx512, :tier => :avx2, :kernels => {:arith_add => :avx2, :rotate_copy => :generic, ...}}</tt>
+ */
+VALUE rb_Ipp_dispatch_report() {
+  const IppLibraryVersion* version;
+  const DispatchTable* table;
+  VALUE result, ipp, kernels;
+  char targetCpu[sizeof(version->targetCpu) + 1];
+  int i;
+
+  ipp = rb_hash_new();
+  version = ippGetLibVersion();
+  if(version != NULL) {
+    memcpy(targetCpu, version->targetCpu, sizeof(version->targetCpu));
+    targetCpu[sizeof(version->targetCpu)] = '\0';
+
+    rb_hash_aset(ipp, ID2SYM(rb_intern("name")), C2R_STR(version->Name));
+    rb_hash_aset(ipp, ID2SYM(rb_intern("version")), C2R_STR(version->Version));
+    rb_hash_aset(ipp, ID2SYM(rb_intern("build_date")), C2R_STR(version->BuildDate));
+    rb_hash_aset(ipp, ID2SYM(rb_intern("target_cpu")), rb_str_new2(targetCpu));
+  }
+
+  kernels = rb_hash_new();
+  for(i = 0; i < dispatch_table_count(); i++) {
+    table = dispatch_table(i);
+    rb_hash_aset(kernels, ID2SYM(rb_intern(table->name)), c2r_cpu_tier(table->tier));
+  }
+
+  result = rb_hash_new();
+  rb_hash_aset(result, ID2SYM(rb_intern("ipp")), ipp);
+  rb_hash_aset(result, ID2SYM(rb_intern("cpu_tier")), c2r_cpu_tier(dispatch_cpu_tier()));
+  rb_hash_aset(result, ID2SYM(rb_intern("tier")), c2r_cpu_tier(dispatch_tier()));
+  rb_hash_aset(result, ID2SYM(rb_intern("kernels")), kernels);
+  return result;
+}
+
+
+/**
+ * @returns tier that native kernels are selected for, one of :generic, :sse4, :avx2, :avx512
+ */
+VALUE rb_Ipp_force_cpu_tier(VALUE self) {
+  return c2r_cpu_tier(dispatch_tier());
+}
+
+
+/**
+ * Selects native kernels of the given tier, or of the highest lower tier a kernel is built for. nil restores the highest tier supported by the CPU.
+ * Tiers above the one supported by the CPU are rejected. IPP primitives are not affected.
+ */
+VALUE rb_Ipp_force_cpu_tier_set(VALUE self, VALUE value) {
+  CpuTier tier;
+
+  tier = r2c_cpu_tier(value);
+  if(dispatch_set_tier(tier) != ippStsNoErr)
+    rb_raise(rb_eArgError, "CPU doesn't support :%s tier", dispatch_tier_name(tier));
+  return value;
+}
+
+
+/**
+ * @returns alignment of rows of newly allocated images in bytes
+ */
+VALUE rb_Ipp_alignment(VALUE self) {
+  return C2R_INT(data_alignment());
+}
+
+
+/**
+ * Sets alignment of rows of newly allocated images, a power of two between 16 and 4096. nil restores the default one, which is 64 on AVX-512 capable CPUs and 32 on others.
+ */
+VALUE rb_Ipp_alignment_set(VALUE self, VALUE value) {
+  int alignment;
+
+  if(NIL_P(value))
+    data_set_alignment(0);
+  else if((alignment = R2C_INT(value)) == 0 || data_set_alignment(alignment) != ippStsNoErr)
+    rb_raise(rb_eArgError, "wrong alignment: %d", alignment);
+  return value;
+}
+
+
+/**
+ * @returns true if the first interior pixel of newly allocated images is aligned, false if the buffer start is
+ */
+VALUE rb_Ipp_align_interior(VALUE self) {
+  return C2R_BOOL(data_align_interior());
+}
+
+
+/**
+ * Sets whether the first interior pixel of newly allocated images, and therefore every row inside the border, must be aligned rather than the buffer start.
+ */
+VALUE rb_Ipp_align_interior_set(VALUE self, VALUE value) {
+  data_set_align_interior(R2C_BOOL(value));
+  return value;
+}
+
+
+/**
+ * @returns memory policy of image buffers, one of :default, :thp, :hugetlb
+ */
+VALUE rb_Ipp_memory_policy(VALUE self) {
+  return ID2SYM(rb_intern(memory_names[data_memory_policy()]));
+}
+
+
+/**
+ * Sets memory policy of image buffers not smaller than Ipp.huge_page_threshold: :default for the ruby heap, :thp for transparent huge pages,
+ * :hugetlb for the reserved huge page pool. If the system can't provide huge pages, allocation falls back from :hugetlb to :thp, and from :thp to the ruby heap.
+ */
+VALUE rb_Ipp_memory_policy_set(VALUE self, VALUE value) {
+  data_set_memory_policy(r2c_memory_policy(value));
+  return value;
+}
+
+
+/**
+ * @returns minimal size in bytes of image buffer allocated according to the memory policy
+ */
+VALUE rb_Ipp_huge_page_threshold(VALUE self) {
+  return ULL2NUM(data_huge_page_threshold());
+}
+
+
+/**
+ * Sets minimal size in bytes of image buffer allocated according to the memory policy.
+ */
+VALUE rb_Ipp_huge_page_threshold_set(VALUE self, VALUE value) {
+  data_set_huge_page_threshold((size_t) NUM2ULL(value));
+  return value;
+}
+
+
+/**
+ * @returns hash of image buffer allocation statistics: live blocks, live bytes and allocations made so far for each kind of memory
+ *   under :default, :thp and :hugetlb, and :fallbacks, :live_bytes, :peak_bytes, e.g.
+ *   <tt>{:default => {:blocks => 12, :bytes => 1048576, :allocations => 80}, :thp => {...}, :hugetlb => {...}, :fallbacks => 0, :live_bytes => ..., :peak_bytes => ...}</tt>
+ */
+VALUE rb_Ipp_allocation_stats(VALUE self) {
+  DataStats stats;
+  VALUE result, kind;
+  int i;
+
+  data_stats(&stats);
+
+  result = rb_hash_new();
+  for(i = 0; i < DATA_BLOCK_KIND_COUNT; i++) {
+    kind = rb_hash_new();
+    rb_hash_aset(kind, ID2SYM(rb_intern("blocks")), C2R_INT(stats.blocks[i]));
+    rb_hash_aset(kind, ID2SYM(rb_intern("bytes")), ULL2NUM(stats.bytes[i]));
+    rb_hash_aset(kind, ID2SYM(rb_intern("allocations")), C2R_INT(stats.allocations[i]));
+    rb_hash_aset(result, ID2SYM(rb_intern(memory_names[i])), kind);
+  }
+  rb_hash_aset(result, ID2SYM(rb_intern("fallbacks")), C2R_INT(stats.fallbacks));
+  rb_hash_aset(result, ID2SYM(rb_intern("live_bytes")), ULL2NUM(stats.liveBytes));
+  rb_hash_aset(result, ID2SYM(rb_intern("peak_bytes")), ULL2NUM(stats.peakBytes));
+  return result;
+}
+
+
+/**
+ * @returns number of NUMA nodes that have CPUs available to the process
+ */
+VALUE rb_Ipp_numa_nodes(VALUE self) {
+  return C2R_INT(numa_node_count());
+}
+
+
+/**
+ * @returns NUMA placement policy of image buffers, :none or :first_touch
+ */
+VALUE rb_Ipp_numa_policy(VALUE self) {
+  return ID2SYM(rb_intern(numa_policy() == NUMA_POLICY_FIRST_TOUCH ? "first_touch" : "none"));
+}
+
+
+/**
+ * Sets NUMA placement policy of image buffers. With :first_touch, large buffers are zeroed band by band by the workers that will process them,
+ * so that each band is placed on the node of its worker. Combine with Ipp.bind_workers = true to keep workers, and therefore bands, on their nodes.
+ */
+VALUE rb_Ipp_numa_policy_set(VALUE self, VALUE value) {
+  numa_set_policy(r2c_numa_policy(value));
+  return value;
+}
+
+
+/**
+ * @returns true if workers are bound to NUMA nodes
+ */
+VALUE rb_Ipp_bind_workers(VALUE self) {
+  return C2R_BOOL(numa_workers_bound());
+}
+
+
+/**
+ * Binds workers to NUMA nodes, consecutive workers share a node. Workers rebind before their next job or tile, the calling thread isn't bound.
+ * false restores the original affinity.
+ */
+VALUE rb_Ipp_bind_workers_set(VALUE self, VALUE value) {
+  if(numa_bind_workers(R2C_BOOL(value)) != ippStsNoErr)
+    rb_raise(rb_eNotImpError, "binding workers to NUMA nodes is not supported by this build or system");
+  return value;
+}
+
+
+/**
+ * @returns number of threads in the pool that runs asynchronous operations and tiles of parallel kernels
+ */
+VALUE rb_Ipp_pool_size(VALUE self) {
+  return C2R_INT(pool_size());
+}
+
+
+/**
+ * Sets number of threads in the pool, nil restores the default one, i.e. IPP4R_NUM_THREADS or OMP_THREAD_LIMIT from the environment,
+ * or the number of CPUs.
+ */
+VALUE rb_Ipp_pool_size_set(VALUE self, VALUE value) {
+  if(pool_set_size(NIL_P(value) ? 0 : R2C_INT(value)) != ippStsNoErr)
+    rb_raise(rb_eArgError, "pool size must be in 1..%d", POOL_MAX_SIZE);
+  return value;
+}
+
+
+/**
+ * @returns hash of utilization counters of a thread
+ */
+static VALUE rb_Ipp_pool_counters(const PoolCounters* counters) {
+  VALUE result;
+
+  result = rb_hash_new();
+  rb_hash_aset(result, ID2SYM(rb_intern("loops")), LL2NUM(counters->loops));
+  rb_hash_aset(result, ID2SYM(rb_intern("serial_loops")), LL2NUM(counters->serialLoops));
+  rb_hash_aset(result, ID2SYM(rb_intern("tasks")), LL2NUM(counters->tasks));
+  rb_hash_aset(result, ID2SYM(rb_intern("steals")), LL2NUM(counters->steals));
+  rb_hash_aset(result, ID2SYM(rb_intern("jobs")), LL2NUM(counters->jobs));
+  rb_hash_aset(result, ID2SYM(rb_intern("sleeps")), LL2NUM(counters->sleeps));
+  rb_hash_aset(result, ID2SYM(rb_intern("busy")), rb_float_new(counters->busy));
+  return result;
+}
+
+
+/**
+ * @returns hash of utilization counters of the pool: size, number of live workers, numbers of parallel and serial loops,
+ * counters of each worker slot used so far in :workers_stats, and counters of the threads that called kernels in :callers
+ */
+VALUE rb_Ipp_pool_stats(VALUE self) {
+  PoolStats* stats;
+  VALUE result, workers;
+  int i;
+
+  stats = ALLOC(PoolStats);
+  pool_stats(stats);
+
+  result = rb_hash_new();
+  rb_hash_aset(result, ID2SYM(rb_intern("size")), C2R_INT(stats->size));
+  rb_hash_aset(result, ID2SYM(rb_intern("workers")), C2R_INT(stats->workers));
+  rb_hash_aset(result, ID2SYM(rb_intern("loops")), LL2NUM(stats->loops));
+  rb_hash_aset(result, ID2SYM(rb_intern("serial_loops")), LL2NUM(stats->serialLoops));
+  workers = rb_ary_new2(stats->slots);
+  for(i = 0; i < stats->slots; i++)
+    rb_ary_push(workers, rb_Ipp_pool_counters(&stats->worker[i]));
+  rb_hash_aset(result, ID2SYM(rb_intern("workers_stats")), workers);
+  rb_hash_aset(result, ID2SYM(rb_intern("callers")), rb_Ipp_pool_counters(&stats->callers));
+
+  xfree(stats);
+  return result;
+}
+
+
+/**
+ * End proc that stops the pool before the interpreter goes down under the running jobs.
+ */
+static void rb_Ipp_pool_shutdown(VALUE data) {
+  pool_shutdown();
+}
+
+
 // -------------------------------------------------------------------------- //
 // Init
 // -------------------------------------------------------------------------- //
@@ -68,10 +440,37 @@ void Init_ipp4r() {
   /* trace depth */
   IF_TRACE(trace_depth = 0;)
 
+  /* Select native kernels for the CPU */
+  dispatch_init();
+  numa_init();
+  pool_init();
+  rb_set_end_proc(rb_Ipp_pool_shutdown, Qnil);
+
 
   /* Then init Ipp module */
   rb_Ipp = rb_define_module("Ipp");
   rb_define_module_function(rb_Ipp, "version", rb_Ipp_version, 0);
+  rb_define_module_function(rb_Ipp, "cpu_features", rb_Ipp_cpu_features, 0);
+  rb_define_module_function(rb_Ipp, "dispatch_report", rb_Ipp_dispatch_report, 0);
+  rb_define_module_function(rb_Ipp, "force_cpu_tier", rb_Ipp_force_cpu_tier, 0);
+  rb_define_module_function(rb_Ipp, "force_cpu_tier=", rb_Ipp_force_cpu_tier_set, 1);
+  rb_define_module_function(rb_Ipp, "alignment", rb_Ipp_alignment, 0);
+  rb_define_module_function(rb_Ipp, "alignment=", rb_Ipp_alignment_set, 1);
+  rb_define_module_function(rb_Ipp, "align_interior", rb_Ipp_align_interior, 0);
+  rb_define_module_function(rb_Ipp, "align_interior=", rb_Ipp_align_interior_set, 1);
+  rb_define_module_function(rb_Ipp, "memory_policy", rb_Ipp_memory_policy, 0);
+  rb_define_module_function(rb_Ipp, "memory_policy=", rb_Ipp_memory_policy_set, 1);
+  rb_define_module_function(rb_Ipp, "huge_page_threshold", rb_Ipp_huge_page_threshold, 0);
+  rb_define_module_function(rb_Ipp, "huge_page_threshold=", rb_Ipp_huge_page_threshold_set, 1);
+  rb_define_module_function(rb_Ipp, "allocation_stats", rb_Ipp_allocation_stats, 0);
+  rb_define_module_function(rb_Ipp, "numa_nodes", rb_Ipp_numa_nodes, 0);
+  rb_define_module_function(rb_Ipp, "numa_policy", rb_Ipp_numa_policy, 0);
+  rb_define_module_function(rb_Ipp, "numa_policy=", rb_Ipp_numa_policy_set, 1);
+  rb_define_module_function(rb_Ipp, "bind_workers", rb_Ipp_bind_workers, 0);
+  rb_define_module_function(rb_Ipp, "bind_workers=", rb_Ipp_bind_workers_set, 1);
+  rb_define_module_function(rb_Ipp, "pool_size", rb_Ipp_pool_size, 0);
+  rb_define_module_function(rb_Ipp, "pool_size=", rb_Ipp_pool_size_set, 1);
+  rb_define_module_function(rb_Ipp, "pool_stats", rb_Ipp_pool_stats, 0);
 
   /* Then enums */
   rb_Enum = rb_define_class_under(rb_Ipp, "Enum", rb_cObject);
@@ -86,6 +485,8 @@ void Init_ipp4r() {
 #define DEFINE_ENUM(E, ARG) ENUM(ARX_JOIN(ipp, E), ARX_STRINGIZE(ARX_JOIN(Ipp, E)))
   ENUM_DEF(rb_MetaType, "MetaType")
     ARX_ARRAY_FOREACH(M_SUPPORTED, DEFINE_ENUM, ~)
+    ARX_ARRAY_FOREACH(M_STORAGE_ONLY, DEFINE_ENUM, ~)
+    ARX_ARRAY_FOREACH(M_PLANAR, DEFINE_ENUM, ~)
   ENUM_END()
   
   ENUM_DEF(rb_Channels, "Channels")
@@ -93,7 +494,7 @@ void Init_ipp4r() {
   ENUM_END()
   
   ENUM_DEF(rb_DataType, "DataType")
-    ARX_ARRAY_FOREACH(D_SUPPORTED, DEFINE_ENUM, ~)
+    ARX_ARRAY_FOREACH(D_ALL, DEFINE_ENUM, ~)
   ENUM_END()
 #undef DEFINE_ENUM
 
@@ -117,11 +518,58 @@ void Init_ipp4r() {
     ENUM(ippMskSize5x5, "MskSize5x5")
   ENUM_END()
 
+  ENUM_DEF(rb_BlendMode, "BlendMode")
+    ENUM(BLEND_COPY,     "BlendCopy")
+    ENUM(BLEND_OVER,     "BlendOver")
+    ENUM(BLEND_MULTIPLY, "BlendMultiply")
+    ENUM(BLEND_SCREEN,   "BlendScreen")
+    ENUM(BLEND_ADDITIVE, "BlendAdditive")
+  ENUM_END()
+
+  ENUM_DEF(rb_ResizeMode, "ResizeMode")
+    ENUM(RESIZE_NEAREST, "ResizeNearest")
+    ENUM(RESIZE_LINEAR,  "ResizeLinear")
+    ENUM(RESIZE_CUBIC,   "ResizeCubic")
+    ENUM(RESIZE_LANCZOS, "ResizeLanczos")
+    ENUM(RESIZE_AREA,    "ResizeArea")
+  ENUM_END()
+
+  ENUM_DEF(rb_InterpMode, "InterpMode")
+    ENUM(INTERP_NEAREST, "InterpNearest")
+    ENUM(INTERP_LINEAR,  "InterpLinear")
+    ENUM(INTERP_CUBIC,   "InterpCubic")
+  ENUM_END()
+
+  ENUM_DEF(rb_BorderMode, "BorderMode")
+    ENUM(BORDER_CONSTANT,    "BorderConstant")
+    ENUM(BORDER_REPLICATE,   "BorderReplicate")
+    ENUM(BORDER_TRANSPARENT, "BorderTransparent")
+  ENUM_END()
+
+  ENUM_DEF(rb_ColorSpace, "ColorSpace")
+    ENUM(COLORSPACE_RGB,   "ColorSpaceRGB")
+    ENUM(COLORSPACE_HSV,   "ColorSpaceHSV")
+    ENUM(COLORSPACE_HLS,   "ColorSpaceHLS")
+    ENUM(COLORSPACE_YCBCR, "ColorSpaceYCbCr")
+    ENUM(COLORSPACE_LAB,   "ColorSpaceLab")
+    ENUM(COLORSPACE_XYZ,   "ColorSpaceXYZ")
+  ENUM_END()
+
+  ENUM_DEF(rb_Yuv420Format, "Yuv420Format")
+    ENUM(YUV420_I420, "Yuv420I420")
+    ENUM(YUV420_YV12, "Yuv420YV12")
+    ENUM(YUV420_NV12, "Yuv420NV12")
+    ENUM(YUV420_NV21, "Yuv420NV21")
+  ENUM_END()
+
   /* And all other classes */
   rb_Image = rb_define_class_under(rb_Ipp, "Image", rb_cObject);
   rb_define_singleton_method(rb_Image, "jaehne", rb_Image_jaehne, -1);
   rb_define_singleton_method(rb_Image, "ramp", rb_Image_ramp, -1);
   rb_define_singleton_method(rb_Image, "load", rb_Image_load, -1);
+  rb_define_singleton_method(rb_Image, "reconstruct_laplacian", rb_Image_reconstruct_laplacian, 1);
+  rb_define_singleton_method(rb_Image, "from_yuv420", rb_Image_from_yuv420, -1);
+  rb_define_singleton_method(rb_Image, "batch", rb_Image_batch, 1);
   rb_define_alloc_func(rb_Image, rb_Image_alloc);
   rb_define_method(rb_Image, "initialize", rb_Image_initialize, -1);
   rb_define_method(rb_Image, "initialize_copy", rb_Image_initialize_copy, 1);
@@ -131,6 +579,10 @@ void Init_ipp4r() {
   rb_define_method(rb_Image, "add_rand_uniform!", rb_Image_add_rand_uniform_bang, 2);
   rb_define_method(rb_Image, "add_rand_uniform", rb_Image_add_rand_uniform, 2);
   rb_define_method(rb_Image, "convert", rb_Image_convert, 1);
+  rb_define_method(rb_Image, "to_colorspace", rb_Image_to_colorspace, -1);
+  rb_define_method(rb_Image, "from_colorspace", rb_Image_from_colorspace, -1);
+  rb_define_method(rb_Image, "to_yuv420", rb_Image_to_yuv420, -1);
+  rb_define_method(rb_Image, "to_planar", rb_Image_to_planar, 0);
   rb_define_method(rb_Image, "width", rb_Image_width, 0);
   rb_define_method(rb_Image, "height", rb_Image_height, 0);
   rb_define_method(rb_Image, "size", rb_Image_size, 0);
@@ -143,6 +595,7 @@ void Init_ipp4r() {
   rb_define_method(rb_Image, "fill!", rb_Image_fill_bang, 1);
   rb_define_method(rb_Image, "fill", rb_Image_fill, 1);
   rb_define_method(rb_Image, "transpose", rb_Image_transpose, 0);
+  rb_define_method(rb_Image, "transpose!", rb_Image_transpose_bang, 0);
   rb_define_method(rb_Image, "subimage", rb_Image_subimage, -1);
   rb_define_method(rb_Image, "threshold!", rb_Image_threshold_bang, -1);
   rb_define_method(rb_Image, "threshold", rb_Image_threshold, -1);
@@ -167,11 +620,95 @@ void Init_ipp4r() {
   rb_define_method(rb_Image, "draw_rotated", rb_Image_draw_rotated, -1);
   rb_define_method(rb_Image, "resize", rb_Image_resize, -1);
   rb_define_method(rb_Image, "resize_factor", rb_Image_resize_factor, -1);
+  rb_define_method(rb_Image, "thumbnail", rb_Image_thumbnail, -1);
+  rb_define_method(rb_Image, "gaussian_pyramid", rb_Image_gaussian_pyramid, 1);
+  rb_define_method(rb_Image, "laplacian_pyramid", rb_Image_laplacian_pyramid, 1);
+  rb_define_method(rb_Image, "warp_affine", rb_Image_warp_affine, -1);
+  rb_define_method(rb_Image, "warp_perspective", rb_Image_warp_perspective, -1);
+  rb_define_method(rb_Image, "remap", rb_Image_remap, -1);
   rb_define_method(rb_Image, "mirror!", rb_Image_mirror_bang, -1);
   rb_define_method(rb_Image, "mirror", rb_Image_mirror, -1);
+  rb_define_method(rb_Image, "rotate90!", rb_Image_rotate90_bang, -1);
+  rb_define_method(rb_Image, "rotate90", rb_Image_rotate90, -1);
+  rb_define_method(rb_Image, "normalize_orientation!", rb_Image_normalize_orientation_bang, 1);
+  rb_define_method(rb_Image, "normalize_orientation", rb_Image_normalize_orientation, 1);
+  rb_define_method(rb_Image, "apply_lut!", rb_Image_apply_lut_bang, 1);
+  rb_define_method(rb_Image, "apply_lut", rb_Image_apply_lut, 1);
+  rb_define_method(rb_Image, "add!", rb_Image_add_bang, 1);
+  rb_define_method(rb_Image, "add", rb_Image_add, 1);
+  rb_define_method(rb_Image, "sub!", rb_Image_sub_bang, 1);
+  rb_define_method(rb_Image, "sub", rb_Image_sub, 1);
+  rb_define_method(rb_Image, "mul!", rb_Image_mul_bang, 1);
+  rb_define_method(rb_Image, "mul", rb_Image_mul, 1);
+  rb_define_method(rb_Image, "div!", rb_Image_div_bang, 1);
+  rb_define_method(rb_Image, "div", rb_Image_div, 1);
+  rb_define_method(rb_Image, "abs_diff!", rb_Image_abs_diff_bang, 1);
+  rb_define_method(rb_Image, "abs_diff", rb_Image_abs_diff, 1);
+  rb_define_method(rb_Image, "add_weighted!", rb_Image_add_weighted_bang, -1);
+  rb_define_method(rb_Image, "add_weighted", rb_Image_add_weighted, -1);
+  rb_define_method(rb_Image, "alpha_composite!", rb_Image_alpha_composite_bang, 1);
+  rb_define_method(rb_Image, "alpha_composite", rb_Image_alpha_composite, 1);
+  rb_define_method(rb_Image, "async", rb_Image_async, 0);
+
+  rb_AsyncImage = rb_define_class_under(rb_Image, "Async", rb_cObject);
+  rb_undef_alloc_func(rb_AsyncImage);
+  rb_define_method(rb_AsyncImage, "convert", rb_AsyncImage_convert, 1);
+  rb_define_method(rb_AsyncImage, "transpose", rb_AsyncImage_transpose, 0);
+  rb_define_method(rb_AsyncImage, "mirror", rb_AsyncImage_mirror, -1);
+  rb_define_method(rb_AsyncImage, "rotate90", rb_AsyncImage_rotate90, -1);
+  rb_define_method(rb_AsyncImage, "threshold", rb_AsyncImage_threshold, -1);
+  rb_define_method(rb_AsyncImage, "dilate3x3", rb_AsyncImage_dilate3x3, 0);
+  rb_define_method(rb_AsyncImage, "erode3x3", rb_AsyncImage_erode3x3, 0);
+  rb_define_method(rb_AsyncImage, "dilate", rb_AsyncImage_dilate, -1);
+  rb_define_method(rb_AsyncImage, "erode", rb_AsyncImage_erode, -1);
+  rb_define_method(rb_AsyncImage, "filter", rb_AsyncImage_filter, -1);
+  rb_define_method(rb_AsyncImage, "filter_box", rb_AsyncImage_filter_box, -1);
+  rb_define_method(rb_AsyncImage, "filter_min", rb_AsyncImage_filter_min, -1);
+  rb_define_method(rb_AsyncImage, "filter_max", rb_AsyncImage_filter_max, -1);
+  rb_define_method(rb_AsyncImage, "filter_median", rb_AsyncImage_filter_median, -1);
+  rb_define_method(rb_AsyncImage, "filter_gauss", rb_AsyncImage_filter_gauss, -1);
+  rb_define_method(rb_AsyncImage, "resize", rb_AsyncImage_resize, -1);
+  rb_define_method(rb_AsyncImage, "thumbnail", rb_AsyncImage_thumbnail, -1);
+
+  rb_ImageBatch = rb_define_class_under(rb_Image, "Batch", rb_cObject);
+  rb_undef_alloc_func(rb_ImageBatch);
+  rb_define_method(rb_ImageBatch, "convert", rb_AsyncImage_convert, 1);
+  rb_define_method(rb_ImageBatch, "transpose", rb_AsyncImage_transpose, 0);
+  rb_define_method(rb_ImageBatch, "mirror", rb_AsyncImage_mirror, -1);
+  rb_define_method(rb_ImageBatch, "rotate90", rb_AsyncImage_rotate90, -1);
+  rb_define_method(rb_ImageBatch, "threshold", rb_AsyncImage_threshold, -1);
+  rb_define_method(rb_ImageBatch, "dilate3x3", rb_AsyncImage_dilate3x3, 0);
+  rb_define_method(rb_ImageBatch, "erode3x3", rb_AsyncImage_erode3x3, 0);
+  rb_define_method(rb_ImageBatch, "dilate", rb_AsyncImage_dilate, -1);
+  rb_define_method(rb_ImageBatch, "erode", rb_AsyncImage_erode, -1);
+  rb_define_method(rb_ImageBatch, "filter", rb_AsyncImage_filter, -1);
+  rb_define_method(rb_ImageBatch, "filter_box", rb_AsyncImage_filter_box, -1);
+  rb_define_method(rb_ImageBatch, "filter_min", rb_AsyncImage_filter_min, -1);
+  rb_define_method(rb_ImageBatch, "filter_max", rb_AsyncImage_filter_max, -1);
+  rb_define_method(rb_ImageBatch, "filter_median", rb_AsyncImage_filter_median, -1);
+  rb_define_method(rb_ImageBatch, "filter_gauss", rb_AsyncImage_filter_gauss, -1);
+  rb_define_method(rb_ImageBatch, "resize", rb_AsyncImage_resize, -1);
+  rb_define_method(rb_ImageBatch, "thumbnail", rb_AsyncImage_thumbnail, -1);
+
+  rb_Future = rb_define_class_under(rb_Ipp, "Future", rb_cObject);
+  rb_undef_alloc_func(rb_Future);
+  rb_define_method(rb_Future, "value", rb_Future_value, 0);
+  rb_define_method(rb_Future, "wait", rb_Future_wait, 0);
+  rb_define_method(rb_Future, "ready?", rb_Future_ready_p, 0);
+  rb_define_method(rb_Future, "then", rb_Future_then, 0);
 
   rb_Data = rb_define_class_under(rb_Image, "Data", rb_cObject);
 
+  rb_PlanarImage = rb_define_class_under(rb_Ipp, "PlanarImage", rb_cObject);
+  rb_define_alloc_func(rb_PlanarImage, rb_PlanarImage_alloc);
+  rb_define_method(rb_PlanarImage, "initialize", rb_PlanarImage_initialize, -1);
+  rb_define_method(rb_PlanarImage, "width", rb_PlanarImage_width, 0);
+  rb_define_method(rb_PlanarImage, "height", rb_PlanarImage_height, 0);
+  rb_define_method(rb_PlanarImage, "metatype", rb_PlanarImage_metatype, 0);
+  rb_define_method(rb_PlanarImage, "planes", rb_PlanarImage_planes, 0);
+  rb_define_method(rb_PlanarImage, "channel", rb_PlanarImage_channel, 1);
+  rb_define_method(rb_PlanarImage, "to_image", rb_PlanarImage_to_image, 0);
+
   rb_Color = rb_define_class_under(rb_Ipp, "Color", rb_cObject);
   rb_define_alloc_func(rb_Color, rb_Color_alloc);
   rb_define_method(rb_Color, "initialize", rb_Color_initialize, -1);
@@ -204,6 +741,53 @@ void Init_ipp4r() {
   RB_DEFINE_ACCESSOR(Point, x);
   RB_DEFINE_ACCESSOR(Point, y);
 
+  rb_Lut = rb_define_class_under(rb_Ipp, "LUT", rb_cObject);
+  rb_define_singleton_method(rb_Lut, "gamma", rb_Lut_gamma, 1);
+  rb_define_singleton_method(rb_Lut, "levels", rb_Lut_levels, -1);
+  rb_define_alloc_func(rb_Lut, rb_Lut_alloc);
+  rb_define_method(rb_Lut, "initialize", rb_Lut_initialize, -1);
+  rb_define_method(rb_Lut, "compose", rb_Lut_compose, 1);
+  rb_define_method(rb_Lut, "length", rb_Lut_length, 0);
+
+  rb_Kernel = rb_define_class_under(rb_Ipp, "Kernel", rb_cObject);
+  rb_define_alloc_func(rb_Kernel, rb_Matrix_alloc);
+  rb_define_method(rb_Kernel, "initialize", rb_Matrix_initialize, -1);
+  rb_define_method(rb_Kernel, "initialize_copy", rb_Matrix_initialize_copy, 1);
+  rb_define_method(rb_Kernel, "width", rb_Matrix_width, 0);
+  rb_define_method(rb_Kernel, "height", rb_Matrix_height, 0);
+  rb_define_method(rb_Kernel, "size", rb_Matrix_size, 0);
+  rb_define_method(rb_Kernel, "nonzero", rb_Matrix_nonzero, 0);
+  rb_define_method(rb_Kernel, "separable?", rb_Matrix_separable_p, 0);
+  rb_define_method(rb_Kernel, "symmetry", rb_Matrix_symmetry, 0);
+  rb_define_method(rb_Kernel, "factors", rb_Matrix_factors, 0);
+  rb_define_method(rb_Kernel, "to_a", rb_Matrix_to_a, 0);
+
+  rb_Mask = rb_define_class_under(rb_Ipp, "Mask", rb_cObject);
+  rb_define_alloc_func(rb_Mask, rb_Matrix_alloc);
+  rb_define_method(rb_Mask, "initialize", rb_Matrix_initialize, -1);
+  rb_define_method(rb_Mask, "initialize_copy", rb_Matrix_initialize_copy, 1);
+  rb_define_method(rb_Mask, "width", rb_Matrix_width, 0);
+  rb_define_method(rb_Mask, "height", rb_Matrix_height, 0);
+  rb_define_method(rb_Mask, "size", rb_Matrix_size, 0);
+  rb_define_method(rb_Mask, "nonzero", rb_Matrix_nonzero, 0);
+  rb_define_method(rb_Mask, "separable?", rb_Matrix_separable_p, 0);
+  rb_define_method(rb_Mask, "symmetry", rb_Matrix_symmetry, 0);
+  rb_define_method(rb_Mask, "to_a", rb_Matrix_to_a, 0);
+
+  rb_ResizePlan = rb_define_class_under(rb_Ipp, "ResizePlan", rb_cObject);
+  rb_define_alloc_func(rb_ResizePlan, rb_ResizePlan_alloc);
+  rb_define_method(rb_ResizePlan, "initialize", rb_ResizePlan_initialize, -1);
+  rb_define_method(rb_ResizePlan, "apply", rb_ResizePlan_apply, -1);
+  rb_define_method(rb_ResizePlan, "src_size", rb_ResizePlan_src_size, 0);
+  rb_define_method(rb_ResizePlan, "dst_size", rb_ResizePlan_dst_size, 0);
+
+  rb_RemapPlan = rb_define_class_under(rb_Ipp, "RemapPlan", rb_cObject);
+  rb_define_alloc_func(rb_RemapPlan, rb_RemapPlan_alloc);
+  rb_define_method(rb_RemapPlan, "initialize", rb_RemapPlan_initialize, -1);
+  rb_define_method(rb_RemapPlan, "apply", rb_RemapPlan_apply, -1);
+  rb_define_method(rb_RemapPlan, "src_size", rb_RemapPlan_src_size, 0);
+  rb_define_method(rb_RemapPlan, "dst_size", rb_RemapPlan_dst_size, 0);
+
   rb_Exception = rb_define_class_under(rb_Ipp, "Exception", rb_eStandardError);
 
   // forbid new()
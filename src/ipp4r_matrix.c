@@ -1,42 +1,399 @@
 #include <assert.h>
+#include <math.h>
+#include <string.h>
+#include <ruby.h>
 #include "ipp4r.h"
-#include "ipp4r_matrix.h"
 
 
-Matrix* matrix_new(VALUE r_matrix, int isMask) {
-  Matrix* result;
-  int r, c;
-  int i, j;
+// -------------------------------------------------------------------------- //
+// Supplementary functions
+// -------------------------------------------------------------------------- //
+/**
+ * @returns coefficient of a matrix in row i and column j
+ */
+static double matrix_get(const Matrix* matrix, int i, int j) {
+  if(matrix->isMask)
+    return ((const Ipp8u*) matrix->data)[i * matrix->size.width + j];
+  else
+    return ((const Ipp32f*) matrix->data)[i * matrix->size.width + j];
+}
+
+
+/**
+ * Sets coefficient number n of a matrix in row-major order. Mask cells are set for values of 1 or more.
+ */
+static void matrix_set(Matrix* matrix, int n, double v) {
+  if(matrix->isMask)
+    ((Ipp8u*) matrix->data)[n] = v >= 1.0 ? 1 : 0;
+  else
+    ((Ipp32f*) matrix->data)[n] = (Ipp32f) v;
+}
+
+
+// -------------------------------------------------------------------------- //
+// matrix_alloc
+// -------------------------------------------------------------------------- //
+Matrix* matrix_alloc(IppiSize size, int isMask) {
+  Matrix* matrix;
+  size_t dataSize;
+
+  assert(size.width > 0 && size.height > 0);
+
+  /* Coefficients and factors are placed right after the struct, in the same block */
+  dataSize = (size_t) size.width * size.height * (isMask ? sizeof(Ipp8u) : sizeof(Ipp32f));
+  matrix = (Matrix*) malloc(sizeof(Matrix) + MATRIX_ALIGNMENT - 1 + dataSize + (isMask ? 0 : (size.width + size.height) * sizeof(Ipp32f)));
+  if(matrix == NULL)
+    return NULL;
+
+  ATOMIC_INIT(&matrix->refs, 1);
+  matrix->isMask = isMask;
+  matrix->data = (void*) (((size_t) (matrix + 1) + MATRIX_ALIGNMENT - 1) & ~((size_t) MATRIX_ALIGNMENT - 1));
+  matrix->size = size;
+  matrix->nonZero = 0;
+  matrix->symmetry = 0;
+  matrix->separable = FALSE;
+  if(isMask) {
+    matrix->column = NULL;
+    matrix->row = NULL;
+  } else {
+    matrix->column = (Ipp32f*) ((char*) matrix->data + dataSize);
+    matrix->row = matrix->column + size.height;
+  }
+
+  return matrix;
+}
 
-  r = R2C_INT(rb_funcall(r_matrix, rb_ID_row_size, 0));
-  c = R2C_INT(rb_funcall(r_matrix, rb_ID_column_size, 0));
-
-  result = (Matrix*) malloc(sizeof(Matrix));
-  result->size.height = r;
-  result->size.width = c;
-  result->isMask = isMask;
-  result->data = malloc(r * c * (isMask ? sizeof(char) : sizeof(float)));
-
-  for(i = 0; i < r; i++) {
-    for(j = 0; j < c; j++) {
-      VALUE v = rb_funcall_rescue(r_matrix, rb_ID_aref, 2, C2R_INT(i), C2R_INT(j));
-      if(v == Qundef) {
-        matrix_destroy(result);
-        return NULL;
+
+// -------------------------------------------------------------------------- //
+// matrix_analyze
+// -------------------------------------------------------------------------- //
+void matrix_analyze(Matrix* matrix) {
+  int width, height, i, j, p, q;
+  double v, maxAbs;
+
+  assert(matrix != NULL);
+
+  width = matrix->size.width;
+  height = matrix->size.height;
+
+  matrix->nonZero = 0;
+  matrix->symmetry = MATRIX_SYMMETRIC_LEFT_RIGHT | MATRIX_SYMMETRIC_TOP_BOTTOM | MATRIX_SYMMETRIC_CENTRAL;
+  maxAbs = 0.0;
+  p = q = 0;
+  for(i = 0; i < height; i++) {
+    for(j = 0; j < width; j++) {
+      v = matrix_get(matrix, i, j);
+      if(v != 0.0)
+        matrix->nonZero++;
+      if(fabs(v) > maxAbs) {
+        maxAbs = fabs(v);
+        p = i;
+        q = j;
       }
-      if(isMask)
-        *((char*) result->data + i * c + j) = R2C_INT(v) > 0 ? 1 : 0;
-      else
-        *((float*) result->data + i * c + j) = R2C_FLT(v);
+      if(v != matrix_get(matrix, i, width - 1 - j))
+        matrix->symmetry &= ~MATRIX_SYMMETRIC_LEFT_RIGHT;
+      if(v != matrix_get(matrix, height - 1 - i, j))
+        matrix->symmetry &= ~MATRIX_SYMMETRIC_TOP_BOTTOM;
+      if(v != matrix_get(matrix, height - 1 - i, width - 1 - j))
+        matrix->symmetry &= ~MATRIX_SYMMETRIC_CENTRAL;
     }
   }
 
+  if(matrix->isMask) {
+    matrix->separable = matrix->nonZero == width * height;
+    return;
+  }
+
+  /* Kernel of rank 1 is the outer product of its column and its row through the largest coefficient, the column being scaled by that coefficient. */
+  for(i = 0; i < height; i++)
+    matrix->column[i] = maxAbs == 0.0 ? 0.0f : (Ipp32f) (matrix_get(matrix, i, q) / matrix_get(matrix, p, q));
+  for(j = 0; j < width; j++)
+    matrix->row[j] = (Ipp32f) matrix_get(matrix, p, j);
+
+  matrix->separable = TRUE;
+  for(i = 0; i < height && matrix->separable; i++)
+    for(j = 0; j < width; j++)
+      if(fabs((double) matrix->column[i] * matrix->row[j] - matrix_get(matrix, i, j)) > MATRIX_EPSILON * maxAbs)
+        matrix->separable = FALSE;
+}
+
+
+// -------------------------------------------------------------------------- //
+// matrix_new
+// -------------------------------------------------------------------------- //
+Matrix* matrix_new(VALUE value, int isMask) {
+  value = rb_Matrix_coerce(value, isMask ? rb_Mask : rb_Kernel);
+
+  return matrix_retain(Data_Get_Struct_Ret(value, Matrix));
+}
+
+
+// -------------------------------------------------------------------------- //
+// matrix_retain
+// -------------------------------------------------------------------------- //
+Matrix* matrix_retain(Matrix* matrix) {
+  assert(matrix != NULL);
+
+  ATOMIC_INC(&matrix->refs);
+  return matrix;
+}
+
+
+// -------------------------------------------------------------------------- //
+// matrix_release
+// -------------------------------------------------------------------------- //
+void matrix_release(Matrix* matrix) {
+  assert(matrix != NULL);
+
+  if(ATOMIC_DEC(&matrix->refs) != 0)
+    return;
+
+  free(matrix);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Matrix_alloc
+// -------------------------------------------------------------------------- //
+VALUE rb_Matrix_alloc(VALUE klass) {
+  return WRAP_MATRIX_A(NULL, klass); /* Underlying C struct will be allocated later, in "initialize" method */
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Matrix_initialize
+// -------------------------------------------------------------------------- //
+VALUE rb_Matrix_initialize(int argc, VALUE *argv, VALUE self) {
+  Matrix* matrix;
+  Matrix* source;
+  VALUE rows, row;
+  IppiSize size;
+  int isMask, elemSize, i, j, n;
+
+  isMask = RTEST(rb_obj_is_kind_of(self, rb_Mask));
+  elemSize = isMask ? sizeof(Ipp8u) : sizeof(Ipp32f);
+  source = NULL;
+  rows = Qnil;
+
+  switch(argc) {
+  case 1:
+    if(RTEST(rb_obj_is_kind_of(argv[0], rb_Kernel)) || RTEST(rb_obj_is_kind_of(argv[0], rb_Mask))) {
+      source = Data_Get_Struct_Ret(argv[0], Matrix);
+      size = source->size;
+      break;
+    }
+
+    rows = argv[0];
+    if(TYPE(rows) != T_ARRAY) {
+      if(!rb_respond_to(rows, rb_ID_to_a))
+        rb_raise(rb_eTypeError, "wrong argument type %s (expected Matrix or Array)", rb_obj_classname(rows));
+      rows = rb_funcall(rows, rb_ID_to_a, 0);
+      Check_Type(rows, T_ARRAY);
+    }
+
+    size.height = RARRAY_LEN(rows);
+    size.width = 0;
+    for(i = 0; i < size.height; i++) {
+      row = rb_ary_entry(rows, i);
+      Check_Type(row, T_ARRAY);
+      if(i == 0)
+        size.width = RARRAY_LEN(row);
+      else if(RARRAY_LEN(row) != size.width)
+        rb_raise(rb_eArgError, "all rows must be of the same length");
+    }
+    break;
+  case 3:
+    size.width = R2C_INT(argv[1]);
+    size.height = R2C_INT(argv[2]);
+    if(size.width <= 0 || size.height <= 0)
+      break; /* reported below */
+
+    if(TYPE(argv[0]) == T_STRING) {
+      if(RSTRING_LEN(argv[0]) != (long) size.width * size.height * elemSize)
+        rb_raise(rb_eArgError, "string of %d x %d coefficients must be %d bytes long", size.width, size.height, size.width * size.height * elemSize);
+    } else {
+      Check_Type(argv[0], T_ARRAY);
+      if(RARRAY_LEN(argv[0]) != (long) size.width * size.height)
+        rb_raise(rb_eArgError, "array of %d x %d coefficients must be %d elements long", size.width, size.height, size.width * size.height);
+    }
+    break;
+  default:
+    rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 1 or 3)", argc);
+    break;
+  }
+
+  if(size.width <= 0 || size.height <= 0)
+    rb_raise(rb_eArgError, "wrong %s size: %d x %d", isMask ? "mask" : "kernel", size.width, size.height);
+
+  matrix = matrix_alloc(size, isMask);
+  if(matrix == NULL)
+    rb_raise(rb_eNoMemError, "could not allocate Matrix structure");
+  if(DATA_PTR(self) != NULL)
+    matrix_release((Matrix*) DATA_PTR(self)); /* re-initialization */
+  DATA_PTR(self) = matrix; /* gc will free it if conversion below throws */
+
+  n = size.width * size.height;
+  if(source != NULL) {
+    for(i = 0; i < size.height; i++)
+      for(j = 0; j < size.width; j++)
+        matrix_set(matrix, i * size.width + j, matrix_get(source, i, j));
+  } else if(argc == 1) {
+    for(i = 0; i < size.height; i++)
+      for(j = 0; j < size.width; j++)
+        matrix_set(matrix, i * size.width + j, R2C_DBL(rb_ary_entry(rb_ary_entry(rows, i), j)));
+  } else if(TYPE(argv[0]) == T_STRING) {
+    memcpy(matrix->data, RSTRING_PTR(argv[0]), n * elemSize);
+    if(isMask)
+      for(i = 0; i < n; i++)
+        ((Ipp8u*) matrix->data)[i] = ((Ipp8u*) matrix->data)[i] != 0;
+  } else {
+    for(i = 0; i < n; i++)
+      matrix_set(matrix, i, R2C_DBL(rb_ary_entry(argv[0], i)));
+  }
+
+  matrix_analyze(matrix);
+
+  return self;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Matrix_initialize_copy
+// -------------------------------------------------------------------------- //
+VALUE rb_Matrix_initialize_copy(VALUE self, VALUE other) {
+  Matrix* matrix;
+
+  if(self == other)
+    return self;
+
+  /* Matrix is immutable, so copies share it */
+  matrix = matrix_retain(Data_Get_Struct_Ret(other, Matrix));
+  if(DATA_PTR(self) != NULL)
+    matrix_release((Matrix*) DATA_PTR(self));
+  DATA_PTR(self) = matrix;
+
+  return self;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Matrix_width
+// -------------------------------------------------------------------------- //
+VALUE rb_Matrix_width(VALUE self) {
+  return C2R_INT(Data_Get_Struct_Ret(self, Matrix)->size.width);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Matrix_height
+// -------------------------------------------------------------------------- //
+VALUE rb_Matrix_height(VALUE self) {
+  return C2R_INT(Data_Get_Struct_Ret(self, Matrix)->size.height);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Matrix_size
+// -------------------------------------------------------------------------- //
+VALUE rb_Matrix_size(VALUE self) {
+  Matrix* matrix;
+
+  matrix = Data_Get_Struct_Ret(self, Matrix);
+  return WRAP_SIZE(size_new(matrix->size.width, matrix->size.height));
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Matrix_nonzero
+// -------------------------------------------------------------------------- //
+VALUE rb_Matrix_nonzero(VALUE self) {
+  return C2R_INT(Data_Get_Struct_Ret(self, Matrix)->nonZero);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Matrix_separable_p
+// -------------------------------------------------------------------------- //
+VALUE rb_Matrix_separable_p(VALUE self) {
+  return C2R_BOOL(Data_Get_Struct_Ret(self, Matrix)->separable);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Matrix_symmetry
+// -------------------------------------------------------------------------- //
+VALUE rb_Matrix_symmetry(VALUE self) {
+  Matrix* matrix;
+  VALUE result;
+
+  matrix = Data_Get_Struct_Ret(self, Matrix);
+
+  result = rb_ary_new();
+  if(matrix->symmetry & MATRIX_SYMMETRIC_LEFT_RIGHT)
+    rb_ary_push(result, ID2SYM(rb_intern("left_right")));
+  if(matrix->symmetry & MATRIX_SYMMETRIC_TOP_BOTTOM)
+    rb_ary_push(result, ID2SYM(rb_intern("top_bottom")));
+  if(matrix->symmetry & MATRIX_SYMMETRIC_CENTRAL)
+    rb_ary_push(result, ID2SYM(rb_intern("central")));
+
   return result;
 }
 
-void matrix_destroy(Matrix* c_matrix) {
-  assert(c_matrix != NULL);
-  assert(c_matrix->data != NULL);
-  free(c_matrix->data);
-  free(c_matrix);
+
+// -------------------------------------------------------------------------- //
+// rb_Matrix_factors
+// -------------------------------------------------------------------------- //
+VALUE rb_Matrix_factors(VALUE self) {
+  Matrix* matrix;
+  VALUE column, row;
+  int i;
+
+  matrix = Data_Get_Struct_Ret(self, Matrix);
+  if(matrix->isMask || !matrix->separable)
+    return Qnil;
+
+  column = rb_ary_new2(matrix->size.height);
+  for(i = 0; i < matrix->size.height; i++)
+    rb_ary_push(column, C2R_DBL(matrix->column[i]));
+
+  row = rb_ary_new2(matrix->size.width);
+  for(i = 0; i < matrix->size.width; i++)
+    rb_ary_push(row, C2R_DBL(matrix->row[i]));
+
+  return rb_ary_new3(2, column, row);
 }
+
+
+// -------------------------------------------------------------------------- //
+// rb_Matrix_to_a
+// -------------------------------------------------------------------------- //
+VALUE rb_Matrix_to_a(VALUE self) {
+  Matrix* matrix;
+  VALUE result, row;
+  int i, j;
+
+  matrix = Data_Get_Struct_Ret(self, Matrix);
+
+  result = rb_ary_new2(matrix->size.height);
+  for(i = 0; i < matrix->size.height; i++) {
+    row = rb_ary_new2(matrix->size.width);
+    for(j = 0; j < matrix->size.width; j++)
+      rb_ary_push(row, matrix->isMask ? C2R_INT((int) matrix_get(matrix, i, j)) : C2R_DBL(matrix_get(matrix, i, j)));
+    rb_ary_push(result, row);
+  }
+
+  return result;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Matrix_coerce
+// -------------------------------------------------------------------------- //
+VALUE rb_Matrix_coerce(VALUE value, VALUE klass) {
+  if(RTEST(rb_obj_is_kind_of(value, klass)))
+    return value;
+  else
+    return rb_class_new_instance(1, &value, klass);
+}
+
+
@@ -2,24 +2,253 @@
 #define __IPP4R_MATRIX_H__
 
 #include <ruby.h>
+#include <ippdefs.h>
 #include "ipp4r_fwd.h"
+#include "ipp4r_atomic.h"
+
+/**
+ * @file
+ *
+ * This file defines C and Ruby interfaces for compiled kernels of linear filters and masks of morphological operations. <p>
+ *
+ * <tt>Ipp::Kernel</tt> and <tt>Ipp::Mask</tt> are built once from a <tt>Matrix</tt>, an array of rows, or a flat array or packed string of coefficients,
+ * and can then be passed to <tt>filter</tt>, <tt>dilate</tt> and <tt>erode</tt>, including their asynchronous and batch versions, any number of times
+ * at no conversion cost. Other values are still accepted wherever a kernel or a mask is expected, they're just compiled on every call. <p>
+ *
+ * Coefficients are stored the way IPP takes them, in row-major order, as Ipp32f for kernels and as Ipp8u zeros and ones for masks, aligned to MATRIX_ALIGNMENT.
+ * They're analyzed once, when compiled: the number of non-zero ones, symmetries, and separability along with the factors of a separable kernel
+ * are stored next to them, and native filters use them to pick a cheaper algorithm, see filter_kernel. <p>
+ *
+ * Matrix is immutable and reference counted, so operations hold a reference rather than a copy, e.g. while they're queued on the pool.
+ */
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// -------------------------------------------------------------------------- //
+// Defines
+// -------------------------------------------------------------------------- //
+#define MATRIX_ALIGNMENT 64     /**< Alignment of coefficients in bytes */
+#define MATRIX_EPSILON 1e-6     /**< Tolerance of the separability test, relative to the largest coefficient */
+
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/**
+ * Symmetries of a matrix
+ */
+typedef enum {
+  MATRIX_SYMMETRIC_LEFT_RIGHT = 1,  /**< matrix doesn't change when mirrored left to right */
+  MATRIX_SYMMETRIC_TOP_BOTTOM = 2,  /**< matrix doesn't change when mirrored top to bottom */
+  MATRIX_SYMMETRIC_CENTRAL = 4      /**< matrix doesn't change when rotated by 180 degrees, i.e. convolution with it is the same as correlation */
+} MatrixSymmetry;
+
+
+/**
+ * Matrix struct, a compiled kernel or mask
+ */
 struct _Matrix {
-  int isMask;       /**< char or float? */
-  void* data;       /**< data */
-  IppiSize size;    /**< size */
+  ATOMIC_INT refs;      /**< number of references */
+  int isMask;           /**< char or float? */
+  void* data;           /**< coefficients, aligned to MATRIX_ALIGNMENT */
+  IppiSize size;        /**< size */
+  int nonZero;          /**< number of non-zero coefficients */
+  int symmetry;         /**< combination of MatrixSymmetry flags */
+  int separable;        /**< is kernel the outer product of column and row? Mask is separable if it's a full rectangle */
+  Ipp32f* column;       /**< column factor of size.height elements, valid if a kernel is separable, NULL for masks */
+  Ipp32f* row;          /**< row factor of size.width elements, valid if a kernel is separable, NULL for masks */
 };
 
-Matrix* matrix_new(VALUE r_matrix, int isMask);
 
-void matrix_destroy(Matrix* c_matrix);
+// -------------------------------------------------------------------------- //
+// Matrix C interface
+// -------------------------------------------------------------------------- //
+/**
+ * Allocates a Matrix of the given size, holding one reference. Coefficients are left uninitialized, matrix_analyze must be called once they're filled in.
+ *
+ * @returns newly allocated Matrix, or NULL in case of an error
+ */
+Matrix* matrix_alloc(IppiSize size, int isMask);
+
+
+/**
+ * Computes the analysis of a Matrix from its coefficients.
+ */
+void matrix_analyze(Matrix* matrix);
+
+
+/**
+ * Compiles the given ruby value into a kernel or a mask. Ipp::Kernel or Ipp::Mask of the requested kind is shared rather than copied.
+ * Raises if the value can't be converted.
+ *
+ * @param value Ipp::Kernel, Ipp::Mask, Matrix or array of rows
+ * @param isMask compile a mask or a kernel?
+ * @returns Matrix holding a reference that belongs to the caller
+ */
+Matrix* matrix_new(VALUE value, int isMask);
+
+
+/**
+ * Adds a reference to a Matrix.
+ *
+ * @returns matrix
+ */
+Matrix* matrix_retain(Matrix* matrix);
+
+
+/**
+ * Releases a reference to a Matrix, the matrix is freed with the last one. Safe to call from any thread.
+ */
+void matrix_release(Matrix* matrix);
+
+
+// -------------------------------------------------------------------------- //
+// Matrix Ruby interface
+// -------------------------------------------------------------------------- //
+/**
+ * Alloc function for Kernel and Mask classes. Note that the memory is actually allocated in "initialize" method.
+ */
+VALUE rb_Matrix_alloc(VALUE klass);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Kernel#initialize(matrix)</tt>
+ * <li> <tt>Ipp::Kernel#initialize(rows)</tt>
+ * <li> <tt>Ipp::Kernel#initialize(coefficients, width, height)</tt>
+ * <li> <tt>Ipp::Mask#initialize(matrix)</tt>
+ * <li> <tt>Ipp::Mask#initialize(rows)</tt>
+ * <li> <tt>Ipp::Mask#initialize(coefficients, width, height)</tt>
+ * </ul>
+ *
+ * Compiles a kernel or a mask from a Matrix, an Ipp::Kernel, an Ipp::Mask or an array of rows, or from a flat array or a packed string of coefficients
+ * in row-major order. Strings hold native 32-bit floats for kernels, e.g. <tt>array.pack("f*")</tt>, and bytes for masks.
+ * Mask cells with coefficients of 1 or more are set.
+ */
+VALUE rb_Matrix_initialize(int argc, VALUE *argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Kernel#initialize_copy(other)</tt>
+ * </ul>
+ *
+ * Shares the compiled coefficients of other.
+ */
+VALUE rb_Matrix_initialize_copy(VALUE self, VALUE other);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Kernel#width</tt>
+ * </ul>
+ */
+VALUE rb_Matrix_width(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Kernel#height</tt>
+ * </ul>
+ */
+VALUE rb_Matrix_height(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Kernel#size</tt>
+ * </ul>
+ *
+ * @returns Ipp::Size of the kernel
+ */
+VALUE rb_Matrix_size(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Kernel#nonzero</tt>
+ * </ul>
+ *
+ * @returns number of non-zero coefficients
+ */
+VALUE rb_Matrix_nonzero(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Kernel#separable?</tt>
+ * </ul>
+ *
+ * @returns true if the kernel is the outer product of a column and a row, or if the mask is a full rectangle
+ */
+VALUE rb_Matrix_separable_p(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Kernel#symmetry</tt>
+ * </ul>
+ *
+ * @returns array of symmetries of the kernel, out of <tt>:left_right</tt>, <tt>:top_bottom</tt> and <tt>:central</tt>
+ */
+VALUE rb_Matrix_symmetry(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Kernel#factors</tt>
+ * </ul>
+ *
+ * @returns <tt>[column, row]</tt> arrays whose outer product is the kernel, or nil if the kernel isn't separable
+ */
+VALUE rb_Matrix_factors(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Kernel#to_a</tt>
+ * </ul>
+ *
+ * @returns array of rows of coefficients
+ */
+VALUE rb_Matrix_to_a(VALUE self);
+
+
+/**
+ * Converts the given ruby value to Ipp::Kernel or Ipp::Mask. Objects of klass are returned as is, anything else is passed to klass.new.
+ *
+ * @param klass rb_Kernel or rb_Mask
+ * @returns object of klass
+ */
+VALUE rb_Matrix_coerce(VALUE value, VALUE klass);
+
+
+/**
+ * Wraps a Matrix structure into ruby VALUE using given CLASS. Wrapper holds the reference the matrix was created with.
+ *
+ * @param MATRIX <tt>Matrix*</tt>
+ * @param CLASS <tt>VALUE</tt> of ruby class used for wrapping
+ */
+#define WRAP_MATRIX_A(MATRIX, CLASS)                                            \
+  Data_Wrap_Struct((CLASS), NULL, matrix_release, (MATRIX))
+
 
 #ifdef __cplusplus
 }
 #endif
 
-#endif
\ No newline at end of file
+#endif
+
+
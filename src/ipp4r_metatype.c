@@ -11,12 +11,21 @@
  */
 static void metatype_static_check(void) {
   /* check M_INDEX */
-#define CHECK_M_INDEX(INDEX, ARG) STATIC_ASSERT(( M_INDEX(ARX_ARRAY_ELEM(INDEX, M_SUPPORTED)) == INDEX ));
-  ARX_ARRAY_FOREACH(ARX_INDEX_ARRAY(ARX_ARRAY_SIZE(M_SUPPORTED)), CHECK_M_INDEX, ~)
+#define CHECK_M_INDEX(INDEX, ARG) STATIC_ASSERT(( M_INDEX(ARX_ARRAY_ELEM(INDEX, M_STORABLE)) == INDEX ));
+  ARX_ARRAY_FOREACH(ARX_INDEX_ARRAY(ARX_ARRAY_SIZE(M_STORABLE)), CHECK_M_INDEX, ~)
+
+  /* check that M_SUPPORTED and M_INTERLEAVED are prefixes of M_STORABLE, metatype tables are indexed by IppMetaType */
+#define CHECK_M_PREFIX(INDEX, LIST) STATIC_ASSERT(( M_INDEX(ARX_ARRAY_ELEM(INDEX, LIST)) == INDEX ));
+  ARX_ARRAY_FOREACH(ARX_INDEX_ARRAY(ARX_ARRAY_SIZE(M_SUPPORTED)), CHECK_M_PREFIX, M_SUPPORTED)
+  ARX_ARRAY_FOREACH(ARX_INDEX_ARRAY(ARX_ARRAY_SIZE(M_INTERLEAVED)), CHECK_M_PREFIX, M_INTERLEAVED)
+
+  /* check that IppMetaType enum follows M_INDEX */
+#define CHECK_M_CENUM(METATYPE, ARG) STATIC_ASSERT(( M_CENUM(METATYPE) == M_INDEX(METATYPE) ));
+  ARX_ARRAY_FOREACH(M_STORABLE, CHECK_M_CENUM, ~)
 
   /* check D_INDEX */
-#define CHECK_D_INDEX(INDEX, ARG) STATIC_ASSERT(( D_INDEX(ARX_ARRAY_ELEM(INDEX, D_SUPPORTED)) == INDEX ));
-  ARX_ARRAY_FOREACH(ARX_INDEX_ARRAY(ARX_ARRAY_SIZE(D_SUPPORTED)), CHECK_D_INDEX, ~)
+#define CHECK_D_INDEX(INDEX, ARG) STATIC_ASSERT(( D_INDEX(ARX_ARRAY_ELEM(INDEX, D_ALL)) == INDEX ));
+  ARX_ARRAY_FOREACH(ARX_INDEX_ARRAY(ARX_ARRAY_SIZE(D_ALL)), CHECK_D_INDEX, ~)
 
   /* check C_INDEX */
 #define CHECK_C_INDEX(INDEX, ARG) STATIC_ASSERT(( C_INDEX(ARX_ARRAY_ELEM(INDEX, C_SUPPORTED)) == INDEX ));
@@ -24,17 +33,45 @@ static void metatype_static_check(void) {
 
   /* check accessors */
 #define CHECK_M_ACCESSORS(METATYPE, ARG) STATIC_ASSERT(( M_CENUM(M_CREATE(M_DATATYPE(METATYPE), M_CHANNELS(METATYPE))) == M_CENUM(METATYPE) ));
-  ARX_ARRAY_FOREACH(M_SUPPORTED, CHECK_M_ACCESSORS, ~)
+  ARX_ARRAY_FOREACH(M_INTERLEAVED, CHECK_M_ACCESSORS, ~)
 }
 
 
+// -------------------------------------------------------------------------- //
+// Metatype tables
+// -------------------------------------------------------------------------- //
+#define CHANNELS_VALUE(M) C_CENUM(M_CHANNELS(M))
+DEFINE_METATABLE_VALUES(IppChannels, metatype_channels_table, M_STORABLE, CHANNELS_VALUE)
+#undef CHANNELS_VALUE
+
+#define DATATYPE_VALUE(M) D_CENUM(M_DATATYPE(M))
+DEFINE_METATABLE_VALUES(IppDataType, metatype_datatype_table, M_STORABLE, DATATYPE_VALUE)
+#undef DATATYPE_VALUE
+
+#define CNUMB_VALUE(M) C_CNUMB(M_CHANNELS(M))
+DEFINE_METATABLE_VALUES(unsigned char, metatype_cnumb_table, M_STORABLE, CNUMB_VALUE)
+#undef CNUMB_VALUE
+
+#define PIXEL_SIZE_VALUE(M) (sizeof(D_CTYPE(M_DATATYPE(M))) * C_CNUMB(M_CHANNELS(M)) / M_PLANES(M))
+DEFINE_METATABLE_VALUES(unsigned char, metatype_pixel_size_table, M_STORABLE, PIXEL_SIZE_VALUE)
+#undef PIXEL_SIZE_VALUE
+
+#define PLANES_VALUE(M) M_PLANES(M)
+DEFINE_METATABLE_VALUES(unsigned char, metatype_planes_table, M_STORABLE, PLANES_VALUE)
+#undef PLANES_VALUE
+
+#define IS_METATYPE_VALID(METATYPE) ((unsigned int) (METATYPE) < ARX_ARRAY_SIZE(M_STORABLE))
+
+
 // -------------------------------------------------------------------------- //
 // ippmetatype_channels
 // -------------------------------------------------------------------------- //
 IppChannels metatype_channels(IppMetaType metaType) {
-#define METAFUNC(C, ARGS) C_CENUM(M_CHANNELS(C))
-  IPPMETACALL(metaType, return, M_SUPPORTED, METAFUNC, ~, Unreachable(), -1);
-#undef METAFUNC
+  if(!IS_METATYPE_VALID(metaType)) {
+    Unreachable();
+    return -1;
+  }
+  return metatype_channels_table[metaType];
 }
 
 
@@ -42,9 +79,11 @@ IppChannels metatype_channels(IppMetaType metaType) {
 // metatype_datatype
 // -------------------------------------------------------------------------- //
 IppDataType metatype_datatype(IppMetaType metaType) {
-#define METAFUNC(D, ARGS) D_CENUM(M_DATATYPE(D))
-  IPPMETACALL(metaType, return, M_SUPPORTED, METAFUNC, ~, Unreachable(), -1);
-#undef METAFUNC
+  if(!IS_METATYPE_VALID(metaType)) {
+    Unreachable();
+    return -1;
+  }
+  return metatype_datatype_table[metaType];
 }
 
 
@@ -52,11 +91,15 @@ IppDataType metatype_datatype(IppMetaType metaType) {
 // metatype_compose 
 // -------------------------------------------------------------------------- //
 IppMetaType metatype_compose(IppDataType dataType, IppChannels channels) {
-#define METAFUNC_C(C, D) M_CENUM(M_CREATE(D, C))
-#define METAFUNC_D(D, ARGS) IPPMETACALL(channels, return, C_SUPPORTED, METAFUNC_C, D, Unreachable(), -1)
-  IPPMETACALL(dataType, ARX_EMPTY(), D_SUPPORTED, METAFUNC_D, ~, Unreachable(); return -1, ARX_EMPTY());
-#undef METAFUNC_D
-#undef METAFUNC_C
+  /* Not every DATATYPE x CHANNELS pair is a metatype (there are no 16s planar images), so we look through M_STORABLE instead */
+#define COMPOSE_I(M, ARG)                                                       \
+  if(dataType == D_CENUM(M_DATATYPE(M)) && channels == C_CENUM(M_CHANNELS(M)))  \
+    return M_CENUM(M);
+  ARX_ARRAY_FOREACH(M_STORABLE, COMPOSE_I, ~)
+#undef COMPOSE_I
+
+  Unreachable();
+  return -1;
 }
 
 
@@ -64,9 +107,61 @@ IppMetaType metatype_compose(IppDataType dataType, IppChannels channels) {
 // metatype_pixel_size
 // -------------------------------------------------------------------------- //
 int metatype_pixel_size(IppMetaType metaType) {
-#define METAFUNC(M, ARGS) (sizeof(D_CTYPE(M_DATATYPE(M))) * C_CNUMB(M_CHANNELS(M)))
-  IPPMETACALL(metaType, return, M_SUPPORTED, METAFUNC, ~, Unreachable(), -1);
-#undef METAFUNC
+  if(!IS_METATYPE_VALID(metaType)) {
+    Unreachable();
+    return -1;
+  }
+  return metatype_pixel_size_table[metaType];
+}
+
+
+// -------------------------------------------------------------------------- //
+// metatype_cnumb
+// -------------------------------------------------------------------------- //
+int metatype_cnumb(IppMetaType metaType) {
+  if(!IS_METATYPE_VALID(metaType)) {
+    Unreachable();
+    return -1;
+  }
+  return metatype_cnumb_table[metaType];
+}
+
+
+// -------------------------------------------------------------------------- //
+// metatype_planes
+// -------------------------------------------------------------------------- //
+int metatype_planes(IppMetaType metaType) {
+  if(!IS_METATYPE_VALID(metaType)) {
+    Unreachable();
+    return -1;
+  }
+  return metatype_planes_table[metaType];
+}
+
+
+// -------------------------------------------------------------------------- //
+// metatype_to_planar
+// -------------------------------------------------------------------------- //
+IppMetaType metatype_to_planar(IppMetaType metaType) {
+#define TO_PLANAR_I(M, ARG)                                                     \
+  if(metaType == M_CENUM(M_REPLACE_C(M, IF_M_IS_C(M, P3, C3, AC4))))            \
+    return M_CENUM(M);
+  ARX_ARRAY_FOREACH(M_PLANAR, TO_PLANAR_I, ~)
+#undef TO_PLANAR_I
+
+  return -1;
+}
+
+
+// -------------------------------------------------------------------------- //
+// metatype_to_interleaved
+// -------------------------------------------------------------------------- //
+IppMetaType metatype_to_interleaved(IppMetaType metaType) {
+  if(metatype_planes(metaType) == 1) {
+    Unreachable();
+    return -1;
+  }
+  return metatype_compose(metatype_datatype(metaType), metatype_channels(metaType) == ippP3 ? ippC3 : ippAC4);
 }
 
 
@@ -74,7 +169,13 @@ int metatype_pixel_size(IppMetaType metaType) {
 // is_channels_supported
 // -------------------------------------------------------------------------- //
 int is_channels_supported(IppChannels channels) {
-  IPPMETACALL(channels, return, C_SUPPORTED, IPPMETAVAL, TRUE, ARX_EMPTY(), FALSE);
+#define IS_SUPPORTED_I(C, ARG)                                                  \
+  if(channels == C_CENUM(C))                                                    \
+    return TRUE;
+  ARX_ARRAY_FOREACH(C_SUPPORTED, IS_SUPPORTED_I, ~)
+#undef IS_SUPPORTED_I
+
+  return FALSE;
 }
 
 
@@ -82,7 +183,13 @@ int is_channels_supported(IppChannels channels) {
 // is_datatype_supported
 // -------------------------------------------------------------------------- //
 int is_datatype_supported(IppDataType dataType) {
-  IPPMETACALL(dataType, return, D_SUPPORTED, IPPMETAVAL, TRUE, ARX_EMPTY(), FALSE);
+#define IS_SUPPORTED_I(D, ARG)                                                  \
+  if(dataType == D_CENUM(D))                                                    \
+    return TRUE;
+  ARX_ARRAY_FOREACH(D_ALL, IS_SUPPORTED_I, ~)
+#undef IS_SUPPORTED_I
+
+  return FALSE;
 }
 
 
@@ -90,7 +197,8 @@ int is_datatype_supported(IppDataType dataType) {
 // is_metatype_supported
 // -------------------------------------------------------------------------- //
 int is_metatype_supported(IppMetaType metaType) {
-  IPPMETACALL(metaType, return, M_SUPPORTED, IPPMETAVAL, TRUE, ARX_EMPTY(), FALSE);
+  /* M_SUPPORTED is a prefix of M_STORABLE */
+  return (unsigned int) metaType < ARX_ARRAY_SIZE(M_SUPPORTED);
 }
 
 
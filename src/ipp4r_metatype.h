@@ -31,7 +31,8 @@
  * Also at compile-time we have a special number type - IppMetaNumber, which is a supertype for all data types. 
  * The corresponding pp-time DATATYPE for IppMetaNumber is D_METANUM. <p>
  *
- * At run-time we have METACALL macros which perform a call basing on the value of METATYPE enum, and converters to and from IppMetaNumber type. <p>
+ * At run-time we have METACALL macros which perform a call basing on the value of METATYPE enum, METATABLE macros which define tables indexed by it,
+ * and converters to and from IppMetaNumber type. <p>
  */
 
 #ifdef __cplusplus
@@ -43,20 +44,32 @@ extern "C" {
 // -------------------------------------------------------------------------- //
 #define D_METANUM 32f
 
-#define D_SUPPORTED (3, (8u,     16u,      32f))
-#define D_ALL       (4, (8u,     16u,      32f,    32s))
-#define D_SCALE_MAP (4, (255.0f, 65535.0f, 1.0f,   2147483647.0f))
-#define D_MAX_MAP   (4, (255,    65535,    1.0f,   2147483647))
-
-#define C_SUPPORTED (3, (C1, C3, AC4))
-#define C_ALL       (4, (C1, C3, AC4, C4))
-#define C_COUNT_MAP (4, (1,  3,  4,   4))
+#define D_SUPPORTED (6, (8u,     16u,      32f,    16s,      32s,                64f))
+/* 16f is a storage-only data type: images can be created, converted and copied, but not processed. */
+#define D_STORAGE_ONLY (1, (16f))
+#define D_ALL       (7, (8u,     16u,      32f,    16s,      32s,                64f,  16f))
+#define D_SCALE_MAP (7, (255.0f, 65535.0f, 1.0f,   32767.0f, 2147483647.0,       1.0,  1.0f))
+#define D_MAX_MAP   (7, (255,    65535,    1.0f,   32767,    2147483647,         1.0,  1.0f))
+#define D_MIN_MAP   (7, (0,      0,        0.0f,   -32768,   (-2147483647 - 1),  0.0,  0.0f))
+/* Floating point type that native kernels accumulate values of a data type in. Ipp32f holds all 8u, 16u and 16s values, but not all 32s ones. */
+#define D_ACCUM_MAP (7, (Ipp32f, Ipp32f,   Ipp32f, Ipp32f,   Ipp64f,             Ipp64f, Ipp32f))
+
+#define C_SUPPORTED (4, (C1, C3, AC4, C4))
+#define C_ALL       (6, (C1, C3, AC4, C4, P3, P4))
+#define C_PLANAR    (2, (P3, P4))
+#define C_STORABLE  C_ALL
+#define C_COUNT_MAP (6, (1,  3,  4,   4,  3,  4))
 #define C_MAX_COUNT 4
 
-#define M_SUPPORTED    (9,  (8u_C1, 8u_C3, 8u_AC4, 16u_C1, 16u_C3, 16u_AC4, 32f_C1, 32f_C3, 32f_AC4))
-#define M_ALL          (16, (8u_C1, 8u_C3, 8u_AC4, 16u_C1, 16u_C3, 16u_AC4, 32f_C1, 32f_C3, 32f_AC4, 8u_C4, 16u_C4, 32f_C4, 32s_C1, 32s_C3, 32s_AC4, 32s_C4)) 
-#define M_DATATYPE_MAP (16, (8u,    8u,    8u,     16u,    16u,    16u,     32f,    32f,    32f,     8u,    16u,    32f,    32s,    32s,    32s,     32s   ))
-#define M_CHANNELS_MAP (16, (   C1,    C3,    AC4,     C1,     C3,     AC4,     C1,     C3,     AC4,    C4,     C4,     C4,     C1,     C3,     AC4,     C4))
+#define M_SUPPORTED    (24, (8u_C1, 8u_C3, 8u_AC4, 16u_C1, 16u_C3, 16u_AC4, 32f_C1, 32f_C3, 32f_AC4, 8u_C4, 16u_C4, 32f_C4, 16s_C1, 16s_C3, 16s_AC4, 16s_C4, 32s_C1, 32s_C3, 32s_AC4, 32s_C4, 64f_C1, 64f_C3, 64f_AC4, 64f_C4))
+/* Storage-only and planar metatypes describe storage only, image operations are defined on M_SUPPORTED. */
+#define M_STORAGE_ONLY (4,  (16f_C1, 16f_C3, 16f_AC4, 16f_C4))
+#define M_INTERLEAVED  (28, (8u_C1, 8u_C3, 8u_AC4, 16u_C1, 16u_C3, 16u_AC4, 32f_C1, 32f_C3, 32f_AC4, 8u_C4, 16u_C4, 32f_C4, 16s_C1, 16s_C3, 16s_AC4, 16s_C4, 32s_C1, 32s_C3, 32s_AC4, 32s_C4, 64f_C1, 64f_C3, 64f_AC4, 64f_C4, 16f_C1, 16f_C3, 16f_AC4, 16f_C4))
+#define M_PLANAR       (6,  (8u_P3, 8u_P4, 16u_P3, 16u_P4, 32f_P3, 32f_P4))
+#define M_STORABLE     (34, (8u_C1, 8u_C3, 8u_AC4, 16u_C1, 16u_C3, 16u_AC4, 32f_C1, 32f_C3, 32f_AC4, 8u_C4, 16u_C4, 32f_C4, 16s_C1, 16s_C3, 16s_AC4, 16s_C4, 32s_C1, 32s_C3, 32s_AC4, 32s_C4, 64f_C1, 64f_C3, 64f_AC4, 64f_C4, 16f_C1, 16f_C3, 16f_AC4, 16f_C4, 8u_P3, 8u_P4, 16u_P3, 16u_P4, 32f_P3, 32f_P4))
+#define M_ALL          M_STORABLE
+#define M_DATATYPE_MAP (34, (8u,    8u,    8u,     16u,    16u,    16u,     32f,    32f,    32f,     8u,    16u,    32f,    16s,    16s,    16s,     16s,    32s,    32s,    32s,     32s,    64f,    64f,    64f,     64f,    16f,    16f,    16f,     16f,    8u,    8u,    16u,    16u,    32f,    32f   ))
+#define M_CHANNELS_MAP (34, (   C1,    C3,    AC4,     C1,     C3,     AC4,     C1,     C3,     AC4,    C4,     C4,     C4,     C1,     C3,     AC4,     C4,     C1,     C3,     AC4,     C4,     C1,     C3,     AC4,     C4,     C1,     C3,     AC4,     C4,    P3,    P4,     P3,     P4,     P3,     P4))
 
 
 // -------------------------------------------------------------------------- //
@@ -77,10 +90,28 @@ extern "C" {
 #define M_INDEX_8u_C4   9
 #define M_INDEX_16u_C4  10
 #define M_INDEX_32f_C4  11
-#define M_INDEX_32s_C1  12
-#define M_INDEX_32s_C3  13
-#define M_INDEX_32s_AC4 14
-#define M_INDEX_32s_C4  15
+#define M_INDEX_16s_C1  12
+#define M_INDEX_16s_C3  13
+#define M_INDEX_16s_AC4 14
+#define M_INDEX_16s_C4  15
+#define M_INDEX_32s_C1  16
+#define M_INDEX_32s_C3  17
+#define M_INDEX_32s_AC4 18
+#define M_INDEX_32s_C4  19
+#define M_INDEX_64f_C1  20
+#define M_INDEX_64f_C3  21
+#define M_INDEX_64f_AC4 22
+#define M_INDEX_64f_C4  23
+#define M_INDEX_16f_C1  24
+#define M_INDEX_16f_C3  25
+#define M_INDEX_16f_AC4 26
+#define M_INDEX_16f_C4  27
+#define M_INDEX_8u_P3   28
+#define M_INDEX_8u_P4   29
+#define M_INDEX_16u_P3  30
+#define M_INDEX_16u_P4  31
+#define M_INDEX_32f_P3  32
+#define M_INDEX_32f_P4  33
 
 #define D_INDEX(DATATYPE) D_INDEX_I(DATATYPE)
 #define D_INDEX_I(DATATYPE) D_INDEX_II(D_INDEX_ ## DATATYPE)
@@ -88,7 +119,10 @@ extern "C" {
 #define D_INDEX_8u   0
 #define D_INDEX_16u  1
 #define D_INDEX_32f  2
-#define D_INDEX_32s  3
+#define D_INDEX_16s  3
+#define D_INDEX_32s  4
+#define D_INDEX_64f  5
+#define D_INDEX_16f  6
 
 #define C_INDEX(CHANNELS) C_INDEX_I(CHANNELS)
 #define C_INDEX_I(CHANNELS) C_INDEX_II(C_INDEX_ ## CHANNELS)
@@ -97,6 +131,8 @@ extern "C" {
 #define C_INDEX_C3   1
 #define C_INDEX_AC4  2
 #define C_INDEX_C4   3
+#define C_INDEX_P3   4
+#define C_INDEX_P4   5
 
 
 // -------------------------------------------------------------------------- //
@@ -106,6 +142,8 @@ extern "C" {
 #define M_CHANNELS(METATYPE) ARX_ARRAY_ELEM(M_INDEX(METATYPE), M_CHANNELS_MAP)
 #define M_CREATE(DATATYPE, CHANNELS) ARX_JOIN_3(DATATYPE, _, CHANNELS)
 
+#define M_PLANES(METATYPE) ARX_IF(C_IN_C_2(M_CHANNELS(METATYPE), P3, P4), C_CNUMB(M_CHANNELS(METATYPE)), 1)
+
 #define M_REPLACE_D(METATYPE, DATATYPE) M_CREATE(DATATYPE, M_CHANNELS(METATYPE))
 #define M_REPLACE_C(METATYPE, CHANNELS) M_CREATE(M_DATATYPE(METATYPE), CHANNELS)
 
@@ -120,6 +158,8 @@ extern "C" {
 #define D_CENUM(DATATYPE) ARX_JOIN(ipp, DATATYPE)
 #define D_SCALE(DATATYPE) ARX_ARRAY_ELEM(D_INDEX(DATATYPE), D_SCALE_MAP)
 #define D_MAX(DATATYPE) ARX_ARRAY_ELEM(D_INDEX(DATATYPE), D_MAX_MAP)
+#define D_MIN(DATATYPE) ARX_ARRAY_ELEM(D_INDEX(DATATYPE), D_MIN_MAP)
+#define D_ACCUM(DATATYPE) ARX_ARRAY_ELEM(D_INDEX(DATATYPE), D_ACCUM_MAP)
 
 #define C_CENUM(CHANNELS) ARX_JOIN(ipp, CHANNELS)
 #define C_CNUMB(CHANNELS) ARX_ARRAY_ELEM(C_INDEX(CHANNELS), C_COUNT_MAP)
@@ -166,18 +206,44 @@ extern "C" {
 // -------------------------------------------------------------------------- //
 typedef D_CTYPE(D_METANUM) IppMetaNumber; /**< Supertype for all data types */
 
+/* IPP has no half precision type, 16f values are IEEE 754 binary16 bit patterns, converted by functions from ipp4r_half.h */
+typedef Ipp16u Ipp16f;
+#define ipp16f ((IppDataType) (ipp64fc + 1))
+
 //#define R2C_METANUM(V) ((IppMetaType) R2C_DBL(V))
 //#define C2R_METANUM(V) C2R_DBL(V)
 
 #define M2C_NUMBER(METATYPE, METANUM)                                           \
   M2C_NUMBER_D(M_DATATYPE(METATYPE), (METANUM))
 #define M2C_NUMBER_D(DATATYPE, METANUM)                                         \
-  IF_D_EQ_D(DATATYPE, D_METANUM, (METANUM), (D_CTYPE(DATATYPE)) ((METANUM) * D_SCALE(DATATYPE)))
+  IF_D_EQ_D(DATATYPE, D_METANUM, (METANUM), IF_D_EQ_D(DATATYPE, 16f, half_from_float(METANUM), (D_CTYPE(DATATYPE)) ((METANUM) * D_SCALE(DATATYPE))))
 
 #define C2M_NUMBER(METATYPE, C_NUMBER)                                          \
   C2M_NUMBER_D(M_DATATYPE(METATYPE), (C_NUMBER))
 #define C2M_NUMBER_D(DATATYPE, C_NUMBER)                                        \
-  IF_D_EQ_D(DATATYPE, D_METANUM, (C_NUMBER), (IppMetaNumber) ((C_NUMBER) / D_SCALE(DATATYPE)))
+  IF_D_EQ_D(DATATYPE, D_METANUM, (C_NUMBER), IF_D_EQ_D(DATATYPE, 16f, half_to_float(C_NUMBER), (IppMetaNumber) ((C_NUMBER) / D_SCALE(DATATYPE))))
+
+
+// -------------------------------------------------------------------------- //
+// Saturation
+// -------------------------------------------------------------------------- //
+/**
+ * Defines <tt>PREFIX</tt><tt>DATATYPE</tt> function, which rounds a floating point value of FTYPE to the nearest value of an integer DATATYPE, halves away from zero, 
+ * with saturation. NaN is converted to 0. FTYPE is Ipp32f or Ipp64f, the type kernels compute in. Ipp32f doesn't hold all 32s values, so 32s is exact with Ipp64f only.
+ */
+#define DEFINE_D_SAT(PREFIX, DATATYPE, FTYPE)                                   \
+static D_CTYPE(DATATYPE) ARX_JOIN(PREFIX, DATATYPE)(FTYPE v) {                  \
+  if(v >= (FTYPE) D_MAX(DATATYPE))                                              \
+    return (D_CTYPE(DATATYPE)) D_MAX(DATATYPE);                                 \
+  else if(v > 0)                                                                \
+    return (D_CTYPE(DATATYPE)) (v + (FTYPE) 0.5);                               \
+  else if(v > (FTYPE) D_MIN(DATATYPE))                                          \
+    return (D_CTYPE(DATATYPE)) (v - (FTYPE) 0.5);                               \
+  else if(v <= (FTYPE) D_MIN(DATATYPE))                                         \
+    return (D_CTYPE(DATATYPE)) D_MIN(DATATYPE);                                 \
+  else                                                                          \
+    return 0; /* NaN */                                                         \
+}
 
 
 // -------------------------------------------------------------------------- //
@@ -186,6 +252,8 @@ typedef D_CTYPE(D_METANUM) IppMetaNumber; /**< Supertype for all data types */
 typedef enum {
 #define ENUM_METATYPE_I(METATYPE, ARG) M_CENUM(METATYPE),
   ARX_ARRAY_FOREACH(M_SUPPORTED, ENUM_METATYPE_I, ARX_EMPTY)
+  ARX_ARRAY_FOREACH(M_STORAGE_ONLY, ENUM_METATYPE_I, ARX_EMPTY)
+  ARX_ARRAY_FOREACH(M_PLANAR, ENUM_METATYPE_I, ARX_EMPTY)
 #undef ENUM_METATYPE_I
 } IppMetaType;
 
@@ -287,6 +355,51 @@ typedef enum {
 #define IPPMETAVAL(METATUPE, ARG) ARG
 
 
+// -------------------------------------------------------------------------- //
+// METATABLE
+// -------------------------------------------------------------------------- //
+/**
+ * Defines a constant array NAME of TYPE indexed by IppMetaType. Entry for metatype M is <tt>VALUE(M)</tt>.
+ * LIST must be a prefix of M_STORABLE, i.e. M_SUPPORTED, M_INTERLEAVED or M_STORABLE.
+ */
+#define DEFINE_METATABLE_VALUES(TYPE, NAME, LIST, VALUE)                        \
+  static const TYPE NAME[] = { ARX_ARRAY_FOREACH(LIST, METATABLE_VALUES_ENTRY, VALUE) };
+#define METATABLE_VALUES_ENTRY(M, VALUE) VALUE(M),
+
+
+/**
+ * Defines a function table NAME indexed by IppMetaType over M_INTERLEAVED. For each metatype M of LIST, function <tt>NAME_M</tt>
+ * returning RETURN_TYPE, with parameters PARAMS and body <tt>BODY(M)</tt>, is defined and put into the table. Entries of other metatypes are NULL. <p>
+ *
+ * This is the table counterpart of METACALL: instead of a switch over LIST at each call site, a call is a bounds check and an indexed load, see METATABLE_CALL.
+ */
+#define DEFINE_METATABLE(RETURN_TYPE, NAME, LIST, PARAMS, BODY)                 \
+  ARX_ARRAY_FOREACH(LIST, METATABLE_FUNC, (4, (RETURN_TYPE, NAME, PARAMS, BODY))) \
+  static RETURN_TYPE (* const NAME[]) PARAMS = { ARX_ARRAY_FOREACH(M_INTERLEAVED, METATABLE_ENTRY, (2, (NAME, LIST))) };
+#define METATABLE_FUNC(M, ARGS)                                                 \
+  METATABLE_FUNC_I(M, ARX_ARRAY_ELEM(0, ARGS), ARX_ARRAY_ELEM(1, ARGS), ARX_ARRAY_ELEM(2, ARGS), ARX_ARRAY_ELEM(3, ARGS))
+#define METATABLE_FUNC_I(M, RETURN_TYPE, NAME, PARAMS, BODY)                    \
+  static RETURN_TYPE ARX_JOIN_3(NAME, _, M) PARAMS { BODY(M) }
+#define METATABLE_ENTRY(M, ARGS)                                                \
+  ARX_IF(ARX_ARRAY_EXISTS(ARX_ARRAY_ELEM(1, ARGS), M_EQ_M, M), ARX_JOIN_3(ARX_ARRAY_ELEM(0, ARGS), _, M), NULL),
+
+
+/**
+ * @returns function of the given metatype from table NAME, or NULL if there's none
+ */
+#define METATABLE_FUNCTION(NAME, METATYPE)                                      \
+  ((unsigned int) (METATYPE) < sizeof(NAME) / sizeof((NAME)[0]) ? (NAME)[(METATYPE)] : NULL)
+
+
+/**
+ * Calls the function of the given metatype from table NAME with ARGS.
+ *
+ * @returns result of the call, or FALLBACK if there's no function for the metatype
+ */
+#define METATABLE_CALL(NAME, METATYPE, ARGS, FALLBACK)                          \
+  (METATABLE_FUNCTION(NAME, METATYPE) != NULL ? (NAME)[(METATYPE)] ARGS : (FALLBACK))
+
+
 // -------------------------------------------------------------------------- //
 // IppMetaType run-time accessors
 // -------------------------------------------------------------------------- //
@@ -309,11 +422,35 @@ IppMetaType metatype_compose(IppDataType dataType, IppChannels channels);
 
 
 /**
- * @return size in bytes of one pixel for given metatype
+ * @returns number of channel values in a pixel of the given metatype, e.g. 4 for AC4 and P4
+ */
+int metatype_cnumb(IppMetaType metaType);
+
+
+/**
+ * @return size in bytes of one pixel for given metatype. For planar metatypes this is the size of one pixel in a plane.
  */
 int metatype_pixel_size(IppMetaType metaType);
 
 
+/**
+ * @returns number of planes an image of the given metatype is stored in, 1 for interleaved metatypes
+ */
+int metatype_planes(IppMetaType metaType);
+
+
+/**
+ * @returns planar metatype with the same data type and channels as the given interleaved one (P3 for C3, P4 for AC4), or -1 if there is none
+ */
+IppMetaType metatype_to_planar(IppMetaType metaType);
+
+
+/**
+ * @returns interleaved metatype with the same data type and channels as the given planar one (C3 for P3, AC4 for P4)
+ */
+IppMetaType metatype_to_interleaved(IppMetaType metaType);
+
+
 // -------------------------------------------------------------------------- //
 // is_supported functions
 // -------------------------------------------------------------------------- //
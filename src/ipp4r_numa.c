@@ -0,0 +1,189 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#  define _GNU_SOURCE 1 /* for sched_setaffinity */
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ipp4r.h"
+
+#if defined(__linux__)
+#  include <sched.h>
+#  define NUMA_USE_AFFINITY
+#endif
+
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/** Buffer touched by numa_first_touch */
+typedef struct {
+  void* buffer;         /**< buffer to touch */
+  int step;             /**< size of row in bytes */
+} NumaTouch;
+
+
+// -------------------------------------------------------------------------- //
+// Local variables
+// -------------------------------------------------------------------------- //
+static int numa_nodes = 1;
+static NumaPolicy numa_policy_value = NUMA_POLICY_NONE;
+static int numa_bound = FALSE;
+
+#ifdef NUMA_USE_AFFINITY
+static cpu_set_t numa_node_cpus[NUMA_MAX_NODES];
+static cpu_set_t numa_process_cpus;
+#endif
+
+
+// -------------------------------------------------------------------------- //
+// Supplementary functions
+// -------------------------------------------------------------------------- //
+#ifdef NUMA_USE_AFFINITY
+/**
+ * Reads a cpu list of the given node, e.g. "0-7,16-23", from sysfs.
+ *
+ * @returns TRUE if the node exists, FALSE otherwise
+ */
+static int numa_read_node_cpus(int node, cpu_set_t* cpus) {
+  char path[64], list[4096];
+  char* p;
+  FILE* file;
+  long first, last, cpu;
+
+  sprintf(path, "/sys/devices/system/node/node%d/cpulist", node);
+  if((file = fopen(path, "r")) == NULL)
+    return FALSE;
+  if(fgets(list, sizeof(list), file) == NULL)
+    list[0] = '\0';
+  fclose(file);
+
+  CPU_ZERO(cpus);
+  for(p = list; *p >= '0' && *p <= '9'; p++) {
+    first = last = strtol(p, &p, 10);
+    if(*p == '-')
+      last = strtol(p + 1, &p, 10);
+    for(cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++)
+      CPU_SET(cpu, cpus);
+    if(*p != ',')
+      break;
+  }
+
+  return TRUE;
+}
+#endif
+
+
+// -------------------------------------------------------------------------- //
+// numa_init
+// -------------------------------------------------------------------------- //
+void numa_init(void) {
+#ifdef NUMA_USE_AFFINITY
+  int node;
+
+  if(sched_getaffinity(0, sizeof(numa_process_cpus), &numa_process_cpus) != 0)
+    return;
+
+  /* Node numbers may have gaps, and nodes with no CPUs available to the process (e.g. memory-only ones) can't run workers */
+  numa_nodes = 0;
+  for(node = 0; node < NUMA_MAX_NODES; node++) {
+    if(!numa_read_node_cpus(node, &numa_node_cpus[numa_nodes]))
+      continue;
+    CPU_AND(&numa_node_cpus[numa_nodes], &numa_node_cpus[numa_nodes], &numa_process_cpus);
+    if(CPU_COUNT(&numa_node_cpus[numa_nodes]) > 0)
+      numa_nodes++;
+  }
+
+  if(numa_nodes == 0) {
+    numa_nodes = 1;
+    numa_node_cpus[0] = numa_process_cpus;
+  }
+#endif
+}
+
+
+// -------------------------------------------------------------------------- //
+// Accessors
+// -------------------------------------------------------------------------- //
+int numa_node_count(void) {
+  return numa_nodes;
+}
+
+NumaPolicy numa_policy(void) {
+  return numa_policy_value;
+}
+
+void numa_set_policy(NumaPolicy policy) {
+  assert(policy == NUMA_POLICY_NONE || policy == NUMA_POLICY_FIRST_TOUCH);
+
+  numa_policy_value = policy;
+}
+
+int numa_workers_bound(void) {
+  return numa_bound;
+}
+
+
+// -------------------------------------------------------------------------- //
+// numa_bind_workers
+// -------------------------------------------------------------------------- //
+int numa_bind_workers(int bind) {
+#ifdef NUMA_USE_AFFINITY
+  cpu_set_t cpus;
+
+  /* Workers bind themselves before their next job or tile, so failures can only be caught here */
+  if(bind && sched_getaffinity(0, sizeof(cpus), &cpus) != 0)
+    return ippStsNotSupportedModeErr;
+
+  numa_bound = bind ? TRUE : FALSE;
+  pool_rebind();
+  return ippStsNoErr;
+#else
+  return bind ? ippStsNotSupportedModeErr : ippStsNoErr;
+#endif
+}
+
+
+// -------------------------------------------------------------------------- //
+// numa_bind_thread
+// -------------------------------------------------------------------------- //
+void numa_bind_thread(int worker, int workers) {
+#ifdef NUMA_USE_AFFINITY
+  int node;
+
+  assert(worker >= 0 && workers > 0);
+
+  node = min(worker, workers - 1) * numa_nodes / workers;
+  sched_setaffinity(0, sizeof(cpu_set_t), numa_bound ? &numa_node_cpus[node] : &numa_process_cpus);
+#endif
+}
+
+
+// -------------------------------------------------------------------------- //
+// numa_first_touch
+// -------------------------------------------------------------------------- //
+/**
+ * Zeroes a band of rows. Tile function for pool_parallel_for.
+ */
+static void numa_first_touch_band(void* arg, int begin, int end) {
+  NumaTouch* touch = (NumaTouch*) arg;
+
+  memset((char*) touch->buffer + (size_t) begin * touch->step, 0, (size_t) (end - begin) * touch->step);
+}
+
+void numa_first_touch(void* buffer, int step, int rows) {
+  NumaTouch touch;
+
+  assert(buffer != NULL && step > 0 && rows > 0);
+
+  if(numa_policy_value != NUMA_POLICY_FIRST_TOUCH || (size_t) step * rows < NUMA_FIRST_TOUCH_MIN)
+    return;
+
+  /* Tiles of the same size as the ones of kernels, so that a band is usually touched by the worker of its node */
+  touch.buffer = buffer;
+  touch.step = step;
+  pool_parallel_for(rows, pool_tile_rows(step), numa_first_touch_band, &touch);
+}
+
+
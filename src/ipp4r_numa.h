@@ -0,0 +1,115 @@
+#ifndef __IPP4R_NUMA_H__
+#define __IPP4R_NUMA_H__
+
+#include <ippdefs.h>
+#include "ipp4r_fwd.h"
+
+/**
+ * @file
+ *
+ * This file defines NUMA-aware placement of image buffers and binding of worker threads to NUMA nodes. <p>
+ *
+ * Row loops run as tiles on the workers of the pool, see pool_parallel_for. With NUMA_POLICY_FIRST_TOUCH, new image buffers are touched
+ * tile by tile on the pool before use, so that the OS places each tile on the node of the worker that touched it. Tiles are stolen
+ * by whichever worker is idle, so placement is a best effort: it pays off when the same tiles of an image tend to land on the same workers,
+ * e.g. when images are processed by loops of the same shape. Workers must be pinned for that placement to last, numa_bind_workers pins
+ * consecutive workers to the same node, and workers steal from their neighbours first. <p>
+ *
+ * Topology is read from /sys/devices/system/node, binding needs Linux. Elsewhere the system is reported as a single node, and
+ * binding does nothing.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -------------------------------------------------------------------------- //
+// Defines
+// -------------------------------------------------------------------------- //
+#define NUMA_MAX_NODES 64                     /**< Maximal number of NUMA nodes supported */
+#define NUMA_FIRST_TOUCH_MIN (4 << 20)        /**< Minimal size of buffer that is first touched by workers, smaller ones are usually reused heap memory */
+
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/**
+ * NUMA placement policy of image buffers
+ */
+typedef enum {
+  NUMA_POLICY_NONE,         /**< pages are placed wherever the allocating thread touches them first */
+  NUMA_POLICY_FIRST_TOUCH   /**< buffers are zeroed band by band by the workers that will process them */
+} NumaPolicy;
+
+
+// -------------------------------------------------------------------------- //
+// Function declarations
+// -------------------------------------------------------------------------- //
+/**
+ * Reads NUMA topology. Must be called once at load time.
+ */
+void numa_init(void);
+
+
+/**
+ * @returns number of NUMA nodes
+ */
+int numa_node_count(void);
+
+
+/**
+ * @returns NUMA placement policy of image buffers, NUMA_POLICY_NONE by default
+ */
+NumaPolicy numa_policy(void);
+
+
+/**
+ * Sets NUMA placement policy of newly allocated image buffers.
+ */
+void numa_set_policy(NumaPolicy policy);
+
+
+/**
+ * @returns TRUE if workers are bound to NUMA nodes
+ */
+int numa_workers_bound(void);
+
+
+/**
+ * Binds workers to NUMA nodes, or restores their original affinity. Workers are spread over nodes in contiguous blocks:
+ * worker t of n runs on the CPUs of node <tt>t * nodes / n</tt>. Workers apply the binding themselves before their next job or tile,
+ * see numa_bind_thread, and the calling thread isn't bound.
+ *
+ * @param bind TRUE to bind workers, FALSE to unbind them
+ * @returns ippStsNoErr if everything went OK, ippStsNotSupportedModeErr if binding isn't supported by the build or the system
+ */
+int numa_bind_workers(int bind);
+
+
+/**
+ * Binds the calling worker thread according to numa_bind_workers, called by workers of the pool.
+ *
+ * @param worker slot of the worker
+ * @param workers number of workers
+ */
+void numa_bind_thread(int worker, int workers);
+
+
+/**
+ * Touches a newly allocated buffer tile by tile from the workers, according to the NUMA placement policy. Does nothing for small buffers.
+ *
+ * @param buffer buffer to touch, its contents are zeroed
+ * @param step size of row in bytes
+ * @param rows number of rows
+ */
+void numa_first_touch(void* buffer, int step, int rows);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
+
@@ -0,0 +1,273 @@
+#include <assert.h>
+#include "ipp4r.h"
+
+
+// -------------------------------------------------------------------------- //
+// Kernels
+// -------------------------------------------------------------------------- //
+#define PLANAR_M_SUPPORTED (6, (8u_C3, 8u_AC4, 16u_C3, 16u_AC4, 32f_C3, 32f_AC4))
+
+/** Split kernel, rows of planes are given by pointers to them */
+typedef void (*PlanarSplitFunc)(const void* pSrc, void** planes, int width);
+
+/** Merge kernel, rows of planes are given by pointers to them */
+typedef void (*PlanarMergeFunc)(void** planes, void* pDst, int width);
+
+/**
+ * Defines <tt>planar_split_DATATYPE_CHANNELSR</tt> and <tt>planar_merge_DATATYPE_CHANNELSR</tt> kernels.
+ * Both process one row of an interleaved image, with planes given by pointers to their rows.
+ */
+#define DEFINE_PLANAR_KERNELS(METATYPE, ARG)                                    \
+  DEFINE_PLANAR_KERNELS_I(M_DATATYPE(METATYPE), M_CHANNELS(METATYPE), D_CTYPE(M_DATATYPE(METATYPE)), C_CNUMB(M_CHANNELS(METATYPE)))
+#define DEFINE_PLANAR_KERNELS_I(D, C, CTYPE, CNUMB)                             \
+static void ARX_JOIN_5(planar_split_, D, _, C, R)(const void* pSrc, void** planes, int width) { \
+  const CTYPE* s = (const CTYPE*) pSrc;                                         \
+  CTYPE** p = (CTYPE**) planes;                                                 \
+  int x, c;                                                                     \
+                                                                                \
+  for(x = 0; x < width; x++, s += CNUMB)                                        \
+    for(c = 0; c < CNUMB; c++)                                                  \
+      p[c][x] = s[c];                                                           \
+}                                                                               \
+                                                                                \
+static void ARX_JOIN_5(planar_merge_, D, _, C, R)(void** planes, void* pDst, int width) { \
+  CTYPE** p = (CTYPE**) planes;                                                 \
+  CTYPE* d = (CTYPE*) pDst;                                                     \
+  int x, c;                                                                     \
+                                                                                \
+  for(x = 0; x < width; x++, d += CNUMB)                                        \
+    for(c = 0; c < CNUMB; c++)                                                  \
+      d[c] = p[c][x];                                                           \
+}
+
+#define PLANAR_IS_SUPPORTED(M) ARX_ARRAY_EXISTS(PLANAR_M_SUPPORTED, M_EQ_M, M)
+#define PLANAR_SPLIT_KERNEL(M) ARX_IF(PLANAR_IS_SUPPORTED(M), ARX_JOIN_5(planar_split_, M_DATATYPE(M), _, M_CHANNELS(M), R), NULL)
+#define PLANAR_MERGE_KERNEL(M) ARX_IF(PLANAR_IS_SUPPORTED(M), ARX_JOIN_5(planar_merge_, M_DATATYPE(M), _, M_CHANNELS(M), R), NULL)
+
+ARX_ARRAY_FOREACH(PLANAR_M_SUPPORTED, DEFINE_PLANAR_KERNELS, ~)
+DEFINE_METATABLE_VALUES(PlanarSplitFunc, planar_split_table, M_SUPPORTED, PLANAR_SPLIT_KERNEL)
+DEFINE_METATABLE_VALUES(PlanarMergeFunc, planar_merge_table, M_SUPPORTED, PLANAR_MERGE_KERNEL)
+
+
+// -------------------------------------------------------------------------- //
+// Tiles
+// -------------------------------------------------------------------------- //
+/** Arguments of the row loops of planar_split and planar_merge, shared by their tiles */
+typedef struct {
+  PlanarSplitFunc split;
+  PlanarMergeFunc merge;
+  char* interleaved;    /**< interleaved source or destination */
+  int step;             /**< row step of interleaved */
+  char* planes;         /**< first plane of planar destination or source */
+  int planeRowStep;     /**< row step of a plane */
+  int planeStep;        /**< distance between planes */
+  int cnumb;
+  int width;
+} PlanarTile;
+
+
+/**
+ * Tile functions for pool_parallel_for, items are rows.
+ */
+static void planar_split_tile(void* arg, int yStart, int yEnd) {
+  PlanarTile* t = (PlanarTile*) arg;
+  void* p[C_MAX_COUNT];
+  const void* s;
+  int y, c;
+
+  for(y = yStart; y < yEnd; y++) {
+    s = t->interleaved + y * t->step;
+    for(c = 0; c < t->cnumb; c++)
+      p[c] = t->planes + c * t->planeStep + y * t->planeRowStep;
+
+    t->split(s, p, t->width);
+  }
+}
+
+static void planar_merge_tile(void* arg, int yStart, int yEnd) {
+  PlanarTile* t = (PlanarTile*) arg;
+  void* p[C_MAX_COUNT];
+  void* d;
+  int y, c;
+
+  for(y = yStart; y < yEnd; y++) {
+    d = t->interleaved + y * t->step;
+    for(c = 0; c < t->cnumb; c++)
+      p[c] = t->planes + c * t->planeStep + y * t->planeRowStep;
+
+    t->merge(p, d, t->width);
+  }
+}
+
+
+// -------------------------------------------------------------------------- //
+// planar_split
+// -------------------------------------------------------------------------- //
+int planar_split(IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, int planeStep, IppiSize roi) {
+  PlanarTile tile;
+
+  assert(pSrc != NULL && pDst != NULL);
+
+  if(METATABLE_FUNCTION(planar_split_table, metaType) == NULL)
+    return ippStsNumChannelsErr;
+
+  tile.split = planar_split_table[metaType];
+  tile.merge = NULL;
+  tile.interleaved = (char*) pSrc;
+  tile.step = srcStep;
+  tile.planes = (char*) pDst;
+  tile.planeRowStep = dstStep;
+  tile.planeStep = planeStep;
+  tile.cnumb = metatype_cnumb(metaType);
+  tile.width = roi.width;
+  pool_parallel_for(roi.height, pool_tile_rows(roi.width * metatype_pixel_size(metaType)), planar_split_tile, &tile);
+
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// planar_merge
+// -------------------------------------------------------------------------- //
+int planar_merge(IppMetaType metaType, const void* pSrc, int srcStep, int planeStep, void* pDst, int dstStep, IppiSize roi) {
+  PlanarTile tile;
+
+  assert(pSrc != NULL && pDst != NULL);
+
+  if(METATABLE_FUNCTION(planar_merge_table, metaType) == NULL)
+    return ippStsNumChannelsErr;
+
+  tile.split = NULL;
+  tile.merge = planar_merge_table[metaType];
+  tile.interleaved = (char*) pDst;
+  tile.step = dstStep;
+  tile.planes = (char*) pSrc;
+  tile.planeRowStep = srcStep;
+  tile.planeStep = planeStep;
+  tile.cnumb = metatype_cnumb(metaType);
+  tile.width = roi.width;
+  pool_parallel_for(roi.height, pool_tile_rows(roi.width * metatype_pixel_size(metaType)), planar_merge_tile, &tile);
+
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// r2c_metatype
+// -------------------------------------------------------------------------- //
+IppMetaType r2c_metatype(VALUE value) {
+  IppMetaType metaType;
+
+  metaType = R2C_ENUM(value, rb_MetaType);
+  if(metatype_planes(metaType) > 1)
+    rb_raise(rb_eArgError, "planar metatypes are supported by Ipp::PlanarImage only");
+
+  return metaType;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_PlanarImage_alloc
+// -------------------------------------------------------------------------- //
+VALUE rb_PlanarImage_alloc(VALUE klass) {
+  return image_wrap_class(NULL, klass); /* Underlying C struct will be allocated later, in "initialize" method */
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_PlanarImage_initialize
+// -------------------------------------------------------------------------- //
+VALUE rb_PlanarImage_initialize(int argc, VALUE* argv, VALUE self) {
+  int width, height;
+  IppMetaType metaType;
+  Image* image;
+
+  metaType = ipp8u_P3;
+
+  switch(argc) {
+  case 3:
+    metaType = R2C_ENUM(argv[2], rb_MetaType);
+    if(metatype_planes(metaType) == 1 && (metaType = metatype_to_planar(metaType)) == (IppMetaType) -1)
+      rb_raise(rb_eArgError, "metatype has no planar counterpart");
+  case 2:
+    width = R2C_INT(argv[0]);
+    height = R2C_INT(argv[1]);
+    if(width <= 0 || height <= 0)
+      rb_raise(rb_Exception, "wrong image size: %d x %d", width, height);
+    raise_on_error(image_new(&image, width, height, metaType, 0));
+    break;
+  default:
+    rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 2 or 3)", argc);
+    break;
+  }
+
+  DATA_PTR(self) = image;
+  image_share(image);
+
+  return self;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_PlanarImage_width
+// -------------------------------------------------------------------------- //
+VALUE rb_PlanarImage_width(VALUE self) {
+  return C2R_INT(image_width(Data_Get_Struct_Ret(self, Image)));
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_PlanarImage_height
+// -------------------------------------------------------------------------- //
+VALUE rb_PlanarImage_height(VALUE self) {
+  return C2R_INT(image_height(Data_Get_Struct_Ret(self, Image)));
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_PlanarImage_metatype
+// -------------------------------------------------------------------------- //
+VALUE rb_PlanarImage_metatype(VALUE self) {
+  return C2R_ENUM(image_metatype(Data_Get_Struct_Ret(self, Image)), rb_MetaType);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_PlanarImage_planes
+// -------------------------------------------------------------------------- //
+VALUE rb_PlanarImage_planes(VALUE self) {
+  return C2R_INT(metatype_planes(image_metatype(Data_Get_Struct_Ret(self, Image))));
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_PlanarImage_channel
+// -------------------------------------------------------------------------- //
+VALUE rb_PlanarImage_channel(VALUE self, VALUE index) {
+  Image* image;
+  Image* plane;
+  int i;
+
+  image = Data_Get_Struct_Ret(self, Image);
+  i = R2C_INT(index);
+  if(i < 0 || i >= metatype_planes(image_metatype(image)))
+    rb_raise(rb_eIndexError, "channel index %d out of range", i);
+
+  raise_on_error(image_plane(image, &plane, i));
+
+  return image_wrap(plane);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_PlanarImage_to_image
+// -------------------------------------------------------------------------- //
+VALUE rb_PlanarImage_to_image(VALUE self) {
+  Image* newImage;
+
+  raise_on_error(image_from_planar_copy(Data_Get_Struct_Ret(self, Image), &newImage));
+
+  return image_wrap(newImage);
+}
+
+
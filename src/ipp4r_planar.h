@@ -0,0 +1,157 @@
+#ifndef __IPP4R_PLANAR_H__
+#define __IPP4R_PLANAR_H__
+
+#include <ruby.h>
+#include <ippdefs.h>
+#include "ipp4r_fwd.h"
+#include "ipp4r_metatype.h"
+
+/**
+ * @file
+ *
+ * This file defines C and Ruby interfaces for planar images. <p>
+ *
+ * Planar image stores each channel in a separate plane, i.e. P3 image is three single-channel planes and P4 image is four of them,
+ * the last one holding alpha. All planes live in a single buffer, one after another, and each of them can be viewed as an ordinary C1 image
+ * sharing memory with the planar image, so any image operation can be applied to a single channel without copying it out. <p>
+ *
+ * Planar images are wrapped into a separate ruby class PlanarImage, since image operations are defined for interleaved metatypes only.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -------------------------------------------------------------------------- //
+// Planar C interface
+// -------------------------------------------------------------------------- //
+/**
+ * Splits an interleaved image buffer into planes.
+ *
+ * @param metaType metatype of source, must be C3 or AC4. Alpha channel of AC4 source goes to the fourth plane
+ * @param pSrc source buffer
+ * @param srcStep size of source row in bytes
+ * @param pDst first plane of destination
+ * @param dstStep size of destination plane row in bytes
+ * @param planeStep distance between destination planes in bytes
+ * @param roi size of processed region in pixels
+ * @returns ippStsNoErr if everything went OK, non-zero error code otherwise
+ */
+int planar_split(IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, int planeStep, IppiSize roi);
+
+
+/**
+ * Merges planes into an interleaved image buffer.
+ *
+ * @param metaType metatype of destination, must be C3 or AC4
+ * @param pSrc first plane of source
+ * @param srcStep size of source plane row in bytes
+ * @param planeStep distance between source planes in bytes
+ * @param pDst destination buffer
+ * @param dstStep size of destination row in bytes
+ * @param roi size of processed region in pixels
+ * @returns ippStsNoErr if everything went OK, non-zero error code otherwise
+ */
+int planar_merge(IppMetaType metaType, const void* pSrc, int srcStep, int planeStep, void* pDst, int dstStep, IppiSize roi);
+
+
+// -------------------------------------------------------------------------- //
+// PlanarImage ruby interface
+// -------------------------------------------------------------------------- //
+/**
+ * Converts the given ruby MetaType to IppMetaType. Raises an exception for planar metatypes, which are supported by PlanarImage only.
+ */
+IppMetaType r2c_metatype(VALUE value);
+
+
+/**
+ * Alloc function for PlanarImage class. Note that the memory is actually allocated in "initialize" method.
+ */
+VALUE rb_PlanarImage_alloc(VALUE klass);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::PlanarImage#initialize(width, height, MetaType metatype = Ipp8u_P3)</tt>
+ * </ul>
+ *
+ * Initializes a new uninitialized planar image. Interleaved metatypes are replaced by their planar counterparts, i.e. Ipp8u_C3 by Ipp8u_P3.
+ */
+VALUE rb_PlanarImage_initialize(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::PlanarImage#width</tt>
+ * </ul>
+ *
+ * @returns width of an image
+ */
+VALUE rb_PlanarImage_width(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::PlanarImage#height</tt>
+ * </ul>
+ *
+ * @returns height of an image
+ */
+VALUE rb_PlanarImage_height(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::PlanarImage#metatype</tt>
+ * </ul>
+ *
+ * @returns planar metatype of an image
+ */
+VALUE rb_PlanarImage_metatype(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::PlanarImage#planes</tt>
+ * </ul>
+ *
+ * @returns number of planes
+ */
+VALUE rb_PlanarImage_planes(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::PlanarImage#channel(i)</tt>
+ * </ul>
+ *
+ * Planes are numbered in pixel channel order, i.e. 0 is blue, 2 is red and 3 is alpha.
+ * @returns a C1 Image sharing memory with the i-th plane
+ */
+VALUE rb_PlanarImage_channel(VALUE self, VALUE index);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::PlanarImage#to_image</tt>
+ * </ul>
+ *
+ * @returns a newly created interleaved image, C3 for P3 and AC4 for P4
+ */
+VALUE rb_PlanarImage_to_image(VALUE self);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
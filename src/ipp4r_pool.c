@@ -0,0 +1,700 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <ipp.h>
+#include "ipp4r.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+#  include <process.h>
+#  define POOL_USE_WIN32
+#else
+#  include <pthread.h>
+#  include <unistd.h>
+#  include <time.h>
+#endif
+
+#if defined(_MSC_VER)
+#  define POOL_THREAD_LOCAL __declspec(thread)
+#else
+#  define POOL_THREAD_LOCAL __thread
+#endif
+
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+#ifdef POOL_USE_WIN32
+typedef CRITICAL_SECTION PoolMutex;
+#else
+typedef pthread_mutex_t PoolMutex;
+#endif
+
+
+/** Parallel loop, lives on the stack of the thread that runs pool_parallel_for */
+typedef struct {
+  PoolRangeFunc func;   /**< tile function */
+  void* arg;            /**< argument of tile function */
+  ATOMIC_INT pending;   /**< number of tiles that aren't finished yet */
+} PoolLoop;
+
+
+/** Tile of a parallel loop */
+typedef struct {
+  PoolLoop* loop;       /**< loop of the tile */
+  int begin;            /**< first item */
+  int end;              /**< item after the last one */
+} PoolTask;
+
+
+/** Task deque of a thread. Owner pushes and pops tasks at the bottom, thieves take them from the top */
+typedef struct {
+  PoolMutex mutex;                  /**< guards tasks and top */
+  PoolTask tasks[POOL_DEQUE_SIZE];  /**< ring buffer of tasks */
+  int top;                          /**< index of the oldest task */
+  ATOMIC_INT count;                 /**< number of tasks, changed under the lock, but may be peeked at without it */
+  PoolCounters counters;            /**< utilization counters of the owner */
+} PoolDeque;
+
+
+// -------------------------------------------------------------------------- //
+// Local variables
+// -------------------------------------------------------------------------- //
+static PoolMutex pool_mutex;
+#ifdef POOL_USE_WIN32
+static CONDITION_VARIABLE pool_work_cond;   /* signaled when a job or tasks are queued */
+static CONDITION_VARIABLE pool_done_cond;   /* signaled by pool_notify, by finished loops and by exiting workers */
+#else
+static pthread_cond_t pool_work_cond;
+static pthread_cond_t pool_done_cond;
+#endif
+
+static PoolJob* pool_head = NULL;
+static PoolJob* pool_tail = NULL;
+static int pool_size_value = 0;   /* 0 stands for the default one */
+static int pool_default_size = 1;
+static int pool_workers = 0;      /* number of live workers */
+static int pool_stopping = FALSE;
+
+static PoolDeque pool_deques[POOL_MAX_SIZE + 1];  /* deques of workers by slot, the last one is shared by non-worker threads */
+static int pool_slot_used[POOL_MAX_SIZE];         /* is there a live worker in the slot? */
+static ATOMIC_INT pool_slot_count;                /* number of slots ever used, i.e. of worker deques to steal from */
+static ATOMIC_INT pool_queued;                    /* number of tasks in all deques */
+static ATOMIC_INT pool_idle;                      /* number of workers sleeping for lack of work */
+static ATOMIC_INT pool_epoch;                     /* incremented by pool_rebind */
+
+static POOL_THREAD_LOCAL PoolDeque* pool_current = NULL;  /* deque of the current worker, NULL on other threads */
+static POOL_THREAD_LOCAL int pool_nesting = 0;            /* number of jobs and tiles the current thread runs nested in each other */
+
+
+// -------------------------------------------------------------------------- //
+// Supplementary functions
+// -------------------------------------------------------------------------- //
+#ifdef POOL_USE_WIN32
+#  define pool_mutex_init(MUTEX) InitializeCriticalSection(MUTEX)
+#  define pool_mutex_lock(MUTEX) EnterCriticalSection(MUTEX)
+#  define pool_mutex_unlock(MUTEX) LeaveCriticalSection(MUTEX)
+#  define pool_cond_wait(COND) SleepConditionVariableCS((COND), &pool_mutex, INFINITE)
+#  define pool_cond_signal(COND) WakeConditionVariable(COND)
+#  define pool_cond_broadcast(COND) WakeAllConditionVariable(COND)
+#else
+#  define pool_mutex_init(MUTEX) pthread_mutex_init((MUTEX), NULL)
+#  define pool_mutex_lock(MUTEX) pthread_mutex_lock(MUTEX)
+#  define pool_mutex_unlock(MUTEX) pthread_mutex_unlock(MUTEX)
+#  define pool_cond_wait(COND) pthread_cond_wait((COND), &pool_mutex)
+#  define pool_cond_signal(COND) pthread_cond_signal(COND)
+#  define pool_cond_broadcast(COND) pthread_cond_broadcast(COND)
+#endif
+
+
+/**
+ * Initializes the locks and the condition variables of the pool, and empties the deques.
+ */
+static void pool_init_sync(void) {
+  int i;
+
+  pool_mutex_init(&pool_mutex);
+#ifdef POOL_USE_WIN32
+  InitializeConditionVariable(&pool_work_cond);
+  InitializeConditionVariable(&pool_done_cond);
+#else
+  pthread_cond_init(&pool_work_cond, NULL);
+  pthread_cond_init(&pool_done_cond, NULL);
+#endif
+
+  for(i = 0; i <= POOL_MAX_SIZE; i++) {
+    pool_mutex_init(&pool_deques[i].mutex);
+    pool_deques[i].top = 0;
+    ATOMIC_INIT(&pool_deques[i].count, 0);
+  }
+  for(i = 0; i < POOL_MAX_SIZE; i++)
+    pool_slot_used[i] = FALSE;
+  ATOMIC_INIT(&pool_slot_count, 0);
+  ATOMIC_INIT(&pool_queued, 0);
+  ATOMIC_INIT(&pool_idle, 0);
+}
+
+
+/**
+ * @returns number of CPUs available to the process
+ */
+static int pool_cpu_count(void) {
+#if defined(POOL_USE_WIN32)
+  SYSTEM_INFO info;
+
+  GetSystemInfo(&info);
+  return (int) info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+  long count;
+
+  count = sysconf(_SC_NPROCESSORS_ONLN);
+  return count > 0 ? (int) count : 1;
+#else
+  return 1;
+#endif
+}
+
+
+/**
+ * @returns thread limit given by the environment variable, or 0 if it's not set or invalid
+ */
+static int pool_env_size(const char* name) {
+  const char* value;
+  long size;
+
+  if((value = getenv(name)) == NULL)
+    return 0;
+
+  size = strtol(value, NULL, 10);
+  return size > 0 ? (int) min(size, POOL_MAX_SIZE) : 0;
+}
+
+
+/**
+ * @returns monotonic time in seconds
+ */
+static double pool_time(void) {
+#if defined(POOL_USE_WIN32)
+  LARGE_INTEGER counter, frequency;
+
+  QueryPerformanceCounter(&counter);
+  QueryPerformanceFrequency(&frequency);
+  return (double) counter.QuadPart / frequency.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+  struct timespec time;
+
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec + time.tv_nsec * 1e-9;
+#else
+  return 0.0;
+#endif
+}
+
+
+/**
+ * Pushes a tile onto the bottom of a deque.
+ *
+ * @returns TRUE if the tile was pushed, FALSE if the deque is full
+ */
+static int pool_deque_push(PoolDeque* deque, PoolLoop* loop, int begin, int end) {
+  PoolTask* task;
+  int count;
+
+  pool_mutex_lock(&deque->mutex);
+  count = ATOMIC_LOAD(&deque->count);
+  if(count == POOL_DEQUE_SIZE) {
+    pool_mutex_unlock(&deque->mutex);
+    return FALSE;
+  }
+  task = &deque->tasks[(deque->top + count) % POOL_DEQUE_SIZE];
+  task->loop = loop;
+  task->begin = begin;
+  task->end = end;
+  ATOMIC_INC(&deque->count);
+  pool_mutex_unlock(&deque->mutex);
+
+  ATOMIC_INC(&pool_queued);
+  return TRUE;
+}
+
+
+/**
+ * Takes the newest tile from the bottom of a deque.
+ *
+ * @param loop loop the tile must belong to, or NULL for any loop
+ * @returns TRUE if a tile was taken
+ */
+static int pool_deque_pop(PoolDeque* deque, PoolLoop* loop, PoolTask* task) {
+  int count, taken;
+
+  if(ATOMIC_LOAD(&deque->count) == 0)
+    return FALSE;
+
+  pool_mutex_lock(&deque->mutex);
+  count = ATOMIC_LOAD(&deque->count);
+  taken = count > 0 && (loop == NULL || deque->tasks[(deque->top + count - 1) % POOL_DEQUE_SIZE].loop == loop);
+  if(taken) {
+    *task = deque->tasks[(deque->top + count - 1) % POOL_DEQUE_SIZE];
+    ATOMIC_DEC(&deque->count);
+  }
+  pool_mutex_unlock(&deque->mutex);
+
+  if(taken)
+    ATOMIC_DEC(&pool_queued);
+  return taken;
+}
+
+
+/**
+ * Takes the oldest tile from the top of a deque.
+ *
+ * @returns TRUE if a tile was taken
+ */
+static int pool_deque_steal(PoolDeque* deque, PoolTask* task) {
+  int taken;
+
+  if(ATOMIC_LOAD(&deque->count) == 0)
+    return FALSE;
+
+  pool_mutex_lock(&deque->mutex);
+  taken = ATOMIC_LOAD(&deque->count) > 0;
+  if(taken) {
+    *task = deque->tasks[deque->top];
+    deque->top = (deque->top + 1) % POOL_DEQUE_SIZE;
+    ATOMIC_DEC(&deque->count);
+  }
+  pool_mutex_unlock(&deque->mutex);
+
+  if(taken)
+    ATOMIC_DEC(&pool_queued);
+  return taken;
+}
+
+
+/**
+ * Finds a tile for the current thread: the newest one of its own deque, or the oldest one of another deque. Other deques are searched
+ * starting from the next slot, so that workers steal from their neighbours first, which share their NUMA node when workers are bound.
+ *
+ * @returns TRUE if a tile was found
+ */
+static int pool_take_task(PoolDeque* own, PoolTask* task) {
+  PoolDeque* victim;
+  int slots, first, i, v;
+
+  if(ATOMIC_LOAD(&pool_queued) == 0)
+    return FALSE;
+  if(pool_deque_pop(own, NULL, task))
+    return TRUE;
+
+  /* Slot number 'slots' stands for the deque of non-worker threads */
+  slots = ATOMIC_LOAD(&pool_slot_count);
+  first = own == &pool_deques[POOL_MAX_SIZE] ? slots : (int) (own - pool_deques);
+  for(i = 1; i <= slots; i++) {
+    v = (first + i) % (slots + 1);
+    victim = v == slots ? &pool_deques[POOL_MAX_SIZE] : &pool_deques[v];
+    if(victim != own && pool_deque_steal(victim, task)) {
+      own->counters.steals++;
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+
+/**
+ * Runs a tile and signals the waiter of its loop after the last one.
+ */
+static void pool_run_task(PoolDeque* own, const PoolTask* task) {
+  PoolLoop* loop = task->loop;
+  double start;
+
+  start = pool_nesting == 0 ? pool_time() : 0.0;
+  pool_nesting++;
+  loop->func(loop->arg, task->begin, task->end);
+  pool_nesting--;
+
+  own->counters.tasks++;
+  if(pool_nesting == 0)
+    own->counters.busy += pool_time() - start;
+
+  /* Loop lives on the stack of its waiter, so it's not touched once the last tile is done */
+  if(ATOMIC_DEC(&loop->pending) == 0) {
+    pool_lock();
+    pool_notify();
+    pool_unlock();
+  }
+}
+
+
+/**
+ * Wakes up idle workers, so that they steal the tiles just pushed.
+ */
+static void pool_wake_idle(void) {
+  if(ATOMIC_LOAD(&pool_idle) > 0) {
+    pool_lock();
+    pool_cond_broadcast(&pool_work_cond);
+    pool_unlock();
+  }
+}
+
+
+/**
+ * Worker loop: runs tiles and queued jobs until the pool shrinks below the slot of this worker or is shut down.
+ * Worker leaves the loop only with its deque empty, since tiles it pushes are done before pool_parallel_for returns.
+ */
+static void pool_worker(int slot) {
+  PoolDeque* own = &pool_deques[slot];
+  PoolTask task;
+  PoolJob* job;
+  double start;
+  int epoch, e;
+
+  pool_current = own;
+  epoch = 0;
+
+  for(;;) {
+    if((e = ATOMIC_LOAD(&pool_epoch)) != epoch) {
+      epoch = e;
+      numa_bind_thread(slot, pool_size());
+    }
+
+    /* Tiles first, they belong to loops that someone is already waiting for */
+    while(pool_take_task(own, &task))
+      pool_run_task(own, &task);
+
+    pool_lock();
+    if(pool_stopping || slot >= pool_size())
+      break;
+
+    if(pool_head != NULL) {
+      job = pool_head;
+      pool_head = job->next;
+      if(pool_head == NULL)
+        pool_tail = NULL;
+      pool_unlock();
+
+      start = pool_time();
+      pool_nesting++;
+      job->func(job);
+      pool_nesting--;
+      own->counters.jobs++;
+      own->counters.busy += pool_time() - start;
+      continue;
+    }
+
+    /* Pushers bump pool_queued before they look at pool_idle, so one of the two checks sees the other */
+    ATOMIC_INC(&pool_idle);
+    if(ATOMIC_LOAD(&pool_queued) == 0 && ATOMIC_LOAD(&pool_epoch) == epoch) {
+      own->counters.sleeps++;
+      pool_cond_wait(&pool_work_cond);
+    }
+    ATOMIC_DEC(&pool_idle);
+    pool_unlock();
+  }
+  pool_slot_used[slot] = FALSE;
+  pool_workers--;
+  pool_cond_broadcast(&pool_done_cond);
+  pool_unlock();
+}
+
+
+#ifdef POOL_USE_WIN32
+static unsigned __stdcall pool_thread(void* arg) {
+  pool_worker((int) (size_t) arg);
+  return 0;
+}
+#else
+static void* pool_thread(void* arg) {
+  pool_worker((int) (size_t) arg);
+  return NULL;
+}
+#endif
+
+
+/**
+ * Starts a detached worker thread. Pool must be locked.
+ *
+ * @returns TRUE if the thread was started, FALSE otherwise
+ */
+static int pool_start_worker(int slot) {
+#ifdef POOL_USE_WIN32
+  HANDLE thread;
+
+  thread = (HANDLE) _beginthreadex(NULL, 0, pool_thread, (void*) (size_t) slot, 0, NULL);
+  if(thread == 0)
+    return FALSE;
+  CloseHandle(thread);
+  return TRUE;
+#else
+  pthread_t thread;
+  pthread_attr_t attr;
+  int status;
+
+  pthread_attr_init(&attr);
+  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+  status = pthread_create(&thread, &attr, pool_thread, (void*) (size_t) slot);
+  pthread_attr_destroy(&attr);
+  return status == 0;
+#endif
+}
+
+
+/**
+ * Starts workers in the free slots below the pool size. Pool must be locked.
+ */
+static void pool_start_workers(void) {
+  int size, slot;
+
+  size = pool_size();
+  for(slot = 0; slot < size && pool_workers < size; slot++) {
+    if(pool_slot_used[slot])
+      continue;
+    if(!pool_start_worker(slot))
+      break;
+
+    pool_slot_used[slot] = TRUE;
+    pool_workers++;
+    while(ATOMIC_LOAD(&pool_slot_count) <= slot)
+      ATOMIC_INC(&pool_slot_count);
+  }
+}
+
+
+#ifndef POOL_USE_WIN32
+/**
+ * Resets the pool in a child process, since workers of the parent don't exist there. Lock is held across fork, see pool_init.
+ */
+static void pool_after_fork_child(void) {
+  pool_head = pool_tail = NULL;
+  pool_workers = 0;
+  pool_init_sync();
+}
+#endif
+
+
+// -------------------------------------------------------------------------- //
+// pool_init
+// -------------------------------------------------------------------------- //
+void pool_init(void) {
+  pool_init_sync();
+  ATOMIC_INIT(&pool_epoch, 0);
+
+  /* Host process may cap our threads the same way it caps its OpenMP ones */
+  if((pool_default_size = pool_env_size("IPP4R_NUM_THREADS")) == 0 && (pool_default_size = pool_env_size("OMP_THREAD_LIMIT")) == 0)
+    pool_default_size = min(pool_cpu_count(), POOL_MAX_SIZE);
+
+#ifdef HAVE_IPPSETNUMTHREADS
+  /* IPP thread count is process-wide, threaded IPP would start a team of its own inside every job and tile */
+  ippSetNumThreads(1);
+#endif
+
+#ifndef POOL_USE_WIN32
+  /* Lock is taken before fork, so that the child gets consistent queue */
+  pthread_atfork(pool_lock, pool_unlock, pool_after_fork_child);
+#endif
+}
+
+
+// -------------------------------------------------------------------------- //
+// pool_shutdown
+// -------------------------------------------------------------------------- //
+void pool_shutdown(void) {
+  pool_lock();
+  pool_stopping = TRUE;
+  pool_head = pool_tail = NULL;
+  pool_cond_broadcast(&pool_work_cond);
+  while(pool_workers > 0)
+    pool_cond_wait(&pool_done_cond);
+  pool_unlock();
+}
+
+
+// -------------------------------------------------------------------------- //
+// Accessors
+// -------------------------------------------------------------------------- //
+int pool_size(void) {
+  if(pool_size_value != 0)
+    return pool_size_value;
+  else
+    return pool_default_size;
+}
+
+int pool_set_size(int size) {
+  if(size < 0 || size > POOL_MAX_SIZE)
+    return ippStsBadArgErr;
+
+  pool_lock();
+  pool_size_value = size;
+  pool_cond_broadcast(&pool_work_cond); /* let extra workers exit */
+  pool_unlock();
+
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// pool_submit
+// -------------------------------------------------------------------------- //
+int pool_submit(PoolJob* job) {
+  assert(job != NULL && job->func != NULL);
+
+  pool_lock();
+  if(pool_stopping) {
+    pool_unlock();
+    return ippStsNoMemErr;
+  }
+
+  pool_start_workers();
+  if(pool_workers == 0) {
+    pool_unlock();
+    return ippStsNoMemErr;
+  }
+
+  job->next = NULL;
+  if(pool_tail != NULL)
+    pool_tail->next = job;
+  else
+    pool_head = job;
+  pool_tail = job;
+
+  pool_cond_signal(&pool_work_cond);
+  pool_unlock();
+
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// pool_parallel_for
+// -------------------------------------------------------------------------- //
+void pool_parallel_for(int count, int grain, PoolRangeFunc func, void* arg) {
+  PoolLoop loop;
+  PoolDeque* own;
+  PoolTask task;
+  int tiles, tile, workers;
+
+  assert(func != NULL);
+
+  if(count <= 0)
+    return;
+
+  grain = max(grain, 1);
+  tiles = (count + grain - 1) / grain;
+  own = pool_current != NULL ? pool_current : &pool_deques[POOL_MAX_SIZE];
+
+  workers = 0;
+  if(tiles > 1) {
+    pool_lock();
+    if(!pool_stopping)
+      pool_start_workers();
+    workers = pool_workers;
+    pool_unlock();
+  }
+
+  if(workers == 0) {
+    own->counters.serialLoops++;
+    func(arg, 0, count);
+    return;
+  }
+
+  loop.func = func;
+  loop.arg = arg;
+  ATOMIC_INIT(&loop.pending, tiles);
+  own->counters.loops++;
+
+  /* Tiles are pushed in reverse, so that the owner runs them from the first one on, while thieves take the last ones */
+  for(tile = tiles - 1; tile >= 0; tile--)
+    if(!pool_deque_push(own, &loop, tile * grain, min((tile + 1) * grain, count)))
+      break;
+  pool_wake_idle();
+
+  /* Tiles that didn't fit into the deque */
+  for(; tile >= 0; tile--) {
+    task.loop = &loop;
+    task.begin = tile * grain;
+    task.end = min((tile + 1) * grain, count);
+    pool_run_task(own, &task);
+  }
+
+  /* Own tiles first, then tiles of other loops while they may nest, then sleep until the stolen tiles are done */
+  while(ATOMIC_LOAD(&loop.pending) > 0) {
+    if(pool_deque_pop(own, &loop, &task) || (pool_nesting < POOL_MAX_DEPTH && pool_take_task(own, &task))) {
+      pool_run_task(own, &task);
+      continue;
+    }
+
+    pool_lock();
+    if(ATOMIC_LOAD(&loop.pending) > 0 && (ATOMIC_LOAD(&pool_queued) == 0 || pool_nesting >= POOL_MAX_DEPTH)) {
+      own->counters.sleeps++;
+      pool_wait();
+    }
+    pool_unlock();
+  }
+}
+
+
+// -------------------------------------------------------------------------- //
+// pool_tile_rows
+// -------------------------------------------------------------------------- //
+int pool_tile_rows(int rowBytes) {
+  return rowBytes > 0 ? max(POOL_TILE_BYTES / rowBytes, 1) : 1;
+}
+
+
+// -------------------------------------------------------------------------- //
+// pool_rebind
+// -------------------------------------------------------------------------- //
+void pool_rebind(void) {
+  pool_lock();
+  ATOMIC_INC(&pool_epoch);
+  pool_cond_broadcast(&pool_work_cond); /* let idle workers rebind now */
+  pool_unlock();
+}
+
+
+// -------------------------------------------------------------------------- //
+// pool_stats
+// -------------------------------------------------------------------------- //
+void pool_stats(PoolStats* stats) {
+  int slot;
+
+  assert(stats != NULL);
+
+  pool_lock();
+  stats->size = pool_size();
+  stats->workers = pool_workers;
+  stats->slots = ATOMIC_LOAD(&pool_slot_count);
+  for(slot = 0; slot < POOL_MAX_SIZE; slot++)
+    stats->worker[slot] = pool_deques[slot].counters;
+  stats->callers = pool_deques[POOL_MAX_SIZE].counters;
+
+  stats->loops = stats->callers.loops;
+  stats->serialLoops = stats->callers.serialLoops;
+  for(slot = 0; slot < POOL_MAX_SIZE; slot++) {
+    stats->loops += stats->worker[slot].loops;
+    stats->serialLoops += stats->worker[slot].serialLoops;
+  }
+  pool_unlock();
+}
+
+
+// -------------------------------------------------------------------------- //
+// Synchronization
+// -------------------------------------------------------------------------- //
+void pool_lock(void) {
+  pool_mutex_lock(&pool_mutex);
+}
+
+void pool_unlock(void) {
+  pool_mutex_unlock(&pool_mutex);
+}
+
+void pool_wait(void) {
+  pool_cond_wait(&pool_done_cond);
+}
+
+void pool_notify(void) {
+  pool_cond_broadcast(&pool_done_cond);
+}
+
+
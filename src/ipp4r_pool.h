@@ -0,0 +1,202 @@
+#ifndef __IPP4R_POOL_H__
+#define __IPP4R_POOL_H__
+
+#include <ippdefs.h>
+#include "ipp4r_fwd.h"
+
+/**
+ * @file
+ *
+ * This file defines a pool of native worker threads, which is the only scheduler of the extension: it runs jobs in the background,
+ * e.g. asynchronous image operations, and tiles of parallel kernels. <p>
+ *
+ * Workers are unknown to ruby: they never take the GVL, so jobs and tiles must not touch ruby objects or call ruby API that may raise or trigger gc.
+ * Image buffers allocated on workers come from malloc rather than xmalloc for that reason, see data_new. Workers are started lazily by the first job or loop. <p>
+ *
+ * Jobs are queued in FIFO order. Kernels split their rows into tiles with pool_parallel_for: tiles are pushed onto the task deque of the calling worker
+ * (non-worker threads share one deque), the owner takes them from the bottom, and idle workers steal them from the top of other deques.
+ * A worker finishes the tiles it can find before it starts a new job, so a kernel run by a job of a batch spreads over the cores that are idle
+ * and stays on its own worker otherwise, and nested loops never start more threads than the pool has. The thread that waits for its loop
+ * runs tiles too, its own or stolen ones, and only sleeps when there are none left. <p>
+ *
+ * Pool size is the concurrency cap of the extension. It defaults to IPP4R_NUM_THREADS or OMP_THREAD_LIMIT from the environment,
+ * so that a host process which limits its own threads can limit ours the same way, and to the number of CPUs otherwise.
+ * Threads that call kernels directly, e.g. ruby threads, aren't counted, since they run tiles instead of sleeping.
+ * pool_init sets the IPP thread count, which is process-wide, to 1 where IPP has ippSetNumThreads, so that IPP functions run by jobs and tiles don't add threads past the cap. <p>
+ *
+ * Pool has a single lock, which also guards the state of jobs that their submitters wait for: a job marks itself done under the lock
+ * and calls pool_notify, and a waiter checks the mark under the lock and calls pool_wait until it's set. Deques have locks of their own. <p>
+ *
+ * Workers don't survive fork. Child process starts with an empty pool, and jobs that were queued or running in the parent at the moment of fork never finish in the child.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -------------------------------------------------------------------------- //
+// Defines
+// -------------------------------------------------------------------------- //
+#define POOL_MAX_SIZE 256           /**< Maximal number of workers */
+#define POOL_DEQUE_SIZE 64          /**< Capacity of a task deque, tiles that don't fit are run by the thread that creates them */
+#define POOL_MAX_DEPTH 8            /**< Maximal number of tiles of other loops a waiting thread may run nested in each other */
+#define POOL_TILE_BYTES (64 << 10)  /**< Preferred amount of pixel data in a tile, see pool_tile_rows */
+
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+typedef struct _PoolJob PoolJob;
+
+/**
+ * Job function, called on a worker without the pool lock.
+ */
+typedef void (*PoolFunc)(PoolJob* job);
+
+
+/**
+ * Job of the pool, usually embedded as the first field into a larger structure that holds the arguments.
+ */
+struct _PoolJob {
+  PoolFunc func;        /**< job function */
+  PoolJob* next;        /**< next job in the queue */
+};
+
+
+/**
+ * Tile function of a parallel loop, called for a range of items. Called on any thread, so it must not use ruby API.
+ *
+ * @param arg argument passed to pool_parallel_for
+ * @param begin first item of the range
+ * @param end item after the last one of the range
+ */
+typedef void (*PoolRangeFunc)(void* arg, int begin, int end);
+
+
+/**
+ * Utilization counters of a thread. Counters are updated by their thread without synchronization, so a snapshot may be slightly off.
+ */
+typedef struct {
+  long long loops;      /**< number of loops split into tiles */
+  long long serialLoops; /**< number of loops run alone, being too small or having no workers */
+  long long tasks;      /**< number of tiles run */
+  long long steals;     /**< number of tiles taken from deques of other threads */
+  long long jobs;       /**< number of jobs run */
+  long long sleeps;     /**< number of times the thread went to sleep for lack of work */
+  double busy;          /**< seconds spent running tiles and jobs, tiles nested in jobs are counted once */
+} PoolCounters;
+
+
+/**
+ * Utilization statistics of the pool.
+ */
+typedef struct {
+  int size;                               /**< pool size, i.e. the concurrency cap */
+  int workers;                            /**< number of live workers */
+  int slots;                              /**< number of worker slots used so far, counters of the others are zero */
+  long long loops;                        /**< number of loops split into tiles, by all threads */
+  long long serialLoops;                  /**< number of loops run by their caller alone, by all threads */
+  PoolCounters worker[POOL_MAX_SIZE];     /**< counters of workers, indexed by worker slot */
+  PoolCounters callers;                   /**< counters of non-worker threads that run tiles of their loops */
+} PoolStats;
+
+
+// -------------------------------------------------------------------------- //
+// Function declarations
+// -------------------------------------------------------------------------- //
+/**
+ * Initializes the pool. Must be called once at load time, doesn't start any workers.
+ */
+void pool_init(void);
+
+
+/**
+ * Finishes running jobs and stops all workers, jobs that haven't started yet are dropped. Called at exit.
+ */
+void pool_shutdown(void);
+
+
+/**
+ * @returns number of workers, IPP4R_NUM_THREADS, OMP_THREAD_LIMIT or number of CPUs available to the process by default
+ */
+int pool_size(void);
+
+
+/**
+ * Sets number of workers. Extra workers stop once they finish their current job, missing ones are started by the next job.
+ *
+ * @param size number of workers between 1 and POOL_MAX_SIZE, or 0 to restore the default one
+ * @returns ippStsNoErr if everything went OK, ippStsBadArgErr for a wrong size
+ */
+int pool_set_size(int size);
+
+
+/**
+ * Queues a job. The job must stay valid until its function is called.
+ *
+ * @returns ippStsNoErr if everything went OK, ippStsNoMemErr if no worker could be started, e.g. after pool_shutdown
+ */
+int pool_submit(PoolJob* job);
+
+
+/**
+ * Runs func over items 0..count-1 split into tiles of grain items, on the calling thread and on idle workers, and returns once all tiles are done.
+ * May be nested, i.e. called from a tile or a job. Small loops, and all loops while the pool has no workers, are run by the caller alone.
+ *
+ * @param count number of items, e.g. rows or bands
+ * @param grain number of items in a tile
+ * @param func tile function
+ * @param arg argument of func
+ */
+void pool_parallel_for(int count, int grain, PoolRangeFunc func, void* arg);
+
+
+/**
+ * @returns number of rows of rowBytes bytes that make a tile of about POOL_TILE_BYTES, at least 1
+ */
+int pool_tile_rows(int rowBytes);
+
+
+/**
+ * Makes every worker call numa_bind_thread before its next job or tile, e.g. after the binding of workers is changed.
+ */
+void pool_rebind(void);
+
+
+/**
+ * Fills utilization statistics of the pool.
+ */
+void pool_stats(PoolStats* stats);
+
+
+/**
+ * Locks the pool.
+ */
+void pool_lock(void);
+
+
+/**
+ * Unlocks the pool.
+ */
+void pool_unlock(void);
+
+
+/**
+ * Waits until some job calls pool_notify, or until the waiter is woken up by pool_notify for another reason. Pool must be locked.
+ */
+void pool_wait(void);
+
+
+/**
+ * Wakes up all waiters. Pool must be locked.
+ */
+void pool_notify(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
@@ -0,0 +1,207 @@
+#include <assert.h>
+#include <math.h>
+#include "ipp4r.h"
+
+
+// -------------------------------------------------------------------------- //
+// Supplementary functions
+// -------------------------------------------------------------------------- //
+#define PYRAMID_CLAMP(I, N) ((I) < 0 ? 0 : (I) >= (N) ? (N) - 1 : (I))
+
+/* Rounding conversion of an accumulated value to a given data type, see D_ACCUM. */
+DEFINE_D_SAT(pyramid_round_, 8u, D_ACCUM(8u))
+DEFINE_D_SAT(pyramid_round_, 16u, D_ACCUM(16u))
+DEFINE_D_SAT(pyramid_round_, 16s, D_ACCUM(16s))
+DEFINE_D_SAT(pyramid_round_, 32s, D_ACCUM(32s))
+#define pyramid_round_32f(V) (V)
+#define pyramid_round_64f(V) (V)
+
+
+// -------------------------------------------------------------------------- //
+// Kernels
+// -------------------------------------------------------------------------- //
+/** Reduction kernel */
+typedef void (*PyramidDownFunc)(const void* pSrc, int srcStep, IppiSize srcSize, void* pDst, int dstStep, void* buffer);
+
+/** Normalization kernel */
+typedef void (*PyramidNormalizeFunc)(const void* pSrc, int srcStep, Ipp32f* pDst, int dstStep, IppiSize roi);
+
+
+/**
+ * Defines a kernel <tt>pyramid_down_DATATYPE_CHANNELSR</tt>. Rows of the source are first combined vertically into a row buffer of ATYPE, see D_ACCUM, then the buffer is filtered horizontally.
+ */
+#define DEFINE_PYRAMID_DOWN_KERNEL(METATYPE, ARG)                               \
+  DEFINE_PYRAMID_DOWN_KERNEL_I(M_DATATYPE(METATYPE), M_CHANNELS(METATYPE), D_CTYPE(M_DATATYPE(METATYPE)), D_ACCUM(M_DATATYPE(METATYPE)), C_CNUMB(M_CHANNELS(METATYPE)))
+#define DEFINE_PYRAMID_DOWN_KERNEL_I(D, C, CTYPE, ATYPE, CNUMB)                 \
+static void ARX_JOIN_5(pyramid_down_, D, _, C, R)(const void* pSrc, int srcStep, IppiSize srcSize, void* pDst, int dstStep, void* buffer) { \
+  int x, y, c, i, rowLength;                                                    \
+  int x0, x1, x2, x3, x4;                                                       \
+  const CTYPE* s[5];                                                            \
+  CTYPE* d;                                                                     \
+  ATYPE* row;                                                                   \
+  IppiSize dstSize;                                                             \
+                                                                                \
+  row = (ATYPE*) buffer;                                                        \
+  dstSize = pyramid_next_size(srcSize);                                         \
+  rowLength = srcSize.width * CNUMB;                                            \
+                                                                                \
+  for(y = 0; y < dstSize.height; y++) {                                         \
+    for(i = 0; i < 5; i++)                                                      \
+      s[i] = (const CTYPE*) ((const char*) pSrc + PYRAMID_CLAMP(2 * y - 2 + i, srcSize.height) * srcStep); \
+    for(i = 0; i < rowLength; i++)                                              \
+      row[i] = (ATYPE) s[0][i] + s[4][i] + 4 * ((ATYPE) s[1][i] + s[3][i]) + 6 * (ATYPE) s[2][i]; \
+                                                                                \
+    d = (CTYPE*) ((char*) pDst + y * dstStep);                                  \
+    for(x = 0; x < dstSize.width; x++, d += CNUMB) {                            \
+      x0 = PYRAMID_CLAMP(2 * x - 2, srcSize.width) * CNUMB;                     \
+      x1 = PYRAMID_CLAMP(2 * x - 1, srcSize.width) * CNUMB;                     \
+      x2 = 2 * x * CNUMB;                                                       \
+      x3 = PYRAMID_CLAMP(2 * x + 1, srcSize.width) * CNUMB;                     \
+      x4 = PYRAMID_CLAMP(2 * x + 2, srcSize.width) * CNUMB;                     \
+      for(c = 0; c < CNUMB; c++)                                                \
+        d[c] = ARX_JOIN(pyramid_round_, D)((row[x0 + c] + row[x4 + c] + 4 * (row[x1 + c] + row[x3 + c]) + 6 * row[x2 + c]) * (ATYPE) (1.0 / 256.0)); \
+    }                                                                           \
+  }                                                                             \
+}
+
+#define PYRAMID_DOWN_KERNEL(M, ARG) ARX_JOIN_5(pyramid_down_, M_DATATYPE(M), _, M_CHANNELS(M), R)
+
+ARX_ARRAY_FOREACH(M_SUPPORTED, DEFINE_PYRAMID_DOWN_KERNEL, ~)
+DEFINE_DISPATCH_KERNELS(pyramid_down_kernels_generic, M_SUPPORTED, PYRAMID_DOWN_KERNEL, ~)
+
+
+/**
+ * Defines a kernel <tt>pyramid_normalize_DATATYPE_CHANNELSR</tt>.
+ */
+#define DEFINE_PYRAMID_NORMALIZE_KERNEL(METATYPE, ARG)                          \
+  DEFINE_PYRAMID_NORMALIZE_KERNEL_I(M_DATATYPE(METATYPE), M_CHANNELS(METATYPE), D_CTYPE(M_DATATYPE(METATYPE)), C_CNUMB(M_CHANNELS(METATYPE)))
+#define DEFINE_PYRAMID_NORMALIZE_KERNEL_I(D, C, CTYPE, CNUMB)                   \
+static void ARX_JOIN_5(pyramid_normalize_, D, _, C, R)(const void* pSrc, int srcStep, Ipp32f* pDst, int dstStep, IppiSize roi) { \
+  int y, i;                                                                     \
+  const CTYPE* s;                                                               \
+  Ipp32f* d;                                                                    \
+                                                                                \
+  for(y = 0; y < roi.height; y++) {                                             \
+    s = (const CTYPE*) ((const char*) pSrc + y * srcStep);                      \
+    d = (Ipp32f*) ((char*) pDst + y * dstStep);                                 \
+    for(i = 0; i < roi.width * CNUMB; i++)                                      \
+      d[i] = C2M_NUMBER_D(D, s[i]);                                             \
+  }                                                                             \
+}
+
+#define PYRAMID_NORMALIZE_KERNEL(M, ARG) ARX_JOIN_5(pyramid_normalize_, M_DATATYPE(M), _, M_CHANNELS(M), R)
+
+ARX_ARRAY_FOREACH(M_SUPPORTED, DEFINE_PYRAMID_NORMALIZE_KERNEL, ~)
+DEFINE_DISPATCH_KERNELS(pyramid_normalize_kernels_generic, M_SUPPORTED, PYRAMID_NORMALIZE_KERNEL, ~)
+
+DEFINE_DISPATCH_TABLE(pyramid_down_table, "pyramid_down", pyramid_down_kernels)
+DEFINE_DISPATCH_TABLE(pyramid_normalize_table, "pyramid_normalize", pyramid_normalize_kernels)
+
+
+// -------------------------------------------------------------------------- //
+// pyramid_dispatch_init
+// -------------------------------------------------------------------------- //
+void pyramid_dispatch_init(void) {
+  dispatch_register(&pyramid_down_table);
+  dispatch_register(&pyramid_normalize_table);
+}
+
+
+// -------------------------------------------------------------------------- //
+// pyramid_next_size
+// -------------------------------------------------------------------------- //
+IppiSize pyramid_next_size(IppiSize size) {
+  return ippi_size((size.width + 1) / 2, (size.height + 1) / 2);
+}
+
+
+// -------------------------------------------------------------------------- //
+// pyramid_down
+// -------------------------------------------------------------------------- //
+int pyramid_down(IppMetaType metaType, const void* pSrc, int srcStep, IppiSize srcSize, void* pDst, int dstStep, void* buffer) {
+  PyramidDownFunc kernel;
+
+  assert(pSrc != NULL && pDst != NULL && buffer != NULL);
+
+  kernel = DISPATCH_KERNEL(PyramidDownFunc, pyramid_down_table, metaType);
+  if(kernel == NULL)
+    return ippStsDataTypeErr;
+
+  kernel(pSrc, srcStep, srcSize, pDst, dstStep, buffer);
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// pyramid_up_add
+// -------------------------------------------------------------------------- //
+int pyramid_up_add(IppChannels channels, const Ipp32f* pSrc, int srcStep, IppiSize srcSize, Ipp32f* pDst, int dstStep, IppiSize dstSize, Ipp32f sign, Ipp32f* buffer) {
+  int x, y, c, i, j, cnumb, rowLength;
+  int x0, x1, x2;
+  const Ipp32f* s0;
+  const Ipp32f* s1;
+  const Ipp32f* s2;
+  Ipp32f* d;
+
+  assert(pSrc != NULL && pDst != NULL && buffer != NULL);
+
+  if(!is_channels_supported(channels)) {
+    Unreachable();
+    return ippStsBadArgErr;
+  }
+  cnumb = metatype_cnumb(metatype_compose(ipp32f, channels));
+
+  rowLength = srcSize.width * cnumb;
+
+  for(y = 0; y < dstSize.height; y++) {
+    /* Vertical pass: even rows are (1 6 1) / 8 of the source rows around them, odd rows are (1 1) / 2. */
+    j = y / 2;
+    s1 = (const Ipp32f*) ((const char*) pSrc + j * srcStep);
+    s2 = (const Ipp32f*) ((const char*) pSrc + PYRAMID_CLAMP(j + 1, srcSize.height) * srcStep);
+    if(y % 2 == 0) {
+      s0 = (const Ipp32f*) ((const char*) pSrc + PYRAMID_CLAMP(j - 1, srcSize.height) * srcStep);
+      for(i = 0; i < rowLength; i++)
+        buffer[i] = (s0[i] + 6.0f * s1[i] + s2[i]) * 0.125f;
+    } else {
+      for(i = 0; i < rowLength; i++)
+        buffer[i] = (s1[i] + s2[i]) * 0.5f;
+    }
+
+    /* Horizontal pass, the same way. */
+    d = (Ipp32f*) ((char*) pDst + y * dstStep);
+    for(x = 0; x < dstSize.width; x++, d += cnumb) {
+      j = x / 2;
+      x1 = j * cnumb;
+      x2 = PYRAMID_CLAMP(j + 1, srcSize.width) * cnumb;
+      if(x % 2 == 0) {
+        x0 = PYRAMID_CLAMP(j - 1, srcSize.width) * cnumb;
+        for(c = 0; c < cnumb; c++)
+          d[c] += sign * (buffer[x0 + c] + 6.0f * buffer[x1 + c] + buffer[x2 + c]) * 0.125f;
+      } else {
+        for(c = 0; c < cnumb; c++)
+          d[c] += sign * (buffer[x1 + c] + buffer[x2 + c]) * 0.5f;
+      }
+    }
+  }
+
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// pyramid_normalize
+// -------------------------------------------------------------------------- //
+int pyramid_normalize(IppMetaType metaType, const void* pSrc, int srcStep, Ipp32f* pDst, int dstStep, IppiSize roi) {
+  PyramidNormalizeFunc kernel;
+
+  assert(pSrc != NULL && pDst != NULL);
+
+  kernel = DISPATCH_KERNEL(PyramidNormalizeFunc, pyramid_normalize_table, metaType);
+  if(kernel == NULL)
+    return ippStsDataTypeErr;
+
+  kernel(pSrc, srcStep, pDst, dstStep, roi);
+  return ippStsNoErr;
+}
+
+
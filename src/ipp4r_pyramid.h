@@ -0,0 +1,97 @@
+#ifndef __IPP4R_PYRAMID_H__
+#define __IPP4R_PYRAMID_H__
+
+#include <ippdefs.h>
+#include "ipp4r_fwd.h"
+#include "ipp4r_metatype.h"
+
+/**
+ * @file
+ *
+ * This file defines kernels for Gaussian and Laplacian image pyramids. <p>
+ *
+ * Each pyramid level is obtained from the previous one by a fused blur-and-decimate pass with a separable 5x5 binomial kernel,
+ * so only the retained pixels are ever computed. Level sizes are rounded up, i.e. a level of size (w, h) is followed by a level of size ((w + 1) / 2, (h + 1) / 2). <p>
+ *
+ * Laplacian levels are signed, therefore they are stored as 32f values in MetaNumber space.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -------------------------------------------------------------------------- //
+// Defines
+// -------------------------------------------------------------------------- //
+/** Size in bytes of a pyramid_down scratch buffer for source of the given width, four channels of the widest accumulator type */
+#define PYRAMID_BUFFER_SIZE(WIDTH) ((WIDTH) * 4 * sizeof(Ipp64f))
+
+
+// -------------------------------------------------------------------------- //
+// Function declarations
+// -------------------------------------------------------------------------- //
+/**
+ * @returns size of the pyramid level following the level of the given size
+ */
+IppiSize pyramid_next_size(IppiSize size);
+
+
+/**
+ * Blurs an image buffer with a 5x5 binomial kernel and decimates it by 2 in both directions. Border pixels are replicated.
+ *
+ * @param metaType metatype of source and destination
+ * @param pSrc source buffer
+ * @param srcStep size of source row in bytes
+ * @param srcSize size of source in pixels
+ * @param pDst destination buffer of pyramid_next_size(srcSize) pixels
+ * @param dstStep size of destination row in bytes
+ * @param buffer scratch buffer of at least PYRAMID_BUFFER_SIZE(srcSize.width) bytes
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int pyramid_down(IppMetaType metaType, const void* pSrc, int srcStep, IppiSize srcSize, void* pDst, int dstStep, void* buffer);
+
+
+/**
+ * Upsamples a 32f image buffer by 2 in both directions with the pyramid interpolation kernel, and adds the result multiplied by sign to the destination.
+ *
+ * @param channels channels of source and destination
+ * @param pSrc source buffer
+ * @param srcStep size of source row in bytes
+ * @param srcSize size of source in pixels
+ * @param pDst destination buffer, pyramid_next_size(dstSize) must be equal to srcSize
+ * @param dstStep size of destination row in bytes
+ * @param dstSize size of destination in pixels
+ * @param sign factor for the upsampled image, 1 for reconstruction and -1 for decomposition
+ * @param buffer scratch buffer of at least srcSize.width * 4 elements
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int pyramid_up_add(IppChannels channels, const Ipp32f* pSrc, int srcStep, IppiSize srcSize, Ipp32f* pDst, int dstStep, IppiSize dstSize, Ipp32f sign, Ipp32f* buffer);
+
+
+/**
+ * Converts an image buffer to 32f MetaNumber representation.
+ *
+ * @param metaType metatype of source. Destination is of 32f metatype with the same channels
+ * @param pSrc source buffer
+ * @param srcStep size of source row in bytes
+ * @param pDst destination buffer
+ * @param dstStep size of destination row in bytes
+ * @param roi size of processed region in pixels
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int pyramid_normalize(IppMetaType metaType, const void* pSrc, int srcStep, Ipp32f* pDst, int dstStep, IppiSize roi);
+
+
+/**
+ * Registers dispatch tables of pyramid kernels, see dispatch_init.
+ */
+void pyramid_dispatch_init(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
@@ -30,7 +30,7 @@ TRACE_FUNC(VALUE, rb_Image_initialize, (int argc, VALUE *argv, VALUE self)) {
   case 4:
     border = R2C_INT(argv[3]);
   case 3:
-    metaType = R2C_ENUM(argv[2], rb_MetaType);
+    metaType = r2c_metatype(argv[2]);
   case 2:
     width = R2C_INT(argv[0]);
     height = R2C_INT(argv[1]);
@@ -312,12 +312,115 @@ VALUE rb_Image_metatype(VALUE self) {
 TRACE_FUNC(VALUE, rb_Image_convert, (VALUE self, VALUE r_metatype)) {
   Image* result;
 
-  raise_on_error(image_convert_copy(Data_Get_Struct_Ret(self, Image), &result, R2C_ENUM(r_metatype, rb_MetaType)));
+  raise_on_error(image_convert_copy(Data_Get_Struct_Ret(self, Image), &result, r2c_metatype(r_metatype)));
 
   TRACE_RETURN(image_wrap(result));
 } TRACE_END
 
 
+// -------------------------------------------------------------------------- //
+// rb_Image_colorspace_generic
+// -------------------------------------------------------------------------- //
+static VALUE rb_Image_colorspace_generic(int argc, VALUE* argv, VALUE self, int forward) {
+  Image* image;
+  Image* result;
+  ColorSpace space;
+  IppDataType dataType;
+
+  if(argc < 1 || argc > 2)
+    rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 1..2)", argc);
+
+  image = Data_Get_Struct_Ret(self, Image);
+  space = r2c_color_space(argv[0]);
+  dataType = (argc == 2 && !NIL_P(argv[1])) ? R2C_ENUM(argv[1], rb_DataType) : image_datatype(image);
+
+  if(image_channels(image) == ippC1)
+    rb_raise(rb_eArgError, "color space conversion requires a color image");
+
+  if(forward)
+    raise_on_error(image_colorspace_copy(image, &result, COLORSPACE_RGB, space, dataType));
+  else
+    raise_on_error(image_colorspace_copy(image, &result, space, COLORSPACE_RGB, dataType));
+
+  return image_wrap(result);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_to_colorspace
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_to_colorspace(int argc, VALUE* argv, VALUE self) {
+  return rb_Image_colorspace_generic(argc, argv, self, TRUE);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_from_colorspace
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_from_colorspace(int argc, VALUE* argv, VALUE self) {
+  return rb_Image_colorspace_generic(argc, argv, self, FALSE);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_to_yuv420
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_to_yuv420(int argc, VALUE* argv, VALUE self) {
+  Image* image;
+  Yuv420Format format;
+  VALUE result;
+
+  if(argc > 1)
+    rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 0..1)", argc);
+
+  image = Data_Get_Struct_Ret(self, Image);
+  format = argc == 1 ? r2c_yuv420_format(argv[0]) : YUV420_I420;
+
+  result = rb_str_new(NULL, colorspace_yuv420_size(ippi_size(image_width(image), image_height(image))));
+  raise_on_error(image_to_yuv420(image, format, (Ipp8u*) RSTRING_PTR(result)));
+
+  return result;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_from_yuv420
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_from_yuv420(int argc, VALUE* argv, VALUE klass) {
+  Image* image;
+  Yuv420Format format;
+  IppiSize size;
+
+  if(argc < 3 || argc > 4)
+    rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 3..4)", argc);
+
+  Check_Type(argv[0], T_STRING);
+  size = ippi_size(R2C_INT(argv[1]), R2C_INT(argv[2]));
+  format = argc == 4 ? r2c_yuv420_format(argv[3]) : YUV420_I420;
+
+  if(size.width <= 0 || size.height <= 0)
+    rb_raise(rb_eArgError, "invalid image size %dx%d", size.width, size.height);
+  if(RSTRING_LEN(argv[0]) < colorspace_yuv420_size(size))
+    rb_raise(rb_eArgError, "YUV 4:2:0 data too short: %d bytes instead of %d", (int) RSTRING_LEN(argv[0]), colorspace_yuv420_size(size));
+
+  raise_on_error(image_from_yuv420(&image, (const Ipp8u*) RSTRING_PTR(argv[0]), size, format));
+
+  return image_wrap(image);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_to_planar
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_to_planar(VALUE self) {
+  Image* newImage;
+
+  raise_on_error(image_to_planar_copy(Data_Get_Struct_Ret(self, Image), &newImage));
+
+  return image_wrap_class(newImage, rb_PlanarImage);
+}
+
+
 // -------------------------------------------------------------------------- //
 // rb_Image_ref
 // -------------------------------------------------------------------------- //
@@ -393,6 +496,21 @@ VALUE rb_Image_transpose(VALUE self) {
 }
 
 
+// -------------------------------------------------------------------------- //
+// rb_Image_transpose_bang
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_transpose_bang(VALUE self) {
+  int status;
+
+  status = image_transpose(Data_Get_Struct_Ret(self, Image));
+  if(status == ippStsSizeErr)
+    rb_raise(rb_eArgError, "in-place transposition of a non-square subimage is not supported, use transpose instead");
+  raise_on_error(status);
+
+  return self;
+}
+
+
 // -------------------------------------------------------------------------- //
 // rb_Image_threshold_parseargs
 // -------------------------------------------------------------------------- //
@@ -504,9 +622,7 @@ static void rb_Image_filter_matrix_anchor_parseargs(int argc, VALUE* argv, int i
     if(argc == 2)
       *anchor = *Data_Get_Struct_Ret(argv[1], IppiPoint); /* this one throws */
 
-    *mask = matrix_new(argv[0], isMask);
-    if(*mask == NULL)
-      rb_raise(rb_eArgError, "Argument #1 must be a matrix");
+    *mask = matrix_new(argv[0], isMask); /* this one throws too */
 
     if(argc == 1) {
       anchor->x = (*mask)->size.width / 2;
@@ -531,7 +647,7 @@ VALUE rb_Image_dilate(int argc, VALUE* argv, VALUE self) {
   
   rb_Image_filter_matrix_anchor_parseargs(argc, argv, TRUE, &mask, &anchor);
   status = image_dilate_copy(Data_Get_Struct_Ret(self, Image), &newImage, mask, anchor); /* this one won't throw */
-  matrix_destroy(mask);
+  matrix_release(mask);
   raise_on_error(status);
   return image_wrap(newImage);
 }
@@ -547,7 +663,7 @@ VALUE rb_Image_dilate_bang(int argc, VALUE* argv, VALUE self) {
 
   rb_Image_filter_matrix_anchor_parseargs(argc, argv, TRUE, &mask, &anchor);
   status = image_dilate(Data_Get_Struct_Ret(self, Image), mask, anchor); /* this one won't throw */
-  matrix_destroy(mask);
+  matrix_release(mask);
   raise_on_error(status);
   return self;
 }
@@ -564,7 +680,7 @@ VALUE rb_Image_erode(int argc, VALUE* argv, VALUE self) {
 
   rb_Image_filter_matrix_anchor_parseargs(argc, argv, TRUE, &mask, &anchor);
   status = image_erode_copy(Data_Get_Struct_Ret(self, Image), &newImage, mask, anchor); /* this one won't throw */
-  matrix_destroy(mask);
+  matrix_release(mask);
   raise_on_error(status);
   return image_wrap(newImage);
 }
@@ -580,7 +696,7 @@ VALUE rb_Image_erode_bang(int argc, VALUE* argv, VALUE self) {
 
   rb_Image_filter_matrix_anchor_parseargs(argc, argv, TRUE, &mask, &anchor);
   status = image_erode(Data_Get_Struct_Ret(self, Image), mask, anchor); /* this one won't throw */
-  matrix_destroy(mask);
+  matrix_release(mask);
   raise_on_error(status);
   return self;
 }
@@ -687,20 +803,28 @@ VALUE rb_Image_filter_median(int argc, VALUE* argv, VALUE self) {
 
 
 // -------------------------------------------------------------------------- //
-// rb_Image_filter_gauss
+// rb_Image_filter_gauss_parseargs
 // -------------------------------------------------------------------------- //
-VALUE rb_Image_filter_gauss(int argc, VALUE* argv, VALUE self) {
-  Image* newImage;
-  IppiMaskSize maskSize;
-
+static void rb_Image_filter_gauss_parseargs(int argc, VALUE* argv, IppiMaskSize* maskSize) {
   switch(argc) {
   case 1:
-    maskSize = R2C_ENUM(argv[0], rb_MaskSize);
+    *maskSize = R2C_ENUM(argv[0], rb_MaskSize);
     break;
   default:
     rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 1)", argc);
     break;
   }
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_filter_gauss
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_filter_gauss(int argc, VALUE* argv, VALUE self) {
+  Image* newImage;
+  IppiMaskSize maskSize;
+
+  rb_Image_filter_gauss_parseargs(argc, argv, &maskSize);
 
   raise_on_error(image_filter_gauss_copy(Data_Get_Struct_Ret(self, Image), &newImage, maskSize));
 
@@ -719,7 +843,7 @@ VALUE rb_Image_filter(int argc, VALUE* argv, VALUE self) {
 
   rb_Image_filter_matrix_anchor_parseargs(argc, argv, FALSE, &kernel, &anchor);
   status = image_filter_copy(Data_Get_Struct_Ret(self, Image), &newImage, kernel, anchor); /* this one won't throw */
-  matrix_destroy(kernel);
+  matrix_release(kernel);
   raise_on_error(status);
   return image_wrap(newImage);
 }
@@ -757,6 +881,13 @@ VALUE rb_Image_border(VALUE self) {
 VALUE rb_Image_draw_bang(int argc, VALUE* argv, VALUE self) {
   Image* src;
   IppiPoint pos;
+  BlendMode mode;
+
+  if(argc > 1 && CLASS_OF(argv[argc - 1]) == rb_BlendMode) {
+    mode = R2C_ENUM(argv[argc - 1], rb_BlendMode);
+    argc--;
+  } else
+    mode = BLEND_COPY;
 
   switch(argc) {
   case 3:
@@ -775,7 +906,7 @@ VALUE rb_Image_draw_bang(int argc, VALUE* argv, VALUE self) {
   }
   src = Data_Get_Struct_Ret(argv[0], Image);
 
-  raise_on_error(image_draw(Data_Get_Struct_Ret(self, Image), src, pos));
+  raise_on_error(image_draw(Data_Get_Struct_Ret(self, Image), src, pos, mode));
 
   return self;
 }
@@ -840,27 +971,73 @@ VALUE rb_Image_draw_rotated(int argc, VALUE* argv, VALUE self) {
 
 
 // -------------------------------------------------------------------------- //
-// rb_Image_resize
+// rb_Image_resize_parsemode
 // -------------------------------------------------------------------------- //
-VALUE rb_Image_resize(int argc, VALUE* argv, VALUE self) {
-  int status;
-  IppiSize newSize;
-  Image* newImage;
+/**
+ * Extracts an optional trailing resize mode from arguments. Mode may be given directly, or as <tt>:mode => mode</tt> hash.
+ *
+ * @param argc pointer to the number of arguments, is decremented if a mode was found
+ * @param argv arguments
+ * @param modeArgPos position the mode argument would have if present
+ * @returns resize mode, RESIZE_CUBIC by default
+ */
+static ResizeMode rb_Image_resize_parsemode(int* argc, VALUE* argv, int modeArgPos) {
+  VALUE mode;
+
+  if(*argc == 0)
+    return RESIZE_CUBIC;
+
+  mode = argv[*argc - 1];
+  if(TYPE(mode) == T_HASH) {
+    (*argc)--;
+    mode = rb_hash_aref(mode, ID2SYM(rb_intern("mode")));
+    return NIL_P(mode) ? RESIZE_CUBIC : r2c_resize_mode(mode);
+  } else if(*argc == modeArgPos + 1 && !RTEST(rb_obj_is_kind_of(mode, rb_cNumeric))) {
+    (*argc)--;
+    return r2c_resize_mode(mode);
+  } else
+    return RESIZE_CUBIC;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_resize_parseargs
+// -------------------------------------------------------------------------- //
+static void rb_Image_resize_parseargs(int argc, VALUE* argv, IppiSize* newSize, ResizeMode* mode) {
+  if(argc == 2 && !RTEST(rb_obj_is_kind_of(argv[0], rb_cNumeric)))
+    *mode = rb_Image_resize_parsemode(&argc, argv, 1);
+  else
+    *mode = rb_Image_resize_parsemode(&argc, argv, 2);
 
   switch(argc) {
   case 1:
-    newSize = *Data_Get_Struct_Ret(argv[0], IppiSize);
+    *newSize = *Data_Get_Struct_Ret(argv[0], IppiSize);
     break;
   case 2:
-    newSize.width = R2C_INT(argv[0]);
-    newSize.height = R2C_INT(argv[1]);
+    newSize->width = R2C_INT(argv[0]);
+    newSize->height = R2C_INT(argv[1]);
     break;
   default:
     rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 1 or 2)", argc);
     break;
   }
 
-  raise_on_error(image_resize_copy(Data_Get_Struct_Ret(self, Image), &newImage, newSize));
+  if(newSize->width <= 0 || newSize->height <= 0)
+    rb_raise(rb_eArgError, "image size must be positive");
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_resize
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_resize(int argc, VALUE* argv, VALUE self) {
+  IppiSize newSize;
+  Image* newImage;
+  ResizeMode mode;
+
+  rb_Image_resize_parseargs(argc, argv, &newSize, &mode);
+
+  raise_on_error(image_resize_copy(Data_Get_Struct_Ret(self, Image), &newImage, newSize, mode));
   return image_wrap(newImage);
 }
 
@@ -870,7 +1047,13 @@ VALUE rb_Image_resize(int argc, VALUE* argv, VALUE self) {
 // -------------------------------------------------------------------------- //
 VALUE rb_Image_resize_factor(int argc, VALUE* argv, VALUE self) {
   double xFactor, yFactor;
-  
+  Image* image;
+  Image* newImage;
+  IppiSize newSize;
+  ResizeMode mode;
+
+  mode = rb_Image_resize_parsemode(&argc, argv, 2);
+
   switch(argc) {
   case 2:
     xFactor = R2C_DBL(argv[0]);
@@ -881,7 +1064,220 @@ VALUE rb_Image_resize_factor(int argc, VALUE* argv, VALUE self) {
     break;
   }
 
-  return rb_funcall(self, rb_ID_resize, 2, C2R_INT((int) (R2C_DBL(rb_funcall(self, rb_ID_width, 0)) * xFactor)), C2R_INT((int) (R2C_DBL(rb_funcall(self, rb_ID_height, 0)) * yFactor)));
+  image = Data_Get_Struct_Ret(self, Image);
+  newSize.width = (int) (image_width(image) * xFactor);
+  newSize.height = (int) (image_height(image) * yFactor);
+  if(newSize.width <= 0 || newSize.height <= 0)
+    rb_raise(rb_eArgError, "image size must be positive");
+
+  raise_on_error(image_resize_copy(image, &newImage, newSize, mode));
+  return image_wrap(newImage);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_thumbnail_parseargs
+// -------------------------------------------------------------------------- //
+static void rb_Image_thumbnail_parseargs(int argc, VALUE* argv, IppiSize* maxSize) {
+  switch(argc) {
+  case 1:
+    *maxSize = *Data_Get_Struct_Ret(argv[0], IppiSize);
+    break;
+  case 2:
+    maxSize->width = R2C_INT(argv[0]);
+    maxSize->height = R2C_INT(argv[1]);
+    break;
+  default:
+    rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 1 or 2)", argc);
+    break;
+  }
+
+  if(maxSize->width <= 0 || maxSize->height <= 0)
+    rb_raise(rb_eArgError, "thumbnail size must be positive");
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_thumbnail
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_thumbnail(int argc, VALUE* argv, VALUE self) {
+  IppiSize maxSize;
+  Image* newImage;
+
+  rb_Image_thumbnail_parseargs(argc, argv, &maxSize);
+
+  raise_on_error(image_thumbnail_copy(Data_Get_Struct_Ret(self, Image), &newImage, maxSize));
+  return image_wrap(newImage);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_pyramid_levels
+// -------------------------------------------------------------------------- //
+/**
+ * Wraps a pyramid built by image_gaussian_pyramid or image_laplacian_pyramid into an array of subimages, one per level.
+ */
+static VALUE rb_Image_pyramid_levels(Image* pyramid, IppiSize size, int levels) {
+  volatile VALUE rb_pyramid;
+  VALUE result;
+  Image* level;
+  int y;
+
+  rb_pyramid = image_wrap(pyramid); /* levels share its Data, keep it referenced until the first one is created */
+  result = rb_ary_new2(levels);
+  for(y = 0; levels > 0; levels--) {
+    raise_on_error(image_subimage(Data_Get_Struct_Ret(rb_pyramid, Image), &level, 0, y, size.width, size.height));
+    rb_ary_push(result, image_wrap(level));
+    y += size.height;
+    size = pyramid_next_size(size);
+  }
+  return result;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_gaussian_pyramid
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_gaussian_pyramid(VALUE self, VALUE r_levels) {
+  int levels;
+  Image* image;
+  Image* pyramid;
+
+  levels = R2C_INT(r_levels);
+  if(levels <= 0)
+    rb_raise(rb_eArgError, "number of pyramid levels must be positive");
+
+  image = Data_Get_Struct_Ret(self, Image);
+  raise_on_error(image_gaussian_pyramid(image, &pyramid, levels));
+  return rb_Image_pyramid_levels(pyramid, ippi_size(image_width(image), image_height(image)), levels);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_laplacian_pyramid
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_laplacian_pyramid(VALUE self, VALUE r_levels) {
+  int levels;
+  Image* image;
+  Image* pyramid;
+
+  levels = R2C_INT(r_levels);
+  if(levels <= 0)
+    rb_raise(rb_eArgError, "number of pyramid levels must be positive");
+
+  image = Data_Get_Struct_Ret(self, Image);
+  raise_on_error(image_laplacian_pyramid(image, &pyramid, levels));
+  return rb_Image_pyramid_levels(pyramid, ippi_size(image_width(image), image_height(image)), levels);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_reconstruct_laplacian
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_reconstruct_laplacian(VALUE klass, VALUE r_levels) {
+  int i, count;
+  Image** levels;
+  Image* newImage;
+
+  Check_Type(r_levels, T_ARRAY);
+  count = RARRAY_LEN(r_levels);
+  if(count == 0)
+    rb_raise(rb_eArgError, "pyramid must contain at least 1 level");
+
+  levels = ALLOCA_N(Image*, count);
+  for(i = 0; i < count; i++)
+    levels[i] = Data_Get_Struct_Ret(rb_ary_entry(r_levels, i), Image);
+
+  raise_on_error(image_laplacian_reconstruct(levels, count, &newImage));
+  return image_wrap(newImage);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_warp_generic
+// -------------------------------------------------------------------------- //
+/**
+ * Implements warp_affine and warp_perspective, rows is the number of rows expected in the transform matrix.
+ */
+static VALUE rb_Image_warp_generic(int argc, VALUE* argv, VALUE self, int rows) {
+  double coeffs[9];
+  IppiSize dstSize;
+  InterpMode interp;
+  BorderMode border;
+  Image* image;
+  Image* newImage;
+
+  image = Data_Get_Struct_Ret(self, Image);
+  dstSize = ippi_size(image_width(image), image_height(image));
+  interp = INTERP_LINEAR;
+  border = BORDER_CONSTANT;
+  r2c_remap_options(&argc, argv, &interp, &border, NULL);
+
+  switch(argc) {
+  case 3:
+    interp = r2c_interp_mode(argv[2]);
+  case 2:
+    if(!NIL_P(argv[1]))
+      dstSize = *Data_Get_Struct_Ret(argv[1], IppiSize);
+  case 1:
+    if(r2c_transform(argv[0], coeffs) != rows)
+      rb_raise(rb_eArgError, "transform matrix must be %dx3", rows);
+    break;
+  default:
+    rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 1, 2 or 3)", argc);
+    break;
+  }
+
+  if(dstSize.width <= 0 || dstSize.height <= 0)
+    rb_raise(rb_eArgError, "image size must be positive");
+
+  raise_on_error(image_warp_copy(image, &newImage, dstSize, coeffs, interp, border));
+  return image_wrap(newImage);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_warp_affine
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_warp_affine(int argc, VALUE* argv, VALUE self) {
+  return rb_Image_warp_generic(argc, argv, self, 2);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_warp_perspective
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_warp_perspective(int argc, VALUE* argv, VALUE self) {
+  return rb_Image_warp_generic(argc, argv, self, 3);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_remap
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_remap(int argc, VALUE* argv, VALUE self) {
+  InterpMode interp;
+  BorderMode border;
+  Image* newImage;
+
+  interp = INTERP_LINEAR;
+  border = BORDER_CONSTANT;
+  r2c_remap_options(&argc, argv, &interp, &border, NULL);
+
+  switch(argc) {
+  case 4:
+    border = r2c_border_mode(argv[3]);
+  case 3:
+    interp = r2c_interp_mode(argv[2]);
+  case 2:
+    break;
+  default:
+    rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 2, 3 or 4)", argc);
+    break;
+  }
+
+  raise_on_error(image_remap_copy(Data_Get_Struct_Ret(self, Image), &newImage, Data_Get_Struct_Ret(argv[0], Image), Data_Get_Struct_Ret(argv[1], Image), interp, border));
+  return image_wrap(newImage);
 }
 
 
@@ -926,3 +1322,497 @@ VALUE rb_Image_mirror_bang(int argc, VALUE* argv, VALUE self) {
 
   return self;
 }
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_rotate90_parseargs
+// -------------------------------------------------------------------------- //
+static void rb_Image_rotate90_parseargs(int argc, VALUE* argv, Orientation* orientation) {
+  switch(argc) {
+  case 0:
+    *orientation = rotate_quarter_turns(1);
+    break;
+  case 1:
+    *orientation = rotate_quarter_turns(R2C_INT(argv[0]));
+    break;
+  default:
+    rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 0..1)", argc);
+    break;
+  }
+}
+
+
+// -------------------------------------------------------------------------- //
+// r2c_orientation
+// -------------------------------------------------------------------------- //
+static Orientation r2c_orientation(VALUE exif) {
+  int value;
+
+  value = R2C_INT(exif);
+  if(value < ORIENT_NORMAL || value > ORIENT_ROTATE_270)
+    rb_raise(rb_eArgError, "invalid EXIF orientation %d, must be in 1..8", value);
+
+  return (Orientation) value;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_orient_bang
+// -------------------------------------------------------------------------- //
+static VALUE rb_Image_orient_bang(VALUE self, Orientation orientation) {
+  Image* image;
+
+  image = Data_Get_Struct_Ret(self, Image);
+  if(rotate_swaps_axes(orientation) && image_width(image) != image_height(image))
+    rb_raise(rb_eArgError, "in-place rotation by 90 degrees requires a square image, use a non-bang method instead");
+
+  raise_on_error(image_orient(image, orientation));
+
+  return self;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_rotate90
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_rotate90(int argc, VALUE* argv, VALUE self) {
+  Orientation orientation;
+  Image* newImage;
+
+  rb_Image_rotate90_parseargs(argc, argv, &orientation);
+
+  raise_on_error(image_orient_copy(Data_Get_Struct_Ret(self, Image), &newImage, orientation));
+
+  return image_wrap(newImage);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_rotate90_bang
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_rotate90_bang(int argc, VALUE* argv, VALUE self) {
+  Orientation orientation;
+
+  rb_Image_rotate90_parseargs(argc, argv, &orientation);
+
+  return rb_Image_orient_bang(self, orientation);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_normalize_orientation
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_normalize_orientation(VALUE self, VALUE exif) {
+  Image* newImage;
+
+  raise_on_error(image_orient_copy(Data_Get_Struct_Ret(self, Image), &newImage, r2c_orientation(exif)));
+
+  return image_wrap(newImage);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_normalize_orientation_bang
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_normalize_orientation_bang(VALUE self, VALUE exif) {
+  return rb_Image_orient_bang(self, r2c_orientation(exif));
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_apply_lut
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_apply_lut(VALUE self, VALUE lut) {
+  Image* newImage;
+
+  lut = rb_Lut_coerce(lut);
+
+  raise_on_error(image_apply_lut_copy(Data_Get_Struct_Ret(self, Image), &newImage, Data_Get_Struct_Ret(lut, Lut)));
+
+  return image_wrap(newImage);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_apply_lut_bang
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_apply_lut_bang(VALUE self, VALUE lut) {
+  lut = rb_Lut_coerce(lut);
+
+  raise_on_error(image_apply_lut(Data_Get_Struct_Ret(self, Image), Data_Get_Struct_Ret(lut, Lut)));
+
+  return self;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_arith_generic
+// -------------------------------------------------------------------------- //
+/**
+ * Performs an arithmetic operation. Other operand may be an Image, a Color or a Numeric, which is treated as a gray color.
+ */
+static VALUE rb_Image_arith_generic(VALUE self, VALUE other, ArithOp op, const IppMetaNumber* weights, int inPlace) {
+  Image* image;
+  Image* newImage;
+  Color color;
+
+  image = Data_Get_Struct_Ret(self, Image);
+
+  if(RTEST(rb_obj_is_kind_of(other, rb_Image))) {
+    if(inPlace)
+      raise_on_error(image_arith(image, Data_Get_Struct_Ret(other, Image), op, weights));
+    else
+      raise_on_error(image_arith_copy(image, &newImage, Data_Get_Struct_Ret(other, Image), op, weights));
+  } else {
+    if(RTEST(rb_obj_is_kind_of(other, rb_cNumeric)))
+      color.r = color.g = color.b = color.a = R2M_NUM(other);
+    else
+      R2C_COLOR(&color, other);
+
+    if(inPlace)
+      raise_on_error(image_arith_c(image, &color, op, weights));
+    else
+      raise_on_error(image_arith_c_copy(image, &newImage, &color, op, weights));
+  }
+
+  return inPlace ? self : image_wrap(newImage);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_[add|sub|mul|div|abs_diff][_bang]
+// -------------------------------------------------------------------------- //
+#define DEFINE_ARITH_METHODS(NAME, OP)                                          \
+VALUE ARX_JOIN(rb_Image_, NAME)(VALUE self, VALUE other) {                      \
+  return rb_Image_arith_generic(self, other, OP, NULL, FALSE);                  \
+}                                                                               \
+VALUE ARX_JOIN_3(rb_Image_, NAME, _bang)(VALUE self, VALUE other) {             \
+  return rb_Image_arith_generic(self, other, OP, NULL, TRUE);                   \
+}
+
+DEFINE_ARITH_METHODS(add, ARITH_ADD)
+DEFINE_ARITH_METHODS(sub, ARITH_SUB)
+DEFINE_ARITH_METHODS(mul, ARITH_MUL)
+DEFINE_ARITH_METHODS(div, ARITH_DIV)
+DEFINE_ARITH_METHODS(abs_diff, ARITH_ABSDIFF)
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_add_weighted_parseargs
+// -------------------------------------------------------------------------- //
+static void rb_Image_add_weighted_parseargs(int argc, VALUE* argv, VALUE* other, IppMetaNumber* weights) {
+  if(argc != 3 && argc != 4)
+    rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 3..4)", argc);
+
+  weights[0] = R2M_NUM(argv[0]);
+  *other = argv[1];
+  weights[1] = R2M_NUM(argv[2]);
+  weights[2] = argc == 4 ? R2M_NUM(argv[3]) : 0.0f;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_add_weighted
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_add_weighted(int argc, VALUE* argv, VALUE self) {
+  VALUE other;
+  IppMetaNumber weights[3];
+
+  rb_Image_add_weighted_parseargs(argc, argv, &other, weights);
+
+  return rb_Image_arith_generic(self, other, ARITH_ADDWEIGHTED, weights, FALSE);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_add_weighted_bang
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_add_weighted_bang(int argc, VALUE* argv, VALUE self) {
+  VALUE other;
+  IppMetaNumber weights[3];
+
+  rb_Image_add_weighted_parseargs(argc, argv, &other, weights);
+
+  return rb_Image_arith_generic(self, other, ARITH_ADDWEIGHTED, weights, TRUE);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_alpha_composite
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_alpha_composite(VALUE self, VALUE src) {
+  Image* newImage;
+
+  raise_on_error(image_alpha_composite_copy(Data_Get_Struct_Ret(self, Image), &newImage, Data_Get_Struct_Ret(src, Image)));
+
+  return image_wrap(newImage);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_alpha_composite_bang
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_alpha_composite_bang(VALUE self, VALUE src) {
+  raise_on_error(image_alpha_composite(Data_Get_Struct_Ret(self, Image), Data_Get_Struct_Ret(src, Image)));
+
+  return self;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_async
+// -------------------------------------------------------------------------- //
+VALUE rb_Image_async(VALUE self) {
+  Image* clone;
+
+  raise_on_error(image_clone(Data_Get_Struct_Ret(self, Image), &clone));
+
+  return image_wrap_class(clone, rb_AsyncImage);
+}
+
+
+// -------------------------------------------------------------------------- //
+// Asynchronous operations
+// -------------------------------------------------------------------------- //
+/* These run on pool workers, see FutureFunc. */
+static int async_convert(Image* image, Image** dst, const FutureArgs* args) {
+  return image_convert_copy(image, dst, args->metaType);
+}
+
+static int async_transpose(Image* image, Image** dst, const FutureArgs* args) {
+  return image_transpose_copy(image, dst);
+}
+
+static int async_mirror(Image* image, Image** dst, const FutureArgs* args) {
+  return image_mirror_copy(image, dst, args->axis);
+}
+
+static int async_rotate90(Image* image, Image** dst, const FutureArgs* args) {
+  return image_orient_copy(image, dst, args->orientation);
+}
+
+static int async_threshold(Image* image, Image** dst, const FutureArgs* args) {
+  Color threshold, value;
+
+  threshold = args->threshold;
+  value = args->value;
+  return image_threshold_copy(image, dst, &threshold, args->cmp, &value);
+}
+
+static int async_dilate3x3(Image* image, Image** dst, const FutureArgs* args) {
+  return image_dilate3x3_copy(image, dst);
+}
+
+static int async_erode3x3(Image* image, Image** dst, const FutureArgs* args) {
+  return image_erode3x3_copy(image, dst);
+}
+
+static int async_dilate(Image* image, Image** dst, const FutureArgs* args) {
+  return image_dilate_copy(image, dst, args->matrix, args->anchor);
+}
+
+static int async_erode(Image* image, Image** dst, const FutureArgs* args) {
+  return image_erode_copy(image, dst, args->matrix, args->anchor);
+}
+
+static int async_filter(Image* image, Image** dst, const FutureArgs* args) {
+  return image_filter_copy(image, dst, args->matrix, args->anchor);
+}
+
+static int async_filter_box(Image* image, Image** dst, const FutureArgs* args) {
+  return image_filter_box_copy(image, dst, args->size, args->anchor);
+}
+
+static int async_filter_min(Image* image, Image** dst, const FutureArgs* args) {
+  return image_filter_min_copy(image, dst, args->size, args->anchor);
+}
+
+static int async_filter_max(Image* image, Image** dst, const FutureArgs* args) {
+  return image_filter_max_copy(image, dst, args->size, args->anchor);
+}
+
+static int async_filter_median(Image* image, Image** dst, const FutureArgs* args) {
+  return image_filter_median_copy(image, dst, args->size, args->anchor);
+}
+
+static int async_filter_gauss(Image* image, Image** dst, const FutureArgs* args) {
+  return image_filter_gauss_copy(image, dst, args->maskSize);
+}
+
+static int async_resize(Image* image, Image** dst, const FutureArgs* args) {
+  return image_resize_copy(image, dst, args->size, args->mode);
+}
+
+static int async_thumbnail(Image* image, Image** dst, const FutureArgs* args) {
+  return image_thumbnail_copy(image, dst, args->size);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_Image_defer
+// -------------------------------------------------------------------------- //
+/**
+ * Queues an operation for Image::Async, or records it for Image::Batch, which shares the methods of Image::Async.
+ *
+ * @returns future of the operation, or self for Image::Batch
+ */
+static VALUE rb_Image_defer(VALUE self, FutureFunc func, const FutureArgs* args) {
+  if(RTEST(rb_obj_is_kind_of(self, rb_ImageBatch)))
+    return rb_Batch_record(self, func, args);
+  else
+    return rb_Future_submit(self, func, args);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_AsyncImage_[operation]
+// -------------------------------------------------------------------------- //
+VALUE rb_AsyncImage_convert(VALUE self, VALUE r_metatype) {
+  FutureArgs args;
+
+  memset(&args, 0, sizeof(args));
+  args.metaType = r2c_metatype(r_metatype);
+
+  return rb_Image_defer(self, async_convert, &args);
+}
+
+VALUE rb_AsyncImage_transpose(VALUE self) {
+  FutureArgs args;
+
+  memset(&args, 0, sizeof(args));
+
+  return rb_Image_defer(self, async_transpose, &args);
+}
+
+VALUE rb_AsyncImage_mirror(int argc, VALUE* argv, VALUE self) {
+  FutureArgs args;
+
+  memset(&args, 0, sizeof(args));
+  rb_Image_mirror_parseargs(argc, argv, &args.axis);
+
+  return rb_Image_defer(self, async_mirror, &args);
+}
+
+VALUE rb_AsyncImage_rotate90(int argc, VALUE* argv, VALUE self) {
+  FutureArgs args;
+
+  memset(&args, 0, sizeof(args));
+  rb_Image_rotate90_parseargs(argc, argv, &args.orientation);
+
+  return rb_Image_defer(self, async_rotate90, &args);
+}
+
+VALUE rb_AsyncImage_threshold(int argc, VALUE* argv, VALUE self) {
+  FutureArgs args;
+
+  memset(&args, 0, sizeof(args));
+  rb_Image_threshold_parseargs(argc, argv, &args.threshold, &args.cmp, &args.value);
+
+  return rb_Image_defer(self, async_threshold, &args);
+}
+
+VALUE rb_AsyncImage_dilate3x3(VALUE self) {
+  FutureArgs args;
+
+  memset(&args, 0, sizeof(args));
+
+  return rb_Image_defer(self, async_dilate3x3, &args);
+}
+
+VALUE rb_AsyncImage_erode3x3(VALUE self) {
+  FutureArgs args;
+
+  memset(&args, 0, sizeof(args));
+
+  return rb_Image_defer(self, async_erode3x3, &args);
+}
+
+VALUE rb_AsyncImage_dilate(int argc, VALUE* argv, VALUE self) {
+  FutureArgs args;
+
+  memset(&args, 0, sizeof(args));
+  rb_Image_filter_matrix_anchor_parseargs(argc, argv, TRUE, &args.matrix, &args.anchor);
+
+  return rb_Image_defer(self, async_dilate, &args);
+}
+
+VALUE rb_AsyncImage_erode(int argc, VALUE* argv, VALUE self) {
+  FutureArgs args;
+
+  memset(&args, 0, sizeof(args));
+  rb_Image_filter_matrix_anchor_parseargs(argc, argv, TRUE, &args.matrix, &args.anchor);
+
+  return rb_Image_defer(self, async_erode, &args);
+}
+
+VALUE rb_AsyncImage_filter(int argc, VALUE* argv, VALUE self) {
+  FutureArgs args;
+
+  memset(&args, 0, sizeof(args));
+  rb_Image_filter_matrix_anchor_parseargs(argc, argv, FALSE, &args.matrix, &args.anchor);
+
+  return rb_Image_defer(self, async_filter, &args);
+}
+
+VALUE rb_AsyncImage_filter_box(int argc, VALUE* argv, VALUE self) {
+  FutureArgs args;
+
+  memset(&args, 0, sizeof(args));
+  rb_Image_filter_size_anchor_parseargs(argc, argv, &args.size, &args.anchor);
+
+  return rb_Image_defer(self, async_filter_box, &args);
+}
+
+VALUE rb_AsyncImage_filter_min(int argc, VALUE* argv, VALUE self) {
+  FutureArgs args;
+
+  memset(&args, 0, sizeof(args));
+  rb_Image_filter_size_anchor_parseargs(argc, argv, &args.size, &args.anchor);
+
+  return rb_Image_defer(self, async_filter_min, &args);
+}
+
+VALUE rb_AsyncImage_filter_max(int argc, VALUE* argv, VALUE self) {
+  FutureArgs args;
+
+  memset(&args, 0, sizeof(args));
+  rb_Image_filter_size_anchor_parseargs(argc, argv, &args.size, &args.anchor);
+
+  return rb_Image_defer(self, async_filter_max, &args);
+}
+
+VALUE rb_AsyncImage_filter_median(int argc, VALUE* argv, VALUE self) {
+  FutureArgs args;
+
+  memset(&args, 0, sizeof(args));
+  rb_Image_filter_size_anchor_parseargs(argc, argv, &args.size, &args.anchor);
+
+  return rb_Image_defer(self, async_filter_median, &args);
+}
+
+VALUE rb_AsyncImage_filter_gauss(int argc, VALUE* argv, VALUE self) {
+  FutureArgs args;
+
+  memset(&args, 0, sizeof(args));
+  rb_Image_filter_gauss_parseargs(argc, argv, &args.maskSize);
+
+  return rb_Image_defer(self, async_filter_gauss, &args);
+}
+
+VALUE rb_AsyncImage_resize(int argc, VALUE* argv, VALUE self) {
+  FutureArgs args;
+
+  memset(&args, 0, sizeof(args));
+  rb_Image_resize_parseargs(argc, argv, &args.size, &args.mode);
+
+  return rb_Image_defer(self, async_resize, &args);
+}
+
+VALUE rb_AsyncImage_thumbnail(int argc, VALUE* argv, VALUE self) {
+  FutureArgs args;
+
+  memset(&args, 0, sizeof(args));
+  rb_Image_thumbnail_parseargs(argc, argv, &args.size);
+
+  return rb_Image_defer(self, async_thumbnail, &args);
+}
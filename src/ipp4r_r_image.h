@@ -201,6 +201,63 @@ VALUE rb_Image_metatype(VALUE self);
 VALUE rb_Image_convert(VALUE self, VALUE r_channels);
 
 
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#to_colorspace(ColorSpace space, DataType to = nil) </tt>
+ * </ul>
+ * 
+ * Converts an RGB image to the given color space, optionally changing its data type in the same pass. Space may also be given as a symbol, e.g. <tt>:lab</tt>.
+ * @returns a newly created image
+ */
+VALUE rb_Image_to_colorspace(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#from_colorspace(ColorSpace space, DataType to = nil) </tt>
+ * </ul>
+ * 
+ * Converts an image in the given color space back to RGB, optionally changing its data type in the same pass.
+ * @returns a newly created image
+ */
+VALUE rb_Image_from_colorspace(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#to_yuv420(Yuv420Format format = :i420) </tt>
+ * </ul>
+ * 
+ * @returns a string with YUV 4:2:0 representation of an image
+ */
+VALUE rb_Image_to_yuv420(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Singleton method:
+ * <ul>
+ * <li> <tt>Ipp::Image.from_yuv420(String data, Integer width, Integer height, Yuv420Format format = :i420) </tt>
+ * </ul>
+ * 
+ * @returns a newly created 8u_C3 image decoded from a YUV 4:2:0 string
+ */
+VALUE rb_Image_from_yuv420(int argc, VALUE* argv, VALUE klass);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#to_planar </tt>
+ * </ul>
+ * 
+ * @returns a newly created PlanarImage, P3 for C3 image and P4 for AC4 image
+ */
+VALUE rb_Image_to_planar(VALUE self);
+
+
 /**
  * Method:
  * <ul>
@@ -258,6 +315,18 @@ VALUE rb_Image_fill(VALUE self, VALUE color);
 VALUE rb_Image_transpose(VALUE self);
 
 
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#transpose! </tt>
+ * </ul>
+ * 
+ * Transposes an image in place. Non-square subimages cannot be transposed in place.
+ * @returns self
+ */
+VALUE rb_Image_transpose_bang(VALUE self);
+
+
 /**
  * Method:
  * <ul>
@@ -332,9 +401,10 @@ VALUE rb_Image_erode3x3_bang(VALUE self);
 /**
  * Method:
  * <ul>
- * <li> <tt>Ipp::Image#dilate(Matrix mask, Point anchor = maskSize / 2) </tt>
+ * <li> <tt>Ipp::Image#dilate(Mask mask, Point anchor = maskSize / 2) </tt>
  * </ul>
  *
+ * Mask may also be anything Ipp::Mask.new takes, e.g. a Matrix, in which case it's compiled on every call.
  * @returns a dilated copy of a source image
  */
 VALUE rb_Image_dilate(int argc, VALUE* argv, VALUE self);
@@ -343,7 +413,7 @@ VALUE rb_Image_dilate(int argc, VALUE* argv, VALUE self);
 /**
  * Method:
  * <ul>
- * <li> <tt>Ipp::Image#dilate!(Matrix mask, Point anchor = maskSize / 2) </tt>
+ * <li> <tt>Ipp::Image#dilate!(Mask mask, Point anchor = maskSize / 2) </tt>
  * </ul>
  *
  * @returns self
@@ -354,7 +424,7 @@ VALUE rb_Image_dilate_bang(int argc, VALUE* argv, VALUE self);
 /**
  * Method:
  * <ul>
- * <li> <tt>Ipp::Image#erode(Matrix mask, Point anchor = maskSize / 2) </tt>
+ * <li> <tt>Ipp::Image#erode(Mask mask, Point anchor = maskSize / 2) </tt>
  * </ul>
  *
  * @returns an eroded copy of a source image
@@ -365,7 +435,7 @@ VALUE rb_Image_erode(int argc, VALUE* argv, VALUE self);
 /**
  * Method:
  * <ul>
- * <li> <tt>Ipp::Image#erode!(Matrix mask, Point anchor = maskSize / 2) </tt>
+ * <li> <tt>Ipp::Image#erode!(Mask mask, Point anchor = maskSize / 2) </tt>
  * </ul>
  *
  * @returns self
@@ -448,10 +518,11 @@ VALUE rb_Image_filter_gauss(int argc, VALUE* argv, VALUE self);
 /**
  * Method:
  * <ul>
- * <li> <tt>Ipp::Image#filter(Matrix kernel, Point anchor = kernelSize / 2) </tt>
+ * <li> <tt>Ipp::Image#filter(Kernel kernel, Point anchor = kernelSize / 2) </tt>
  * </ul>
  *
  * Filters an image using a general rectangular kernel.
+ * Kernel may also be anything Ipp::Kernel.new takes, e.g. a Matrix, in which case it's compiled on every call.
  * @returns a newly created filtered image
  */
 VALUE rb_Image_filter(int argc, VALUE* argv, VALUE self);
@@ -495,11 +566,11 @@ VALUE rb_Image_border(VALUE self);
 /**
  * Method:
  * <ul>
- * <li> <tt>Ipp::Image#draw(Image src, Point pos = (0, 0)) </tt>
- * <li> <tt>Ipp::Image#draw(Image src, posX, posY) </tt> 
+ * <li> <tt>Ipp::Image#draw(Image src, Point pos = (0, 0), BlendMode mode = BlendCopy) </tt>
+ * <li> <tt>Ipp::Image#draw(Image src, posX, posY, BlendMode mode = BlendCopy) </tt> 
  * </ul>
  *
- * Draws the given image src on a copy of the current image
+ * Draws the given image src on a copy of the current image. Modes other than BlendCopy use the alpha channel of src.
  * @returns a newly created image with src drawn on it
  */
 VALUE rb_Image_draw(int argc, VALUE* argv, VALUE self);
@@ -508,11 +579,12 @@ VALUE rb_Image_draw(int argc, VALUE* argv, VALUE self);
 /**
  * Method:
  * <ul>
- * <li> <tt>Ipp::Image#draw!(Image src, Point pos = (0, 0)) </tt>
- * <li> <tt>Ipp::Image#draw!(Image src, posX, posY) </tt> 
+ * <li> <tt>Ipp::Image#draw!(Image src, Point pos = (0, 0), BlendMode mode = BlendCopy) </tt>
+ * <li> <tt>Ipp::Image#draw!(Image src, posX, posY, BlendMode mode = BlendCopy) </tt> 
  * </ul>
  *
- * Draws the given image src on the current image
+ * Draws the given image src on the current image. Modes other than BlendCopy use the alpha channel of src.
+ * Converted src is cached, so drawing the same sprite repeatedly is cheap.
  * @returns self
  */
 VALUE rb_Image_draw_bang(int argc, VALUE* argv, VALUE self);
@@ -545,11 +617,13 @@ VALUE rb_Image_draw_rotated(int argc, VALUE* argv, VALUE self);
 /**
  * Method:
  * <ul>
- * <li> <tt>Ipp::Image#resize(Size newSize) </tt>
- * <li> <tt>Ipp::Image#resize(newX, newY) </tt> 
+ * <li> <tt>Ipp::Image#resize(Size newSize, mode = ResizeCubic) </tt>
+ * <li> <tt>Ipp::Image#resize(newX, newY, mode = ResizeCubic) </tt> 
+ * <li> <tt>Ipp::Image#resize(newX, newY, :mode => mode) </tt> 
  * </ul>
  *
- * Resizes the given image
+ * Resizes the given image. Mode is either Ipp::ResizeMode or one of :nearest, :linear, :cubic, :lanczos, :area symbols.
+ * Resize plans are cached internally, so resizing many images of the same size is cheap.
  * @returns a newly created resized image
  */
 VALUE rb_Image_resize(int argc, VALUE* argv, VALUE self);
@@ -558,7 +632,7 @@ VALUE rb_Image_resize(int argc, VALUE* argv, VALUE self);
 /**
  * Method:
  * <ul>
- * <li> <tt>Ipp::Image#resize_factor(xFactor, yFactor) </tt>
+ * <li> <tt>Ipp::Image#resize_factor(xFactor, yFactor, mode = ResizeCubic) </tt>
  * </ul>
  *
  * Resizes the given image
@@ -567,6 +641,100 @@ VALUE rb_Image_resize(int argc, VALUE* argv, VALUE self);
 VALUE rb_Image_resize_factor(int argc, VALUE* argv, VALUE self);
 
 
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#thumbnail(Size maxSize) </tt>
+ * <li> <tt>Ipp::Image#thumbnail(maxX, maxY) </tt> 
+ * </ul>
+ *
+ * Downscales the given image to fit into the given size, preserving aspect ratio. Uses fast 2x box halving followed by a single Lanczos resample,
+ * which is both faster and less aliased than a direct resize for large scale factors.
+ * @returns a newly created image
+ */
+VALUE rb_Image_thumbnail(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#gaussian_pyramid(levels) </tt>
+ * </ul>
+ *
+ * Builds a Gaussian pyramid of the given image. Each level is blurred with a 5x5 binomial kernel and decimated by 2.
+ * All levels are subimages of a single newly allocated image, level 0 is a copy of the given image.
+ * @returns an array of <tt>levels</tt> images of the same metatype as the given one
+ */
+VALUE rb_Image_gaussian_pyramid(VALUE self, VALUE levels);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#laplacian_pyramid(levels) </tt>
+ * </ul>
+ *
+ * Builds a Laplacian pyramid of the given image. Each level is the difference between a Gaussian level and the expanded next one,
+ * the last level is a Gaussian level. All levels are subimages of a single newly allocated image.
+ * @returns an array of <tt>levels</tt> images of 32f metatype with the same channels as the given image
+ */
+VALUE rb_Image_laplacian_pyramid(VALUE self, VALUE levels);
+
+
+/**
+ * Singleton method:
+ * <ul>
+ * <li> <tt>Ipp::Image#reconstruct_laplacian(Array levels) </tt>
+ * </ul>
+ *
+ * Collapses a Laplacian pyramid, as returned by <tt>laplacian_pyramid</tt>, back into an image.
+ * @returns a newly created image of 32f metatype
+ */
+VALUE rb_Image_reconstruct_laplacian(VALUE klass, VALUE levels);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#warp_affine(Matrix transform, Size size = self.size, interp = InterpLinear, options = {}) </tt>
+ * </ul>
+ *
+ * Applies an affine transform, given as a 2x3 matrix that maps source coordinates to destination coordinates.
+ * Options are <tt>:interp</tt> and <tt>:border</tt>, see Ipp::RemapPlan. By default destination pixels that map outside of the given image are set to zero.
+ * To apply the same transform to many images, use Ipp::RemapPlan.
+ * @returns a newly created image
+ */
+VALUE rb_Image_warp_affine(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#warp_perspective(Matrix transform, Size size = self.size, interp = InterpLinear, options = {}) </tt>
+ * </ul>
+ *
+ * Applies a perspective transform, given as a 3x3 matrix that maps source coordinates to destination coordinates.
+ * Options are <tt>:interp</tt> and <tt>:border</tt>, see Ipp::RemapPlan. By default destination pixels that map outside of the given image are set to zero.
+ * To apply the same transform to many images, use Ipp::RemapPlan.
+ * @returns a newly created image
+ */
+VALUE rb_Image_warp_perspective(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#remap(Image mapX, Image mapY, interp = InterpLinear, border = BorderConstant) </tt>
+ * <li> <tt>Ipp::Image#remap(Image mapX, Image mapY, :interp => interp, :border => border) </tt>
+ * </ul>
+ *
+ * Samples the given image at arbitrary points, i.e. pixel (x, y) of the result is taken from (mapX[x, y], mapY[x, y]) of the given image.
+ * Maps are 32f_C1 images of the result size. To remap many images with the same maps, use Ipp::RemapPlan, which also stores maps in a compact form.
+ * @returns a newly created image
+ */
+VALUE rb_Image_remap(int argc, VALUE* argv, VALUE self);
+
+
 /**
  * Method:
  * <ul>
@@ -591,6 +759,402 @@ VALUE rb_Image_mirror(int argc, VALUE* argv, VALUE self);
 VALUE rb_Image_mirror_bang(int argc, VALUE* argv, VALUE self);
 
 
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#rotate90(k = 1) </tt>
+ * </ul>
+ *
+ * Rotates the given image k times by 90 degrees counterclockwise, negative k rotates clockwise
+ * @returns a newly created rotated image
+ */
+VALUE rb_Image_rotate90(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#rotate90!(k = 1) </tt>
+ * </ul>
+ *
+ * Rotates the given image k times by 90 degrees counterclockwise in place. Odd k requires a square image.
+ * @returns self
+ */
+VALUE rb_Image_rotate90_bang(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#normalize_orientation(exif) </tt>
+ * </ul>
+ *
+ * Brings an image with the given EXIF orientation tag (1..8) to normal orientation
+ * @returns a newly created image
+ */
+VALUE rb_Image_normalize_orientation(VALUE self, VALUE exif);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#normalize_orientation!(exif) </tt>
+ * </ul>
+ *
+ * Brings an image with the given EXIF orientation tag (1..8) to normal orientation in place. Tags 5..8 require a square image.
+ * @returns self
+ */
+VALUE rb_Image_normalize_orientation_bang(VALUE self, VALUE exif);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#apply_lut(LUT lut) </tt>
+ * <li> <tt>Ipp::Image#apply_lut(Array curve) </tt>
+ * </ul>
+ *
+ * Maps pixel values of an image through a lookup table
+ * @returns a newly created image
+ */
+VALUE rb_Image_apply_lut(VALUE self, VALUE lut);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#apply_lut!(LUT lut) </tt>
+ * <li> <tt>Ipp::Image#apply_lut!(Array curve) </tt>
+ * </ul>
+ *
+ * Maps pixel values of an image through a lookup table
+ * @returns self
+ */
+VALUE rb_Image_apply_lut_bang(VALUE self, VALUE lut);
+
+
+/**
+ * Methods:
+ * <ul>
+ * <li> <tt>Ipp::Image#add(Image other) </tt>
+ * <li> <tt>Ipp::Image#add(Color other) </tt>
+ * <li> <tt>Ipp::Image#add(Numeric other) </tt>
+ * <li> <tt>Ipp::Image#sub</tt>, <tt>Ipp::Image#mul</tt>, <tt>Ipp::Image#div</tt>, <tt>Ipp::Image#abs_diff</tt> with the same arguments
+ * </ul>
+ *
+ * Performs per-pixel arithmetic operation on pixel values normalized to [0, 1], saturating the result. Image operand must be of the same size,
+ * it's converted to the metatype of self if needed. Numeric operand is treated as a gray color.
+ * @returns a newly created image
+ */
+VALUE rb_Image_add(VALUE self, VALUE other);
+VALUE rb_Image_sub(VALUE self, VALUE other);
+VALUE rb_Image_mul(VALUE self, VALUE other);
+VALUE rb_Image_div(VALUE self, VALUE other);
+VALUE rb_Image_abs_diff(VALUE self, VALUE other);
+
+
+/**
+ * Methods:
+ * <ul>
+ * <li> <tt>Ipp::Image#add!(Image other) </tt>
+ * <li> <tt>Ipp::Image#add!(Color other) </tt>
+ * <li> <tt>Ipp::Image#add!(Numeric other) </tt>
+ * <li> <tt>Ipp::Image#sub!</tt>, <tt>Ipp::Image#mul!</tt>, <tt>Ipp::Image#div!</tt>, <tt>Ipp::Image#abs_diff!</tt> with the same arguments
+ * </ul>
+ *
+ * Performs per-pixel arithmetic operation in place.
+ * @returns self
+ */
+VALUE rb_Image_add_bang(VALUE self, VALUE other);
+VALUE rb_Image_sub_bang(VALUE self, VALUE other);
+VALUE rb_Image_mul_bang(VALUE self, VALUE other);
+VALUE rb_Image_div_bang(VALUE self, VALUE other);
+VALUE rb_Image_abs_diff_bang(VALUE self, VALUE other);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#add_weighted(Float alpha, other, Float beta, Float gamma = 0.0) </tt>
+ * </ul>
+ *
+ * Computes <tt>alpha * self + beta * other + gamma</tt>, where other is an Image, a Color or a Numeric.
+ * @returns a newly created image
+ */
+VALUE rb_Image_add_weighted(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#add_weighted!(Float alpha, other, Float beta, Float gamma = 0.0) </tt>
+ * </ul>
+ *
+ * Computes <tt>alpha * self + beta * other + gamma</tt> in place.
+ * @returns self
+ */
+VALUE rb_Image_add_weighted_bang(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#alpha_composite(Image src) </tt>
+ * </ul>
+ *
+ * Composites src over self using the alpha channel of src. Both images must be of the same size.
+ * @returns a newly created image
+ */
+VALUE rb_Image_alpha_composite(VALUE self, VALUE src);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#alpha_composite!(Image src) </tt>
+ * </ul>
+ *
+ * Composites src over self using the alpha channel of src. Both images must be of the same size.
+ * @returns self
+ */
+VALUE rb_Image_alpha_composite_bang(VALUE self, VALUE src);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image#async</tt>
+ * </ul>
+ *
+ * Methods of the returned proxy queue operations on the thread pool and return Ipp::Future objects at once, e.g. <tt>img.async.filter_median(size).value</tt>.
+ * Proxy holds a copy-on-write snapshot of the image, so later changes to the image don't affect it.
+ * @returns a new Ipp::Image::Async
+ * @see ipp4r_future.h
+ */
+VALUE rb_Image_async(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image::Async#convert(metatype)</tt>
+ * <li> <tt>Ipp::Image::Batch#convert(metatype)</tt>
+ * </ul>
+ *
+ * Queues conversion to the given metatype, see Image#convert.
+ * @returns a new Ipp::Future of the resulting image, or self for Batch
+ */
+VALUE rb_AsyncImage_convert(VALUE self, VALUE r_metatype);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image::Async#transpose</tt>
+ * <li> <tt>Ipp::Image::Batch#transpose</tt>
+ * </ul>
+ *
+ * Queues transposition, see Image#transpose.
+ * @returns a new Ipp::Future of the resulting image, or self for Batch
+ */
+VALUE rb_AsyncImage_transpose(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image::Async#mirror(Axis axis)</tt>
+ * <li> <tt>Ipp::Image::Batch#mirror(Axis axis)</tt>
+ * </ul>
+ *
+ * Queues mirroring, see Image#mirror.
+ * @returns a new Ipp::Future of the resulting image, or self for Batch
+ */
+VALUE rb_AsyncImage_mirror(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image::Async#rotate90(k = 1)</tt>
+ * <li> <tt>Ipp::Image::Batch#rotate90(k = 1)</tt>
+ * </ul>
+ *
+ * Queues rotation by quarter turns, see Image#rotate90.
+ * @returns a new Ipp::Future of the resulting image, or self for Batch
+ */
+VALUE rb_AsyncImage_rotate90(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image::Async#threshold(threshold, cmp = Ipp::LessThan, value = threshold)</tt>
+ * <li> <tt>Ipp::Image::Batch#threshold(threshold, cmp = Ipp::LessThan, value = threshold)</tt>
+ * </ul>
+ *
+ * Queues thresholding, see Image#threshold.
+ * @returns a new Ipp::Future of the resulting image, or self for Batch
+ */
+VALUE rb_AsyncImage_threshold(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image::Async#dilate3x3</tt>
+ * <li> <tt>Ipp::Image::Batch#dilate3x3</tt>
+ * </ul>
+ *
+ * Queues 3x3 dilation, see Image#dilate3x3.
+ * @returns a new Ipp::Future of the resulting image, or self for Batch
+ */
+VALUE rb_AsyncImage_dilate3x3(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image::Async#erode3x3</tt>
+ * <li> <tt>Ipp::Image::Batch#erode3x3</tt>
+ * </ul>
+ *
+ * Queues 3x3 erosion, see Image#erode3x3.
+ * @returns a new Ipp::Future of the resulting image, or self for Batch
+ */
+VALUE rb_AsyncImage_erode3x3(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image::Async#dilate(Mask mask, Point anchor = maskSize / 2)</tt>
+ * <li> <tt>Ipp::Image::Batch#dilate(Mask mask, Point anchor = maskSize / 2)</tt>
+ * </ul>
+ *
+ * Queues dilation, see Image#dilate.
+ * @returns a new Ipp::Future of the resulting image, or self for Batch
+ */
+VALUE rb_AsyncImage_dilate(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image::Async#erode(Mask mask, Point anchor = maskSize / 2)</tt>
+ * <li> <tt>Ipp::Image::Batch#erode(Mask mask, Point anchor = maskSize / 2)</tt>
+ * </ul>
+ *
+ * Queues erosion, see Image#erode.
+ * @returns a new Ipp::Future of the resulting image, or self for Batch
+ */
+VALUE rb_AsyncImage_erode(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image::Async#filter(Kernel kernel, Point anchor = kernelSize / 2)</tt>
+ * <li> <tt>Ipp::Image::Batch#filter(Kernel kernel, Point anchor = kernelSize / 2)</tt>
+ * </ul>
+ *
+ * Queues convolution with a kernel, see Image#filter.
+ * @returns a new Ipp::Future of the resulting image, or self for Batch
+ */
+VALUE rb_AsyncImage_filter(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image::Async#filter_box(size, anchor = {size.width / 2, size.height / 2})</tt>
+ * <li> <tt>Ipp::Image::Batch#filter_box(size, anchor = {size.width / 2, size.height / 2})</tt>
+ * </ul>
+ *
+ * Queues the box filter, see Image#filter_box.
+ * @returns a new Ipp::Future of the resulting image, or self for Batch
+ */
+VALUE rb_AsyncImage_filter_box(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image::Async#filter_min(size, anchor = {size.width / 2, size.height / 2})</tt>
+ * <li> <tt>Ipp::Image::Batch#filter_min(size, anchor = {size.width / 2, size.height / 2})</tt>
+ * </ul>
+ *
+ * Queues the min filter, see Image#filter_min.
+ * @returns a new Ipp::Future of the resulting image, or self for Batch
+ */
+VALUE rb_AsyncImage_filter_min(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image::Async#filter_max(size, anchor = {size.width / 2, size.height / 2})</tt>
+ * <li> <tt>Ipp::Image::Batch#filter_max(size, anchor = {size.width / 2, size.height / 2})</tt>
+ * </ul>
+ *
+ * Queues the max filter, see Image#filter_max.
+ * @returns a new Ipp::Future of the resulting image, or self for Batch
+ */
+VALUE rb_AsyncImage_filter_max(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image::Async#filter_median(size, anchor = {size.width / 2, size.height / 2})</tt>
+ * <li> <tt>Ipp::Image::Batch#filter_median(size, anchor = {size.width / 2, size.height / 2})</tt>
+ * </ul>
+ *
+ * Queues the median filter, see Image#filter_median.
+ * @returns a new Ipp::Future of the resulting image, or self for Batch
+ */
+VALUE rb_AsyncImage_filter_median(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image::Async#filter_gauss(MaskSize)</tt>
+ * <li> <tt>Ipp::Image::Batch#filter_gauss(MaskSize)</tt>
+ * </ul>
+ *
+ * Queues the gaussian filter, see Image#filter_gauss.
+ * @returns a new Ipp::Future of the resulting image, or self for Batch
+ */
+VALUE rb_AsyncImage_filter_gauss(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image::Async#resize(Size newSize, mode = ResizeCubic)</tt>
+ * <li> <tt>Ipp::Image::Batch#resize(Size newSize, mode = ResizeCubic)</tt>
+ * </ul>
+ *
+ * Queues resampling, see Image#resize.
+ * @returns a new Ipp::Future of the resulting image, or self for Batch
+ */
+VALUE rb_AsyncImage_resize(int argc, VALUE* argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::Image::Async#thumbnail(Size maxSize)</tt>
+ * <li> <tt>Ipp::Image::Batch#thumbnail(Size maxSize)</tt>
+ * </ul>
+ *
+ * Queues thumbnail generation, see Image#thumbnail.
+ * @returns a new Ipp::Future of the resulting image, or self for Batch
+ */
+VALUE rb_AsyncImage_thumbnail(int argc, VALUE* argv, VALUE self);
+
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,873 @@
+#include <assert.h>
+#include <math.h>
+#include "ipp4r.h"
+
+
+// -------------------------------------------------------------------------- //
+// Supplementary functions
+// -------------------------------------------------------------------------- //
+#define REMAP_CLAMP(I, N) ((I) < 0 ? 0 : (I) >= (N) ? (N) - 1 : (I))
+
+/** Source row Y, pSrc and srcStep must be in scope */
+#define REMAP_ROW(CTYPE, Y) ((const CTYPE*) ((const char*) pSrc + (Y) * srcStep))
+
+/** Tests whether a floating point source point lies outside of the source image. NaNs are outside too */
+#define REMAP_IS_OUTSIDE(X, Y, SIZE) (!((X) >= -0.5f && (Y) >= -0.5f && (X) < (SIZE).width - 0.5f && (Y) < (SIZE).height - 0.5f))
+
+/** Clamps a floating point coordinate to [0, N - 1], NaNs are clamped to 0 */
+#define REMAP_CLAMPF(V, N) ((V) >= 0.0f ? ((V) <= (N) - 1.0f ? (V) : (N) - 1.0f) : 0.0f)
+
+/**
+ * Handles destination pixels that map outside of the source, according to the plan border mode. Must be used inside a loop over destination pixels.
+ */
+#define REMAP_HANDLE_OUTSIDE(CNUMB)                                             \
+  {                                                                             \
+    if(plan->border == BORDER_CONSTANT)                                         \
+      for(c = 0; c < CNUMB; c++)                                                \
+        d[c] = 0;                                                               \
+    continue;                                                                   \
+  }
+
+/**
+ * Reads the source point of the x-th destination pixel from Ipp32f maps into sx and sy, clamping it for BORDER_REPLICATE. Must be used inside a loop over destination pixels.
+ */
+#define REMAP_FETCH(CNUMB)                                                      \
+  sx = mapX[x];                                                                 \
+  sy = mapY[x];                                                                 \
+  if(plan->border == BORDER_REPLICATE) {                                        \
+    sx = REMAP_CLAMPF(sx, plan->srcSize.width);                                 \
+    sy = REMAP_CLAMPF(sy, plan->srcSize.height);                                \
+  } else if(REMAP_IS_OUTSIDE(sx, sy, plan->srcSize))                            \
+    REMAP_HANDLE_OUTSIDE(CNUMB)
+
+#define REMAP_CUBIC_BITS 10     /**< Precision of fixed-point cubic weights */
+#define REMAP_FIXED_CHUNK 64    /**< Number of pixels gathered at once by chunked kernels that use fixed-point maps */
+
+/** Rounds a sum of fixed-point cubic taps of 8u values and saturates it to 8u */
+#define REMAP_CUBIC_SAT_8u(V) ((Ipp8u) ((V) <= 0 ? 0 : (V) >= (255 << (2 * REMAP_CUBIC_BITS)) ? 255 : ((V) + (1 << (2 * REMAP_CUBIC_BITS - 1))) >> (2 * REMAP_CUBIC_BITS)))
+
+static Ipp32s remapCubicTable[REMAP_FRAC_SIZE][4];
+static int remapCubicTableReady = FALSE;
+
+
+/**
+ * Computes weights of the Keys cubic filter (a = -0.5) for the four taps around a point with the given fractional offset.
+ */
+static void remap_cubic_weights(Ipp32f t, Ipp32f* w) {
+  w[0] = ((-0.5f * t + 1.0f) * t - 0.5f) * t;
+  w[1] = (1.5f * t - 2.5f) * t * t + 1.0f;
+  w[2] = ((-1.5f * t + 2.0f) * t + 0.5f) * t;
+  w[3] = (0.5f * t - 0.5f) * t * t;
+}
+
+
+/**
+ * Fills the table of fixed-point cubic weights. Weights for each subpixel position are adjusted to sum up exactly to 1 << REMAP_CUBIC_BITS.
+ */
+static void remap_cubic_table_init(void) {
+  int f, k, sum;
+  Ipp32f w[4];
+
+  if(remapCubicTableReady)
+    return;
+
+  for(f = 0; f < REMAP_FRAC_SIZE; f++) {
+    remap_cubic_weights((Ipp32f) f / REMAP_FRAC_SIZE, w);
+    for(k = 0, sum = 0; k < 4; k++)
+      sum += remapCubicTable[f][k] = (Ipp32s) floor(w[k] * (1 << REMAP_CUBIC_BITS) + 0.5);
+    remapCubicTable[f][1] += (1 << REMAP_CUBIC_BITS) - sum;
+  }
+  remapCubicTableReady = TRUE;
+}
+
+
+/**
+ * Inverts a 3x3 matrix.
+ *
+ * @returns FALSE if the matrix is singular, TRUE otherwise
+ */
+static int remap_invert(const double* m, double* inv) {
+  double det;
+  int i;
+
+  inv[0] = m[4] * m[8] - m[5] * m[7];
+  inv[1] = m[2] * m[7] - m[1] * m[8];
+  inv[2] = m[1] * m[5] - m[2] * m[4];
+  inv[3] = m[5] * m[6] - m[3] * m[8];
+  inv[4] = m[0] * m[8] - m[2] * m[6];
+  inv[5] = m[2] * m[3] - m[0] * m[5];
+  inv[6] = m[3] * m[7] - m[4] * m[6];
+  inv[7] = m[1] * m[6] - m[0] * m[7];
+  inv[8] = m[0] * m[4] - m[1] * m[3];
+
+  det = m[0] * inv[0] + m[1] * inv[3] + m[2] * inv[6];
+  if(fabs(det) < 1.0e-12)
+    return FALSE;
+
+  for(i = 0; i < 9; i++)
+    inv[i] /= det;
+  return TRUE;
+}
+
+
+DEFINE_D_SAT(remap_sat_, 8u, Ipp32f)
+DEFINE_D_SAT(remap_sat_, 16u, Ipp32f)
+DEFINE_D_SAT(remap_sat_, 16s, Ipp32f)
+DEFINE_D_SAT(remap_sat_, 32s, Ipp32f)
+
+#define remap_sat_32f(V) (V)
+#define remap_sat_64f(V) (V)
+
+
+// -------------------------------------------------------------------------- //
+// Kernels
+// -------------------------------------------------------------------------- //
+/** Remap kernel, remaps destination rows [y0, y1) */
+typedef void (*RemapFunc)(const RemapPlan* plan, const void* pSrc, int srcStep, void* pDst, int dstStep, int y0, int y1);
+
+/* Names of kernels that use fixed-point maps */
+#define REMAP_FIXED_KERNEL_NAME(INTERP, C, TIER) ARX_JOIN_3(ARX_JOIN_5(remap_fixed_, INTERP, _8u_, C, R), _, TIER)
+
+/**
+ * Tiers that change the code of kernels that use fixed-point maps, per interpolation mode and channels.
+ * Chunked kernels interpolate whole chunks with vectors, per-pixel ones are scalar on every tier.
+ */
+#define REMAP_FIXED_TIERS_nearest_C1  (1, (generic))
+#define REMAP_FIXED_TIERS_nearest_C3  (1, (generic))
+#define REMAP_FIXED_TIERS_nearest_AC4 (1, (generic))
+#define REMAP_FIXED_TIERS_nearest_C4  (1, (generic))
+#define REMAP_FIXED_TIERS_linear_C1   (4, (generic, sse4, avx2, avx512))
+#define REMAP_FIXED_TIERS_linear_C3   (4, (generic, sse4, avx2, avx512))
+#define REMAP_FIXED_TIERS_linear_AC4  (4, (generic, sse4, avx2, avx512))
+#define REMAP_FIXED_TIERS_linear_C4   (4, (generic, sse4, avx2, avx512))
+#define REMAP_FIXED_TIERS_cubic_C1    (1, (generic))
+#define REMAP_FIXED_TIERS_cubic_C3    (1, (generic))
+#define REMAP_FIXED_TIERS_cubic_AC4   (4, (generic, sse4, avx2, avx512))
+#define REMAP_FIXED_TIERS_cubic_C4    (4, (generic, sse4, avx2, avx512))
+#define REMAP_FIXED_TIERS(INTERP, C) ARX_JOIN_4(REMAP_FIXED_TIERS_, INTERP, _, C)
+
+/**
+ * Cubic kernels of 4-channel pixels are chunked, gathering 16 taps per value costs less than the scalar sums they replace.
+ * With fewer channels the gather costs more, so they stay per-pixel.
+ */
+#define REMAP_FIXED_CUBIC_C1  DEFINE_REMAP_FIXED_CUBIC_PIXEL
+#define REMAP_FIXED_CUBIC_C3  DEFINE_REMAP_FIXED_CUBIC_PIXEL
+#define REMAP_FIXED_CUBIC_AC4 DEFINE_REMAP_FIXED_CUBIC_CHUNK
+#define REMAP_FIXED_CUBIC_C4  DEFINE_REMAP_FIXED_CUBIC_CHUNK
+
+/**
+ * Gathers a destination pixel that maps outside of the source into the values of a chunk starting at index e, as the CENTER tap of TAPS
+ * holding the value the border mode leaves in the destination. WEIGHTS statement gives that tap the full weight, which interpolates to it exactly.
+ * Must be used inside a loop over pixels of a chunk.
+ */
+#define REMAP_GATHER_OUTSIDE(CNUMB, TAPS, CENTER, WEIGHTS)                      \
+  {                                                                             \
+    for(c = 0; c < CNUMB; c++, e++) {                                           \
+      for(k = 0; k < TAPS; k++)                                                 \
+        t[k][e] = 0;                                                            \
+      if(plan->border != BORDER_CONSTANT)                                       \
+        t[CENTER][e] = d[e];                                                    \
+      WEIGHTS                                                                   \
+    }                                                                           \
+    continue;                                                                   \
+  }
+
+/**
+ * Defines kernels <tt>remap_fixed_INTERP_8u_CHANNELSR_TIER</tt> that use fixed-point maps, for the interpolation modes TIER is listed for.
+ * All channels, including alpha, are interpolated.
+ * Chunked kernels gather taps and weights of REMAP_FIXED_CHUNK pixels of a row first, and then interpolate all of their values in one loop.
+ */
+#define DEFINE_REMAP_FIXED_KERNELS(C, TIER)                                     \
+  ARX_IF(DISPATCH_HAS_TIER(REMAP_FIXED_TIERS(nearest, C), TIER), DEFINE_REMAP_FIXED_NEAREST, ARX_TUPLE_EAT_3)(C, TIER, C_CNUMB(C)) \
+  ARX_IF(DISPATCH_HAS_TIER(REMAP_FIXED_TIERS(linear, C), TIER), DEFINE_REMAP_FIXED_LINEAR, ARX_TUPLE_EAT_3)(C, TIER, C_CNUMB(C)) \
+  ARX_IF(DISPATCH_HAS_TIER(REMAP_FIXED_TIERS(cubic, C), TIER), ARX_JOIN(REMAP_FIXED_CUBIC_, C), ARX_TUPLE_EAT_3)(C, TIER, C_CNUMB(C))
+#define DEFINE_REMAP_FIXED_NEAREST(C, TIER, CNUMB)                              \
+DISPATCH_TARGET(TIER) static void REMAP_FIXED_KERNEL_NAME(nearest, C, TIER)(const RemapPlan* plan, const void* pSrc, int srcStep, void* pDst, int dstStep, int y0, int y1) { \
+  int x, y, c;                                                                  \
+  const Ipp16s* xy;                                                             \
+  const Ipp8u* s;                                                               \
+  Ipp8u* d;                                                                     \
+                                                                                \
+  for(y = y0; y < y1; y++) {                                                    \
+    xy = plan->mapFixed + 2 * y * plan->dstSize.width;                          \
+    d = (Ipp8u*) ((char*) pDst + y * dstStep);                                  \
+    for(x = 0; x < plan->dstSize.width; x++, xy += 2, d += CNUMB) {             \
+      if(xy[0] == REMAP_OUTSIDE)                                                \
+        REMAP_HANDLE_OUTSIDE(CNUMB)                                             \
+      s = REMAP_ROW(Ipp8u, xy[1]) + xy[0] * CNUMB;                              \
+      for(c = 0; c < CNUMB; c++)                                                \
+        d[c] = s[c];                                                            \
+    }                                                                           \
+  }                                                                             \
+}
+#define DEFINE_REMAP_FIXED_LINEAR(C, TIER, CNUMB)                               \
+DISPATCH_TARGET(TIER) static void REMAP_FIXED_KERNEL_NAME(linear, C, TIER)(const RemapPlan* plan, const void* pSrc, int srcStep, void* pDst, int dstStep, int y0, int y1) { \
+  int x, y, c, i, k, e, n, x0, x1, fx, fy;                                      \
+  const Ipp16s* xy;                                                             \
+  const Ipp16u* frac;                                                           \
+  const Ipp8u* s0;                                                              \
+  const Ipp8u* s1;                                                              \
+  Ipp8u* d;                                                                     \
+  Ipp8u t[4][REMAP_FIXED_CHUNK * CNUMB];                                        \
+  Ipp16u wx[REMAP_FIXED_CHUNK * CNUMB];                                         \
+  Ipp16u wy[REMAP_FIXED_CHUNK * CNUMB];                                         \
+                                                                                \
+  for(y = y0; y < y1; y++) {                                                    \
+    xy = plan->mapFixed + 2 * y * plan->dstSize.width;                          \
+    frac = plan->mapFrac + y * plan->dstSize.width;                             \
+    d = (Ipp8u*) ((char*) pDst + y * dstStep);                                  \
+    for(x = 0; x < plan->dstSize.width; x += n, d += n * CNUMB) {               \
+      n = min(REMAP_FIXED_CHUNK, plan->dstSize.width - x);                      \
+      for(i = 0, e = 0; i < n; i++, xy += 2, frac++) {                          \
+        if(xy[0] == REMAP_OUTSIDE)                                              \
+          REMAP_GATHER_OUTSIDE(CNUMB, 4, 0, wx[e] = wy[e] = 0;)                 \
+        fx = *frac & (REMAP_FRAC_SIZE - 1);                                     \
+        fy = *frac >> REMAP_FRAC_BITS;                                          \
+        x0 = REMAP_CLAMP(xy[0], plan->srcSize.width) * CNUMB;                   \
+        x1 = REMAP_CLAMP(xy[0] + 1, plan->srcSize.width) * CNUMB;               \
+        s0 = REMAP_ROW(Ipp8u, REMAP_CLAMP(xy[1], plan->srcSize.height));        \
+        s1 = REMAP_ROW(Ipp8u, REMAP_CLAMP(xy[1] + 1, plan->srcSize.height));    \
+        for(c = 0; c < CNUMB; c++, e++) {                                       \
+          t[0][e] = s0[x0 + c];                                                 \
+          t[1][e] = s0[x1 + c];                                                 \
+          t[2][e] = s1[x0 + c];                                                 \
+          t[3][e] = s1[x1 + c];                                                 \
+          wx[e] = (Ipp16u) fx;                                                  \
+          wy[e] = (Ipp16u) fy;                                                  \
+        }                                                                       \
+      }                                                                         \
+      for(e = 0; e < n * CNUMB; e++)                                            \
+        d[e] = (Ipp8u) (((t[0][e] * (REMAP_FRAC_SIZE - wx[e]) + t[1][e] * wx[e]) * (REMAP_FRAC_SIZE - wy[e]) + \
+                         (t[2][e] * (REMAP_FRAC_SIZE - wx[e]) + t[3][e] * wx[e]) * wy[e] + \
+                         (1 << (2 * REMAP_FRAC_BITS - 1))) >> (2 * REMAP_FRAC_BITS)); \
+    }                                                                           \
+  }                                                                             \
+}
+#define DEFINE_REMAP_FIXED_CUBIC_PIXEL(C, TIER, CNUMB)                          \
+DISPATCH_TARGET(TIER) static void REMAP_FIXED_KERNEL_NAME(cubic, C, TIER)(const RemapPlan* plan, const void* pSrc, int srcStep, void* pDst, int dstStep, int y0, int y1) { \
+  int x, y, c, k, v;                                                            \
+  int xs[4];                                                                    \
+  const Ipp32s* wx;                                                             \
+  const Ipp32s* wy;                                                             \
+  const Ipp16s* xy;                                                             \
+  const Ipp16u* frac;                                                           \
+  const Ipp8u* s[4];                                                            \
+  Ipp8u* d;                                                                     \
+                                                                                \
+  for(y = y0; y < y1; y++) {                                                    \
+    xy = plan->mapFixed + 2 * y * plan->dstSize.width;                          \
+    frac = plan->mapFrac + y * plan->dstSize.width;                             \
+    d = (Ipp8u*) ((char*) pDst + y * dstStep);                                  \
+    for(x = 0; x < plan->dstSize.width; x++, xy += 2, frac++, d += CNUMB) {     \
+      if(xy[0] == REMAP_OUTSIDE)                                                \
+        REMAP_HANDLE_OUTSIDE(CNUMB)                                             \
+      wx = remapCubicTable[*frac & (REMAP_FRAC_SIZE - 1)];                      \
+      wy = remapCubicTable[*frac >> REMAP_FRAC_BITS];                           \
+      for(k = 0; k < 4; k++) {                                                  \
+        xs[k] = REMAP_CLAMP(xy[0] - 1 + k, plan->srcSize.width) * CNUMB;        \
+        s[k] = REMAP_ROW(Ipp8u, REMAP_CLAMP(xy[1] - 1 + k, plan->srcSize.height)); \
+      }                                                                         \
+      for(c = 0; c < CNUMB; c++) {                                              \
+        for(k = 0, v = 0; k < 4; k++)                                           \
+          v += (s[k][xs[0] + c] * wx[0] + s[k][xs[1] + c] * wx[1] + s[k][xs[2] + c] * wx[2] + s[k][xs[3] + c] * wx[3]) * wy[k]; \
+        d[c] = REMAP_CUBIC_SAT_8u(v);                                           \
+      }                                                                         \
+    }                                                                           \
+  }                                                                             \
+}
+#define DEFINE_REMAP_FIXED_CUBIC_CHUNK(C, TIER, CNUMB)                          \
+DISPATCH_TARGET(TIER) static void REMAP_FIXED_KERNEL_NAME(cubic, C, TIER)(const RemapPlan* plan, const void* pSrc, int srcStep, void* pDst, int dstStep, int y0, int y1) { \
+  int x, y, c, i, j, k, e, n, v;                                                \
+  int xs[4];                                                                    \
+  const Ipp32s* px;                                                             \
+  const Ipp32s* py;                                                             \
+  const Ipp16s* xy;                                                             \
+  const Ipp16u* frac;                                                           \
+  const Ipp8u* s[4];                                                            \
+  Ipp8u* d;                                                                     \
+  Ipp8u t[16][REMAP_FIXED_CHUNK * CNUMB];                                       \
+  Ipp16s wx[4][REMAP_FIXED_CHUNK * CNUMB];                                      \
+  Ipp16s wy[4][REMAP_FIXED_CHUNK * CNUMB];                                      \
+                                                                                \
+  for(y = y0; y < y1; y++) {                                                    \
+    xy = plan->mapFixed + 2 * y * plan->dstSize.width;                          \
+    frac = plan->mapFrac + y * plan->dstSize.width;                             \
+    d = (Ipp8u*) ((char*) pDst + y * dstStep);                                  \
+    for(x = 0; x < plan->dstSize.width; x += n, d += n * CNUMB) {               \
+      n = min(REMAP_FIXED_CHUNK, plan->dstSize.width - x);                      \
+      for(i = 0, e = 0; i < n; i++, xy += 2, frac++) {                          \
+        if(xy[0] == REMAP_OUTSIDE)                                              \
+          REMAP_GATHER_OUTSIDE(CNUMB, 16, 5, for(k = 0; k < 4; k++) wx[k][e] = wy[k][e] = (Ipp16s) (k == 1 ? 1 << REMAP_CUBIC_BITS : 0);) \
+        px = remapCubicTable[*frac & (REMAP_FRAC_SIZE - 1)];                    \
+        py = remapCubicTable[*frac >> REMAP_FRAC_BITS];                         \
+        for(k = 0; k < 4; k++) {                                                \
+          xs[k] = REMAP_CLAMP(xy[0] - 1 + k, plan->srcSize.width) * CNUMB;      \
+          s[k] = REMAP_ROW(Ipp8u, REMAP_CLAMP(xy[1] - 1 + k, plan->srcSize.height)); \
+        }                                                                       \
+        for(c = 0; c < CNUMB; c++, e++) {                                       \
+          for(k = 0; k < 4; k++) {                                              \
+            for(j = 0; j < 4; j++)                                              \
+              t[4 * k + j][e] = s[k][xs[j] + c];                                \
+            wx[k][e] = (Ipp16s) px[k];                                          \
+            wy[k][e] = (Ipp16s) py[k];                                          \
+          }                                                                     \
+        }                                                                       \
+      }                                                                         \
+      for(e = 0; e < n * CNUMB; e++) {                                          \
+        for(k = 0, v = 0; k < 4; k++)                                           \
+          v += (t[4 * k][e] * wx[0][e] + t[4 * k + 1][e] * wx[1][e] + t[4 * k + 2][e] * wx[2][e] + t[4 * k + 3][e] * wx[3][e]) * wy[k][e]; \
+        d[e] = REMAP_CUBIC_SAT_8u(v);                                           \
+      }                                                                         \
+    }                                                                           \
+  }                                                                             \
+}
+
+/**
+ * Defines kernels and kernel arrays <tt>remap_fixed_INTERP_kernels_TIER</tt> for TIER, with entries for 8u metatypes only.
+ * Entries of interpolation modes that TIER isn't listed for are the kernels of the tier below.
+ */
+#define DEFINE_REMAP_FIXED_KERNEL_ARRAYS(TIER, ARG)                             \
+  ARX_ARRAY_FOREACH(C_SUPPORTED, DEFINE_REMAP_FIXED_KERNELS, TIER)              \
+  DEFINE_DISPATCH_KERNELS(ARX_JOIN(remap_fixed_nearest_kernels_, TIER), M_SUPPORTED, REMAP_FIXED_KERNEL, (nearest, TIER)) \
+  DEFINE_DISPATCH_KERNELS(ARX_JOIN(remap_fixed_linear_kernels_, TIER), M_SUPPORTED, REMAP_FIXED_KERNEL, (linear, TIER)) \
+  DEFINE_DISPATCH_KERNELS(ARX_JOIN(remap_fixed_cubic_kernels_, TIER), M_SUPPORTED, REMAP_FIXED_KERNEL, (cubic, TIER))
+#define REMAP_FIXED_KERNEL(M, ARGS) REMAP_FIXED_KERNEL_I(M, ARX_TUPLE_ELEM(2, 0, ARGS), ARX_TUPLE_ELEM(2, 1, ARGS))
+#define REMAP_FIXED_KERNEL_I(M, INTERP, TIER)                                   \
+  IF_M_IS_D(M, 8u, REMAP_FIXED_KERNEL_NAME(INTERP, M_CHANNELS(M), DISPATCH_TIER_FLOOR(REMAP_FIXED_TIERS(INTERP, M_CHANNELS(M)), TIER)), NULL)
+
+ARX_ARRAY_FOREACH(DISPATCH_TIERS, DEFINE_REMAP_FIXED_KERNEL_ARRAYS, ~)
+
+DEFINE_DISPATCH_TIERED_TABLE(remap_fixed_nearest_table, "remap_fixed_nearest", remap_fixed_nearest_kernels)
+DEFINE_DISPATCH_TIERED_TABLE(remap_fixed_linear_table, "remap_fixed_linear", remap_fixed_linear_kernels)
+DEFINE_DISPATCH_TIERED_TABLE(remap_fixed_cubic_table, "remap_fixed_cubic", remap_fixed_cubic_kernels)
+
+
+/**
+ * Defines kernels <tt>remap_INTERP_DATATYPE_CHANNELSR</tt> that use Ipp32f maps. All channels, including alpha, are interpolated.
+ */
+#define DEFINE_REMAP_KERNELS(METATYPE, ARG)                                     \
+  DEFINE_REMAP_KERNELS_I(M_DATATYPE(METATYPE), M_CHANNELS(METATYPE), D_CTYPE(M_DATATYPE(METATYPE)), C_CNUMB(M_CHANNELS(METATYPE)))
+#define DEFINE_REMAP_KERNELS_I(D, C, CTYPE, CNUMB)                              \
+static void ARX_JOIN_5(remap_nearest_, D, _, C, R)(const RemapPlan* plan, const void* pSrc, int srcStep, void* pDst, int dstStep, int y0, int y1) { \
+  int x, y, c;                                                                  \
+  Ipp32f sx, sy;                                                                \
+  const Ipp32f* mapX;                                                           \
+  const Ipp32f* mapY;                                                           \
+  const CTYPE* s;                                                               \
+  CTYPE* d;                                                                     \
+                                                                                \
+  for(y = y0; y < y1; y++) {                                                    \
+    mapX = (const Ipp32f*) ((const char*) plan->mapX + y * plan->mapXStep);     \
+    mapY = (const Ipp32f*) ((const char*) plan->mapY + y * plan->mapYStep);     \
+    d = (CTYPE*) ((char*) pDst + y * dstStep);                                  \
+    for(x = 0; x < plan->dstSize.width; x++, d += CNUMB) {                      \
+      REMAP_FETCH(CNUMB)                                                        \
+      s = REMAP_ROW(CTYPE, (int) (sy + 0.5f)) + (int) (sx + 0.5f) * CNUMB;      \
+      for(c = 0; c < CNUMB; c++)                                                \
+        d[c] = s[c];                                                            \
+    }                                                                           \
+  }                                                                             \
+}                                                                               \
+                                                                                \
+static void ARX_JOIN_5(remap_linear_, D, _, C, R)(const RemapPlan* plan, const void* pSrc, int srcStep, void* pDst, int dstStep, int y0, int y1) { \
+  int x, y, c, ix, iy, x0, x1;                                                  \
+  Ipp32f sx, sy, fx, fy;                                                        \
+  const Ipp32f* mapX;                                                           \
+  const Ipp32f* mapY;                                                           \
+  const CTYPE* s0;                                                              \
+  const CTYPE* s1;                                                              \
+  CTYPE* d;                                                                     \
+                                                                                \
+  for(y = y0; y < y1; y++) {                                                    \
+    mapX = (const Ipp32f*) ((const char*) plan->mapX + y * plan->mapXStep);     \
+    mapY = (const Ipp32f*) ((const char*) plan->mapY + y * plan->mapYStep);     \
+    d = (CTYPE*) ((char*) pDst + y * dstStep);                                  \
+    for(x = 0; x < plan->dstSize.width; x++, d += CNUMB) {                      \
+      REMAP_FETCH(CNUMB)                                                        \
+      ix = (int) (sx + 1.0f) - 1;                                               \
+      iy = (int) (sy + 1.0f) - 1;                                               \
+      fx = sx - ix;                                                             \
+      fy = sy - iy;                                                             \
+      x0 = REMAP_CLAMP(ix, plan->srcSize.width) * CNUMB;                        \
+      x1 = REMAP_CLAMP(ix + 1, plan->srcSize.width) * CNUMB;                    \
+      s0 = REMAP_ROW(CTYPE, REMAP_CLAMP(iy, plan->srcSize.height));             \
+      s1 = REMAP_ROW(CTYPE, REMAP_CLAMP(iy + 1, plan->srcSize.height));         \
+      for(c = 0; c < CNUMB; c++)                                                \
+        d[c] = ARX_JOIN(remap_sat_, D)((s0[x0 + c] * (1.0f - fx) + s0[x1 + c] * fx) * (1.0f - fy) + (s1[x0 + c] * (1.0f - fx) + s1[x1 + c] * fx) * fy); \
+    }                                                                           \
+  }                                                                             \
+}                                                                               \
+                                                                                \
+static void ARX_JOIN_5(remap_cubic_, D, _, C, R)(const RemapPlan* plan, const void* pSrc, int srcStep, void* pDst, int dstStep, int y0, int y1) { \
+  int x, y, c, k, ix, iy;                                                       \
+  int xs[4];                                                                    \
+  Ipp32f sx, sy, v;                                                             \
+  Ipp32f wx[4], wy[4];                                                          \
+  const Ipp32f* mapX;                                                           \
+  const Ipp32f* mapY;                                                           \
+  const CTYPE* s[4];                                                            \
+  CTYPE* d;                                                                     \
+                                                                                \
+  for(y = y0; y < y1; y++) {                                                    \
+    mapX = (const Ipp32f*) ((const char*) plan->mapX + y * plan->mapXStep);     \
+    mapY = (const Ipp32f*) ((const char*) plan->mapY + y * plan->mapYStep);     \
+    d = (CTYPE*) ((char*) pDst + y * dstStep);                                  \
+    for(x = 0; x < plan->dstSize.width; x++, d += CNUMB) {                      \
+      REMAP_FETCH(CNUMB)                                                        \
+      ix = (int) (sx + 1.0f) - 1;                                               \
+      iy = (int) (sy + 1.0f) - 1;                                               \
+      remap_cubic_weights(sx - ix, wx);                                         \
+      remap_cubic_weights(sy - iy, wy);                                         \
+      for(k = 0; k < 4; k++) {                                                  \
+        xs[k] = REMAP_CLAMP(ix - 1 + k, plan->srcSize.width) * CNUMB;           \
+        s[k] = REMAP_ROW(CTYPE, REMAP_CLAMP(iy - 1 + k, plan->srcSize.height)); \
+      }                                                                         \
+      for(c = 0; c < CNUMB; c++) {                                              \
+        for(k = 0, v = 0.0f; k < 4; k++)                                        \
+          v += (s[k][xs[0] + c] * wx[0] + s[k][xs[1] + c] * wx[1] + s[k][xs[2] + c] * wx[2] + s[k][xs[3] + c] * wx[3]) * wy[k]; \
+        d[c] = ARX_JOIN(remap_sat_, D)(v);                                      \
+      }                                                                         \
+    }                                                                           \
+  }                                                                             \
+}
+
+#define REMAP_NEAREST_KERNEL(M) ARX_JOIN_5(remap_nearest_, M_DATATYPE(M), _, M_CHANNELS(M), R)
+#define REMAP_LINEAR_KERNEL(M) ARX_JOIN_5(remap_linear_, M_DATATYPE(M), _, M_CHANNELS(M), R)
+#define REMAP_CUBIC_KERNEL(M) ARX_JOIN_5(remap_cubic_, M_DATATYPE(M), _, M_CHANNELS(M), R)
+
+ARX_ARRAY_FOREACH(M_SUPPORTED, DEFINE_REMAP_KERNELS, ~)
+DEFINE_METATABLE_VALUES(RemapFunc, remap_nearest_table, M_SUPPORTED, REMAP_NEAREST_KERNEL)
+DEFINE_METATABLE_VALUES(RemapFunc, remap_linear_table, M_SUPPORTED, REMAP_LINEAR_KERNEL)
+DEFINE_METATABLE_VALUES(RemapFunc, remap_cubic_table, M_SUPPORTED, REMAP_CUBIC_KERNEL)
+
+/** Kernel tables of fixed-point and Ipp32f maps, indexed by InterpMode */
+static DispatchTable* const remap_fixed_tables[] = {&remap_fixed_nearest_table, &remap_fixed_linear_table, &remap_fixed_cubic_table};
+static const RemapFunc* const remap_tables[] = {remap_nearest_table, remap_linear_table, remap_cubic_table};
+
+
+/** Arguments of the row loop of remap_plan_apply, shared by its tiles */
+typedef struct {
+  RemapFunc kernel;
+  RemapPlan* plan;
+  const void* pSrc;
+  int srcStep;
+  void* pDst;
+  int dstStep;
+} RemapTile;
+
+
+/**
+ * Remaps destination rows [y0, y1). Tile function for pool_parallel_for.
+ */
+static void remap_plan_apply_tile(void* arg, int y0, int y1) {
+  RemapTile* t = (RemapTile*) arg;
+
+  t->kernel(t->plan, t->pSrc, t->srcStep, t->pDst, t->dstStep, y0, y1);
+}
+
+
+/**
+ * Allocates a plan and its maps. Fixed-point maps are used only if requested, and only for 8u images that fit into Ipp16s coordinates.
+ * For REMAP_MAPS_BORROWED no maps are allocated.
+ */
+static RemapPlan* remap_plan_alloc(IppiSize srcSize, IppiSize dstSize, IppMetaType metaType, InterpMode interp, BorderMode border, RemapMapFormat format) {
+  RemapPlan* plan;
+  int n;
+
+  plan = (RemapPlan*) malloc(sizeof(RemapPlan));
+  if(plan == NULL)
+    return NULL;
+
+  plan->srcSize = srcSize;
+  plan->dstSize = dstSize;
+  plan->metaType = metaType;
+  plan->interp = interp;
+  plan->border = border;
+  plan->ownsMaps = format != REMAP_MAPS_BORROWED;
+  plan->mapFixed = NULL;
+  plan->mapFrac = NULL;
+  plan->mapX = NULL;
+  plan->mapY = NULL;
+  plan->mapXStep = plan->mapYStep = dstSize.width * sizeof(Ipp32f);
+
+  n = dstSize.width * dstSize.height;
+  if(format == REMAP_MAPS_BORROWED)
+    ; /* nothing to allocate */
+  else if(format == REMAP_MAPS_FIXED && metatype_datatype(metaType) == ipp8u && srcSize.width <= REMAP_FIXED_MAX && srcSize.height <= REMAP_FIXED_MAX) {
+    remap_cubic_table_init();
+    plan->mapFixed = (Ipp16s*) malloc(2 * n * sizeof(Ipp16s));
+    plan->mapFrac = (Ipp16u*) malloc(n * sizeof(Ipp16u));
+    if(plan->mapFixed == NULL || plan->mapFrac == NULL) {
+      remap_plan_destroy(plan);
+      return NULL;
+    }
+  } else {
+    plan->mapX = (Ipp32f*) malloc(n * sizeof(Ipp32f));
+    plan->mapY = (Ipp32f*) malloc(n * sizeof(Ipp32f));
+    if(plan->mapX == NULL || plan->mapY == NULL) {
+      remap_plan_destroy(plan);
+      return NULL;
+    }
+  }
+
+  return plan;
+}
+
+
+/**
+ * Stores a source point for the i-th destination pixel into plan maps.
+ */
+static void remap_plan_store(RemapPlan* plan, int i, double sx, double sy) {
+  int fx, fy;
+
+  if(plan->mapX != NULL) {
+    plan->mapX[i] = (Ipp32f) sx;
+    plan->mapY[i] = (Ipp32f) sy;
+    return;
+  }
+
+  if(plan->border == BORDER_REPLICATE) {
+    sx = REMAP_CLAMPF(sx, plan->srcSize.width);
+    sy = REMAP_CLAMPF(sy, plan->srcSize.height);
+  }
+
+  if(REMAP_IS_OUTSIDE(sx, sy, plan->srcSize)) {
+    plan->mapFixed[2 * i] = REMAP_OUTSIDE;
+    plan->mapFixed[2 * i + 1] = 0;
+    plan->mapFrac[i] = 0;
+  } else if(plan->interp == INTERP_NEAREST) {
+    plan->mapFixed[2 * i] = (Ipp16s) floor(sx + 0.5);
+    plan->mapFixed[2 * i + 1] = (Ipp16s) floor(sy + 0.5);
+    plan->mapFrac[i] = 0;
+  } else {
+    /* Round to the subpixel grid first, so that the integer and fractional parts stay consistent. Both are >= -REMAP_FRAC_SIZE / 2 here. */
+    fx = (int) floor(sx * REMAP_FRAC_SIZE + 0.5) + REMAP_FRAC_SIZE;
+    fy = (int) floor(sy * REMAP_FRAC_SIZE + 0.5) + REMAP_FRAC_SIZE;
+    plan->mapFixed[2 * i] = (Ipp16s) ((fx >> REMAP_FRAC_BITS) - 1);
+    plan->mapFixed[2 * i + 1] = (Ipp16s) ((fy >> REMAP_FRAC_BITS) - 1);
+    plan->mapFrac[i] = (Ipp16u) (((fy & (REMAP_FRAC_SIZE - 1)) << REMAP_FRAC_BITS) | (fx & (REMAP_FRAC_SIZE - 1)));
+  }
+}
+
+
+// -------------------------------------------------------------------------- //
+// remap_plan_new_transform
+// -------------------------------------------------------------------------- //
+int remap_plan_new_transform(RemapPlan** dst, IppiSize srcSize, IppiSize dstSize, IppMetaType metaType, const double* coeffs, InterpMode interp, BorderMode border) {
+  RemapPlan* plan;
+  double m[9];
+  double w;
+  int x, y, i;
+
+  assert(dst != NULL && coeffs != NULL);
+  assert(srcSize.width > 0 && srcSize.height > 0 && dstSize.width > 0 && dstSize.height > 0);
+
+  /* Maps go from destination to source, hence the inverse. */
+  if(!remap_invert(coeffs, m))
+    return ippStsCoeffErr;
+
+  plan = remap_plan_alloc(srcSize, dstSize, metaType, interp, border, REMAP_MAPS_FIXED);
+  if(plan == NULL)
+    return ippStsNoMemErr;
+
+  for(y = 0, i = 0; y < dstSize.height; y++) {
+    for(x = 0; x < dstSize.width; x++, i++) {
+      w = m[6] * x + m[7] * y + m[8];
+      if(w > 1.0e-12)
+        remap_plan_store(plan, i, (m[0] * x + m[1] * y + m[2]) / w, (m[3] * x + m[4] * y + m[5]) / w);
+      else
+        remap_plan_store(plan, i, REMAP_OUTSIDE, REMAP_OUTSIDE); /* point at infinity or behind the camera */
+    }
+  }
+
+  *dst = plan;
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// remap_plan_new_maps
+// -------------------------------------------------------------------------- //
+int remap_plan_new_maps(RemapPlan** dst, IppiSize srcSize, IppiSize dstSize, IppMetaType metaType, const Ipp32f* mapX, int mapXStep, const Ipp32f* mapY, int mapYStep, InterpMode interp, BorderMode border, RemapMapFormat format) {
+  RemapPlan* plan;
+  const Ipp32f* sx;
+  const Ipp32f* sy;
+  int x, y, i;
+
+  assert(dst != NULL && mapX != NULL && mapY != NULL);
+  assert(srcSize.width > 0 && srcSize.height > 0 && dstSize.width > 0 && dstSize.height > 0);
+
+  plan = remap_plan_alloc(srcSize, dstSize, metaType, interp, border, format);
+  if(plan == NULL)
+    return ippStsNoMemErr;
+
+  if(format == REMAP_MAPS_BORROWED) {
+    plan->mapX = (Ipp32f*) mapX;
+    plan->mapY = (Ipp32f*) mapY;
+    plan->mapXStep = mapXStep;
+    plan->mapYStep = mapYStep;
+  } else {
+    for(y = 0, i = 0; y < dstSize.height; y++) {
+      sx = (const Ipp32f*) ((const char*) mapX + y * mapXStep);
+      sy = (const Ipp32f*) ((const char*) mapY + y * mapYStep);
+      for(x = 0; x < dstSize.width; x++, i++)
+        remap_plan_store(plan, i, sx[x], sy[x]);
+    }
+  }
+
+  *dst = plan;
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// remap_plan_destroy
+// -------------------------------------------------------------------------- //
+void remap_plan_destroy(RemapPlan* plan) {
+  assert(plan != NULL);
+
+  if(plan->ownsMaps) {
+    free(plan->mapFixed);
+    free(plan->mapFrac);
+    free(plan->mapX);
+    free(plan->mapY);
+  }
+  free(plan);
+}
+
+
+// -------------------------------------------------------------------------- //
+// remap_dispatch_init
+// -------------------------------------------------------------------------- //
+void remap_dispatch_init(void) {
+  dispatch_register(&remap_fixed_nearest_table);
+  dispatch_register(&remap_fixed_linear_table);
+  dispatch_register(&remap_fixed_cubic_table);
+}
+
+
+// -------------------------------------------------------------------------- //
+// remap_plan_apply
+// -------------------------------------------------------------------------- //
+int remap_plan_apply(RemapPlan* plan, const void* pSrc, int srcStep, void* pDst, int dstStep) {
+  RemapTile tile;
+
+  assert(plan != NULL && pSrc != NULL && pDst != NULL);
+
+  if(!is_metatype_supported(plan->metaType))
+    return ippStsDataTypeErr;
+  if((unsigned int) plan->interp > INTERP_CUBIC) {
+    Unreachable();
+    return ippStsBadArgErr;
+  }
+
+  /* Cost of a band varies with the source area it maps to, which is what stealing evens out */
+  if(plan->mapFixed != NULL)
+    tile.kernel = DISPATCH_KERNEL(RemapFunc, *remap_fixed_tables[plan->interp], plan->metaType);
+  else
+    tile.kernel = remap_tables[plan->interp][plan->metaType];
+  tile.plan = plan;
+  tile.pSrc = pSrc;
+  tile.srcStep = srcStep;
+  tile.pDst = pDst;
+  tile.dstStep = dstStep;
+  pool_parallel_for(plan->dstSize.height, REMAP_BAND_HEIGHT, remap_plan_apply_tile, &tile);
+
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// r2c_interp_mode
+// -------------------------------------------------------------------------- //
+InterpMode r2c_interp_mode(VALUE value) {
+  ID id;
+
+  if(SYMBOL_P(value)) {
+    id = SYM2ID(value);
+    if(id == rb_intern("nearest"))
+      return INTERP_NEAREST;
+    else if(id == rb_intern("linear"))
+      return INTERP_LINEAR;
+    else if(id == rb_intern("cubic"))
+      return INTERP_CUBIC;
+    else
+      rb_raise(rb_eArgError, "unknown interpolation mode :%s", rb_id2name(id));
+  }
+
+  return (InterpMode) R2C_ENUM(value, rb_InterpMode);
+}
+
+
+// -------------------------------------------------------------------------- //
+// r2c_border_mode
+// -------------------------------------------------------------------------- //
+BorderMode r2c_border_mode(VALUE value) {
+  ID id;
+
+  if(SYMBOL_P(value)) {
+    id = SYM2ID(value);
+    if(id == rb_intern("constant"))
+      return BORDER_CONSTANT;
+    else if(id == rb_intern("replicate"))
+      return BORDER_REPLICATE;
+    else if(id == rb_intern("transparent"))
+      return BORDER_TRANSPARENT;
+    else
+      rb_raise(rb_eArgError, "unknown border mode :%s", rb_id2name(id));
+  }
+
+  return (BorderMode) R2C_ENUM(value, rb_BorderMode);
+}
+
+
+// -------------------------------------------------------------------------- //
+// r2c_remap_options
+// -------------------------------------------------------------------------- //
+void r2c_remap_options(int* argc, VALUE* argv, InterpMode* interp, BorderMode* border, int* fixed) {
+  VALUE options, value;
+
+  if(*argc == 0 || TYPE(argv[*argc - 1]) != T_HASH)
+    return;
+
+  options = argv[--(*argc)];
+  if(!NIL_P(value = rb_hash_aref(options, ID2SYM(rb_intern("interp")))))
+    *interp = r2c_interp_mode(value);
+  if(!NIL_P(value = rb_hash_aref(options, ID2SYM(rb_intern("border")))))
+    *border = r2c_border_mode(value);
+  if(fixed != NULL && !NIL_P(value = rb_hash_aref(options, ID2SYM(rb_intern("fixed")))))
+    *fixed = RTEST(value);
+}
+
+
+// -------------------------------------------------------------------------- //
+// r2c_transform
+// -------------------------------------------------------------------------- //
+int r2c_transform(VALUE value, double* coeffs) {
+  Matrix* matrix;
+  int i, rows;
+
+  matrix = matrix_new(value, FALSE);
+
+  rows = matrix->size.height;
+  if(matrix->size.width != 3 || (rows != 2 && rows != 3)) {
+    matrix_release(matrix);
+    rb_raise(rb_eArgError, "transform matrix must be 2x3 or 3x3");
+  }
+
+  coeffs[6] = 0.0;
+  coeffs[7] = 0.0;
+  coeffs[8] = 1.0;
+  for(i = 0; i < rows * 3; i++)
+    coeffs[i] = ((float*) matrix->data)[i];
+
+  matrix_release(matrix);
+  return rows;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_RemapPlan_alloc
+// -------------------------------------------------------------------------- //
+VALUE rb_RemapPlan_alloc(VALUE klass) {
+  return WRAP_REMAPPLAN_A(NULL, klass); /* Underlying C struct will be allocated later, in "initialize" method */
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_RemapPlan_initialize
+// -------------------------------------------------------------------------- //
+VALUE rb_RemapPlan_initialize(int argc, VALUE *argv, VALUE self) {
+  RemapPlan* plan;
+  Image* mapX;
+  Image* mapY;
+  IppiSize srcSize, dstSize;
+  IppMetaType metaType;
+  InterpMode interp;
+  BorderMode border;
+  int fixed;
+  double coeffs[9];
+
+  interp = INTERP_LINEAR;
+  border = BORDER_CONSTANT;
+  fixed = TRUE;
+  r2c_remap_options(&argc, argv, &interp, &border, &fixed);
+
+  if(argc != 4 && argc != 5)
+    rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 4 or 5)", argc);
+  if(argc == 5)
+    interp = r2c_interp_mode(argv[4]);
+
+  srcSize = *Data_Get_Struct_Ret(argv[0], IppiSize);
+  if(srcSize.width <= 0 || srcSize.height <= 0)
+    rb_raise(rb_eArgError, "image sizes must be positive");
+
+  if(RTEST(rb_obj_is_kind_of(argv[1], rb_Image))) {
+    mapX = Data_Get_Struct_Ret(argv[1], Image);
+    mapY = Data_Get_Struct_Ret(argv[2], Image);
+    metaType = r2c_metatype(argv[3]);
+    raise_on_error(image_remap_plan_new(&plan, srcSize, metaType, mapX, mapY, interp, border, fixed ? REMAP_MAPS_FIXED : REMAP_MAPS_32F));
+  } else {
+    dstSize = *Data_Get_Struct_Ret(argv[1], IppiSize);
+    metaType = r2c_metatype(argv[2]);
+    r2c_transform(argv[3], coeffs);
+    if(dstSize.width <= 0 || dstSize.height <= 0)
+      rb_raise(rb_eArgError, "image sizes must be positive");
+
+    raise_on_error(remap_plan_new_transform(&plan, srcSize, dstSize, metaType, coeffs, interp, border));
+  }
+  if(DATA_PTR(self) != NULL)
+    remap_plan_destroy((RemapPlan*) DATA_PTR(self)); /* re-initialization */
+  DATA_PTR(self) = plan;
+
+  return self;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_RemapPlan_apply
+// -------------------------------------------------------------------------- //
+VALUE rb_RemapPlan_apply(int argc, VALUE *argv, VALUE self) {
+  RemapPlan* plan;
+  Image* newImage;
+
+  plan = Data_Get_Struct_Ret(self, RemapPlan);
+
+  switch(argc) {
+  case 1:
+    raise_on_error(image_remap_plan_copy(Data_Get_Struct_Ret(argv[0], Image), &newImage, plan));
+    return image_wrap(newImage);
+  case 2:
+    raise_on_error(image_remap_plan(Data_Get_Struct_Ret(argv[0], Image), Data_Get_Struct_Ret(argv[1], Image), plan));
+    return argv[1];
+  default:
+    rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 1 or 2)", argc);
+    return Qnil;
+  }
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_RemapPlan_src_size
+// -------------------------------------------------------------------------- //
+VALUE rb_RemapPlan_src_size(VALUE self) {
+  RemapPlan* plan;
+
+  plan = Data_Get_Struct_Ret(self, RemapPlan);
+
+  return WRAP_SIZE(size_new(plan->srcSize.width, plan->srcSize.height));
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_RemapPlan_dst_size
+// -------------------------------------------------------------------------- //
+VALUE rb_RemapPlan_dst_size(VALUE self) {
+  RemapPlan* plan;
+
+  plan = Data_Get_Struct_Ret(self, RemapPlan);
+
+  return WRAP_SIZE(size_new(plan->dstSize.width, plan->dstSize.height));
+}
+
+
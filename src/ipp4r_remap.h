@@ -0,0 +1,273 @@
+#ifndef __IPP4R_REMAP_H__
+#define __IPP4R_REMAP_H__
+
+#include <ruby.h>
+#include <ippdefs.h>
+#include "ipp4r_fwd.h"
+#include "ipp4r_metatype.h"
+
+/**
+ * @file
+ *
+ * This file defines C and Ruby interfaces for remap plans. <p>
+ *
+ * RemapPlan stores, for each destination pixel, the coordinates of the source point it is sampled from. Coordinates are computed once,
+ * when a plan is created from a geometric transform or from user-supplied coordinate maps, so applying a plan is a single pass of lookups and interpolation. <p>
+ *
+ * For 8u images coordinates are stored in fixed point: integer parts as a pair of Ipp16s values, and fractional parts, REMAP_FRAC_BITS bits for each axis,
+ * packed into a single Ipp16u value that indexes precomputed integer interpolation weights. This takes 6 bytes per pixel instead of 8 for a pair of Ipp32f maps,
+ * and avoids all floating point math in the inner loop. Other data types use Ipp32f coordinate maps. <p>
+ *
+ * Destination pixels whose source point lies outside the source image are handled according to the plan BorderMode. <p>
+ *
+ * Destination rows are processed in independent bands of REMAP_BAND_HEIGHT rows, which run in parallel as tiles on the pool, see pool_parallel_for.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -------------------------------------------------------------------------- //
+// Defines
+// -------------------------------------------------------------------------- //
+#define REMAP_FRAC_BITS 5                       /**< Number of fractional bits per coordinate in fixed-point maps */
+#define REMAP_FRAC_SIZE (1 << REMAP_FRAC_BITS)  /**< Number of subpixel positions per axis in fixed-point maps */
+#define REMAP_FIXED_MAX 32767                   /**< Maximal source image dimension for which fixed-point maps are used */
+#define REMAP_OUTSIDE (-32768)                  /**< Coordinate value that marks destination pixels mapped outside of the source */
+#define REMAP_BAND_HEIGHT 32                    /**< Number of destination rows processed by a single task */
+
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/**
+ * Interpolation mode
+ */
+typedef enum {
+  INTERP_NEAREST,       /**< nearest neighbor */
+  INTERP_LINEAR,        /**< bilinear */
+  INTERP_CUBIC          /**< bicubic (Keys filter with a = -0.5) */
+} InterpMode;
+
+
+/**
+ * Border mode, i.e. what happens to destination pixels that are mapped outside of the source image
+ */
+typedef enum {
+  BORDER_CONSTANT,      /**< set to zero */
+  BORDER_REPLICATE,     /**< sampled from the nearest edge pixel */
+  BORDER_TRANSPARENT    /**< left untouched */
+} BorderMode;
+
+
+/**
+ * Format of coordinate maps stored in a plan
+ */
+typedef enum {
+  REMAP_MAPS_BORROWED,  /**< Ipp32f maps owned by the caller, which must keep them alive while the plan is in use */
+  REMAP_MAPS_32F,       /**< Ipp32f maps owned by the plan */
+  REMAP_MAPS_FIXED      /**< fixed-point maps owned by the plan, if the plan metatype supports them, Ipp32f maps otherwise */
+} RemapMapFormat;
+
+
+/**
+ * Remap plan struct
+ */
+struct _RemapPlan {
+  IppiSize srcSize;     /**< size of a source image */
+  IppiSize dstSize;     /**< size of a destination image */
+  IppMetaType metaType; /**< metatype of source and destination images */
+  InterpMode interp;    /**< interpolation mode */
+  BorderMode border;    /**< border mode */
+  int ownsMaps;         /**< whether maps are freed together with the plan */
+
+  Ipp16s* mapFixed;     /**< integer parts of source coordinates, (x, y) pair per destination pixel, or NULL if Ipp32f maps are used */
+  Ipp16u* mapFrac;      /**< fractional parts of source coordinates, (y << REMAP_FRAC_BITS) | x per destination pixel, or NULL if Ipp32f maps are used */
+  Ipp32f* mapX;         /**< source x coordinate per destination pixel, or NULL if fixed-point maps are used */
+  Ipp32f* mapY;         /**< source y coordinate per destination pixel, or NULL if fixed-point maps are used */
+  int mapXStep;         /**< size of mapX row in bytes */
+  int mapYStep;         /**< size of mapY row in bytes */
+};
+
+
+// -------------------------------------------------------------------------- //
+// RemapPlan C interface
+// -------------------------------------------------------------------------- //
+/**
+ * Creates a new remap plan for a projective transform.
+ *
+ * @param dst pointer to the newly created plan
+ * @param srcSize size of a source image
+ * @param dstSize size of a destination image
+ * @param metaType metatype of images
+ * @param coeffs 3x3 row-major matrix of a transform that maps source coordinates to destination coordinates. Affine transforms have (0, 0, 1) as the last row
+ * @param interp interpolation mode
+ * @param border border mode
+ * @returns ippStsNoErr if everything went OK, ippStsCoeffErr if the transform is singular, non-zero error code otherwise
+ */
+int remap_plan_new_transform(RemapPlan** dst, IppiSize srcSize, IppiSize dstSize, IppMetaType metaType, const double* coeffs, InterpMode interp, BorderMode border);
+
+
+/**
+ * Creates a new remap plan from coordinate maps.
+ *
+ * @param dst pointer to the newly created plan
+ * @param srcSize size of a source image
+ * @param dstSize size of a destination image, and of the maps
+ * @param metaType metatype of images
+ * @param mapX source x coordinate for each destination pixel
+ * @param mapXStep size of mapX row in bytes
+ * @param mapY source y coordinate for each destination pixel
+ * @param mapYStep size of mapY row in bytes
+ * @param interp interpolation mode
+ * @param border border mode
+ * @param format format of maps to store in the plan. Maps are converted to it in a single pass, or just referenced for REMAP_MAPS_BORROWED
+ * @returns ippStsNoErr if everything went OK, non-zero error code otherwise
+ */
+int remap_plan_new_maps(RemapPlan** dst, IppiSize srcSize, IppiSize dstSize, IppMetaType metaType, const Ipp32f* mapX, int mapXStep, const Ipp32f* mapY, int mapYStep, InterpMode interp, BorderMode border, RemapMapFormat format);
+
+
+/**
+ * Frees memory occupied by RemapPlan structure.
+ */
+void remap_plan_destroy(RemapPlan* plan);
+
+
+/**
+ * Remaps an image buffer using a remap plan. Source and destination must not overlap.
+ *
+ * @param plan remap plan
+ * @param pSrc source buffer of plan->srcSize
+ * @param srcStep size of source row in bytes
+ * @param pDst destination buffer of plan->dstSize
+ * @param dstStep size of destination row in bytes
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int remap_plan_apply(RemapPlan* plan, const void* pSrc, int srcStep, void* pDst, int dstStep);
+
+
+/**
+ * Registers dispatch tables of remap kernels, see dispatch_init.
+ */
+void remap_dispatch_init(void);
+
+
+// -------------------------------------------------------------------------- //
+// RemapPlan ruby interface
+// -------------------------------------------------------------------------- //
+/**
+ * Alloc function for RemapPlan class. Note that the memory is actually allocated in "initialize" method.
+ */
+VALUE rb_RemapPlan_alloc(VALUE klass);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::RemapPlan#initialize(Size srcSize, Size dstSize, MetaType metaType, Matrix transform, interp = InterpLinear, options = {})</tt>
+ * <li> <tt>Ipp::RemapPlan#initialize(Size srcSize, Image mapX, Image mapY, MetaType metaType, interp = InterpLinear, options = {})</tt>
+ * </ul>
+ *
+ * Initializes a new RemapPlan object for a 2x3 affine or a 3x3 perspective transform from source to destination coordinates, or for a pair of 32f_C1 coordinate maps.
+ * Maps are converted on creation and may be discarded afterwards. <br>
+ * Interpolation mode is either Ipp::InterpMode or one of :nearest, :linear, :cubic symbols. Supported options are <tt>:interp</tt>, <tt>:border</tt> (Ipp::BorderMode or
+ * one of :constant, :replicate, :transparent symbols) and <tt>:fixed</tt>, which may be set to false to keep 32f maps for 8u images.
+ */
+VALUE rb_RemapPlan_initialize(int argc, VALUE *argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::RemapPlan#apply(Image src)</tt>
+ * <li> <tt>Ipp::RemapPlan#apply(Image src, Image dst)</tt>
+ * </ul>
+ *
+ * Remaps src. The second form writes the result into an existing dst and does not allocate anything.
+ * @returns a newly created image, or dst
+ */
+VALUE rb_RemapPlan_apply(int argc, VALUE *argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::RemapPlan#src_size</tt>
+ * </ul>
+ *
+ * @returns size of a source image
+ */
+VALUE rb_RemapPlan_src_size(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::RemapPlan#dst_size</tt>
+ * </ul>
+ *
+ * @returns size of a destination image
+ */
+VALUE rb_RemapPlan_dst_size(VALUE self);
+
+
+/**
+ * Converts the given ruby value to InterpMode. Accepts Ipp::InterpMode values and :nearest, :linear, :cubic symbols.
+ */
+InterpMode r2c_interp_mode(VALUE value);
+
+
+/**
+ * Converts the given ruby value to BorderMode. Accepts Ipp::BorderMode values and :constant, :replicate, :transparent symbols.
+ */
+BorderMode r2c_border_mode(VALUE value);
+
+
+/**
+ * Extracts a trailing options hash with <tt>:interp</tt>, <tt>:border</tt> and <tt>:fixed</tt> keys from arguments. Values of missing options are left untouched.
+ *
+ * @param argc pointer to the number of arguments, is decremented if a hash was found
+ * @param argv arguments
+ * @param interp interpolation mode
+ * @param border border mode
+ * @param fixed whether to use fixed-point maps, may be NULL if not applicable
+ */
+void r2c_remap_options(int* argc, VALUE* argv, InterpMode* interp, BorderMode* border, int* fixed);
+
+
+/**
+ * Converts the given ruby Matrix to transform coefficients.
+ *
+ * @param value 2x3 or 3x3 matrix
+ * @param coeffs 3x3 row-major matrix, last row of 2x3 matrices is set to (0, 0, 1)
+ * @returns number of rows in the given matrix
+ */
+int r2c_transform(VALUE value, double* coeffs);
+
+
+/**
+ * Wraps a RemapPlan structure into ruby VALUE using given CLASS.
+ *
+ * @param PLAN <tt>RemapPlan*</tt>
+ * @param CLASS <tt>VALUE</tt> of ruby class used for wrapping
+ */
+#define WRAP_REMAPPLAN_A(PLAN, CLASS)                                           \
+  Data_Wrap_Struct((CLASS), NULL, remap_plan_destroy, (PLAN))
+
+
+/**
+ * Wraps a RemapPlan structure into ruby VALUE.
+ *
+ * @param PLAN <tt>RemapPlan*</tt>
+ */
+#define WRAP_REMAPPLAN(PLAN)                                                    \
+  WRAP_REMAPPLAN_A(PLAN, rb_RemapPlan)
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
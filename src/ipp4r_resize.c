@@ -0,0 +1,586 @@
+#include <assert.h>
+#include <math.h>
+#include <ruby.h>
+#include "ipp4r.h"
+
+
+// -------------------------------------------------------------------------- //
+// Filters
+// -------------------------------------------------------------------------- //
+#define RESIZE_PI 3.14159265358979323846
+
+static double resize_filter_linear(double x) {
+  x = fabs(x);
+  return x < 1.0 ? 1.0 - x : 0.0;
+}
+
+static double resize_filter_cubic(double x) {
+  const double a = -0.5;
+
+  x = fabs(x);
+  if(x < 1.0)
+    return ((a + 2.0) * x - (a + 3.0)) * x * x + 1.0;
+  else if(x < 2.0)
+    return ((a * x - 5.0 * a) * x + 8.0 * a) * x - 4.0 * a;
+  else
+    return 0.0;
+}
+
+static double resize_sinc(double x) {
+  if(x == 0.0)
+    return 1.0;
+  x *= RESIZE_PI;
+  return sin(x) / x;
+}
+
+static double resize_filter_lanczos(double x) {
+  x = fabs(x);
+  return x < 3.0 ? resize_sinc(x) * resize_sinc(x / 3.0) : 0.0;
+}
+
+
+// -------------------------------------------------------------------------- //
+// Supplementary functions
+// -------------------------------------------------------------------------- //
+/**
+ * Computes resampling coefficients along one axis.
+ *
+ * @param axis axis to initialize
+ * @param srcLength source length in pixels
+ * @param dstLength destination length in pixels
+ * @param mode interpolation mode
+ * @param indexScale factor to multiply source indices by
+ * @param weightSize size of a weight, i.e. of the accumulator type, Ipp32f or Ipp64f
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+static int resize_axis_init(ResizeAxis* axis, int srcLength, int dstLength, ResizeMode mode, int indexScale, int weightSize) {
+  double scale, filterScale, support, center, lo, hi, sum;
+  double (*filter)(double);
+  double* w;
+  int d, t, first, i;
+
+  scale = (double) srcLength / dstLength;
+  filterScale = max(scale, 1.0);
+  filter = NULL;
+  support = 0.0;
+
+  switch(mode) {
+  case RESIZE_NEAREST:
+    axis->taps = 1;
+    break;
+  case RESIZE_AREA:
+    axis->taps = (int) ceil(scale) + 1;
+    break;
+  case RESIZE_LINEAR:
+    filter = resize_filter_linear;
+    support = 1.0;
+    break;
+  case RESIZE_CUBIC:
+    filter = resize_filter_cubic;
+    support = 2.0;
+    break;
+  case RESIZE_LANCZOS:
+    filter = resize_filter_lanczos;
+    support = 3.0;
+    break;
+  default:
+    return ippStsBadArgErr;
+  }
+  if(filter != NULL)
+    axis->taps = (int) ceil(2.0 * support * filterScale) + 1;
+
+  axis->index = (int*) malloc(dstLength * axis->taps * sizeof(int));
+  axis->weight = malloc(dstLength * axis->taps * weightSize);
+  w = (double*) malloc(axis->taps * sizeof(double));
+  if(axis->index == NULL || axis->weight == NULL || w == NULL) {
+    free(w);
+    return ippStsNoMemErr;
+  }
+
+  for(d = 0; d < dstLength; d++) {
+    int* index = axis->index + d * axis->taps;
+
+    if(mode == RESIZE_NEAREST) {
+      index[0] = min((int) ((d + 0.5) * scale), srcLength - 1) * indexScale;
+      w[0] = sum = 1.0;
+    } else {
+
+      if(mode == RESIZE_AREA) {
+        lo = d * scale;
+        hi = (d + 1) * scale;
+        first = (int) floor(lo);
+      } else {
+        center = (d + 0.5) * scale;
+        first = (int) floor(center - support * filterScale);
+      }
+
+      sum = 0.0;
+      for(t = 0; t < axis->taps; t++) {
+        i = first + t;
+        if(mode == RESIZE_AREA)
+          w[t] = max(0.0, min(i + 1.0, hi) - max((double) i, lo));
+        else
+          w[t] = filter((i + 0.5 - center) / filterScale);
+        index[t] = max(0, min(i, srcLength - 1)) * indexScale;
+        sum += w[t];
+      }
+    }
+
+    for(t = 0; t < axis->taps; t++) {
+      if(weightSize == sizeof(Ipp64f))
+        ((Ipp64f*) axis->weight)[d * axis->taps + t] = w[t] / sum;
+      else
+        ((Ipp32f*) axis->weight)[d * axis->taps + t] = (Ipp32f) (w[t] / sum);
+    }
+  }
+
+  free(w);
+  return ippStsNoErr;
+}
+
+
+DEFINE_D_SAT(resize_sat_, 8u, D_ACCUM(8u))
+DEFINE_D_SAT(resize_sat_, 16u, D_ACCUM(16u))
+DEFINE_D_SAT(resize_sat_, 16s, D_ACCUM(16s))
+DEFINE_D_SAT(resize_sat_, 32s, D_ACCUM(32s))
+
+#define resize_sat_32f(V) (V)
+#define resize_sat_64f(V) (V)
+
+
+// -------------------------------------------------------------------------- //
+// Kernels
+// -------------------------------------------------------------------------- //
+/** Resampling kernel */
+typedef void (*ResizeFunc)(ResizePlan* plan, const void* pSrc, int srcStep, void* pDst, int dstStep);
+
+/** Halving kernel */
+typedef void (*ResizeHalveFunc)(const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize dstRoi);
+
+
+/* Names of resampling kernels */
+#define RESIZE_KERNEL_NAME(D, C, TIER) ARX_JOIN_3(ARX_JOIN_5(resize_apply_, D, _, C, R), _, TIER)
+
+/* Tiers that change the code of resampling kernels of a data type. AVX2 vectorizes channels of 32s and 64f, and broadcasts weights for the others. */
+#define RESIZE_TIERS_8u  (2, (generic, avx2))
+#define RESIZE_TIERS_16u (2, (generic, avx2))
+#define RESIZE_TIERS_32f (3, (generic, sse4, avx2))
+#define RESIZE_TIERS_16s (2, (generic, avx2))
+#define RESIZE_TIERS_32s (2, (generic, avx2))
+#define RESIZE_TIERS_64f (2, (generic, avx2))
+#define RESIZE_TIERS(D) ARX_JOIN(RESIZE_TIERS_, D)
+
+/**
+ * Defines a kernel <tt>resize_apply_METATYPER_TIER</tt>, if TIER is listed for the data type of METATYPE. All channels, including alpha, are resampled.
+ * Weights, the row buffer and sums are of ATYPE, see D_ACCUM.
+ */
+#define DEFINE_RESIZE_KERNEL(METATYPE, TIER)                                    \
+  DEFINE_RESIZE_KERNEL_I(M_DATATYPE(METATYPE), M_CHANNELS(METATYPE), TIER)
+#define DEFINE_RESIZE_KERNEL_I(D, C, TIER)                                      \
+  ARX_IF(DISPATCH_HAS_TIER(RESIZE_TIERS(D), TIER), DEFINE_RESIZE_KERNEL_II, ARX_TUPLE_EAT_6)(D, C, TIER, D_CTYPE(D), D_ACCUM(D), C_CNUMB(C))
+#define DEFINE_RESIZE_KERNEL_II(D, C, TIER, CTYPE, ATYPE, CNUMB)                \
+DISPATCH_TARGET(TIER) static void RESIZE_KERNEL_NAME(D, C, TIER)(ResizePlan* plan, const void* pSrc, int srcStep, void* pDst, int dstStep) { \
+  int x, y, t, c, i;                                                            \
+  int rowLength;                                                                \
+  ATYPE* row;                                                                   \
+  ATYPE sum[CNUMB];                                                             \
+  const int* index;                                                             \
+  const ATYPE* weight;                                                          \
+  const CTYPE* s;                                                               \
+  const ATYPE* r;                                                               \
+  CTYPE* d;                                                                     \
+                                                                                \
+  rowLength = plan->srcSize.width * CNUMB;                                      \
+  row = (ATYPE*) plan->buffer;                                                  \
+                                                                                \
+  for(y = 0; y < plan->dstSize.height; y++) {                                   \
+    /* vertical pass */                                                         \
+    index = plan->y.index + y * plan->y.taps;                                   \
+    weight = (const ATYPE*) plan->y.weight + y * plan->y.taps;                  \
+    s = (const CTYPE*) ((const char*) pSrc + index[0] * srcStep);               \
+    for(i = 0; i < rowLength; i++)                                              \
+      row[i] = weight[0] * s[i];                                                \
+    for(t = 1; t < plan->y.taps; t++) {                                         \
+      if(weight[t] == 0)                                                        \
+        continue;                                                               \
+      s = (const CTYPE*) ((const char*) pSrc + index[t] * srcStep);             \
+      for(i = 0; i < rowLength; i++)                                            \
+        row[i] += weight[t] * s[i];                                             \
+    }                                                                           \
+                                                                                \
+    /* horizontal pass */                                                       \
+    index = plan->x.index;                                                      \
+    weight = (const ATYPE*) plan->x.weight;                                     \
+    d = (CTYPE*) ((char*) pDst + y * dstStep);                                  \
+    for(x = 0; x < plan->dstSize.width; x++, d += CNUMB, index += plan->x.taps, weight += plan->x.taps) { \
+      for(c = 0; c < CNUMB; c++)                                                \
+        sum[c] = 0;                                                             \
+      for(t = 0; t < plan->x.taps; t++) {                                       \
+        r = row + index[t];                                                     \
+        for(c = 0; c < CNUMB; c++)                                              \
+          sum[c] += weight[t] * r[c];                                           \
+      }                                                                         \
+      for(c = 0; c < CNUMB; c++)                                                \
+        d[c] = ARX_JOIN(resize_sat_, D)(sum[c]);                                \
+    }                                                                           \
+  }                                                                             \
+}
+
+/**
+ * Defines resampling kernels and a kernel array <tt>resize_apply_kernels_TIER</tt> for TIER.
+ * Entries of data types that TIER isn't listed for are the kernels of the tier below.
+ */
+#define DEFINE_RESIZE_KERNELS(TIER, ARG)                                        \
+  ARX_ARRAY_FOREACH(M_SUPPORTED, DEFINE_RESIZE_KERNEL, TIER)                    \
+  DEFINE_DISPATCH_KERNELS(ARX_JOIN(resize_apply_kernels_, TIER), M_SUPPORTED, RESIZE_KERNEL, TIER)
+#define RESIZE_KERNEL(M, TIER) RESIZE_KERNEL_NAME(M_DATATYPE(M), M_CHANNELS(M), DISPATCH_TIER_FLOOR(RESIZE_TIERS(M_DATATYPE(M)), TIER))
+
+ARX_ARRAY_FOREACH(DISPATCH_TIERS, DEFINE_RESIZE_KERNELS, ~)
+
+
+/* Average of four DATATYPE values */
+#define RESIZE_AVG4_8u(A, B, C, D)  ((Ipp8u) (((unsigned int) (A) + (B) + (C) + (D) + 2) >> 2))
+#define RESIZE_AVG4_16u(A, B, C, D) ((Ipp16u) (((unsigned int) (A) + (B) + (C) + (D) + 2) >> 2))
+#define RESIZE_AVG4_32f(A, B, C, D) (((A) + (B) + (C) + (D)) * 0.25f)
+#define RESIZE_AVG4_16s(A, B, C, D) ((Ipp16s) (((int) (A) + (B) + (C) + (D) + 2) >> 2))
+#define RESIZE_AVG4_32s(A, B, C, D) ((Ipp32s) (((Ipp64s) (A) + (B) + (C) + (D) + 2) >> 2))
+#define RESIZE_AVG4_64f(A, B, C, D) (((A) + (B) + (C) + (D)) * 0.25)
+
+
+/* Names of halving kernels */
+#define HALVE_KERNEL_NAME(D, C, TIER) ARX_JOIN_3(ARX_JOIN_5(resize_halve_, D, _, C, R), _, TIER)
+
+/* Tiers that pay off for halving kernels of a data type, measured on 512x128 images. Integer sums widen with each tier, except that SSE4.1 gains
+ * nothing on 8u, floating-point ones gain from AVX2 only. 3-channel pixels barely vectorize on any tier. */
+#define HALVE_TIERS_8u  (3, (generic, avx2, avx512))
+#define HALVE_TIERS_16u (4, (generic, sse4, avx2, avx512))
+#define HALVE_TIERS_32f (2, (generic, avx2))
+#define HALVE_TIERS_16s (4, (generic, sse4, avx2, avx512))
+#define HALVE_TIERS_32s (4, (generic, sse4, avx2, avx512))
+#define HALVE_TIERS_64f (2, (generic, avx2))
+#define HALVE_TIERS(D) ARX_JOIN(HALVE_TIERS_, D)
+
+/**
+ * Defines a kernel <tt>resize_halve_METATYPER_TIER</tt> that downscales an image by 2 in both directions with a 2x2 box filter, if TIER is listed for the data type of METATYPE.
+ * In-place operation with the same row step is supported, since every destination element is written after the source elements at or before its position were read.
+ */
+#define DEFINE_HALVE_KERNEL(METATYPE, TIER)                                     \
+  DEFINE_HALVE_KERNEL_I(M_DATATYPE(METATYPE), M_CHANNELS(METATYPE), TIER)
+#define DEFINE_HALVE_KERNEL_I(D, C, TIER)                                       \
+  ARX_IF(DISPATCH_HAS_TIER(HALVE_TIERS(D), TIER), DEFINE_HALVE_KERNEL_II, ARX_TUPLE_EAT_5)(D, C, TIER, D_CTYPE(D), C_CNUMB(C))
+#define DEFINE_HALVE_KERNEL_II(D, C, TIER, CTYPE, CNUMB)                        \
+DISPATCH_TARGET(TIER) static void HALVE_KERNEL_NAME(D, C, TIER)(const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize dstRoi) { \
+  int x, y, c;                                                                  \
+  const CTYPE* s0;                                                              \
+  const CTYPE* s1;                                                              \
+  CTYPE* d;                                                                     \
+                                                                                \
+  for(y = 0; y < dstRoi.height; y++) {                                          \
+    s0 = (const CTYPE*) ((const char*) pSrc + 2 * y * srcStep);                 \
+    s1 = (const CTYPE*) ((const char*) s0 + srcStep);                           \
+    d = (CTYPE*) ((char*) pDst + y * dstStep);                                  \
+    for(x = 0; x < dstRoi.width; x++, s0 += 2 * CNUMB, s1 += 2 * CNUMB, d += CNUMB) \
+      for(c = 0; c < CNUMB; c++)                                                \
+        d[c] = ARX_JOIN(RESIZE_AVG4_, D)(s0[c], s0[c + CNUMB], s1[c], s1[c + CNUMB]); \
+  }                                                                             \
+}
+
+/**
+ * Defines halving kernels and a kernel array <tt>resize_halve_kernels_TIER</tt> for TIER.
+ * Entries of data types that TIER isn't listed for are the kernels of the tier below.
+ */
+#define DEFINE_HALVE_KERNELS(TIER, ARG)                                         \
+  ARX_ARRAY_FOREACH(M_SUPPORTED, DEFINE_HALVE_KERNEL, TIER)                     \
+  DEFINE_DISPATCH_KERNELS(ARX_JOIN(resize_halve_kernels_, TIER), M_SUPPORTED, HALVE_KERNEL, TIER)
+#define HALVE_KERNEL(M, TIER) HALVE_KERNEL_NAME(M_DATATYPE(M), M_CHANNELS(M), DISPATCH_TIER_FLOOR(HALVE_TIERS(M_DATATYPE(M)), TIER))
+
+ARX_ARRAY_FOREACH(DISPATCH_TIERS, DEFINE_HALVE_KERNELS, ~)
+
+
+// -------------------------------------------------------------------------- //
+// Dispatch tables
+// -------------------------------------------------------------------------- //
+DEFINE_DISPATCH_TIERED_TABLE(resize_apply_table, "resize_apply", resize_apply_kernels)
+DEFINE_DISPATCH_TIERED_TABLE(resize_halve_table, "resize_halve", resize_halve_kernels)
+
+/** Sizes of accumulator values, indexed by IppMetaType */
+#define RESIZE_ACCUM_SIZE(M) sizeof(D_ACCUM(M_DATATYPE(M)))
+DEFINE_METATABLE_VALUES(unsigned char, resize_accum_size_table, M_SUPPORTED, RESIZE_ACCUM_SIZE)
+
+
+// -------------------------------------------------------------------------- //
+// Plan cache
+// -------------------------------------------------------------------------- //
+static ResizePlan* planCache[RESIZE_PLAN_CACHE_SIZE];
+static unsigned int planCacheTime[RESIZE_PLAN_CACHE_SIZE];
+static unsigned int planCacheClock = 0;
+
+
+// -------------------------------------------------------------------------- //
+// resize_plan_new
+// -------------------------------------------------------------------------- //
+ResizePlan* resize_plan_new(IppiSize srcSize, IppiSize dstSize, IppMetaType metaType, ResizeMode mode) {
+  ResizePlan* plan;
+  int cnumb, accSize;
+
+  assert(srcSize.width > 0 && srcSize.height > 0 && dstSize.width > 0 && dstSize.height > 0);
+
+  plan = (ResizePlan*) malloc(sizeof(ResizePlan));
+  if(plan == NULL)
+    return NULL;
+
+  /* storage-only metatypes are rejected by resize_plan_apply */
+  if(is_metatype_supported(metaType)) {
+    cnumb = metatype_cnumb(metaType);
+    accSize = resize_accum_size_table[metaType];
+  } else {
+    cnumb = 1;
+    accSize = sizeof(Ipp32f);
+  }
+
+  plan->srcSize = srcSize;
+  plan->dstSize = dstSize;
+  plan->metaType = metaType;
+  plan->mode = mode;
+  plan->x.index = plan->y.index = NULL;
+  plan->x.weight = plan->y.weight = NULL;
+  plan->buffer = malloc(srcSize.width * cnumb * accSize);
+
+  if(plan->buffer == NULL || 
+    IS_ERROR(resize_axis_init(&plan->x, srcSize.width, dstSize.width, mode, cnumb, accSize)) || 
+    IS_ERROR(resize_axis_init(&plan->y, srcSize.height, dstSize.height, mode, 1, accSize))) {
+    resize_plan_destroy(plan);
+    return NULL;
+  }
+
+  return plan;
+}
+
+
+// -------------------------------------------------------------------------- //
+// resize_plan_destroy
+// -------------------------------------------------------------------------- //
+void resize_plan_destroy(ResizePlan* plan) {
+  assert(plan != NULL);
+
+  free(plan->x.index);
+  free(plan->x.weight);
+  free(plan->y.index);
+  free(plan->y.weight);
+  free(plan->buffer);
+  free(plan);
+}
+
+
+// -------------------------------------------------------------------------- //
+// resize_plan_cached
+// -------------------------------------------------------------------------- //
+ResizePlan* resize_plan_cached(IppiSize srcSize, IppiSize dstSize, IppMetaType metaType, ResizeMode mode) {
+  int i, oldest;
+  ResizePlan* plan;
+
+  oldest = 0;
+  for(i = 0; i < RESIZE_PLAN_CACHE_SIZE; i++) {
+    plan = planCache[i];
+    if(plan != NULL && plan->metaType == metaType && plan->mode == mode && 
+      plan->srcSize.width == srcSize.width && plan->srcSize.height == srcSize.height &&
+      plan->dstSize.width == dstSize.width && plan->dstSize.height == dstSize.height) {
+      planCacheTime[i] = ++planCacheClock;
+      return plan;
+    }
+    if(planCache[i] == NULL || (planCache[oldest] != NULL && planCacheTime[i] < planCacheTime[oldest]))
+      oldest = i;
+  }
+
+  plan = resize_plan_new(srcSize, dstSize, metaType, mode);
+  if(plan == NULL)
+    return NULL;
+
+  if(planCache[oldest] != NULL)
+    resize_plan_destroy(planCache[oldest]);
+  planCache[oldest] = plan;
+  planCacheTime[oldest] = ++planCacheClock;
+  return plan;
+}
+
+
+// -------------------------------------------------------------------------- //
+// resize_plan_acquire
+// -------------------------------------------------------------------------- //
+ResizePlan* resize_plan_acquire(IppiSize srcSize, IppiSize dstSize, IppMetaType metaType, ResizeMode mode) {
+  if(ruby_native_thread_p())
+    return resize_plan_cached(srcSize, dstSize, metaType, mode);
+  else
+    return resize_plan_new(srcSize, dstSize, metaType, mode);
+}
+
+
+// -------------------------------------------------------------------------- //
+// resize_plan_release
+// -------------------------------------------------------------------------- //
+void resize_plan_release(ResizePlan* plan) {
+  if(!ruby_native_thread_p())
+    resize_plan_destroy(plan);
+}
+
+
+// -------------------------------------------------------------------------- //
+// resize_dispatch_init
+// -------------------------------------------------------------------------- //
+void resize_dispatch_init(void) {
+  dispatch_register(&resize_apply_table);
+  dispatch_register(&resize_halve_table);
+}
+
+
+// -------------------------------------------------------------------------- //
+// resize_plan_apply
+// -------------------------------------------------------------------------- //
+int resize_plan_apply(ResizePlan* plan, const void* pSrc, int srcStep, void* pDst, int dstStep) {
+  ResizeFunc kernel;
+
+  assert(plan != NULL && pSrc != NULL && pDst != NULL);
+
+  kernel = DISPATCH_KERNEL(ResizeFunc, resize_apply_table, plan->metaType);
+  if(kernel == NULL)
+    return ippStsDataTypeErr;
+
+  kernel(plan, pSrc, srcStep, pDst, dstStep);
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// resize_halve
+// -------------------------------------------------------------------------- //
+int resize_halve(IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize dstRoi) {
+  ResizeHalveFunc kernel;
+
+  assert(pSrc != NULL && pDst != NULL);
+
+  kernel = DISPATCH_KERNEL(ResizeHalveFunc, resize_halve_table, metaType);
+  if(kernel == NULL)
+    return ippStsDataTypeErr;
+
+  kernel(pSrc, srcStep, pDst, dstStep, dstRoi);
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// r2c_resize_mode
+// -------------------------------------------------------------------------- //
+ResizeMode r2c_resize_mode(VALUE value) {
+  ID id;
+
+  if(SYMBOL_P(value)) {
+    id = SYM2ID(value);
+    if(id == rb_intern("nearest"))
+      return RESIZE_NEAREST;
+    else if(id == rb_intern("linear"))
+      return RESIZE_LINEAR;
+    else if(id == rb_intern("cubic"))
+      return RESIZE_CUBIC;
+    else if(id == rb_intern("lanczos"))
+      return RESIZE_LANCZOS;
+    else if(id == rb_intern("area"))
+      return RESIZE_AREA;
+    else
+      rb_raise(rb_eArgError, "unknown resize mode :%s", rb_id2name(id));
+  }
+
+  return (ResizeMode) R2C_ENUM(value, rb_ResizeMode);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_ResizePlan_alloc
+// -------------------------------------------------------------------------- //
+VALUE rb_ResizePlan_alloc(VALUE klass) {
+  return WRAP_RESIZEPLAN_A(NULL, klass); /* Underlying C struct will be allocated later, in "initialize" method */
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_ResizePlan_initialize
+// -------------------------------------------------------------------------- //
+VALUE rb_ResizePlan_initialize(int argc, VALUE *argv, VALUE self) {
+  ResizePlan* plan;
+  IppiSize srcSize, dstSize;
+  IppMetaType metaType;
+  ResizeMode mode;
+
+  switch(argc) {
+  case 3:
+  case 4:
+    srcSize = *Data_Get_Struct_Ret(argv[0], IppiSize);
+    dstSize = *Data_Get_Struct_Ret(argv[1], IppiSize);
+    metaType = r2c_metatype(argv[2]);
+    mode = argc == 4 ? r2c_resize_mode(argv[3]) : RESIZE_CUBIC;
+    break;
+  default:
+    rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 3 or 4)", argc);
+    break;
+  }
+
+  if(srcSize.width <= 0 || srcSize.height <= 0 || dstSize.width <= 0 || dstSize.height <= 0)
+    rb_raise(rb_eArgError, "image sizes must be positive");
+
+  plan = resize_plan_new(srcSize, dstSize, metaType, mode);
+  if(plan == NULL)
+    rb_raise(rb_eNoMemError, "could not allocate ResizePlan structure");
+  if(DATA_PTR(self) != NULL)
+    resize_plan_destroy((ResizePlan*) DATA_PTR(self)); /* re-initialization */
+  DATA_PTR(self) = plan;
+
+  return self;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_ResizePlan_apply
+// -------------------------------------------------------------------------- //
+VALUE rb_ResizePlan_apply(int argc, VALUE *argv, VALUE self) {
+  ResizePlan* plan;
+  Image* newImage;
+
+  plan = Data_Get_Struct_Ret(self, ResizePlan);
+
+  switch(argc) {
+  case 1:
+    raise_on_error(image_resize_plan_copy(Data_Get_Struct_Ret(argv[0], Image), &newImage, plan));
+    return image_wrap(newImage);
+  case 2:
+    raise_on_error(image_resize_plan(Data_Get_Struct_Ret(argv[0], Image), Data_Get_Struct_Ret(argv[1], Image), plan));
+    return argv[1];
+  default:
+    rb_raise(rb_eArgError, "wrong number of arguments (%d instead of 1 or 2)", argc);
+    return Qnil;
+  }
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_ResizePlan_src_size
+// -------------------------------------------------------------------------- //
+VALUE rb_ResizePlan_src_size(VALUE self) {
+  ResizePlan* plan;
+
+  plan = Data_Get_Struct_Ret(self, ResizePlan);
+
+  return WRAP_SIZE(size_new(plan->srcSize.width, plan->srcSize.height));
+}
+
+
+// -------------------------------------------------------------------------- //
+// rb_ResizePlan_dst_size
+// -------------------------------------------------------------------------- //
+VALUE rb_ResizePlan_dst_size(VALUE self) {
+  ResizePlan* plan;
+
+  plan = Data_Get_Struct_Ret(self, ResizePlan);
+
+  return WRAP_SIZE(size_new(plan->dstSize.width, plan->dstSize.height));
+}
+
+
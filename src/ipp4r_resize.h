@@ -0,0 +1,237 @@
+#ifndef __IPP4R_RESIZE_H__
+#define __IPP4R_RESIZE_H__
+
+#include <ruby.h>
+#include <ippdefs.h>
+#include "ipp4r_fwd.h"
+#include "ipp4r_metatype.h"
+
+/**
+ * @file
+ *
+ * This file defines C and Ruby interfaces for resize plans. <p>
+ *
+ * ResizePlan stores everything that depends only on source size, destination size, metatype and interpolation mode:
+ * per-axis tables of source indices and normalized filter weights, and a scratch row buffer. Resampling is separable - each destination row is
+ * obtained by a vertical pass over the source rows into the scratch buffer, followed by a horizontal pass from the buffer into the destination.
+ * Therefore applying a plan to any number of frames costs no allocations and no weight computations. <p>
+ *
+ * When downscaling, filter kernels are stretched by the scale factor, so all modes except RESIZE_NEAREST are antialiased.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -------------------------------------------------------------------------- //
+// Defines
+// -------------------------------------------------------------------------- //
+#define RESIZE_PLAN_CACHE_SIZE 8  /**< Number of plans kept in the internal cache used by Image#resize */
+
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/**
+ * Interpolation mode
+ */
+typedef enum {
+  RESIZE_NEAREST,       /**< nearest neighbor */
+  RESIZE_LINEAR,        /**< bilinear (triangle filter) */
+  RESIZE_CUBIC,         /**< bicubic (Keys filter with a = -0.5) */
+  RESIZE_LANCZOS,       /**< Lanczos filter with 3 lobes */
+  RESIZE_AREA           /**< pixel area relation, i.e. exact box averaging */
+} ResizeMode;
+
+
+/**
+ * Resampling coefficients along one axis
+ */
+typedef struct {
+  int taps;             /**< number of filter taps per destination pixel */
+  int* index;           /**< source indices, taps per destination pixel, clamped to source bounds */
+  void* weight;         /**< normalized filter weights, taps per destination pixel, of the accumulator type of the plan's data type, see D_ACCUM */
+} ResizeAxis;
+
+
+/**
+ * Resize plan struct
+ */
+struct _ResizePlan {
+  IppiSize srcSize;     /**< size of a source image */
+  IppiSize dstSize;     /**< size of a destination image */
+  IppMetaType metaType; /**< metatype of source and destination images */
+  ResizeMode mode;      /**< interpolation mode */
+
+  ResizeAxis x;         /**< horizontal coefficients, indices are in pixel elements, i.e. already multiplied by the number of channels */
+  ResizeAxis y;         /**< vertical coefficients, indices are in rows */
+  void* buffer;         /**< scratch row of srcSize.width * channels elements of the accumulator type */
+};
+
+
+// -------------------------------------------------------------------------- //
+// ResizePlan C interface
+// -------------------------------------------------------------------------- //
+/**
+ * Creates a new resize plan.
+ *
+ * @param srcSize size of a source image
+ * @param dstSize size of a destination image
+ * @param metaType metatype of images
+ * @param mode interpolation mode
+ * @returns newly allocated ResizePlan, or NULL in case of an error.
+ */
+ResizePlan* resize_plan_new(IppiSize srcSize, IppiSize dstSize, IppMetaType metaType, ResizeMode mode);
+
+
+/**
+ * Frees memory occupied by ResizePlan structure.
+ */
+void resize_plan_destroy(ResizePlan* plan);
+
+
+/**
+ * Looks up a plan with the given parameters in the internal cache of RESIZE_PLAN_CACHE_SIZE entries, creating it if needed and evicting the least recently used one.
+ * Returned plan is owned by the cache and stays valid until the next call to this function.
+ *
+ * @returns cached ResizePlan, or NULL in case of an error.
+ */
+ResizePlan* resize_plan_cached(IppiSize srcSize, IppiSize dstSize, IppMetaType metaType, ResizeMode mode);
+
+
+/**
+ * Gets a plan for a single resize. The cache is only used on ruby threads, since it isn't thread safe, so pool workers get a private plan.
+ * The plan must be given back with resize_plan_release.
+ *
+ * @returns ResizePlan, or NULL in case of an error.
+ */
+ResizePlan* resize_plan_acquire(IppiSize srcSize, IppiSize dstSize, IppMetaType metaType, ResizeMode mode);
+
+
+/**
+ * Gives back a plan obtained with resize_plan_acquire.
+ */
+void resize_plan_release(ResizePlan* plan);
+
+
+/**
+ * Resamples an image buffer using a resize plan. Source and destination must not overlap.
+ *
+ * @param plan resize plan
+ * @param pSrc source buffer of plan->srcSize
+ * @param srcStep size of source row in bytes
+ * @param pDst destination buffer of plan->dstSize
+ * @param dstStep size of destination row in bytes
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int resize_plan_apply(ResizePlan* plan, const void* pSrc, int srcStep, void* pDst, int dstStep);
+
+
+/**
+ * Downscales an image buffer by 2 in both directions, averaging 2x2 blocks. Odd last row and column of the source are dropped.
+ * In-place operation is supported if pSrc is equal to pDst and srcStep is equal to dstStep.
+ *
+ * @param metaType metatype of source and destination
+ * @param pSrc source buffer, at least 2 * dstRoi.width by 2 * dstRoi.height pixels
+ * @param srcStep size of source row in bytes
+ * @param pDst destination buffer
+ * @param dstStep size of destination row in bytes
+ * @param dstRoi size of destination in pixels
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int resize_halve(IppMetaType metaType, const void* pSrc, int srcStep, void* pDst, int dstStep, IppiSize dstRoi);
+
+
+// -------------------------------------------------------------------------- //
+// ResizePlan ruby interface
+// -------------------------------------------------------------------------- //
+/**
+ * Alloc function for ResizePlan class. Note that the memory is actually allocated in "initialize" method.
+ */
+VALUE rb_ResizePlan_alloc(VALUE klass);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::ResizePlan#initialize(Size srcSize, Size dstSize, MetaType metaType, mode = ResizeCubic)</tt>
+ * </ul>
+ *
+ * Initializes a new ResizePlan object. Mode is either Ipp::ResizeMode or one of :nearest, :linear, :cubic, :lanczos, :area symbols.
+ */
+VALUE rb_ResizePlan_initialize(int argc, VALUE *argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::ResizePlan#apply(Image src)</tt>
+ * <li> <tt>Ipp::ResizePlan#apply(Image src, Image dst)</tt>
+ * </ul>
+ *
+ * Resamples src. The second form writes the result into an existing dst and does not allocate anything.
+ * @returns a newly created image, or dst
+ */
+VALUE rb_ResizePlan_apply(int argc, VALUE *argv, VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::ResizePlan#src_size</tt>
+ * </ul>
+ *
+ * @returns size of a source image
+ */
+VALUE rb_ResizePlan_src_size(VALUE self);
+
+
+/**
+ * Method:
+ * <ul>
+ * <li> <tt>Ipp::ResizePlan#dst_size</tt>
+ * </ul>
+ *
+ * @returns size of a destination image
+ */
+VALUE rb_ResizePlan_dst_size(VALUE self);
+
+
+/**
+ * Converts the given ruby value to ResizeMode. Accepts Ipp::ResizeMode values and :nearest, :linear, :cubic, :lanczos, :area symbols.
+ */
+ResizeMode r2c_resize_mode(VALUE value);
+
+
+/**
+ * Wraps a ResizePlan structure into ruby VALUE using given CLASS.
+ *
+ * @param PLAN <tt>ResizePlan*</tt>
+ * @param CLASS <tt>VALUE</tt> of ruby class used for wrapping
+ */
+#define WRAP_RESIZEPLAN_A(PLAN, CLASS)                                          \
+  Data_Wrap_Struct((CLASS), NULL, resize_plan_destroy, (PLAN))
+
+
+/**
+ * Wraps a ResizePlan structure into ruby VALUE.
+ *
+ * @param PLAN <tt>ResizePlan*</tt>
+ */
+#define WRAP_RESIZEPLAN(PLAN)                                                   \
+  WRAP_RESIZEPLAN_A(PLAN, rb_ResizePlan)
+
+
+/**
+ * Registers dispatch tables of resampling kernels, see dispatch_init.
+ */
+void resize_dispatch_init(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
@@ -0,0 +1,355 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ipp4r.h"
+
+
+// -------------------------------------------------------------------------- //
+// Supplementary functions
+// -------------------------------------------------------------------------- //
+/**
+ * Linear mapping of destination coordinates to source coordinates, i.e. <tt>sx = xx * x + xy * y + x0</tt>, <tt>sy = yx * x + yy * y + y0</tt>.
+ */
+typedef struct {
+  int xx, xy, x0;
+  int yx, yy, y0;
+} RotateMap;
+
+#define ROTATE_MAP_X(M, X, Y) ((M)->xx * (X) + (M)->xy * (Y) + (M)->x0)
+#define ROTATE_MAP_Y(M, X, Y) ((M)->yx * (X) + (M)->yy * (Y) + (M)->y0)
+
+
+/**
+ * Fills the mapping for the given transform of a source of the given size.
+ */
+static void rotate_map_init(RotateMap* m, Orientation orientation, IppiSize srcSize) {
+  int w, h;
+
+  w = srcSize.width - 1;
+  h = srcSize.height - 1;
+
+  switch(orientation) {
+  case ORIENT_FLIP_H:      m->xx = -1; m->xy =  0; m->x0 = w; m->yx =  0; m->yy =  1; m->y0 = 0; break;
+  case ORIENT_ROTATE_180:  m->xx = -1; m->xy =  0; m->x0 = w; m->yx =  0; m->yy = -1; m->y0 = h; break;
+  case ORIENT_FLIP_V:      m->xx =  1; m->xy =  0; m->x0 = 0; m->yx =  0; m->yy = -1; m->y0 = h; break;
+  case ORIENT_TRANSPOSE:   m->xx =  0; m->xy =  1; m->x0 = 0; m->yx =  1; m->yy =  0; m->y0 = 0; break;
+  case ORIENT_ROTATE_90:   m->xx =  0; m->xy =  1; m->x0 = 0; m->yx = -1; m->yy =  0; m->y0 = h; break;
+  case ORIENT_TRANSVERSE:  m->xx =  0; m->xy = -1; m->x0 = w; m->yx = -1; m->yy =  0; m->y0 = h; break;
+  case ORIENT_ROTATE_270:  m->xx =  0; m->xy = -1; m->x0 = w; m->yx =  1; m->yy =  0; m->y0 = 0; break;
+  default:                 m->xx =  1; m->xy =  0; m->x0 = 0; m->yx =  0; m->yy =  1; m->y0 = 0; break;
+  }
+}
+
+
+// -------------------------------------------------------------------------- //
+// Kernels
+// -------------------------------------------------------------------------- //
+/** Copy kernel */
+typedef void (*RotateCopyFunc)(const char* pBase, int dx, int dy, void* pDst, int dstStep, IppiSize dstSize, int tileWidth);
+
+/** In-place kernel */
+typedef void (*RotateInplaceFunc)(char* p, int step, const RotateMap* m, int order, IppiSize domain);
+
+
+/* Names of kernels */
+#define ROTATE_KERNEL_NAME(OP, D, C, TIER) ARX_JOIN_3(ARX_JOIN_7(rotate_, OP, _, D, _, C, R), _, TIER)
+
+/* Tiers that pay off for kernels of a data type, measured on 512x512 images. Only mirrored rows vectorize, and only for 1- and 4-channel pixels;
+ * pixels of axis-swapping transforms are read with a stride no tier helps with. Byte and word reversals gain from SSE4.1 pshufb on,
+ * in-place swaps of wider elements from AVX2, copies of wider elements are memory bound on every tier. */
+#define ROTATE_COPY_TIERS_8u     (4, (generic, sse4, avx2, avx512))
+#define ROTATE_COPY_TIERS_16u    (4, (generic, sse4, avx2, avx512))
+#define ROTATE_COPY_TIERS_32f    (1, (generic))
+#define ROTATE_COPY_TIERS_16s    (4, (generic, sse4, avx2, avx512))
+#define ROTATE_COPY_TIERS_32s    (1, (generic))
+#define ROTATE_COPY_TIERS_64f    (1, (generic))
+#define ROTATE_COPY_TIERS_16f    (4, (generic, sse4, avx2, avx512))
+#define ROTATE_INPLACE_TIERS_8u  (4, (generic, sse4, avx2, avx512))
+#define ROTATE_INPLACE_TIERS_16u (4, (generic, sse4, avx2, avx512))
+#define ROTATE_INPLACE_TIERS_32f (3, (generic, avx2, avx512))
+#define ROTATE_INPLACE_TIERS_16s (4, (generic, sse4, avx2, avx512))
+#define ROTATE_INPLACE_TIERS_32s (3, (generic, avx2, avx512))
+#define ROTATE_INPLACE_TIERS_64f (2, (generic, avx2))
+#define ROTATE_INPLACE_TIERS_16f (4, (generic, sse4, avx2, avx512))
+#define ROTATE_TIERS(OP, D) ARX_JOIN_4(ROTATE_, OP, _TIERS_, D)
+
+
+/**
+ * Defines kernels <tt>rotate_copy_DATATYPE_CHANNELSR_TIER</tt> and <tt>rotate_inplace_DATATYPE_CHANNELSR_TIER</tt>, each if TIER is listed for it. <br>
+ * Copy kernel reads destination pixel (x, y) from <tt>pBase + x * dx + y * dy</tt>, where dx and dy are (possibly negative) byte offsets. <br>
+ * In-place kernel moves pixels along cycles of the given order, starting from the pixels of the given domain.
+ */
+#define DEFINE_ROTATE_KERNELS(METATYPE, TIER)                                   \
+  DEFINE_ROTATE_KERNELS_I(M_DATATYPE(METATYPE), M_CHANNELS(METATYPE), TIER, D_CTYPE(M_DATATYPE(METATYPE)), C_CNUMB(M_CHANNELS(METATYPE)))
+#define DEFINE_ROTATE_KERNELS_I(D, C, TIER, CTYPE, CNUMB)                       \
+  ARX_IF(DISPATCH_HAS_TIER(ROTATE_TIERS(COPY, D), TIER), DEFINE_ROTATE_COPY_KERNEL, ARX_TUPLE_EAT_5)(D, C, TIER, CTYPE, CNUMB) \
+  ARX_IF(DISPATCH_HAS_TIER(ROTATE_TIERS(INPLACE, D), TIER), DEFINE_ROTATE_INPLACE_KERNEL, ARX_TUPLE_EAT_5)(D, C, TIER, CTYPE, CNUMB)
+#define DEFINE_ROTATE_COPY_KERNEL(D, C, TIER, CTYPE, CNUMB)                     \
+DISPATCH_TARGET(TIER) static void ROTATE_KERNEL_NAME(copy, D, C, TIER)(const char* pBase, int dx, int dy, void* pDst, int dstStep, IppiSize dstSize, int tileWidth) { \
+  int x, y, c, tx, ty, xEnd, yEnd;                                              \
+  const char* s;                                                                \
+  CTYPE* d;                                                                     \
+                                                                                \
+  for(ty = 0; ty < dstSize.height; ty += ROTATE_TILE) {                         \
+    yEnd = min(ty + ROTATE_TILE, dstSize.height);                               \
+    for(tx = 0; tx < dstSize.width; tx += tileWidth) {                          \
+      xEnd = min(tx + tileWidth, dstSize.width);                                \
+      for(y = ty; y < yEnd; y++) {                                              \
+        s = pBase + y * dy + tx * dx;                                           \
+        d = (CTYPE*) ((char*) pDst + y * dstStep) + tx * CNUMB;                 \
+        if(dx == -(int) sizeof(CTYPE) * CNUMB) {                                \
+          /* Mirrored rows are read backwards with a constant stride, which vectorizes. */ \
+          for(x = 0; x < xEnd - tx; x++)                                        \
+            for(c = 0; c < CNUMB; c++)                                          \
+              d[x * CNUMB + c] = ((const CTYPE*) s)[c - x * CNUMB];             \
+        } else {                                                                \
+          for(x = tx; x < xEnd; x++, s += dx, d += CNUMB)                       \
+            for(c = 0; c < CNUMB; c++)                                          \
+              d[c] = ((const CTYPE*) s)[c];                                     \
+        }                                                                       \
+      }                                                                         \
+    }                                                                           \
+  }                                                                             \
+}
+#define DEFINE_ROTATE_INPLACE_KERNEL(D, C, TIER, CTYPE, CNUMB)                  \
+DISPATCH_TARGET(TIER) static void ROTATE_KERNEL_NAME(inplace, D, C, TIER)(char* p, int step, const RotateMap* m, int order, IppiSize domain) { \
+  int x, y, c, tx, ty, xEnd, yEnd, i, px, py, qx, qy, n;                       \
+  CTYPE* cycle[4];                                                              \
+  CTYPE* a;                                                                     \
+  CTYPE* b;                                                                     \
+  CTYPE t;                                                                      \
+                                                                                \
+  if(order == 2 && m->xx == -1 && m->xy == 0) {                                 \
+    /* Mirrored rows: row y swaps with row qy read backwards, with a constant stride, which vectorizes. */ \
+    for(y = 0; y < domain.height; y++) {                                        \
+      qy = ROTATE_MAP_Y(m, 0, y);                                               \
+      if(qy < y)                                                                \
+        continue;                                                               \
+      a = (CTYPE*) (p + y * step);                                              \
+      b = (CTYPE*) (p + qy * step) + m->x0 * CNUMB;                             \
+      n = qy == y ? domain.width / 2 : domain.width;                            \
+      for(x = 0; x < n; x++) {                                                  \
+        for(c = 0; c < CNUMB; c++) {                                            \
+          t = a[x * CNUMB + c];                                                 \
+          a[x * CNUMB + c] = b[c - x * CNUMB];                                  \
+          b[c - x * CNUMB] = t;                                                 \
+        }                                                                       \
+      }                                                                         \
+    }                                                                           \
+    return;                                                                     \
+  }                                                                             \
+                                                                                \
+  for(ty = 0; ty < domain.height; ty += ROTATE_TILE) {                          \
+    yEnd = min(ty + ROTATE_TILE, domain.height);                                \
+    for(tx = 0; tx < domain.width; tx += ROTATE_TILE) {                         \
+      xEnd = min(tx + ROTATE_TILE, domain.width);                               \
+      for(y = ty; y < yEnd; y++) {                                              \
+        for(x = tx; x < xEnd; x++) {                                            \
+          /* Collect the cycle: pixel i + 1 is the source of pixel i. */        \
+          px = x;                                                               \
+          py = y;                                                               \
+          for(i = 0; i < order; i++) {                                          \
+            cycle[i] = (CTYPE*) (p + py * step) + px * CNUMB;                   \
+            qx = ROTATE_MAP_X(m, px, py);                                       \
+            qy = ROTATE_MAP_Y(m, px, py);                                       \
+            px = qx;                                                            \
+            py = qy;                                                            \
+          }                                                                     \
+                                                                                \
+          /* Pairs are visited twice in the full domain, swap each one once. */ \
+          if(order == 2 && cycle[0] >= cycle[1])                                \
+            continue;                                                           \
+                                                                                \
+          for(c = 0; c < CNUMB; c++) {                                          \
+            t = cycle[0][c];                                                    \
+            for(i = 0; i < order - 1; i++)                                      \
+              cycle[i][c] = cycle[i + 1][c];                                    \
+            cycle[order - 1][c] = t;                                            \
+          }                                                                     \
+        }                                                                       \
+      }                                                                         \
+    }                                                                           \
+  }                                                                             \
+}
+
+#define DEFINE_ROTATE_KERNEL_ARRAYS(TIER, ARG)                                  \
+  ARX_ARRAY_FOREACH(M_INTERLEAVED, DEFINE_ROTATE_KERNELS, TIER)                 \
+  DEFINE_DISPATCH_KERNELS(ARX_JOIN(rotate_copy_kernels_, TIER), M_INTERLEAVED, ROTATE_COPY_KERNEL, TIER) \
+  DEFINE_DISPATCH_KERNELS(ARX_JOIN(rotate_inplace_kernels_, TIER), M_INTERLEAVED, ROTATE_INPLACE_KERNEL, TIER)
+#define ROTATE_COPY_KERNEL(M, TIER) ROTATE_KERNEL_NAME(copy, M_DATATYPE(M), M_CHANNELS(M), DISPATCH_TIER_FLOOR(ROTATE_TIERS(COPY, M_DATATYPE(M)), TIER))
+#define ROTATE_INPLACE_KERNEL(M, TIER) ROTATE_KERNEL_NAME(inplace, M_DATATYPE(M), M_CHANNELS(M), DISPATCH_TIER_FLOOR(ROTATE_TIERS(INPLACE, M_DATATYPE(M)), TIER))
+
+ARX_ARRAY_FOREACH(DISPATCH_TIERS, DEFINE_ROTATE_KERNEL_ARRAYS, ~)
+
+DEFINE_DISPATCH_TIERED_TABLE(rotate_copy_table, "rotate_copy", rotate_copy_kernels)
+DEFINE_DISPATCH_TIERED_TABLE(rotate_inplace_table, "rotate_inplace", rotate_inplace_kernels)
+
+
+// -------------------------------------------------------------------------- //
+// rotate_dispatch_init
+// -------------------------------------------------------------------------- //
+void rotate_dispatch_init(void) {
+  dispatch_register(&rotate_copy_table);
+  dispatch_register(&rotate_inplace_table);
+}
+
+
+// -------------------------------------------------------------------------- //
+// rotate_quarter_turns
+// -------------------------------------------------------------------------- //
+Orientation rotate_quarter_turns(int k) {
+  switch(((k % 4) + 4) % 4) {
+  case 1:
+    return ORIENT_ROTATE_270;
+  case 2:
+    return ORIENT_ROTATE_180;
+  case 3:
+    return ORIENT_ROTATE_90;
+  default:
+    return ORIENT_NORMAL;
+  }
+}
+
+
+// -------------------------------------------------------------------------- //
+// rotate_swaps_axes
+// -------------------------------------------------------------------------- //
+int rotate_swaps_axes(Orientation orientation) {
+  return orientation >= ORIENT_TRANSPOSE;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rotate_size
+// -------------------------------------------------------------------------- //
+IppiSize rotate_size(Orientation orientation, IppiSize size) {
+  return rotate_swaps_axes(orientation) ? ippi_size(size.height, size.width) : size;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rotate_copy
+// -------------------------------------------------------------------------- //
+int rotate_copy(Orientation orientation, IppMetaType metaType, const void* pSrc, int srcStep, IppiSize srcSize, void* pDst, int dstStep) {
+  RotateMap m;
+  RotateCopyFunc kernel;
+  int pixelSize, dx, dy, tileWidth;
+  const char* pBase;
+  IppiSize dstSize;
+
+  assert(pSrc != NULL && pDst != NULL);
+
+  kernel = DISPATCH_KERNEL(RotateCopyFunc, rotate_copy_table, metaType);
+  if(kernel == NULL) {
+    Unreachable();
+    return ippStsBadArgErr;
+  }
+
+  pixelSize = metatype_pixel_size(metaType);
+  dstSize = rotate_size(orientation, srcSize);
+  rotate_map_init(&m, orientation, srcSize);
+
+  pBase = (const char*) pSrc + m.y0 * srcStep + m.x0 * pixelSize;
+  dx = m.yx * srcStep + m.xx * pixelSize;
+  dy = m.yy * srcStep + m.xy * pixelSize;
+
+  /* Row-preserving transforms stream whole rows, only axis-swapping ones need square tiles. */
+  tileWidth = rotate_swaps_axes(orientation) ? ROTATE_TILE : dstSize.width;
+
+  kernel(pBase, dx, dy, pDst, dstStep, dstSize, tileWidth);
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rotate_inplace
+// -------------------------------------------------------------------------- //
+int rotate_inplace(Orientation orientation, IppMetaType metaType, void* pSrcDst, int srcDstStep, IppiSize size) {
+  RotateMap m;
+  RotateInplaceFunc kernel;
+  int order;
+  IppiSize domain;
+
+  assert(pSrcDst != NULL);
+
+  if(orientation == ORIENT_NORMAL)
+    return ippStsNoErr;
+  if(rotate_swaps_axes(orientation) && size.width != size.height)
+    return ippStsSizeErr;
+
+  kernel = DISPATCH_KERNEL(RotateInplaceFunc, rotate_inplace_table, metaType);
+  if(kernel == NULL) {
+    Unreachable();
+    return ippStsBadArgErr;
+  }
+
+  rotate_map_init(&m, orientation, size);
+
+  if(orientation == ORIENT_ROTATE_90 || orientation == ORIENT_ROTATE_270) {
+    /* Each 4-cycle has exactly one pixel in the top-left quadrant, the central pixel of an odd-sized image stays in place. */
+    order = 4;
+    domain = ippi_size(size.width / 2, (size.height + 1) / 2);
+  } else {
+    order = 2;
+    domain = size;
+  }
+
+  kernel((char*) pSrcDst, srcDstStep, &m, order, domain);
+  return ippStsNoErr;
+}
+
+
+// -------------------------------------------------------------------------- //
+// rotate_transpose_restride
+// -------------------------------------------------------------------------- //
+int rotate_transpose_restride(int pixelSize, void* pSrcDst, int srcStep, IppiSize srcSize, int dstStep) {
+  char* p;
+  unsigned char* visited;
+  char tmp[4 * sizeof(Ipp64f)];
+  int w, h, y, count, start, i, j, srcRow;
+
+  assert(pSrcDst != NULL);
+  assert(pixelSize <= (int) sizeof(tmp));
+  assert(dstStep >= srcSize.height * pixelSize);
+
+  p = (char*) pSrcDst;
+  w = srcSize.width;
+  h = srcSize.height;
+  count = w * h;
+  srcRow = w * pixelSize;
+
+  visited = (unsigned char*) calloc((count + 7) / 8, 1);
+  if(visited == NULL)
+    return ippStsNoMemErr;
+
+  /* Pack rows, destination never overtakes the source. */
+  for(y = 1; y < h; y++)
+    memmove(p + y * srcRow, p + y * srcStep, srcRow);
+
+  /* Element at packed index i = y * w + x goes to x * h + y. Follow each cycle backwards, pulling the source of the current slot into it. */
+  for(start = 1; start < count - 1; start++) {
+    if(visited[start >> 3] & (1 << (start & 7)))
+      continue;
+
+    memcpy(tmp, p + start * pixelSize, pixelSize);
+    i = start;
+    for(;;) {
+      visited[i >> 3] |= (unsigned char) (1 << (i & 7));
+      j = (i % h) * w + i / h; /* source of slot i */
+      if(j == start)
+        break;
+      memcpy(p + i * pixelSize, p + j * pixelSize, pixelSize);
+      i = j;
+    }
+    memcpy(p + i * pixelSize, tmp, pixelSize);
+  }
+
+  /* Spread rows of the transposed image, going backwards since destination is ahead of the source. */
+  for(y = w - 1; y > 0; y--)
+    memmove(p + y * dstStep, p + y * h * pixelSize, h * pixelSize);
+
+  free(visited);
+  return ippStsNoErr;
+}
+
+
@@ -0,0 +1,126 @@
+#ifndef __IPP4R_ROTATE_H__
+#define __IPP4R_ROTATE_H__
+
+#include <ippdefs.h>
+#include "ipp4r_fwd.h"
+#include "ipp4r_metatype.h"
+
+/**
+ * @file
+ *
+ * This file defines kernels for lossless right-angle rotations and flips, i.e. for the 8 symmetries of a rectangle. <p>
+ *
+ * Every such transform is a single pass: each destination pixel is read from a source position that is a linear function of destination coordinates,
+ * so a rotation never needs a separate transpose and mirror. Transforms that swap axes are processed in square tiles,
+ * which keeps both the destination rows and the source columns of a tile in cache. <p>
+ *
+ * In-place operation is supported for transforms that keep axes, and for square images. In place, pixels are moved along their cycles
+ * (pairs for flips and transposes, quadruples for quarter turns), also tile by tile. Transforms that mirror rows, in place or not,
+ * read them backwards with a constant stride instead, which the compiler vectorizes per dispatch tier.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -------------------------------------------------------------------------- //
+// Defines
+// -------------------------------------------------------------------------- //
+#define ROTATE_TILE 32  /**< Size of a tile in pixels */
+
+
+// -------------------------------------------------------------------------- //
+// Typedefs
+// -------------------------------------------------------------------------- //
+/**
+ * Orientation, values match the EXIF orientation tag. Each value names the transform that brings an image with such tag to normal orientation.
+ */
+typedef enum {
+  ORIENT_NORMAL = 1,      /**< no transform */
+  ORIENT_FLIP_H = 2,      /**< mirror about vertical axis */
+  ORIENT_ROTATE_180 = 3,  /**< rotate by 180 degrees */
+  ORIENT_FLIP_V = 4,      /**< mirror about horizontal axis */
+  ORIENT_TRANSPOSE = 5,   /**< mirror about main diagonal */
+  ORIENT_ROTATE_90 = 6,   /**< rotate by 90 degrees clockwise */
+  ORIENT_TRANSVERSE = 7,  /**< mirror about anti-diagonal */
+  ORIENT_ROTATE_270 = 8   /**< rotate by 90 degrees counterclockwise */
+} Orientation;
+
+
+// -------------------------------------------------------------------------- //
+// Function declarations
+// -------------------------------------------------------------------------- //
+/**
+ * @returns orientation transform that rotates an image k times by 90 degrees counterclockwise, k may be negative
+ */
+Orientation rotate_quarter_turns(int k);
+
+
+/**
+ * @returns TRUE if the given transform swaps image axes
+ */
+int rotate_swaps_axes(Orientation orientation);
+
+
+/**
+ * @returns size of a transformed image of the given size
+ */
+IppiSize rotate_size(Orientation orientation, IppiSize size);
+
+
+/**
+ * Transforms an image buffer. Source and destination must not overlap.
+ *
+ * @param orientation transform to apply
+ * @param metaType metatype of source and destination
+ * @param pSrc source buffer
+ * @param srcStep size of source row in bytes
+ * @param srcSize size of source in pixels
+ * @param pDst destination buffer of rotate_size(orientation, srcSize) pixels
+ * @param dstStep size of destination row in bytes
+ * @returns ippStsNoErr if everything went OK, non-zero error or warning code otherwise
+ */
+int rotate_copy(Orientation orientation, IppMetaType metaType, const void* pSrc, int srcStep, IppiSize srcSize, void* pDst, int dstStep);
+
+
+/**
+ * Transforms an image buffer in place.
+ *
+ * @param orientation transform to apply
+ * @param metaType metatype of an image
+ * @param pSrcDst image buffer
+ * @param srcDstStep size of image row in bytes
+ * @param size size of an image in pixels
+ * @returns ippStsNoErr if everything went OK, ippStsSizeErr if the transform swaps axes of a non-square image, non-zero error code otherwise
+ */
+int rotate_inplace(Orientation orientation, IppMetaType metaType, void* pSrcDst, int srcDstStep, IppiSize size);
+
+
+/**
+ * Transposes an image buffer of any size in place, changing its row size. <br>
+ * Rows are first packed together, then pixels are moved along the cycles of the transposition permutation, and finally rows of the transposed image
+ * are spread to dstStep bytes apart. Visited pixels are tracked in a bit set, which is the only extra memory used.
+ *
+ * @param pixelSize size of one pixel in bytes
+ * @param pSrcDst image buffer
+ * @param srcStep size of source row in bytes
+ * @param srcSize size of source in pixels
+ * @param dstStep size of destination row in bytes, must be at least <tt>srcSize.height * pixelSize</tt>. Buffer must hold srcSize.width rows of this size
+ * @returns ippStsNoErr if everything went OK, ippStsNoMemErr if memory for a bit set could not be allocated
+ */
+int rotate_transpose_restride(int pixelSize, void* pSrcDst, int srcStep, IppiSize srcSize, int dstStep);
+
+
+/**
+ * Registers dispatch tables of rotation kernels, see dispatch_init.
+ */
+void rotate_dispatch_init(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+
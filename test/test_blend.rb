@@ -0,0 +1,78 @@
+# Blend modes of Image#draw on known pixel values, over opaque (C3) and translucent (AC4) backgrounds.
+$:.unshift File.join(File.dirname(__FILE__), "..", "src")
+require 'test/unit'
+require 'ipp4r'
+
+class TestBlend < Test::Unit::TestCase
+  # [maximum of a data type, background metatypes, source metatype]
+  TYPES = [[255, [Ipp::Ipp8u_C3, Ipp::Ipp8u_AC4], Ipp::Ipp8u_AC4], [65535, [Ipp::Ipp16u_C3, Ipp::Ipp16u_AC4], Ipp::Ipp16u_AC4]]
+
+  # Row of width pixels of gray value v and alpha a, both in 0..255 units
+  def pixel(metatype, v, a, width = 1)
+    img = Ipp::Image.new(width, 1, metatype)
+    width.times { |x| img[x, 0] = Ipp::Color.new(v / 255.0, v / 255.0, v / 255.0, a / 255.0) }
+    img
+  end
+
+  # Runs the block with kernels of each tier the CPU supports
+  def each_tier
+    [:generic, :sse4, :avx2, :avx512].each do |tier|
+      begin
+        Ipp.force_cpu_tier = tier
+      rescue ArgumentError
+        next
+      end
+      yield tier
+    end
+  ensure
+    Ipp.force_cpu_tier = nil
+  end
+
+  # Checks that an opaque source s drawn over a background b gives expected, all in 0..255 units, on rows long enough for vectorized
+  # kernels and their scalar tails
+  def check(mode, s, b, expected, bgAlpha = 255)
+    each_tier do |tier|
+      TYPES.each do |max, bgs, sm|
+        bgs.each do |m|
+          dst = pixel(m, b, bgAlpha, 37)
+          dst.draw!(pixel(sm, s, 255, 37), 0, 0, mode)
+          [0, 36].each do |x|
+            assert_in_delta(expected / 255.0, dst[x, 0].r, 1.0 / max, "#{mode} on #{m}, #{tier}, pixel #{x}")
+            assert_in_delta(1.0, dst[x, 0].a, 1.0 / max, "#{mode} alpha on #{m}, #{tier}, pixel #{x}") if m == bgs.last
+          end
+        end
+      end
+    end
+  end
+
+  def test_over
+    check(Ipp::BlendOver, 128, 64, 128)
+  end
+
+  def test_multiply
+    check(Ipp::BlendMultiply, 128, 128, 128 * 128 / 255.0)
+    check(Ipp::BlendMultiply, 255, 100, 100)
+    check(Ipp::BlendMultiply, 0, 100, 0)
+  end
+
+  def test_screen
+    check(Ipp::BlendScreen, 128, 128, 128 + 128 - 128 * 128 / 255.0)
+    check(Ipp::BlendScreen, 0, 100, 100)
+    check(Ipp::BlendScreen, 255, 100, 255)
+  end
+
+  def test_additive
+    check(Ipp::BlendAdditive, 100, 50, 150)
+    check(Ipp::BlendAdditive, 200, 100, 255)
+  end
+
+  def test_translucent_background
+    # Only AC4 background has alpha: source 128 multiplied over background 128 at half alpha is 128 * (1 - 0.5) + 128 * 128 / 255 * 0.5
+    TYPES.each do |max, bgs, sm|
+      dst = pixel(bgs.last, 128, 127.5)
+      dst.draw!(pixel(sm, 128, 255), 0, 0, Ipp::BlendMultiply)
+      assert_in_delta((64 + 128 * 128 / 255.0 * 0.5) / 255.0, dst[0, 0].r, 2.0 / 255, "multiply on #{bgs.last}")
+      assert_in_delta(1.0, dst[0, 0].a, 1.0 / max, "multiply alpha on #{bgs.last}")
+    end
+  end
+end
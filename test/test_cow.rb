@@ -0,0 +1,74 @@
+# Copy-on-write sharing of image buffers between clones, and views that share pixels with their image.
+$:.unshift File.join(File.dirname(__FILE__), "..", "src")
+require 'test/unit'
+require 'ipp4r'
+
+class TestCow < Test::Unit::TestCase
+  def gray(width, height, v, metatype = Ipp::Ipp8u_C3)
+    img = Ipp::Image.new(width, height, metatype)
+    width.times { |x| height.times { |y| img[x, y] = Ipp::Color.new(v / 255.0, v / 255.0, v / 255.0, 1) } }
+    img
+  end
+
+  def value(img, x, y)
+    (img[x, y].r * 255).round
+  end
+
+  def allocations
+    Ipp.allocation_stats[:default][:allocations]
+  end
+
+  def test_clone_shares_buffer
+    img = gray(8, 8, 10)
+    before = allocations
+    copy = img.clone
+    assert_equal(before, allocations)
+    assert_equal(10, value(copy, 3, 3))
+  end
+
+  def test_clone_isolation
+    img = gray(8, 8, 10)
+    copy = img.clone
+    copy[1, 1] = Ipp::Color.new(1, 1, 1, 1)
+    assert_equal([10, 255], [value(img, 1, 1), value(copy, 1, 1)])
+
+    img.add!(img)
+    assert_equal([20, 10], [value(img, 2, 2), value(copy, 2, 2)])
+  end
+
+  def test_failed_operation_keeps_sharing
+    img = gray(8, 8, 10)
+    copy = img.clone
+    small = gray(4, 4, 1)
+    before = allocations
+    assert_raise(Ipp::Exception) { copy.add!(small) }
+    assert_equal(before, allocations)
+    assert_equal(10, value(img, 0, 0))
+  end
+
+  def test_subimage_sees_parent
+    img = gray(8, 8, 10)
+    sub = img.subimage(2, 2, 4, 4)
+    img[3, 3] = Ipp::Color.new(1, 1, 1, 1)
+    assert_equal(255, value(sub, 1, 1))
+    sub[0, 0] = Ipp::Color.new(0, 0, 0, 1)
+    assert_equal(0, value(img, 2, 2))
+  end
+
+  def test_clone_of_subimage
+    img = gray(8, 8, 10)
+    copy = img.subimage(2, 2, 4, 4).clone
+    img[3, 3] = Ipp::Color.new(1, 1, 1, 1)
+    assert_equal(10, value(copy, 1, 1))
+  end
+
+  def test_view_outlives_image
+    img = gray(8, 8, 10)
+    sub = img.subimage(1, 1, 2, 2)
+    plane = img.to_planar.channel(2)
+    img = nil
+    GC.start
+    assert_equal(10, value(sub, 1, 1))
+    assert_equal(10, value(plane, 5, 5))
+  end
+end
@@ -0,0 +1,80 @@
+# Image#async futures and Image.batch, run on the thread pool.
+$:.unshift File.join(File.dirname(__FILE__), "..", "src")
+# ipp4r first: its exit handler stops the pool and must run after the test runner's
+require 'ipp4r'
+require 'test/unit'
+
+class TestFuture < Test::Unit::TestCase
+  # Image with pixel (x, y) holding x in red and y in green, both in 0..255 units
+  def gradient(width, height)
+    img = Ipp::Image.new(width, height, Ipp::Ipp8u_C3)
+    width.times { |x| height.times { |y| img[x, y] = Ipp::Color.new((x + 0.5) / 255.0, (y + 0.5) / 255.0, 0, 1) } }
+    img
+  end
+
+  def xy(img, x, y)
+    [(img[x, y].r * 255).round, (img[x, y].g * 255).round]
+  end
+
+  def test_value
+    img = gradient(5, 3)
+    future = img.async.transpose
+    result = future.value
+    assert(future.ready?)
+    assert_equal([3, 5], [result.width, result.height])
+    assert_equal([4, 1], xy(result, 1, 4))
+    assert_same(result, future.value)
+  end
+
+  def test_wait
+    future = gradient(5, 3).async.transpose
+    future.wait
+    assert(future.ready?)
+  end
+
+  def test_source_isolation
+    img = gradient(5, 3)
+    future = img.async.transpose
+    img[4, 1] = Ipp::Color.new(1, 1, 1, 1)
+    assert_equal([4, 1], xy(future.value, 1, 4))
+  end
+
+  def test_then
+    future = gradient(5, 3).async.transpose.then { |img| img.width * 10 }
+    assert_equal(30, future.value)
+  end
+
+  def test_then_error
+    future = gradient(5, 3).async.transpose.then { |img| raise ArgumentError, "from block" }
+    assert_raise(ArgumentError) { future.value }
+    assert_raise(ArgumentError) { future.value }
+  end
+
+  def test_then_without_block
+    assert_raise(ArgumentError) { gradient(5, 3).async.transpose.then }
+  end
+
+  def test_batch
+    images = [gradient(4, 2), gradient(6, 3), gradient(5, 5)]
+    results = Ipp::Image.batch(images) { |b| b.transpose.rotate90 }
+    assert_equal([[4, 2], [6, 3], [5, 5]], results.map { |img| [img.width, img.height] })
+    results.each_with_index do |img, i|
+      assert_not_same(images[i], img)
+    end
+
+    results = Ipp::Image.batch(images) { |b| b.transpose }
+    assert_equal([[2, 4], [3, 6], [5, 5]], results.map { |img| [img.width, img.height] })
+    assert_equal([3, 1], xy(results[0], 1, 3))
+    assert_equal([4, 2], [images[0].width, images[0].height])
+  end
+
+  def test_batch_sealed
+    recorder = nil
+    Ipp::Image.batch([gradient(2, 2)]) { |b| recorder = b; b.transpose }
+    assert_raise(RuntimeError) { recorder.transpose }
+  end
+
+  def test_batch_empty
+    assert_equal([], Ipp::Image.batch([]) { |b| b.transpose })
+  end
+end
@@ -0,0 +1,81 @@
+# Image#apply_lut on known curves, with rows wide enough for the vectorized 8u kernels and with their scalar tails.
+$:.unshift File.join(File.dirname(__FILE__), "..", "src")
+require 'test/unit'
+require 'ipp4r'
+
+class TestLut < Test::Unit::TestCase
+  # Gray ramp image, pixel x holds x mod 256 in 0..255 units. Colors are converted to integers by truncation, hence the half.
+  def ramp(width, metatype = Ipp::Ipp8u_C1)
+    img = Ipp::Image.new(width, 2, metatype)
+    width.times do |x|
+      v = [(x % 256 + 0.5) / 255.0, 1.0].min
+      2.times { |y| img[x, y] = Ipp::Color.new(v, v, v, 1) }
+    end
+    img
+  end
+
+  # Runs the block with kernels of each tier the CPU supports
+  def each_tier
+    [:generic, :sse4, :avx2, :avx512].each do |tier|
+      begin
+        Ipp.force_cpu_tier = tier
+      rescue ArgumentError
+        next
+      end
+      yield tier
+    end
+  ensure
+    Ipp.force_cpu_tier = nil
+  end
+
+  def value(img, x, y = 0)
+    (img[x, y].r * 255).round
+  end
+
+  def test_invert
+    each_tier do |tier|
+      [1, 63, 64, 100, 1000].each do |width|
+        img = ramp(width).apply_lut([1.0, 0.0])
+        width.times { |x| assert_equal(255 - x % 256, value(img, x), "#{tier}, width #{width}, pixel #{x}") }
+      end
+    end
+  end
+
+  def test_gamma
+    img = ramp(256).apply_lut(Ipp::LUT.gamma(2.2))
+    256.times { |x| assert_in_delta(255 * (x / 255.0) ** 2.2, value(img, x), 1.0, "pixel #{x}") }
+  end
+
+  def test_levels
+    img = ramp(256).apply_lut(Ipp::LUT.levels(0.25, 0.75))
+    assert_equal(0, value(img, 10))
+    assert_equal(255, value(img, 250))
+    assert_in_delta(128, value(img, 128), 1.0)
+  end
+
+  def test_compose
+    lut = Ipp::LUT.new([1.0, 0.0]).compose(Ipp::LUT.new([1.0, 0.0]))
+    img = ramp(300).apply_lut(lut)
+    300.times { |x| assert_equal(x % 256, value(img, x)) }
+  end
+
+  def test_channels
+    each_tier do |tier|
+      [Ipp::Ipp8u_C3, Ipp::Ipp8u_AC4].each do |metatype|
+        img = ramp(130, metatype)
+        img.apply_lut!(Ipp::LUT.new([0.0, 0.0], [0.0, 1.0], [1.0, 0.0]))
+        130.times do |x|
+          c = img[x, 1]
+          assert_equal([0, x, 255 - x], [(c.r * 255).round, (c.g * 255).round, (c.b * 255).round], "#{tier}, #{metatype}, pixel #{x}")
+          assert_in_delta(1.0, c.a, 1e-6)
+        end
+      end
+    end
+  end
+
+  def test_16u
+    src = ramp(256, Ipp::Ipp16u_C1)
+    img = src.apply_lut([1.0, 0.0])
+    256.times { |x| assert_in_delta(1.0 - src[x, 0].r, img[x, 0].r, 1.0 / 65535) }
+  end
+end
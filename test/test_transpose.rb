@@ -0,0 +1,78 @@
+# Image#transpose! in place and through a copy, with subimages and plane views of the transposed image alive.
+$:.unshift File.join(File.dirname(__FILE__), "..", "src")
+require 'test/unit'
+require 'ipp4r'
+
+class TestTranspose < Test::Unit::TestCase
+  # Image with pixel (x, y) holding x in red and y in green, both in 0..255 units
+  def gradient(width, height, metatype = Ipp::Ipp8u_C4)
+    img = Ipp::Image.new(width, height, metatype)
+    width.times { |x| height.times { |y| img[x, y] = Ipp::Color.new(x / 255.0, y / 255.0, 0, 1) } }
+    img
+  end
+
+  def assert_transposed(img, width, height)
+    assert_equal([height, width], [img.width, img.height])
+    height.times do |x|
+      width.times do |y|
+        assert_equal([y, x], [(img[x, y].r * 255).round, (img[x, y].g * 255).round], "pixel #{x}, #{y}")
+      end
+    end
+  end
+
+  def allocations
+    Ipp.allocation_stats[:default][:allocations]
+  end
+
+  def test_restride
+    # Rows of 64 pixels and columns of 48, border included, have aligned steps that fit into the buffer both ways
+    img = gradient(62, 46)
+    before = allocations
+    img.transpose!
+    assert_equal(before, allocations)
+    assert_transposed(img, 62, 46)
+  end
+
+  def test_square
+    img = gradient(5, 5)
+    img.transpose!
+    assert_transposed(img, 5, 5)
+  end
+
+  def test_subimage
+    img = gradient(62, 46)
+    sub = img.subimage(1, 2, 3, 4)
+    img.transpose!
+    assert_transposed(img, 62, 46)
+
+    img = nil
+    GC.start
+    assert_equal([3, 4], [sub.width, sub.height])
+    assert_equal([2, 3], [(sub[1, 1].r * 255).round, (sub[1, 1].g * 255).round])
+  end
+
+  def test_clone
+    img = gradient(62, 46)
+    copy = img.clone
+    img.transpose!
+    assert_transposed(img, 62, 46)
+    assert_equal([62, 46], [copy.width, copy.height])
+    assert_equal([7, 3], [(copy[7, 3].r * 255).round, (copy[7, 3].g * 255).round])
+  end
+
+  def test_plane
+    planar = gradient(6, 4, Ipp::Ipp8u_C3).to_planar
+    plane = planar.channel(1)
+    plane.transpose!
+    assert_equal([4, 6], [plane.width, plane.height])
+    assert_equal(3, (plane[3, 5].r * 255).round)
+
+    plane = planar.channel(1)
+    planar = nil
+    GC.start
+    assert_equal([6, 4], [plane.width, plane.height])
+    assert_equal(3, (plane[5, 3].r * 255).round)
+    plane.transpose!
+    assert_equal(3, (plane[3, 5].r * 255).round)
+  end
+end